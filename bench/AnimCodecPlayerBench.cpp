@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/utils/SkAnimCodecPlayer.h"
+#include "include/utils/SkRandom.h"
+#include "tools/Resources.h"
+
+#include <algorithm>
+
+// Seeks to random times in an animation, measuring how long it takes to get each frame for a
+// few sizes of the shared frame cache.  getStats() reports how much of the budget was used.
+class AnimCodecPlayerSeekBench final : public Benchmark {
+ public:
+  enum class Budget {
+    kNone,       // Every seek decodes back to an independent frame.
+    kKeyframes,  // Room for about one frame in eight.
+    kAllFrames,
+  };
+
+  AnimCodecPlayerSeekBench(const char* name, const char* source, Budget budget)
+      : fSource(source), fBudget(budget) {
+    static const char* kBudgetNames[] = {"none", "keyframes", "all"};
+    fName.printf("animcodecplayer_seek_%s_%s", name, kBudgetNames[(int)budget]);
+  }
+
+ private:
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+  const char* onGetName() override { return fName.c_str(); }
+
+  void onDelayedSetup() override {
+    sk_sp<SkData> data = GetResourceAsData(fSource);
+    SkASSERT(data);
+    const int frameCount = SkCodec::MakeFromData(data)->getFrameCount();
+    fPlayer = SkAnimCodecPlayer::Make(std::move(data));
+    SkASSERT(fPlayer && fPlayer->duration() > 0);
+
+    const size_t frameBytes = fPlayer->getFrame()->imageInfo().computeMinByteSize();
+    switch (fBudget) {
+      case Budget::kNone: fByteLimit = 0; break;
+      case Budget::kKeyframes: fByteLimit = frameBytes * std::max(1, frameCount / 8); break;
+      case Budget::kAllFrames: fByteLimit = frameBytes * frameCount; break;
+    }
+  }
+
+  void onPerCanvasPreDraw(SkCanvas*) override {
+    fOldByteLimit = SkAnimCodecPlayer::SetFrameCacheByteLimit(fByteLimit);
+  }
+
+  void onPerCanvasPostDraw(SkCanvas*) override {
+    fBytesUsed = SkAnimCodecPlayer::GetFrameCacheBytesUsed();
+    SkAnimCodecPlayer::SetFrameCacheByteLimit(fOldByteLimit);
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    SkRandom rand;
+    while (loops-- > 0) {
+      fPlayer->seek(rand.nextULessThan(fPlayer->duration()));
+      SkAssertResult(fPlayer->getFrame());
+    }
+  }
+
+  void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) override {
+    keys->push_back(SkString("frame_cache_byte_limit"));
+    values->push_back(fByteLimit);
+    keys->push_back(SkString("frame_cache_bytes"));
+    values->push_back(fBytesUsed);
+  }
+
+  SkString fName;
+  const char* fSource;
+  const Budget fBudget;
+  std::unique_ptr<SkAnimCodecPlayer> fPlayer;
+  size_t fByteLimit = 0;
+  size_t fOldByteLimit = 0;
+  size_t fBytesUsed = 0;
+};
+
+using Budget = AnimCodecPlayerSeekBench::Budget;
+
+DEF_BENCH(return new AnimCodecPlayerSeekBench("flight", "images/flightAnim.gif", Budget::kNone));
+DEF_BENCH(return new AnimCodecPlayerSeekBench(
+    "flight", "images/flightAnim.gif", Budget::kKeyframes));
+DEF_BENCH(return new AnimCodecPlayerSeekBench(
+    "flight", "images/flightAnim.gif", Budget::kAllFrames));
+DEF_BENCH(return new AnimCodecPlayerSeekBench("required", "images/required.webp", Budget::kNone));
+DEF_BENCH(return new AnimCodecPlayerSeekBench(
+    "required", "images/required.webp", Budget::kKeyframes));
+DEF_BENCH(return new AnimCodecPlayerSeekBench(
+    "required", "images/required.webp", Budget::kAllFrames));
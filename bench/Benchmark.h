@@ -76,6 +76,9 @@ class Benchmark : public SkRefCnt {
 
   virtual void getGpuStats(SkCanvas*, SkTArray<SkString>* keys, SkTArray<double>* values) {}
 
+  // Extra metrics to log alongside the timing samples, for any backend.
+  virtual void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) {}
+
   // Replaces the GrRecordingContext's dmsaaStats() with a single frame of this benchmark.
   virtual bool getDMSAAStats(GrRecordingContext*) { return false; }
 
@@ -39,6 +39,8 @@ class BitmapRegionDecoderBench : public Benchmark {
   bool isSuitableFor(Backend backend) override;
   void onDraw(int n, SkCanvas* canvas) override;
   void onDelayedSetup() override;
+  void onPerCanvasPreDraw(SkCanvas*) override;
+  void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) override;
 
  private:
   SkString fName;
@@ -47,6 +49,10 @@ class BitmapRegionDecoderBench : public Benchmark {
   const SkColorType fColorType;
   const uint32_t fSampleSize;
   const SkIRect fSubset;
+  // Each loop of onDraw() decodes one crop, so the timing samples are already per crop.
+  // These measure the memory one crop takes.
+  size_t fCropBytes = 0;
+  int64_t fCropRSSBytes = 0;
   using INHERITED = Benchmark;
 };
 #endif  // SK_ENABLE_ANDROID_UTILS
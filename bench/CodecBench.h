@@ -10,6 +10,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
@@ -21,7 +22,10 @@
 class CodecBench : public Benchmark {
  public:
   // Calls encoded->ref()
-  CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType);
+  // If threads > 0, decodes on a thread pool of that many threads.
+  CodecBench(
+      SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType,
+      int threads = 0);
 
  protected:
   const char* onGetName() override;
@@ -33,9 +37,11 @@ class CodecBench : public Benchmark {
   SkString fName;
   const SkColorType fColorType;
   const SkAlphaType fAlphaType;
+  const int fThreads;
   sk_sp<SkData> fData;
   SkImageInfo fInfo;  // Set in onDelayedSetup.
   SkAutoMalloc fPixelStorage;
+  std::unique_ptr<SkExecutor> fExecutor;  // Set in onDelayedSetup if fThreads > 0.
   using INHERITED = Benchmark;
 };
 #endif  // CodecBench_DEFINED
@@ -7,6 +7,9 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
@@ -121,3 +124,69 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Encodes a screenshot-sized PNG serially or in parallel chunks on a thread pool, at a given
+// fZLibLevel.  Setup logs how much bigger the parallel encoding is than the serial one.
+class PngParallelEncodeBench : public Benchmark {
+ public:
+  PngParallelEncodeBench(int zlibLevel, bool parallel)
+      : fZLibLevel(zlibLevel)
+      , fParallel(parallel)
+      , fName(SkStringPrintf("Encode_PNG_2048_%d%s", zlibLevel, parallel ? "_mt" : "")) {}
+
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+  const char* onGetName() override { return fName.c_str(); }
+
+  void onDelayedSetup() override {
+    sk_sp<SkImage> tile = GetResourceAsImage("images/mandrill_512.png");
+    SkASSERT(tile);
+    fBitmap.allocN32Pixels(2048, 2048, /*isOpaque=*/true);
+    SkCanvas canvas(fBitmap);
+    for (int y = 0; y < 2048; y += tile->height()) {
+      for (int x = 0; x < 2048; x += tile->width()) {
+        canvas.drawImage(tile, x, y);
+      }
+    }
+
+    if (fParallel) {
+      fExecutor = SkExecutor::MakeFIFOThreadPool();
+      SkDynamicMemoryWStream serial, parallel;
+      SkAssertResult(this->encode(&serial, nullptr));
+      SkAssertResult(this->encode(&parallel, fExecutor.get()));
+      SkDebugf(
+          "%s: %zu bytes, %+.2f%% vs. serial\n", fName.c_str(), parallel.bytesWritten(),
+          100.0 * ((double)parallel.bytesWritten() / serial.bytesWritten() - 1));
+    }
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    while (loops-- > 0) {
+      SkNullWStream dst;
+      SkAssertResult(this->encode(&dst, fExecutor.get()));
+    }
+  }
+
+ private:
+  bool encode(SkWStream* dst, SkExecutor* executor) const {
+    SkPixmap pixmap;
+    SkAssertResult(fBitmap.peekPixels(&pixmap));
+    SkPngEncoder::Options opts;
+    opts.fZLibLevel = fZLibLevel;
+    opts.fExecutor = executor;
+    return SkPngEncoder::Encode(dst, pixmap, opts);
+  }
+
+  int fZLibLevel;
+  bool fParallel;
+  SkString fName;
+  SkBitmap fBitmap;
+  std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new PngParallelEncodeBench(1, false));
+DEF_BENCH(return new PngParallelEncodeBench(1, true));
+DEF_BENCH(return new PngParallelEncodeBench(6, false));
+DEF_BENCH(return new PngParallelEncodeBench(6, true));
+DEF_BENCH(return new PngParallelEncodeBench(9, false));
+DEF_BENCH(return new PngParallelEncodeBench(9, true));
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/utils/SkRandom.h"
+
+#include <vector>
+
+// Flushes a frame of antialiased concave paths on the mock backend, which the triangulating path
+// renderer triangulates at flush time without caching. With 'parallel', the ops do that on a
+// thread pool (GrContextOptions::fPrepareOpsInParallel).
+class FlushPrepareBench : public Benchmark {
+ public:
+  FlushPrepareBench(bool parallel) : fParallel(parallel) {
+    fName.printf("flush_prepare_triangulated_paths_%s", parallel ? "parallel" : "serial");
+  }
+
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+ protected:
+  inline static constexpr int kNumPaths = 2000;
+  // The triangulator only antialiases paths with up to 10 verbs.
+  inline static constexpr int kPointsPerPath = 9;
+  inline static constexpr int kSurfaceSize = 1024;
+
+  const char* onGetName() override { return fName.c_str(); }
+
+  void onDelayedSetup() override {
+    GrContextOptions options;
+    options.fGpuPathRenderers = GpuPathRenderers::kTriangulating;
+    if (fParallel) {
+      fExecutor = SkExecutor::MakeFIFOThreadPool();
+      options.fExecutor = fExecutor.get();
+      options.fPrepareOpsInParallel = true;
+    }
+    fContext = GrDirectContext::MakeMock(nullptr, options);
+    if (!fContext) {
+      return;
+    }
+    fSurface = SkSurface::MakeRenderTarget(
+        fContext.get(), SkBudgeted::kNo, SkImageInfo::MakeN32Premul(kSurfaceSize, kSurfaceSize));
+
+    // Self-intersecting stars, so the triangulator has some work to do.
+    SkRandom rand;
+    for (int i = 0; i < kNumPaths; ++i) {
+      SkPoint center = {rand.nextRangeF(0, kSurfaceSize), rand.nextRangeF(0, kSurfaceSize)};
+      float radius = rand.nextRangeF(16, 64);
+      SkPath& star = fPaths.emplace_back();
+      for (int p = 0; p < kPointsPerPath; ++p) {
+        float angle = p * 4 * SK_ScalarPI * 2 / kPointsPerPath;
+        star.lineTo(center + SkVector{SkScalarCos(angle), SkScalarSin(angle)} * radius);
+      }
+    }
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    if (!fSurface) {
+      return;
+    }
+    SkCanvas* canvas = fSurface->getCanvas();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < loops; ++i) {
+      for (const SkPath& path : fPaths) {
+        canvas->drawPath(path, paint);
+      }
+      fContext->flushAndSubmit();
+    }
+  }
+
+  SkString fName;
+  const bool fParallel;
+  std::unique_ptr<SkExecutor> fExecutor;
+  sk_sp<GrDirectContext> fContext;
+  sk_sp<SkSurface> fSurface;
+  std::vector<SkPath> fPaths;
+
+  using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new FlushPrepareBench(/* parallel */ false);)
+DEF_BENCH(return new FlushPrepareBench(/* parallel */ true);)
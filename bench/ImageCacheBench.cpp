@@ -7,6 +7,7 @@
 
 #include "bench/Benchmark.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -66,6 +67,44 @@ class ImageCacheBench : public Benchmark {
   using INHERITED = Benchmark;
 };
 
+// Many threads hitting the same cache, the way raster worker threads hit the global one.
+class ImageCacheThreadedBench : public Benchmark {
+  SkShardedResourceCache fCache;
+  SkString fName;
+
+  enum { CACHE_COUNT = 500, THREAD_COUNT = 16 };
+
+ public:
+  explicit ImageCacheThreadedBench(int shardCount) : fCache(CACHE_COUNT * 100, shardCount) {
+    fName.printf("imagecache_threaded_%dshards", shardCount);
+  }
+
+ protected:
+  const char* onGetName() override { return fName.c_str(); }
+
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+  void onDelayedSetup() override {
+    for (int i = 0; i < CACHE_COUNT; ++i) {
+      fCache.add(new TestRec(TestKey(i), i));
+    }
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    SkTaskGroup().batch(THREAD_COUNT, [&](int thread) {
+      // Mostly hits, spread over the whole cache.
+      for (int i = 0; i < loops; ++i) {
+        fCache.find(TestKey((i * 7 + thread) % CACHE_COUNT), TestRec::Visitor, nullptr);
+      }
+    });
+  }
+
+ private:
+  using INHERITED = Benchmark;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new ImageCacheBench();)
+DEF_BENCH(return new ImageCacheThreadedBench(1);)
+DEF_BENCH(return new ImageCacheThreadedBench(16);)
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrDirectContext.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpu.h"
+
+// Records a UI-like stream of small rects into one OpsTask on the mock backend and flushes it.
+// Each rect uses the next of several blend modes in turn, so rects that could batch together are
+// more chains apart than OpsTask checks one by one. When the rects don't overlap, they can still
+// be batched by looking further; when they do, nothing may be reordered and nothing batches.
+class OpsTaskBench : public Benchmark {
+ public:
+  OpsTaskBench(bool overlap) : fOverlap(overlap) {
+    fName.printf("opstask_interleaved_rects_%s", overlap ? "overlapping" : "disjoint");
+  }
+
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+ protected:
+  inline static constexpr int kSurfaceSize = 1024;
+  inline static constexpr int kRectsPerSide = 32;
+
+  // The coefficient blend modes besides kClear and kDst, which are optimized away.
+  inline static constexpr SkBlendMode kModes[] = {
+      SkBlendMode::kSrc,     SkBlendMode::kSrcOver, SkBlendMode::kDstOver, SkBlendMode::kSrcIn,
+      SkBlendMode::kDstIn,   SkBlendMode::kSrcOut,  SkBlendMode::kDstOut,  SkBlendMode::kSrcATop,
+      SkBlendMode::kDstATop, SkBlendMode::kXor,     SkBlendMode::kPlus,    SkBlendMode::kModulate,
+      SkBlendMode::kScreen};
+
+  const char* onGetName() override { return fName.c_str(); }
+
+  void onDelayedSetup() override {
+    fContext = GrDirectContext::MakeMock(nullptr);
+    if (!fContext) {
+      return;
+    }
+    fSurface = SkSurface::MakeRenderTarget(
+        fContext.get(), SkBudgeted::kNo, SkImageInfo::MakeN32Premul(kSurfaceSize, kSurfaceSize));
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    if (!fSurface) {
+      return;
+    }
+#if GR_GPU_STATS
+    int drawsBefore = fContext->priv().getGpu()->stats()->numDraws();
+#endif
+    const float cellSize = (float)kSurfaceSize / kRectsPerSide;
+    const float rectSize = fOverlap ? cellSize * 2 : cellSize - 2;
+    SkCanvas* canvas = fSurface->getCanvas();
+    SkPaint paint;
+    for (int i = 0; i < loops; ++i) {
+      int mode = 0;
+      for (int y = 0; y < kRectsPerSide; ++y) {
+        for (int x = 0; x < kRectsPerSide; ++x) {
+          paint.setColor(0xff000000 | (x * 8) << 16 | (y * 8) << 8);
+          paint.setBlendMode(kModes[mode]);
+          mode = (mode + 1) % SK_ARRAY_COUNT(kModes);
+          canvas->drawRect(SkRect::MakeXYWH(x * cellSize, y * cellSize, rectSize, rectSize), paint);
+        }
+      }
+      fContext->flushAndSubmit();
+    }
+#if GR_GPU_STATS
+    fDrawsPerFlush =
+        (double)(fContext->priv().getGpu()->stats()->numDraws() - drawsBefore) / loops;
+#endif
+  }
+
+  void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) override {
+#if GR_GPU_STATS
+    keys->push_back(SkString("draws_per_flush"));
+    values->push_back(fDrawsPerFlush);
+#endif
+  }
+
+  SkString fName;
+  const bool fOverlap;
+  sk_sp<GrDirectContext> fContext;
+  sk_sp<SkSurface> fSurface;
+  double fDrawsPerFlush = 0;
+
+  using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new OpsTaskBench(/* overlap */ false);)
+DEF_BENCH(return new OpsTaskBench(/* overlap */ true);)
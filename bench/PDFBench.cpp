@@ -73,6 +73,11 @@ DEF_BENCH(return new PDFScalarBench("PDFScalar_random", next_any);)
 
 #ifdef SK_SUPPORT_PDF
 
+#  include "include/core/SkFont.h"
+#  include "include/core/SkFontMgr.h"
+#  include "include/core/SkFontStyle.h"
+#  include "include/core/SkTypeface.h"
+#  include "src/pdf/SkDeflate.h"
 #  include "src/pdf/SkPDFBitmap.h"
 #  include "src/pdf/SkPDFDocumentPriv.h"
 #  include "src/pdf/SkPDFShader.h"
@@ -179,6 +184,42 @@ class PDFCompressionBench : public Benchmark {
   std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Deflate a few megabytes of PDF commands, serially or a block at a time on an executor's
+    threads, as SkPDF does for large streams when given SkPDF::Metadata::fExecutor. */
+class PDFDeflateBench : public Benchmark {
+ public:
+  explicit PDFDeflateBench(bool parallel) : fParallel(parallel) {}
+
+ protected:
+  const char* onGetName() override {
+    return fParallel ? "PDFDeflate_parallel" : "PDFDeflate_serial";
+  }
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+  void onDelayedSetup() override {
+    sk_sp<SkData> commands = GetResourceAsData("pdf_command_stream.txt");
+    SkASSERT(commands);
+    SkDynamicMemoryWStream input;
+    for (int i = 0; i < 64; ++i) {
+      input.write(commands->data(), commands->size());
+    }
+    fInput = input.detachAsData();
+    fExecutor = fParallel ? SkExecutor::MakeFIFOThreadPool() : nullptr;
+  }
+  void onDraw(int loops, SkCanvas*) override {
+    while (loops-- > 0) {
+      SkNullWStream wStream;
+      SkDeflateWStream deflateWStream(&wStream, -1, false, fExecutor.get());
+      deflateWStream.write(fInput->data(), fInput->size());
+      deflateWStream.finalize();
+    }
+  }
+
+ private:
+  const bool fParallel;
+  sk_sp<SkData> fInput;
+  std::unique_ptr<SkExecutor> fExecutor;
+};
+
 struct PDFColorComponentBench : public Benchmark {
   bool isSuitableFor(Backend b) override { return b == kNonRendering_Backend; }
   const char* onGetName() override { return "PDFColorComponent"; }
@@ -288,14 +329,81 @@ struct PDFClipPathBenchmark : public Benchmark {
   }
 };
 
+// A few pages of text in every CJK typeface the font manager has, using thousands of glyphs from
+// each.  Most of the time goes to closing the document, which subsets each font and makes its
+// glyph widths and ToUnicode CMap; with an executor that happens in parallel.
+struct PDFCJKDocBench : public Benchmark {
+  bool fParallel;
+  std::vector<sk_sp<SkTypeface>> fTypefaces;
+  std::unique_ptr<SkExecutor> fExecutor;
+  explicit PDFCJKDocBench(bool parallel) : fParallel(parallel) {}
+  const char* onGetName() override {
+    return fParallel ? "PDFCJKDocBench_parallel" : "PDFCJKDocBench_serial";
+  }
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+  void onDelayedSetup() override {
+    sk_sp<SkFontMgr> fontMgr = SkFontMgr::RefDefault();
+    for (SkFontStyle style : {SkFontStyle::Normal(), SkFontStyle::Bold()}) {
+      for (const char* language : {"ja", "ko", "zh-Hans", "zh-Hant"}) {
+        sk_sp<SkTypeface> typeface(fontMgr->matchFamilyStyleCharacter(
+            nullptr, style, &language, 1, 0x6587));  // 文
+        if (typeface && std::none_of(fTypefaces.begin(), fTypefaces.end(),
+                                     [&typeface](const sk_sp<SkTypeface>& t) {
+                                       return SkTypeface::Equal(t.get(), typeface.get());
+                                     })) {
+          fTypefaces.push_back(std::move(typeface));
+        }
+      }
+    }
+    if (fTypefaces.empty()) {
+      if (auto typeface = MakeResourceAsTypeface("fonts/NotoSansCJK-VF-subset.otf.ttc")) {
+        fTypefaces.push_back(std::move(typeface));
+      }
+    }
+    fExecutor = fParallel ? SkExecutor::MakeFIFOThreadPool() : nullptr;
+  }
+  void onDraw(int loops, SkCanvas*) override {
+    constexpr int kPages = 4, kLines = 40, kGlyphsPerLine = 40;
+    while (loops-- > 0) {
+      SkNullWStream wStream;
+      SkPDF::Metadata metadata;
+      metadata.fExecutor = fExecutor.get();
+      auto doc = SkPDF::MakeDocument(&wStream, metadata);
+      for (int page = 0; page < kPages; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
+          SkFont font(typeface, 12);
+          const int glyphCount = std::max(typeface->countGlyphs(), 2);
+          for (int line = 0; line < kLines; ++line) {
+            SkGlyphID glyphs[kGlyphsPerLine];
+            for (int i = 0; i < kGlyphsPerLine; ++i) {
+              int index = (page * kLines + line) * kGlyphsPerLine + i;
+              glyphs[i] = SkToU16(1 + index % (glyphCount - 1));
+            }
+            canvas->drawSimpleText(
+                glyphs, sizeof(glyphs), SkTextEncoding::kGlyphID, 20, 20 + 18 * line, font,
+                SkPaint());
+          }
+        }
+        doc->endPage();
+      }
+      doc->close();
+    }
+  }
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFDeflateBench(false);)
+DEF_BENCH(return new PDFDeflateBench(true);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
 DEF_BENCH(return new PDFClipPathBenchmark;)
+DEF_BENCH(return new PDFCJKDocBench(false);)
+DEF_BENCH(return new PDFCJKDocBench(true);)
 
 #  ifdef SK_PDF_ENABLE_SLOW_TESTS
 #    include "include/core/SkExecutor.h"
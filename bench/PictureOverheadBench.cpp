@@ -7,6 +7,8 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRRect.h"
 
@@ -40,3 +42,48 @@ class ClipOverheadRecordingBench : public Benchmark {
   }
 };
 DEF_BENCH(return new ClipOverheadRecordingBench;)
+
+// Measures loading a serialized picture, either re-recording it (MakeFromData) or playing it
+// back straight from the serialized data (MakeDeferredFromData).
+class PictureDeserializeBench : public Benchmark {
+ public:
+  explicit PictureDeserializeBench(bool deferred) : fDeferred(deferred) {}
+
+ private:
+  const char* onGetName() override {
+    return fDeferred ? "picture_deserialize_deferred" : "picture_deserialize";
+  }
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+  void onDelayedSetup() override {
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording({0, 0, 2000, 3000});
+
+    SkPaint paint;
+    SkRRect rrect;
+    rrect.setOval({0, 0, 100, 100});
+    for (int i = 0; i < 10000; i++) {
+      paint.setColor(0xff000000 | (i * 0x10101));
+      canvas->save();
+      canvas->translate(i % 200 * 10, i / 200 * 60);
+      canvas->clipRect({0, 0, 100, 100});
+      canvas->drawRRect(rrect, paint);
+      canvas->drawRect({10, 20, 30, 40}, paint);
+      canvas->restore();
+    }
+    fData = rec.finishRecordingAsPicture()->serialize();
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    for (int loop = 0; loop < loops; loop++) {
+      sk_sp<SkPicture> picture = fDeferred ? SkPicture::MakeDeferredFromData(fData)
+                                           : SkPicture::MakeFromData(fData.get());
+      SkASSERT(picture);
+    }
+  }
+
+  const bool fDeferred;
+  sk_sp<SkData> fData;
+};
+DEF_BENCH(return new PictureDeserializeBench(false);)
+DEF_BENCH(return new PictureDeserializeBench(true);)
@@ -9,6 +9,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
@@ -97,3 +98,55 @@ DEF_BENCH(return new TiledPlaybackBench(kNone, kRandom);)
 DEF_BENCH(return new TiledPlaybackBench(kNone, kTiled);)
 DEF_BENCH(return new TiledPlaybackBench(kRTree, kRandom);)
 DEF_BENCH(return new TiledPlaybackBench(kRTree, kTiled);)
+
+// Plays back a whole 1024x1024 picture at once, either serially or split into tiles drawn in
+// parallel with SkPicture::parallelPlayback().
+class ParallelPlaybackBench : public Benchmark {
+ public:
+  explicit ParallelPlaybackBench(int threads) : fThreads(threads) {
+    fName.printf("parallel_playback_%d", threads);
+  }
+
+  const char* onGetName() override { return fName.c_str(); }
+  SkIPoint onGetSize() override { return SkIPoint::Make(1024, 1024); }
+
+  void onDelayedSetup() override {
+    if (fThreads > 0) {
+      fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(1024, 1024, &factory);
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 10000; i++) {
+      SkScalar x = rand.nextRangeScalar(0, 1024), y = rand.nextRangeScalar(0, 1024),
+               r = rand.nextRangeScalar(0, 64);
+      paint.setColor(rand.nextU());
+      canvas->drawCircle(x, y, r, paint);
+    }
+    fPic = recorder.finishRecordingAsPicture();
+  }
+
+  void onDraw(int loops, SkCanvas* canvas) override {
+    for (int i = 0; i < loops; i++) {
+      if (fExecutor) {
+        fPic->parallelPlayback(canvas, fExecutor.get());
+      } else {
+        fPic->playback(canvas);
+      }
+    }
+  }
+
+ private:
+  int fThreads;
+  SkString fName;
+  sk_sp<SkPicture> fPic;
+  std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new ParallelPlaybackBench(0);)
+DEF_BENCH(return new ParallelPlaybackBench(4);)
+DEF_BENCH(return new ParallelPlaybackBench(16);)
@@ -16,15 +16,30 @@
 static const SkScalar GENERATE_EXTENTS = 1000.0f;
 static const int NUM_BUILD_RECTS = 500;
 static const int NUM_QUERY_RECTS = 5000;
+// Roughly the op count of the big SKPs that motivated Hilbert packing.
+static const int NUM_LARGE_RECTS = 100000;
 static const int GRID_WIDTH = 100;
 
 typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 
+static void append_variant(SkString* name, int count, int defaultCount, SkRTree::Packing packing) {
+  if (count != defaultCount) {
+    name->appendf("_%d", count);
+  }
+  if (SkRTree::Packing::kHilbert == packing) {
+    name->append("_hilbert");
+  }
+}
+
 // Time how long it takes to build an R-Tree.
 class RTreeBuildBench : public Benchmark {
  public:
-  RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
+  RTreeBuildBench(
+      const char* name, MakeRectProc proc, int count = NUM_BUILD_RECTS,
+      SkRTree::Packing packing = SkRTree::Packing::kInsertionOrder)
+      : fProc(proc), fCount(count), fPacking(packing) {
     fName.printf("rtree_%s_build", name);
+    append_variant(&fName, count, NUM_BUILD_RECTS, packing);
   }
 
   bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
@@ -33,20 +48,22 @@ class RTreeBuildBench : public Benchmark {
   const char* onGetName() override { return fName.c_str(); }
   void onDraw(int loops, SkCanvas* canvas) override {
     SkRandom rand;
-    SkAutoTMalloc<SkRect> rects(NUM_BUILD_RECTS);
-    for (int i = 0; i < NUM_BUILD_RECTS; ++i) {
-      rects[i] = fProc(rand, i, NUM_BUILD_RECTS);
+    SkAutoTMalloc<SkRect> rects(fCount);
+    for (int i = 0; i < fCount; ++i) {
+      rects[i] = fProc(rand, i, fCount);
     }
 
     for (int i = 0; i < loops; ++i) {
-      SkRTree tree;
-      tree.insert(rects.get(), NUM_BUILD_RECTS);
+      SkRTree tree(fPacking);
+      tree.insert(rects.get(), fCount);
       SkASSERT(rects != nullptr);  // It'd break this bench if the tree took ownership of rects.
     }
   }
 
  private:
   MakeRectProc fProc;
+  int fCount;
+  SkRTree::Packing fPacking;
   SkString fName;
   using INHERITED = Benchmark;
 };
@@ -54,8 +71,12 @@ class RTreeBuildBench : public Benchmark {
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
  public:
-  RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
+  RTreeQueryBench(
+      const char* name, MakeRectProc proc, int count = NUM_QUERY_RECTS,
+      SkRTree::Packing packing = SkRTree::Packing::kInsertionOrder)
+      : fTree(packing), fProc(proc), fCount(count) {
     fName.printf("rtree_%s_query", name);
+    append_variant(&fName, count, NUM_QUERY_RECTS, packing);
   }
 
   bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
@@ -64,11 +85,11 @@ class RTreeQueryBench : public Benchmark {
   const char* onGetName() override { return fName.c_str(); }
   void onDelayedSetup() override {
     SkRandom rand;
-    SkAutoTMalloc<SkRect> rects(NUM_QUERY_RECTS);
-    for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
-      rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+    SkAutoTMalloc<SkRect> rects(fCount);
+    for (int i = 0; i < fCount; ++i) {
+      rects[i] = fProc(rand, i, fCount);
     }
-    fTree.insert(rects.get(), NUM_QUERY_RECTS);
+    fTree.insert(rects.get(), fCount);
   }
 
   void onDraw(int loops, SkCanvas* canvas) override {
@@ -87,6 +108,7 @@ class RTreeQueryBench : public Benchmark {
  private:
   SkRTree fTree;
   MakeRectProc fProc;
+  int fCount;
   SkString fName;
   using INHERITED = Benchmark;
 };
@@ -132,3 +154,18 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+static constexpr auto kHilbert = SkRTree::Packing::kHilbert;
+
+DEF_BENCH(return new RTreeBuildBench("XY", &make_XYordered_rects, NUM_BUILD_RECTS, kHilbert));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects, NUM_BUILD_RECTS, kHilbert));
+DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects, NUM_QUERY_RECTS, kHilbert));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects, NUM_QUERY_RECTS, kHilbert));
+
+// At scale, where search() during partial playback culling starts to show up.
+DEF_BENCH(return new RTreeBuildBench("XY", &make_XYordered_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects, NUM_LARGE_RECTS, kHilbert));
+DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects, NUM_LARGE_RECTS, kHilbert));
@@ -109,10 +109,57 @@ class SkGlyphCacheStressTest : public Benchmark {
   SkString fName;
 };
 
+// Every thread draws the same few strikes over and over, so the time goes into looking strikes
+// up in the shared cache rather than into rasterizing glyphs.
+class SkGlyphCacheContended : public Benchmark {
+ public:
+  explicit SkGlyphCacheContended(int threadCount) : fThreadCount(threadCount) {}
+
+ protected:
+  const char* onGetName() override {
+    fName.printf("SkGlyphCacheContended%dThreads", fThreadCount);
+    return fName.c_str();
+  }
+
+  bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+  void onDelayedSetup() override {
+    fTypeface = ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal());
+  }
+
+  void onDraw(int loops, SkCanvas*) override {
+    SkTaskGroup().batch(fThreadCount, [&](int) {
+      SkFont font;
+      font.setEdging(SkFont::Edging::kAntiAlias);
+      font.setTypeface(fTypeface);
+      SkPaint defaultPaint;
+      SkPackedGlyphID glyphs[] = {SkPackedGlyphID{font.unicharToGlyph('a')}};
+      for (int work = 0; work < loops; work++) {
+        for (SkScalar size : {12, 14, 16, 20}) {
+          font.setSize(size);
+          auto strikeSpec = SkStrikeSpec::MakeMask(
+              font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+              SkScalerContextFlags::kNone, SkMatrix::I());
+          SkBulkGlyphMetricsAndImages images{strikeSpec};
+          (void)images.glyphs(SkSpan<const SkPackedGlyphID>{glyphs, SK_ARRAY_COUNT(glyphs)});
+        }
+      }
+    });
+  }
+
+ private:
+  using INHERITED = Benchmark;
+  const int fThreadCount;
+  sk_sp<SkTypeface> fTypeface;
+  SkString fName;
+};
+
 DEF_BENCH(return new SkGlyphCacheBasic(256 * 1024);)
 DEF_BENCH(return new SkGlyphCacheBasic(32 * 1024 * 1024);)
 DEF_BENCH(return new SkGlyphCacheStressTest(256 * 1024);)
 DEF_BENCH(return new SkGlyphCacheStressTest(32 * 1024 * 1024);)
+DEF_BENCH(return new SkGlyphCacheContended(1);)
+DEF_BENCH(return new SkGlyphCacheContended(16);)
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
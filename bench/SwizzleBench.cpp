@@ -12,12 +12,24 @@ class SwizzleBench : public Benchmark {
  public:
   SwizzleBench(const char* name, SkOpts::Swizzle_8888_u32 fn) : fName(name), fFn_u32(fn) {}
   SwizzleBench(const char* name, SkOpts::Swizzle_8888_u8 fn) : fName(name), fFn_u8(fn) {}
+  SwizzleBench(const char* name, decltype(SkOpts::index_to_8888) fn)
+      : fName(name), fFn_index(fn) {}
+  SwizzleBench(const char* name, decltype(SkOpts::masks_to_8888) fn)
+      : fName(name), fFn_masks(fn) {}
 
   bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
   const char* onGetName() override { return fName; }
   void onDraw(int loops, SkCanvas*) override {
     static const int K = 1023;  // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
-    uint32_t dst[K], src[K];
+    uint32_t dst[K], src[2 * K] = {};  // Enough for 16-bit RGBA.
+    uint32_t table[256] = {};
+    // The 5-6-5 layout of a 16-bit BMP.
+    const SkOpts::SwizzleMasks masks = {
+        {0xF800, 0x07E0, 0x001F, 0},
+        {11, 5, 0, 0},
+        {255.0f / 31, 255.0f / 63, 255.0f / 31, 0},
+        {0.5f, 0.5f, 0.5f, 255.0f},
+    };
     while (loops-- > 0) {
       if (fFn_u32) {
         fFn_u32(dst, src, K);
@@ -25,6 +37,12 @@ class SwizzleBench : public Benchmark {
       if (fFn_u8) {
         fFn_u8(dst, (const uint8_t*)src, K);
       }
+      if (fFn_index) {
+        fFn_index(dst, (const uint8_t*)src, table, K);
+      }
+      if (fFn_masks) {
+        fFn_masks(dst, src, masks, K);
+      }
     }
   }
 
@@ -32,6 +50,8 @@ class SwizzleBench : public Benchmark {
   const char* fName;
   SkOpts::Swizzle_8888_u32 fFn_u32 = nullptr;
   SkOpts::Swizzle_8888_u8 fFn_u8 = nullptr;
+  decltype(SkOpts::index_to_8888) fFn_index = nullptr;
+  decltype(SkOpts::masks_to_8888) fFn_masks = nullptr;
 };
 
 DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_rgbA", SkOpts::RGBA_to_rgbA));
@@ -44,3 +64,7 @@ DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA
 DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_RGB1", SkOpts::RGB16_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_RGBA", SkOpts::RGBA16_to_RGBA));
+DEF_BENCH(return new SwizzleBench("SkOpts::index_to_8888", SkOpts::index_to_8888));
+DEF_BENCH(return new SwizzleBench("SkOpts::masks_to_8888", SkOpts::masks_to_8888));
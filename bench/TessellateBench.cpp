@@ -24,6 +24,9 @@ namespace skgpu::v1 {
 // This is the number of cubics in desk_chalkboard.skp. (There are no quadratics in the chalkboard.)
 constexpr static int kNumCubicsInChalkboard = 47182;
 
+// Curve count for the benches that measure CPU prepare time on very large paths.
+constexpr static int kNumCurvesInLargePath = 100000;
+
 static sk_sp<GrDirectContext> make_mock_context() {
   GrMockOptions mockOptions;
   mockOptions.fDrawInstancedSupport = true;
@@ -83,6 +86,30 @@ SK_MAYBE_UNUSED static SkPath make_line_path(int maxPow2) {
   return path;
 }
 
+// Makes a path of random curves, each within a 100x100 box somewhere in a 1000x1000 area, so that
+// most of them need a handful of segments and few need chopping.
+static SkPath make_large_curve_path(SkPathVerb verb) {
+  SkRandom rand;
+  SkPath path;
+  for (int i = 0; i < kNumCurvesInLargePath; ++i) {
+    if (i % 100 == 0) {
+      path.moveTo(rand.nextRangeF(0, 900), rand.nextRangeF(0, 900));
+    }
+    SkPoint last = SkPathPriv::PointData(path)[path.countPoints() - 1];
+    float l = std::min(last.fX, 900.f), t = std::min(last.fY, 900.f);
+    SkPoint p[3];
+    for (SkPoint& pt : p) {
+      pt = {l + rand.nextRangeF(0, 100), t + rand.nextRangeF(0, 100)};
+    }
+    if (verb == SkPathVerb::kQuad) {
+      path.quadTo(p[0], p[1]);
+    } else {
+      path.cubicTo(p[0], p[1], p[2]);
+    }
+  }
+  return path;
+}
+
 // This serves as a base class for benchmarking individual methods on PathTessellateOp.
 class PathTessellateBenchmark : public Benchmark {
  public:
@@ -150,6 +177,34 @@ DEF_PATH_TESS_BENCH(GrPathWedgeTessellator, make_cubic_path(8), SkMatrix::I()) {
       fPath.countVerbs());
 }
 
+// Runs the CPU side of 'tess' on a large path: Wang's formula and writing out the patches.
+static void prepare_large_path(
+    PathTessellator* tess, GrMockOpTarget* target, const SkMatrix& matrix, const SkPath& path) {
+  tess->prepare(
+      target, matrix, {gAlmostIdentity, path, SK_PMColor4fTRANSPARENT}, path.countVerbs());
+}
+
+DEF_PATH_TESS_BENCH(
+    GrPathCurveTessellator_100k_cubics, make_large_curve_path(SkPathVerb::kCubic), SkMatrix::I()) {
+  SkArenaAlloc arena(1024);
+  auto tess = PathCurveTessellator::Make(&arena, fTarget->caps().shaderCaps()->fInfinitySupport);
+  prepare_large_path(tess, fTarget.get(), fMatrix, fPath);
+}
+
+DEF_PATH_TESS_BENCH(
+    GrPathCurveTessellator_100k_quads, make_large_curve_path(SkPathVerb::kQuad), SkMatrix::I()) {
+  SkArenaAlloc arena(1024);
+  auto tess = PathCurveTessellator::Make(&arena, fTarget->caps().shaderCaps()->fInfinitySupport);
+  prepare_large_path(tess, fTarget.get(), fMatrix, fPath);
+}
+
+DEF_PATH_TESS_BENCH(
+    GrPathWedgeTessellator_100k_cubics, make_large_curve_path(SkPathVerb::kCubic), SkMatrix::I()) {
+  SkArenaAlloc arena(1024);
+  auto tess = PathWedgeTessellator::Make(&arena, fTarget->caps().shaderCaps()->fInfinitySupport);
+  prepare_large_path(tess, fTarget.get(), fMatrix, fPath);
+}
+
 static void benchmark_wangs_formula_cubic_log2(const SkMatrix& matrix, const SkPath& path) {
   int sum = 0;
   wangs_formula::VectorXform xform(matrix);
@@ -179,6 +234,50 @@ DEF_PATH_TESS_BENCH(
   benchmark_wangs_formula_cubic_log2(fMatrix, fPath);
 }
 
+// Same as benchmark_wangs_formula_cubic_log2, but evaluates N cubics at a time with the batch API.
+template <int N>
+static void benchmark_wangs_formula_cubic_log2_batch(const SkMatrix& matrix, const SkPath& path) {
+  skvx::Vec<N, int> sum = 0;
+  wangs_formula::VectorXform xform(matrix);
+  skvx::float4 p0p1[N], p2p3[N];
+  int count = 0;
+  for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+    if (verb == SkPathVerb::kCubic) {
+      p0p1[count] = skvx::float4::Load(pts);
+      p2p3[count] = skvx::float4::Load(pts + 2);
+      if (++count == N) {
+        skvx::Vec<N, float> x[4], y[4];
+        skvx::strided_load4(reinterpret_cast<const float*>(p0p1), x[0], y[0], x[1], y[1]);
+        skvx::strided_load4(reinterpret_cast<const float*>(p2p3), x[2], y[2], x[3], y[3]);
+        sum += wangs_formula::cubic_log2(4, x, y, xform);
+        count = 0;
+      }
+    }
+  }
+  // Don't let the compiler optimize away wangs_formula::cubic_log2.
+  if (skvx::max(sum) <= 0) {
+    SK_ABORT("sum should be > 0.");
+  }
+}
+
+DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_batch4, make_cubic_path(18), SkMatrix::I()) {
+  benchmark_wangs_formula_cubic_log2_batch<4>(fMatrix, fPath);
+}
+
+DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_batch8, make_cubic_path(18), SkMatrix::I()) {
+  benchmark_wangs_formula_cubic_log2_batch<8>(fMatrix, fPath);
+}
+
+DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_batch16, make_cubic_path(18), SkMatrix::I()) {
+  benchmark_wangs_formula_cubic_log2_batch<16>(fMatrix, fPath);
+}
+
+DEF_PATH_TESS_BENCH(
+    wangs_formula_cubic_log2_batch16_affine, make_cubic_path(18),
+    SkMatrix::MakeAll(.9f, 0.9f, 0, 1.1f, 1.1f, 0, 0, 0, 1)) {
+  benchmark_wangs_formula_cubic_log2_batch<16>(fMatrix, fPath);
+}
+
 static void benchmark_wangs_formula_conic(const SkMatrix& matrix, const SkPath& path) {
   int sum = 0;
   wangs_formula::VectorXform xform(matrix);
@@ -10,7 +10,9 @@
 #include "src/core/SkArenaAlloc.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrSweepTriangulator.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include <vector>
 
 struct TigerPath {
@@ -89,17 +91,87 @@ class TriangulatorBenchmark : public Benchmark, public GrEagerVertexAllocator {
 
 class PathToTrianglesBench : public TriangulatorBenchmark {
  public:
-  PathToTrianglesBench() : TriangulatorBenchmark("PathToTriangles") {}
+  PathToTrianglesBench(GrTriangulator::Engine engine)
+      : TriangulatorBenchmark(
+            engine == GrTriangulator::Engine::kSweep ? "PathToTrianglesSweep" : "PathToTriangles"),
+        fEngine(engine) {}
+
+ protected:
+  void onDelayedSetup() override {
+    TriangulatorBenchmark::onDelayedSetup();
+    if (fEngine == GrTriangulator::Engine::kSweep) {
+      this->validateSweep();
+    }
+  }
 
   void doLoop() override {
     for (const SkPath& path : fPaths) {
       bool isLinear;
-      GrTriangulator::PathToTriangles(path, kTigerTolerance, SkRect::MakeEmpty(), this, &isLinear);
+      GrTriangulator::PathToTriangles(
+          path, kTigerTolerance, SkRect::MakeEmpty(), this, &isLinear, fEngine);
     }
   }
+
+  void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) override {
+    if (fEngine == GrTriangulator::Engine::kSweep) {
+      keys->push_back(SkString("sweep_fallbacks"));
+      values->push_back(fSweepFallbacks);
+      keys->push_back(SkString("sweep_area_mismatches"));
+      values->push_back(fSweepAreaMismatches);
+    }
+  }
+
+ private:
+  // Collects the triangles of one path.
+  class VertexList : public GrEagerVertexAllocator {
+   public:
+    void* lock(size_t stride, int eagerCount) override {
+      SkASSERT(stride == sizeof(SkPoint));
+      fPoints.resize(eagerCount);
+      return fPoints.data();
+    }
+    void unlock(int actualCount) override { fPoints.resize(actualCount); }
+
+    double area() const {
+      double area = 0;
+      for (size_t i = 0; i + 2 < fPoints.size(); i += 3) {
+        SkVector a = fPoints[i + 1] - fPoints[i], b = fPoints[i + 2] - fPoints[i];
+        area += std::abs((double)a.fX * b.fY - (double)a.fY * b.fX) / 2;
+      }
+      return area;
+    }
+
+    std::vector<SkPoint> fPoints;
+  };
+
+  // Both engines should cover the same area of each path, up to rounding where they split edges.
+  // Counts the paths where they don't, and those the sweep engine left to the mesh engine.
+  void validateSweep() {
+    for (const SkPath& path : fPaths) {
+      VertexList mesh, sweep;
+      bool isLinear;
+      int vertexCount;
+      GrTriangulator::PathToTriangles(path, kTigerTolerance, SkRect::MakeEmpty(), &mesh, &isLinear);
+      if (!GrSweepTriangulator::PathToTriangles(
+              path, kTigerTolerance, SkRect::MakeEmpty(), &sweep, &isLinear, &vertexCount)) {
+        ++fSweepFallbacks;
+        continue;
+      }
+      double meshArea = mesh.area(), sweepArea = sweep.area();
+      if (std::abs(meshArea - sweepArea) > 1e-3 * std::max(meshArea, 1.0)) {
+        ++fSweepAreaMismatches;
+      }
+    }
+    SkASSERT(fSweepAreaMismatches == 0);
+  }
+
+  const GrTriangulator::Engine fEngine;
+  int fSweepFallbacks = 0;
+  int fSweepAreaMismatches = 0;
 };
 
-DEF_BENCH(return new PathToTrianglesBench(););
+DEF_BENCH(return new PathToTrianglesBench(GrTriangulator::Engine::kMesh););
+DEF_BENCH(return new PathToTrianglesBench(GrTriangulator::Engine::kSweep););
 
 class TriangulateInnerFanBench : public TriangulatorBenchmark {
  public:
@@ -117,6 +189,78 @@ class TriangulateInnerFanBench : public TriangulatorBenchmark {
 
 DEF_BENCH(return new TriangulateInnerFanBench(););
 
+// Gets each inner fan from a GrTriangulatorCache the way PathInnerTriangulateOp does, triangulating
+// and adding it on a miss. The cache lasts across loops, like frames, so only the first misses.
+// With 'warmStart', each loop starts a new cache from a blob instead, like an app's next run.
+class CachedInnerFanBench : public TriangulatorBenchmark {
+ public:
+  CachedInnerFanBench(bool warmStart)
+      : TriangulatorBenchmark(
+            warmStart ? "TriangulateInnerFanWarmStart" : "TriangulateInnerFanCached"),
+        fWarmStart(warmStart) {}
+
+ protected:
+  void onDelayedSetup() override {
+    TriangulatorBenchmark::onDelayedSetup();
+    fCache = std::make_unique<GrTriangulatorCache>(kCacheByteLimit);
+    if (fWarmStart) {
+      this->drawPaths();
+      fBlob = fCache->serialize();
+    }
+  }
+
+  void doLoop() override {
+    if (fWarmStart) {
+      fCache = std::make_unique<GrTriangulatorCache>(kCacheByteLimit);
+      fCache->deserialize(fBlob->data(), fBlob->size());
+    }
+    this->drawPaths();
+    fArena.reset();
+  }
+
+  void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) override {
+    keys->push_back(SkString("cache_hits"));
+    values->push_back(fCache->hits());
+    keys->push_back(SkString("cache_misses"));
+    values->push_back(fCache->misses());
+  }
+
+ private:
+  inline static constexpr size_t kCacheByteLimit = 64 << 20;
+
+  void drawPaths() {
+    for (const SkPath& path : fPaths) {
+      GrInnerFanTriangulator::BreadcrumbTriangleList breadcrumbList;
+      if (auto fan = fCache->findInnerFan(path)) {
+        fan->appendBreadcrumbs(&fArena, &breadcrumbList);
+        if (int vertexCount = fan->vertexCount()) {
+          memcpy(this->lock(sizeof(SkPoint), vertexCount), fan->fVertices.data(),
+                 vertexCount * sizeof(SkPoint));
+        }
+        continue;
+      }
+      bool isLinear;
+      GrInnerFanTriangulator triangulator(path, &fArena);
+      auto* polys = triangulator.pathToPolys(&breadcrumbList, &isLinear);
+      if (!polys) {
+        continue;
+      }
+      int splitBreadcrumbCount = breadcrumbList.count();
+      int vertexCount = triangulator.polysToTriangles(polys, this, &breadcrumbList);
+      fCache->addInnerFan(
+          path, isLinear, reinterpret_cast<const SkPoint*>(fVertexData.get()), vertexCount,
+          breadcrumbList, splitBreadcrumbCount);
+    }
+  }
+
+  const bool fWarmStart;
+  std::unique_ptr<GrTriangulatorCache> fCache;
+  sk_sp<SkData> fBlob;
+};
+
+DEF_BENCH(return new CachedInnerFanBench(/* warmStart */ false););
+DEF_BENCH(return new CachedInnerFanBench(/* warmStart */ true););
+
 #if 0
 #  include "src/gpu/tessellate/GrMiddleOutPolygonTriangulator.h"
 
@@ -156,6 +156,11 @@ static DEFINE_string(
     "Apply usual --match rules to bench type: micro, recording, "
     "piping, playback, skcodec, etc.");
 
+static DEFINE_string(
+    codecThreads, "",
+    "Space-separated thread counts.  For each, also time decoding each image on a thread pool "
+    "of that many threads, to see how SkCodec's parallel decoding scales.");
+
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(
     forceRasterPipelineHP, false,
@@ -1109,6 +1114,30 @@ class BenchmarkStream {
       fCurrentColorType = 0;
     }
 
+    // Run CodecBenches on thread pools
+    for (; fCurrentThreadedCodec < fImages.count(); fCurrentThreadedCodec++) {
+      fSourceType = "image";
+      fBenchType = "skcodec";
+      const SkString& path = fImages[fCurrentThreadedCodec];
+      if (FLAGS_codecThreads.isEmpty() || CommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+        continue;
+      }
+      sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
+      std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(encoded));
+      if (!codec) {
+        continue;
+      }
+      const SkAlphaType alphaType = codec->getInfo().isOpaque() ? kOpaque_SkAlphaType
+                                                                : kPremul_SkAlphaType;
+      while (fCurrentCodecThreads < FLAGS_codecThreads.count()) {
+        const int threads = atoi(FLAGS_codecThreads[fCurrentCodecThreads++]);
+        return new CodecBench(
+            SkOSPath::Basename(path.c_str()), encoded.get(), kN32_SkColorType, alphaType,
+            threads);
+      }
+      fCurrentCodecThreads = 0;
+    }
+
     // Run AndroidCodecBenches
     const int sampleSizes[] = {2, 4, 8};
     for (; fCurrentAndroidCodec < fImages.count(); fCurrentAndroidCodec++) {
@@ -1284,6 +1313,8 @@ class BenchmarkStream {
   int fCurrentSVG = 0;
   int fCurrentTextBlobTrace = 0;
   int fCurrentCodec = 0;
+  int fCurrentThreadedCodec = 0;
+  int fCurrentCodecThreads = 0;
   int fCurrentAndroidCodec = 0;
 #ifdef SK_ENABLE_ANDROID_UTILS
   int fCurrentBRDImage = 0;
@@ -1519,6 +1550,7 @@ int main(int argc, char** argv) {
           combinedDMSAAStats.merge(dmsaaStats);
         }
       }
+      bench->getStats(&keys, &values);
 
       bench->perCanvasPostDraw(canvas);
 
@@ -1552,7 +1584,7 @@ int main(int argc, char** argv) {
       log.endArray();  // samples
       benchStream.fillCurrentMetrics(log);
       if (!keys.empty()) {
-        // dump to json, only SKPBench currently returns valid keys / values
+        // dump to json, only SKPBench and BitmapRegionDecoderBench currently return keys / values
         SkASSERT(keys.count() == values.count());
         for (int j = 0; j < keys.count(); j++) {
           log.appendMetric(keys[j].c_str(), values[j]);
@@ -27,6 +27,7 @@
 class SkAndroidCodec;
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -283,18 +284,33 @@ class SK_API SkCodec : SkNoncopyable {
         : fZeroInitialized(kNo_ZeroInitialized),
           fSubset(nullptr),
           fFrameIndex(0),
-          fPriorFrame(kNoFrame) {}
+          fPriorFrame(kNoFrame),
+          fExecutor(nullptr) {}
 
     ZeroInitialized fZeroInitialized;
     /**
      *  If not NULL, represents a subset of the original image to decode.
      *  Must be within the bounds returned by getInfo().
      *  If the EncodedFormat is SkEncodedImageFormat::kWEBP (the only one which
-     *  currently supports subsets), the top and left values must be even.
+     *  supports subsets natively, see getValidSubset()), the top and left
+     *  values must be even.
      *
      *  In getPixels and incremental decode, we will attempt to decode the
      *  exact rectangular subset specified by fSubset.
      *
+     *  In getPixels, codecs without native subset support decode the subset
+     *  through their incremental or scanline decoder, skipping the rows above
+     *  and below it and cropping in x where the decoder can (e.g. whole iMCU
+     *  columns in JPEG).  The dimensions passed to getPixels must be the size
+     *  of the subset, or the subset scaled by a scale the codec supports
+     *  natively (see getScaledDimensions()): its size times the ratio of the
+     *  scaled dimensions to the full ones, rounded up, placed at its origin
+     *  times that ratio, rounded down.  Any other dimensions return
+     *  kInvalidScale; arbitrary downscaling of a subset is not supported here
+     *  (SkAndroidCodec can sample instead).  Codecs that can decode neither
+     *  subsets nor top-down scanlines, and subsets of frames other than the
+     *  first, return kUnimplemented.
+     *
      *  In a scanline decode, it does not make sense to specify a subset
      *  top or subset height, since the client already controls which rows
      *  to get and which rows to skip.  During scanline decodes, we will
@@ -326,6 +342,18 @@ class SK_API SkCodec : SkNoncopyable {
      *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
      */
     int fPriorFrame;
+
+    /**
+     *  If not NULL, getPixels() may split the decode into pieces that run in parallel on
+     *  this executor, where the format allows it:
+     *    - JPEGs with restart intervals decode independent bands of rows in parallel.
+     *    - PNGs swizzle and color transform bands of rows in parallel with decompressing
+     *      the rows that follow.
+     *    - WebPs let libwebp filter on its own worker thread.
+     *  Otherwise, and for incremental and scanline decodes, this is ignored.
+     *  Either way, the pixels are the same as decoding without an executor.
+     */
+    SkExecutor* fExecutor;
   };
 
   /**
@@ -918,6 +946,11 @@ class SK_API SkCodec : SkNoncopyable {
       const SkImageInfo&, void* pixels, size_t rowBytes, const Options&,
       SkAndroidCodec* androidCodec = nullptr);
 
+  // Decodes options.fSubset for codecs that can't subset in onGetPixels(), using the
+  // incremental or scanline decoder.  See Options::fSubset.
+  Result getSubsetPixels(
+      const SkImageInfo&, void* pixels, size_t rowBytes, const Options& options);
+
   // Methods for scanline decoding.
   virtual Result onStartScanlineDecode(const SkImageInfo& /*dstInfo*/, const Options& /*options*/) {
     return kUnimplemented;
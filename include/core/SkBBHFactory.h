@@ -57,7 +57,19 @@ class SK_API SkBBHFactory {
 
 class SK_API SkRTreeFactory : public SkBBHFactory {
  public:
+  enum class Packing {
+    kInsertionOrder,  // Pack rects in the order they're inserted (e.g. recording order).
+    kHilbert,         // Sort rects along the Hilbert curve first. Costs a sort when recording
+                      // ends, but queries touch fewer nodes when draw order doesn't follow
+                      // position on the canvas.
+  };
+
+  explicit SkRTreeFactory(Packing packing = Packing::kInsertionOrder) : fPacking(packing) {}
+
   sk_sp<SkBBoxHierarchy> operator()() const override;
+
+ private:
+  Packing fPacking;
 };
 
 #endif
@@ -2406,6 +2406,7 @@ class SK_API SkCanvas {
   friend class SkOverdrawCanvas;
   friend class SkRasterHandleAllocator;
   friend class SkRecords::Draw;
+  friend class SkRecorder;  // predrawNotify() for SkSurface::MakeRasterThreaded()
   template <typename Key>
   friend class SkTestCanvas;
 
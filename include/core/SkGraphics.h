@@ -153,6 +153,31 @@ class SK_API SkGraphics {
    *  Call early in main() to allow Skia to use a JIT to accelerate CPU-bound operations.
    */
   static void AllowJIT();
+
+  /**
+   *  Keep the code generated by the JIT in the file at path, loading code saved there by earlier
+   *  runs and adding to it as new code is generated. The file is only used by this build of Skia
+   *  on this CPU; anything else found there is discarded. Pass nullptr to stop using a file.
+   *
+   *  Returns false if the file could not be opened for writing.
+   */
+  static bool SetJITCachePath(const char* path);
+
+  /**
+   *  How many times JIT code was loaded from the cache file, or had to be generated, since the
+   *  process started.
+   */
+  static int GetJITCacheHitCount();
+  static int GetJITCacheMissCount();
+
+  /**
+   *  When enabled, raster drawing of a lazily decoded image that can decode to YUV planes (e.g. a
+   *  JPEG) caches those planes and converts them to RGB as it draws, instead of caching a full
+   *  RGBA decode.  For 4:2:0 images that halves the cached memory.  Off by default.
+   *
+   *  Returns the previous setting.
+   */
+  static bool SetRasterYUVPlanes(bool enabled);
 };
 
 class SkAutoGraphics {
@@ -18,6 +18,7 @@
 class SkCanvas;
 class SkData;
 struct SkDeserialProcs;
+class SkExecutor;
 class SkImage;
 class SkMatrix;
 struct SkSerialProcs;
@@ -80,6 +81,25 @@ class SK_API SkPicture : public SkRefCnt {
   static sk_sp<SkPicture> MakeFromData(
       const void* data, size_t size, const SkDeserialProcs* procs = nullptr);
 
+  /** Recreates SkPicture that was serialized into data, like MakeFromData(), but shares data
+      with the returned SkPicture instead of copying it. Drawing commands are played back
+      straight from data rather than re-recorded, and encoded images reference their bytes in
+      data. Pass data from SkData::MakeFromFileName() to memory-map a large picture file.
+
+      Pictures serialized by this version of Skia keep their sections 4-byte aligned within
+      data, so when data itself starts 4-byte aligned (as mapped files and SkData allocations
+      do) nothing is copied. Sections of older pictures, or of data that starts unaligned, are
+      copied once into aligned storage.
+      Drawing commands are validated as they are played back; playback stops at the first
+      invalid command.
+
+      @param data   container for serial data; kept alive by the returned SkPicture
+      @param procs  custom serial data decoders; may be nullptr
+      @return       SkPicture constructed from data
+  */
+  static sk_sp<SkPicture> MakeDeferredFromData(
+      sk_sp<SkData> data, const SkDeserialProcs* procs = nullptr);
+
   /** \class SkPicture::AbortCallback
       AbortCallback is an abstract class. An implementation of AbortCallback may
       passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -128,6 +148,20 @@ class SK_API SkPicture : public SkRefCnt {
   */
   virtual void playback(SkCanvas* canvas, AbortCallback* callback = nullptr) const = 0;
 
+  /** Replays the drawing commands on the specified canvas like playback(), but splits a raster
+      canvas into tiles and rasterizes them concurrently on executor. Each tile draws the commands
+      that touch it in their original order. Anti-aliased curves and transformed clips that cross
+      tile boundaries may rasterize slightly differently than they do with playback().
+
+      Falls back to playback() if executor is nullptr, if canvas is not a raster canvas with
+      a wide-open clip, or if the picture uses image filters or saveLayer() backdrops, which
+      read pixels across tile boundaries.
+
+      @param canvas    receiver of drawing commands
+      @param executor  runs the tiles; must outlive this call
+  */
+  void parallelPlayback(SkCanvas* canvas, SkExecutor* executor) const;
+
   /** Returns cull SkRect for this picture, passed in when SkPicture was created.
       Returned SkRect does not specify clipping SkRect for SkPicture; cull is hint
       of SkPicture bounds.
@@ -237,6 +271,7 @@ class SK_API SkPicture : public SkRefCnt {
   // Allowed subclasses.
   SkPicture();
   friend class SkBigPicture;
+  friend class SkDeferredPicture;
   friend class SkEmptyPicture;
   friend class SkPicturePriv;
   template <typename>
@@ -245,8 +280,10 @@ class SK_API SkPicture : public SkRefCnt {
   void serialize(
       SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces,
       bool textBlobsOnly = false) const;
+  // If backing is not null, stream reads from it, and the returned SkPicture may share it.
   static sk_sp<SkPicture> MakeFromStream(
-      SkStream*, const SkDeserialProcs*, class SkTypefacePlayback*);
+      SkStream*, const SkDeserialProcs*, class SkTypefacePlayback*,
+      const SkData* backing = nullptr);
   friend class SkPictureData;
 
   /** Return true if the SkStream/Buffer represents a serialized picture, and
@@ -111,6 +111,7 @@ class SK_API SkPixelRef : public SkRefCnt {
   void setTemporarilyImmutable();
   void restoreMutability();
   friend class SkSurface_Raster;  // For temporary immutable methods above.
+  friend class SkSurface_RasterThreaded;  // Ditto.
 
   void setImmutableWithID(uint32_t genID);
   friend void SkBitmapCache_setImmutableWithID(SkPixelRef*, uint32_t);
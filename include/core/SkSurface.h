@@ -28,6 +28,7 @@
 class SkCanvas;
 class SkCapabilities;
 class SkDeferredDisplayList;
+class SkExecutor;
 class SkPaint;
 class SkSurfaceCharacterization;
 class GrBackendRenderTarget;
@@ -156,6 +157,28 @@ class SK_API SkSurface : public SkRefCnt {
     return MakeRaster(imageInfo, 0, props);
   }
 
+  /** Allocates raster SkSurface whose drawing is spread across threads. SkCanvas returned by
+      SkSurface records draws instead of rasterizing them immediately. Recorded draws are
+      replayed when the pixels are needed (makeImageSnapshot(), readPixels(), peekPixels(),
+      writePixels(), draw()), with horizontal bands of the surface rasterized in parallel on
+      executor. Content drawn inside an unrestored saveLayer() is replayed once it is restored.
+      Anti-aliased curves crossing a band seam may differ slightly from MakeRaster() output.
+      Draws with image filters or backdrops are not split into bands, so they replay serially.
+
+      Pays off for large surfaces where rasterization dominates; small surfaces are better
+      served by MakeRaster(). executor must outlive SkSurface.
+
+      @param imageInfo     width, height, SkColorType, SkAlphaType, SkColorSpace,
+                           of raster surface; width and height must be greater than zero
+      @param executor      runs the band rasterization; if nullptr, returns MakeRaster()
+      @param surfaceProps  LCD striping orientation and setting for device independent fonts;
+                           may be nullptr
+      @return              SkSurface if all parameters are valid; otherwise, nullptr
+  */
+  static sk_sp<SkSurface> MakeRasterThreaded(
+      const SkImageInfo& imageInfo, SkExecutor* executor,
+      const SkSurfaceProps* surfaceProps = nullptr);
+
   /** Allocates raster SkSurface. SkCanvas returned by SkSurface draws directly into pixels.
       Allocates and zeroes pixel memory. Pixel memory size is height times width times
       four. Pixel memory is deleted when SkSurface is deleted.
@@ -19,6 +19,8 @@
 
 class SkExecutor;
 class SkPDFArray;
+class SkPDFCache;
+class SkPDFDocument;
 class SkPDFTagTree;
 
 namespace SkPDF {
@@ -59,6 +61,26 @@ struct StructureElementNode {
   SkString fLang;
 };
 
+/** Encoded images and subsetted font programs, keyed by a hash of their
+    contents, that any number of documents can share so resources they have
+    in common are encoded only once.  Thread-safe: documents on different
+    threads may use the same cache.  The least recently used entries are
+    purged to stay within byteLimit.
+*/
+class SK_API ResourceCache : SkNoncopyable {
+ public:
+  explicit ResourceCache(size_t byteLimit = 64 * 1024 * 1024);
+  ~ResourceCache();
+
+  size_t bytesUsed() const;
+  void purgeAll();
+
+ private:
+  friend class ::SkPDFDocument;
+
+  std::unique_ptr<SkPDFCache> fCache;
+};
+
 /** Optional metadata to be passed into the PDF factory function.
  */
 struct Metadata {
@@ -149,6 +171,28 @@ struct Metadata {
     kHarfbuzz_Subsetter,
     kSfntly_Subsetter,
   } fSubsetter = kHarfbuzz_Subsetter;
+
+  /** If true, write each page, image and content stream to the output as
+      soon as it is finished, so memory use doesn't grow with the number of
+      pages. Without fExecutor, compressed streams are written directly to
+      the document with their /Length in a separate object, rather than
+      buffered to measure them first. With fExecutor, at most a few jobs are
+      queued at a time.
+
+      Streams are always compressed in this mode, even when that doesn't
+      make them smaller, and the page tree may have an extra level.
+
+      Experimental.
+  */
+  bool fStreaming = false;
+
+  /** Cache of images and font subsets to share with other documents.  The
+      caller should retain ownership, and keep it alive until the document
+      is closed.  If this is nullptr, every resource is encoded anew.
+
+      Experimental.
+  */
+  ResourceCache* fResourceCache = nullptr;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
@@ -104,6 +104,21 @@ struct SK_API GrContextOptions {
    */
   SkExecutor* fExecutor = nullptr;
 
+  /**
+   * If true, and fExecutor is set, ops that build their vertex data on the CPU (e.g. triangulated
+   * paths) do that work on the executor's threads at flush time, rather than one after another on
+   * the flushing thread. The data is still written to buffers in draw order.
+   */
+  bool fPrepareOpsInParallel = false;
+
+  /**
+   * If nonzero, triangulations of non-volatile paths that the tessellating path renderer fills
+   * are kept across flushes, up to this many bytes of CPU memory, so drawing the same path again
+   * doesn't triangulate it again. See GrDirectContext::serializeTriangulatorCache() to keep them
+   * across runs.
+   */
+  size_t fTriangulatorCacheByteLimit = 0;
+
   /** Construct mipmaps manually, via repeated downsampling draw-calls. This is used when
       the driver's implementation (glGenerateMipmap) contains bugs. This requires mipmap
       level control (ie desktop or ES3). */
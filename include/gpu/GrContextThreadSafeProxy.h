@@ -23,6 +23,7 @@ class GrCaps;
 class GrContextThreadSafeProxyPriv;
 class GrThreadSafeCache;
 class GrThreadSafePipelineBuilder;
+class GrTriangulatorCache;
 class SkSurfaceCharacterization;
 class SkSurfaceProps;
 
@@ -151,6 +152,7 @@ class SK_API GrContextThreadSafeProxy final : public SkNVRefCnt<GrContextThreadS
   sk_sp<const GrCaps> fCaps;
   std::unique_ptr<sktext::gpu::TextBlobRedrawCoordinator> fTextBlobRedrawCoordinator;
   std::unique_ptr<GrThreadSafeCache> fThreadSafeCache;
+  std::unique_ptr<GrTriangulatorCache> fTriangulatorCache;
   sk_sp<GrThreadSafePipelineBuilder> fPipelineBuilder;
   std::atomic<bool> fAbandoned{false};
 };
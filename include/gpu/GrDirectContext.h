@@ -740,6 +740,14 @@ class SK_API GrDirectContext : public GrRecordingContext {
   // Using cached shader blobs on a different device or driver are undefined.
   bool precompileShader(const SkData& key, const SkData& data);
 
+  // Path triangulations kept by GrContextOptions::fTriangulatorCacheByteLimit can likewise be saved
+  // at exit and loaded at startup, so the paths drawn last time are never triangulated. Loading
+  // adds to what's already cached. Triangulations only depend on the version of Skia, not on the
+  // device, but data from another version is rejected. If the cache is disabled,
+  // serializeTriangulatorCache() returns nullptr and loadTriangulatorCache() returns false.
+  sk_sp<SkData> serializeTriangulatorCache() const;
+  bool loadTriangulatorCache(const SkData& data);
+
 #ifdef SK_ENABLE_DUMP_GPU
   /** Returns a string with detailed information about the context & GPU, in JSON format. */
   SkString dump() const;
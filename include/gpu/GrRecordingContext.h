@@ -28,6 +28,7 @@ class GrProxyProvider;
 class GrRecordingContextPriv;
 class GrSurfaceProxy;
 class GrThreadSafeCache;
+class GrTriangulatorCache;
 class SkArenaAlloc;
 class SkCapabilities;
 class SkJSONWriter;
@@ -193,6 +194,8 @@ class GrRecordingContext : public GrImageContext {
   GrThreadSafeCache* threadSafeCache();
   const GrThreadSafeCache* threadSafeCache() const;
 
+  GrTriangulatorCache* triangulatorCache();
+
   /**
    * Registers an object for flush-related callbacks. (See GrOnFlushCallbackObject.)
    *
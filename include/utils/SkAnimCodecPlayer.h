@@ -17,13 +17,34 @@
 #include <memory>
 #include <vector>
 
+class SkData;
 class SkImage;
 
+/**
+ *  Plays an animated image by seeking to a time and fetching the frame shown then.
+ *
+ *  Decoded frames live in a cache shared by every player in the process and bounded by
+ *  SetFrameCacheByteLimit(), so a player only holds on to its current frame. Players made
+ *  with Make() share frames with any other player of the same encoded data.
+ */
 class SkAnimCodecPlayer {
  public:
   SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
   ~SkAnimCodecPlayer();
 
+  /**
+   *  Returns a player for the encoded data, or nullptr if it can't be decoded.
+   */
+  static std::unique_ptr<SkAnimCodecPlayer> Make(sk_sp<SkData> data);
+
+  /**
+   *  Sets the byte budget of the decoded frame cache shared by all players, and returns the
+   *  previous budget. Frames are purged immediately if the cache is over the new budget.
+   */
+  static size_t SetFrameCacheByteLimit(size_t newLimit);
+  static size_t GetFrameCacheByteLimit();
+  static size_t GetFrameCacheBytesUsed();
+
   /**
    *  Returns the current frame of the animation. This defaults to the first frame for
    *  animated codecs (i.e. msec = 0). Calling this multiple times (without calling seek())
@@ -52,14 +73,20 @@ class SkAnimCodecPlayer {
   bool seek(uint32_t msec);
 
  private:
+  SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, uint64_t sourceID, sk_sp<SkData> encoded);
+
   std::unique_ptr<SkCodec> fCodec;
   SkImageInfo fImageInfo;
   std::vector<SkCodec::FrameInfo> fFrameInfos;
-  std::vector<sk_sp<SkImage>> fImages;
+  std::vector<bool> fKeyframes;
+  uint64_t fSourceID;
+  sk_sp<SkData> fEncoded;  // What fSourceID was made from, if it's shareable.
+  sk_sp<SkImage> fCurrImage;
   int fCurrIndex = 0;
   uint32_t fTotalDuration;
 
   sk_sp<SkImage> getFrameAt(int index);
+  sk_sp<SkImage> decodeFrame(int index, sk_sp<SkImage> requiredImage);
 };
 
 #endif
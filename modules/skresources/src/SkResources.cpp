@@ -98,9 +98,8 @@ ImageAsset::FrameData ImageAsset::getFrameData(float t) {
 }
 
 sk_sp<MultiFrameImageAsset> MultiFrameImageAsset::Make(sk_sp<SkData> data, bool predecode) {
-  if (auto codec = SkCodec::MakeFromData(std::move(data))) {
-    return sk_sp<MultiFrameImageAsset>(
-        new MultiFrameImageAsset(std::make_unique<SkAnimCodecPlayer>(std::move(codec)), predecode));
+  if (auto player = SkAnimCodecPlayer::Make(std::move(data))) {
+    return sk_sp<MultiFrameImageAsset>(new MultiFrameImageAsset(std::move(player), predecode));
   }
 
   return nullptr;
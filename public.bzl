@@ -648,6 +648,7 @@ BASE_SRCS_ALL = [
     "src/core/SkScan_Antihair.cpp",
     "src/core/SkScan_Hairline.cpp",
     "src/core/SkScan_Path.cpp",
+    "src/core/SkScan_SparseStrips.cpp",
     "src/core/SkScopeExit.h",
     "src/core/SkSemaphore.cpp",
     "src/core/SkShaderCodeDictionary.cpp",
@@ -715,6 +716,8 @@ BASE_SRCS_ALL = [
     "src/core/SkVM.h",
     "src/core/SkVMBlitter.cpp",
     "src/core/SkVMBlitter.h",
+    "src/core/SkVMJITCache.cpp",
+    "src/core/SkVMJITCache.h",
     "src/core/SkVM_fwd.h",
     "src/core/SkValidationUtils.h",
     "src/core/SkVertState.cpp",
@@ -1086,8 +1089,12 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/geometry/GrShape.h",
     "src/gpu/ganesh/geometry/GrStyledShape.cpp",
     "src/gpu/ganesh/geometry/GrStyledShape.h",
+    "src/gpu/ganesh/geometry/GrSweepTriangulator.cpp",
+    "src/gpu/ganesh/geometry/GrSweepTriangulator.h",
     "src/gpu/ganesh/geometry/GrTriangulator.cpp",
     "src/gpu/ganesh/geometry/GrTriangulator.h",
+    "src/gpu/ganesh/geometry/GrTriangulatorCache.cpp",
+    "src/gpu/ganesh/geometry/GrTriangulatorCache.h",
     "src/gpu/ganesh/glsl/GrGLSL.cpp",
     "src/gpu/ganesh/glsl/GrGLSL.h",
     "src/gpu/ganesh/glsl/GrGLSLBlend.cpp",
@@ -1172,6 +1179,8 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h",
     "src/gpu/ganesh/ops/LatticeOp.cpp",
     "src/gpu/ganesh/ops/LatticeOp.h",
+    "src/gpu/ganesh/ops/OpChainIndex.cpp",
+    "src/gpu/ganesh/ops/OpChainIndex.h",
     "src/gpu/ganesh/ops/OpsTask.cpp",
     "src/gpu/ganesh/ops/OpsTask.h",
     "src/gpu/ganesh/ops/PathInnerTriangulateOp.cpp",
@@ -1264,6 +1273,7 @@ BASE_SRCS_ALL = [
     "src/image/SkSurface_Gpu.cpp",
     "src/image/SkSurface_Gpu.h",
     "src/image/SkSurface_Raster.cpp",
+    "src/image/SkSurface_RasterThreaded.cpp",
     "src/images/SkImageEncoder.cpp",
     "src/images/SkImageEncoderFns.h",
     "src/images/SkImageEncoderPriv.h",
@@ -1342,6 +1352,8 @@ BASE_SRCS_ALL = [
     "src/pdf/SkKeyedImage.h",
     "src/pdf/SkPDFBitmap.cpp",
     "src/pdf/SkPDFBitmap.h",
+    "src/pdf/SkPDFCache.cpp",
+    "src/pdf/SkPDFCache.h",
     "src/pdf/SkPDFDevice.cpp",
     "src/pdf/SkPDFDevice.h",
     "src/pdf/SkPDFDocument.cpp",
@@ -1659,6 +1671,8 @@ BASE_SRCS_ALL = [
     "src/text/gpu/TextBlobRedrawCoordinator.cpp",
     "src/text/gpu/TextBlobRedrawCoordinator.h",
     "src/utils/SkAnimCodecPlayer.cpp",
+    "src/utils/SkAnimFrameCache.cpp",
+    "src/utils/SkAnimFrameCache.h",
     "src/utils/SkBase64.cpp",
     "src/utils/SkBitSet.h",
     "src/utils/SkBlitterTrace.h",
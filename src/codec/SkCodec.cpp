@@ -416,9 +416,9 @@ SkCodec::Result SkCodec::getPixels(
     if (options->fSubset) {
       SkIRect subset(*options->fSubset);
       if (!this->onGetValidSubset(&subset) || subset != *options->fSubset) {
-        // FIXME: How to differentiate between not supporting subset at all
-        // and not supporting this particular subset?
-        return kUnimplemented;
+        // The codec can't subset in onGetPixels(). Decode just the rows we need, scaled
+        // if the codec can scale natively, instead of decoding the whole image.
+        return this->getSubsetPixels(info, pixels, rowBytes, *options);
       }
     }
   }
@@ -461,6 +461,104 @@ SkCodec::Result SkCodec::getPixels(
   return result;
 }
 
+SkCodec::Result SkCodec::getSubsetPixels(
+    const SkImageInfo& info, void* pixels, size_t rowBytes, const Options& options) {
+  const SkIRect& subset = *options.fSubset;
+  if (subset.isEmpty() || !this->bounds().contains(subset)) {
+    return kInvalidParameters;
+  }
+  if (options.fFrameIndex != 0) {
+    // Other frames may need prior frames blended in, which needs the whole frame.
+    return kUnimplemented;
+  }
+
+  // Find the native scale that takes the subset to exactly info's dimensions. The subset is
+  // specified in full-resolution coordinates; its scaled size is its size times the ratio of
+  // the scaled image to the full one, rounded up like scaled image dimensions are.
+  auto scale_subset = [&](SkISize scaledSize) {
+    const SkISize size = this->dimensions();
+    auto scale_down = [](int x, int scaled, int full) {
+      return SkToInt(int64_t(x) * scaled / full);
+    };
+    auto scale_up = [](int x, int scaled, int full) {
+      return SkToInt((int64_t(x) * scaled + full - 1) / full);
+    };
+    return SkIRect::MakeXYWH(
+        scale_down(subset.x(), scaledSize.width(), size.width()),
+        scale_down(subset.y(), scaledSize.height(), size.height()),
+        scale_up(subset.width(), scaledSize.width(), size.width()),
+        scale_up(subset.height(), scaledSize.height(), size.height()));
+  };
+  SkISize scaledSize = this->dimensions();
+  SkIRect scaledSubset = subset;
+  if (info.dimensions() != subset.size()) {
+    // info's width is the scaled subset width after rounding, so the scale asked for lies
+    // within half a pixel of info.width() / subset.width(). Try the codec's nearest scale
+    // for that and for either end, and take whichever matches exactly.
+    bool found = false;
+    for (float bias : {0.0f, -0.5f, 0.5f}) {
+      scaledSize = this->getScaledDimensions((info.width() + bias) / subset.width());
+      scaledSubset = scale_subset(scaledSize);
+      if (scaledSubset.size() == info.dimensions()) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return kInvalidScale;
+    }
+  }
+  if (!SkIRect::MakeSize(scaledSize).contains(scaledSubset)) {
+    return kInvalidScale;
+  }
+  const SkImageInfo scaledInfo = info.makeDimensions(scaledSize);
+
+  // Incremental decoders use the subset's top and bottom to skip the rows outside of it,
+  // and stop as soon as they have decoded its last row.
+  Options subsetOptions = options;
+  subsetOptions.fSubset = &scaledSubset;
+  const Result startResult =
+      this->startIncrementalDecode(scaledInfo, pixels, rowBytes, &subsetOptions);
+  if (kSuccess == startResult) {
+    int rowsDecoded = 0;
+    const Result result = this->incrementalDecode(&rowsDecoded);
+    if (kIncompleteInput == result || kErrorInInput == result) {
+      this->fillIncompleteImage(
+          scaledInfo, pixels, rowBytes, options.fZeroInitialized, info.height(), rowsDecoded);
+    }
+    return result;
+  } else if (kUnimplemented != startResult) {
+    return startResult;
+  }
+
+  // Scanline decoders only crop in x. Skip (without color converting) the rows above the
+  // subset, and never read the rows below it.
+  if (this->getScanlineOrder() != kTopDown_SkScanlineOrder) {
+    return kUnimplemented;
+  }
+  const SkIRect scanlineSubset =
+      SkIRect::MakeXYWH(scaledSubset.x(), 0, scaledSubset.width(), scaledSize.height());
+  subsetOptions.fSubset = &scanlineSubset;
+  const Result result = this->startScanlineDecode(scaledInfo, &subsetOptions);
+  if (kSuccess != result) {
+    return result;
+  }
+
+  int rowsDecoded = 0;
+  if (this->skipScanlines(scaledSubset.y())) {
+    rowsDecoded = this->getScanlines(pixels, info.height(), rowBytes);
+  }
+  if (rowsDecoded != info.height()) {
+    // getScanlines() has already filled the rows it couldn't decode.
+    if (0 == rowsDecoded) {
+      this->fillIncompleteImage(
+          info, pixels, rowBytes, options.fZeroInitialized, info.height(), 0);
+    }
+    return kIncompleteInput;
+  }
+  return kSuccess;
+}
+
 std::tuple<sk_sp<SkImage>, SkCodec::Result> SkCodec::getImage(
     const SkImageInfo& info, const Options* options) {
   SkBitmap bm;
@@ -8,6 +8,7 @@
 #include "src/codec/SkJpegCodec.h"
 
 #include "include/codec/SkCodec.h"
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkColorData.h"
@@ -16,9 +17,12 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkParseEncodedOrigin.h"
+#include "src/core/SkTaskGroup.h"
 
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
+#include <numeric>
+#include <vector>
 #include "src/codec/SkJpegUtility.h"
 
 #ifdef SK_CODEC_DECODES_JPEG
@@ -509,6 +513,215 @@ static inline bool needs_swizzler_to_convert_from_cmyk(
   return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+namespace {
+
+// Where the pieces of a baseline JPEG with restart markers are, and how its MCUs are laid out.
+struct JpegRestartLayout {
+  size_t fScanStart = 0;        // The entropy-coded data starts here, after the SOS segment.
+  size_t fScanEnd = 0;          // The EOI marker.
+  size_t fHeightOffset = 0;     // The image height in the SOF segment.
+  std::vector<size_t> fSegments;  // Where each restart interval's data starts.
+  int fHeight = 0;
+  int fMCUHeight = 0;
+  int fMCUsPerRow = 0;
+  int fMCURows = 0;
+  int fRestartInterval = 0;  // In MCUs.
+};
+
+uint16_t read_be16(const uint8_t* p) { return (p[0] << 8) | p[1]; }
+
+// Returns false unless data is a single-scan sequential Huffman JPEG with restart markers.
+bool parse_restart_layout(const uint8_t* data, size_t size, JpegRestartLayout* layout) {
+  int width = 0, components = 0, maxH = 1, maxV = 1;
+  size_t pos = 2;  // Skip SOI.
+  for (;;) {
+    if (pos + 4 > size || data[pos] != 0xFF) {
+      return false;
+    }
+    const uint8_t marker = data[pos + 1];
+    if (marker == 0xFF) {
+      pos++;  // Fill byte.
+      continue;
+    }
+    const size_t length = read_be16(data + pos + 2);
+    if (length < 2 || pos + 2 + length > size) {
+      return false;
+    }
+    const uint8_t* segment = data + pos + 4;
+    if (marker == 0xC0 || marker == 0xC1) {
+      if (length < 8) {
+        return false;
+      }
+      layout->fHeightOffset = pos + 5;
+      layout->fHeight = read_be16(segment + 1);
+      width = read_be16(segment + 3);
+      components = segment[5];
+      if (length < 8 + 3 * (size_t)components) {
+        return false;
+      }
+      for (int i = 0; i < components; i++) {
+        maxH = std::max(maxH, segment[7 + 3 * i] >> 4);
+        maxV = std::max(maxV, segment[7 + 3 * i] & 0xF);
+      }
+    } else if ((marker & 0xF0) == 0xC0 && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+      return false;  // Progressive, lossless, or arithmetic coded.
+    } else if (marker == 0xDD) {
+      if (length < 4) {
+        return false;
+      }
+      layout->fRestartInterval = read_be16(segment);
+    } else if (marker == 0xDA) {
+      // All the components must be in this one scan.
+      if (!components || segment[0] != components) {
+        return false;
+      }
+      pos += 2 + length;
+      break;
+    } else if (marker == 0xD9) {
+      return false;
+    }
+    pos += 2 + length;
+  }
+  if (layout->fHeight <= 0 || width <= 0 || layout->fRestartInterval <= 0) {
+    return false;
+  }
+
+  // A scan of one component has MCUs of one 8x8 block, however it's sampled.
+  const int mcuWidth = components == 1 ? 8 : 8 * maxH;
+  layout->fMCUHeight = components == 1 ? 8 : 8 * maxV;
+  layout->fMCUsPerRow = (width + mcuWidth - 1) / mcuWidth;
+  layout->fMCURows = (layout->fHeight + layout->fMCUHeight - 1) / layout->fMCUHeight;
+
+  // Find the restart markers, checking that they're numbered in order.
+  layout->fScanStart = pos;
+  layout->fSegments.push_back(pos);
+  for (; pos + 1 < size; pos++) {
+    if (data[pos] != 0xFF) {
+      continue;
+    }
+    const uint8_t marker = data[pos + 1];
+    if (marker == 0x00 || marker == 0xFF) {
+      pos += marker == 0x00 ? 1 : 0;  // Stuffed zero, or fill before a marker.
+    } else if (marker >= 0xD0 && marker <= 0xD7) {
+      if (marker - 0xD0 != (layout->fSegments.size() - 1) % 8) {
+        return false;
+      }
+      layout->fSegments.push_back(pos + 2);
+      pos++;
+    } else if (marker == 0xD9) {
+      layout->fScanEnd = pos;
+      break;
+    } else {
+      return false;  // DNL, or a marker we don't expect in the middle of a scan.
+    }
+  }
+
+  const int64_t mcus = (int64_t)layout->fMCUsPerRow * layout->fMCURows;
+  return layout->fScanEnd &&
+         (int64_t)layout->fSegments.size() ==
+                 (mcus + layout->fRestartInterval - 1) / layout->fRestartInterval;
+}
+
+// Makes a JPEG of just the MCU rows [top, bottom) of the JPEG in data, which must both start a
+// restart interval.  It's the original headers with a new height, and the restart intervals for
+// those rows, renumbered from zero.
+sk_sp<SkData> make_band_jpeg(
+    const uint8_t* data, const JpegRestartLayout& layout, int top, int bottom) {
+  const int64_t firstMCU = (int64_t)top * layout.fMCUsPerRow;
+  const int64_t endMCU = (int64_t)bottom * layout.fMCUsPerRow;
+  const size_t first = SkToSizeT(firstMCU / layout.fRestartInterval);
+  const size_t end = SkToSizeT((endMCU + layout.fRestartInterval - 1) / layout.fRestartInterval);
+
+  const size_t scanStart = layout.fSegments[first];
+  const size_t scanEnd = end < layout.fSegments.size() ? layout.fSegments[end] - 2
+                                                       : layout.fScanEnd;
+  const size_t headerSize = layout.fScanStart;
+  sk_sp<SkData> band = SkData::MakeUninitialized(headerSize + scanEnd - scanStart + 2);
+  uint8_t* bytes = static_cast<uint8_t*>(band->writable_data());
+
+  memcpy(bytes, data, headerSize);
+  const int height = std::min(layout.fHeight, bottom * layout.fMCUHeight) -
+                     top * layout.fMCUHeight;
+  bytes[layout.fHeightOffset + 0] = SkToU8(height >> 8);
+  bytes[layout.fHeightOffset + 1] = SkToU8(height);
+
+  memcpy(bytes + headerSize, data + scanStart, scanEnd - scanStart);
+  for (size_t i = first + 1; i < end; i++) {
+    bytes[headerSize + layout.fSegments[i] - 1 - scanStart] = SkToU8(0xD0 + (i - first - 1) % 8);
+  }
+  bytes[band->size() - 2] = 0xFF;
+  bytes[band->size() - 1] = 0xD9;
+  return band;
+}
+
+}  // namespace
+
+bool SkJpegCodec::decodeBandsInParallel(
+    const SkImageInfo& dstInfo, void* dst, size_t rowBytes, const Options& options) {
+  // Bands smaller than this aren't worth the trouble of setting up another decoder.
+  static constexpr int kMinBandHeight = 64;
+  static constexpr int kMaxBands = 32;
+
+  SkStream* stream = this->stream();
+  if (dstInfo.dimensions() != this->dimensions() || !stream->getMemoryBase() ||
+      dstInfo.height() < 2 * kMinBandHeight) {
+    return false;
+  }
+  const uint8_t* data = static_cast<const uint8_t*>(stream->getMemoryBase());
+  JpegRestartLayout layout;
+  if (!parse_restart_layout(data, stream->getLength(), &layout) ||
+      layout.fHeight != dstInfo.height()) {
+    return false;
+  }
+
+  // Bands can only start on MCU rows that start a restart interval.
+  const int step =
+      layout.fRestartInterval / std::gcd(layout.fMCUsPerRow, layout.fRestartInterval);
+  const int steps = (layout.fMCURows + step - 1) / step;
+  const int bands = std::min({kMaxBands, steps, dstInfo.height() / kMinBandHeight});
+  if (bands < 2) {
+    return false;
+  }
+
+  // Each band will find any embedded profile itself, but we may have been given a default.
+  const skcms_ICCProfile* profile = this->getEncodedInfo().profile();
+  Options bandOptions = options;
+  bandOptions.fExecutor = nullptr;
+
+  std::vector<bool> ok(bands, false);
+  SkTaskGroup tg(*options.fExecutor);
+  tg.batch(bands, [&](int i) {
+    const int top = std::min(layout.fMCURows, i * steps / bands * step);
+    const int bottom = std::min(layout.fMCURows, (i + 1) * steps / bands * step);
+    // Chroma upsampling looks at the rows above and below, so each band decodes an extra
+    // restart interval's worth of rows on either side, and we keep only the rows in between.
+    // That makes the bands match a serial decode exactly.
+    const int decodeTop = std::max(0, top - step);
+    const int decodeBottom = std::min(layout.fMCURows, bottom + step);
+
+    Result result;
+    std::unique_ptr<SkCodec> codec = SkJpegCodec::MakeFromStream(
+        std::make_unique<SkMemoryStream>(
+            make_band_jpeg(data, layout, decodeTop, decodeBottom)),
+        &result, profile ? SkEncodedInfo::ICCProfile::Make(*profile) : nullptr);
+    const SkImageInfo bandInfo =
+        dstInfo.makeWH(dstInfo.width(), codec ? codec->dimensions().height() : 0);
+    if (!codec || codec->startScanlineDecode(bandInfo, &bandOptions) != kSuccess) {
+      return;
+    }
+
+    const int skip = (top - decodeTop) * layout.fMCUHeight;
+    const int y = top * layout.fMCUHeight;
+    const int rows = std::min(dstInfo.height(), bottom * layout.fMCUHeight) - y;
+    SkAutoTMalloc<uint8_t> skipped(skip * rowBytes);
+    ok[i] = codec->getScanlines(skipped.get(), skip, rowBytes) == skip &&
+            codec->getScanlines(SkTAddOffset<void>(dst, y * rowBytes), rows, rowBytes) == rows;
+  });
+  tg.wait();
+
+  return std::all_of(ok.begin(), ok.end(), [](bool bandOk) { return bandOk; });
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -520,6 +733,10 @@ SkCodec::Result SkJpegCodec::onGetPixels(
     return kUnimplemented;
   }
 
+  if (options.fExecutor && this->decodeBandsInParallel(dstInfo, dst, dstRowBytes, options)) {
+    return kSuccess;
+  }
+
   // Get a pointer to the decompress info since we will use it quite frequently
   jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -655,15 +872,22 @@ SkCodec::Result SkJpegCodec::onStartScanlineDecode(
   bool needsCMYKToRGB = needs_swizzler_to_convert_from_cmyk(
       fDecoderMgr->dinfo()->out_color_space, this->getEncodedInfo().profile(), this->colorXform());
   if (options.fSubset) {
-    uint32_t startX = options.fSubset->x();
-    uint32_t width = options.fSubset->width();
+    // Fancy upsampling treats the edges of the cropped region as the edges of the image, so
+    // decode one extra iMCU column on each side, when there is one, to keep the pixels at the
+    // edges of the subset the same as in a full decode.  The swizzler crops them back off.
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    const int margin = dinfo->max_h_samp_factor * dinfo->min_DCT_scaled_size;
+    const int left = std::max(0, options.fSubset->x() - margin);
+    const int right = std::min((int)dinfo->output_width, options.fSubset->right() + margin);
+    uint32_t startX = left;
+    uint32_t width = right - left;
 
     // libjpeg-turbo may need to align startX to a multiple of the IDCT
     // block size.  If this is the case, it will decrease the value of
     // startX to the appropriate alignment and also increase the value
     // of width so that the right edge of the requested subset remains
     // the same.
-    jpeg_crop_scanline(fDecoderMgr->dinfo(), &startX, &width);
+    jpeg_crop_scanline(dinfo, &startX, &width);
 
     SkASSERT(startX <= (uint32_t)options.fSubset->x());
     SkASSERT(width >= (uint32_t)options.fSubset->width());
@@ -107,6 +107,15 @@ class SkJpegCodec : public SkCodec {
   bool SK_WARN_UNUSED_RESULT allocateStorage(const SkImageInfo& dstInfo);
   int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+  /*
+   * Decodes independent bands of rows in parallel on options.fExecutor, splitting the image
+   * at restart markers.  Returns false if the image can't be split up or a band fails to
+   * decode, in which case some of dst may have been written and the caller should decode
+   * serially.
+   */
+  bool decodeBandsInParallel(
+      const SkImageInfo& dstInfo, void* dst, size_t rowBytes, const Options& options);
+
   /*
    * Scanline decoding.
    */
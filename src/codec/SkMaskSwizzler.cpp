@@ -9,105 +9,8 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkMaskSwizzler.h"
 
-static void swizzle_mask16_to_rgba_opaque(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint16_t* srcPtr = ((uint16_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint16_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    dstPtr[i] = SkPackARGB_as_RGBA(0xFF, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask16_to_bgra_opaque(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint16_t* srcPtr = ((uint16_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint16_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    dstPtr[i] = SkPackARGB_as_BGRA(0xFF, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask16_to_rgba_unpremul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint16_t* srcPtr = ((uint16_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint16_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = SkPackARGB_as_RGBA(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask16_to_bgra_unpremul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint16_t* srcPtr = ((uint16_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint16_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = SkPackARGB_as_BGRA(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask16_to_rgba_premul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint16_t* srcPtr = ((uint16_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint16_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = premultiply_argb_as_rgba(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask16_to_bgra_premul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint16_t* srcPtr = ((uint16_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint16_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = premultiply_argb_as_bgra(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
+#include <algorithm>
+#include <string.h>
 
 // TODO (msarett): We have promoted a two byte per pixel image to 8888, only to
 // convert it back to 565. Instead, we should swizzle to 565 directly.
@@ -127,106 +30,6 @@ static void swizzle_mask16_to_565(
   }
 }
 
-static void swizzle_mask24_to_rgba_opaque(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  srcRow += 3 * startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    dstPtr[i] = SkPackARGB_as_RGBA(0xFF, red, green, blue);
-    srcRow += 3 * sampleX;
-  }
-}
-
-static void swizzle_mask24_to_bgra_opaque(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  srcRow += 3 * startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    dstPtr[i] = SkPackARGB_as_BGRA(0xFF, red, green, blue);
-    srcRow += 3 * sampleX;
-  }
-}
-
-static void swizzle_mask24_to_rgba_unpremul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  srcRow += 3 * startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = SkPackARGB_as_RGBA(alpha, red, green, blue);
-    srcRow += 3 * sampleX;
-  }
-}
-
-static void swizzle_mask24_to_bgra_unpremul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  srcRow += 3 * startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = SkPackARGB_as_BGRA(alpha, red, green, blue);
-    srcRow += 3 * sampleX;
-  }
-}
-
-static void swizzle_mask24_to_rgba_premul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  srcRow += 3 * startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = premultiply_argb_as_rgba(alpha, red, green, blue);
-    srcRow += 3 * sampleX;
-  }
-}
-
-static void swizzle_mask24_to_bgra_premul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  srcRow += 3 * startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = premultiply_argb_as_bgra(alpha, red, green, blue);
-    srcRow += 3 * sampleX;
-  }
-}
-
 static void swizzle_mask24_to_565(
     void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
     uint32_t sampleX) {
@@ -243,106 +46,6 @@ static void swizzle_mask24_to_565(
   }
 }
 
-static void swizzle_mask32_to_rgba_opaque(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint32_t* srcPtr = ((uint32_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    dstPtr[i] = SkPackARGB_as_RGBA(0xFF, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask32_to_bgra_opaque(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint32_t* srcPtr = ((uint32_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    dstPtr[i] = SkPackARGB_as_BGRA(0xFF, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask32_to_rgba_unpremul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint32_t* srcPtr = ((uint32_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = SkPackARGB_as_RGBA(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask32_to_bgra_unpremul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint32_t* srcPtr = ((uint32_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = SkPackARGB_as_BGRA(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask32_to_rgba_premul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint32_t* srcPtr = ((uint32_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = premultiply_argb_as_rgba(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
-static void swizzle_mask32_to_bgra_premul(
-    void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
-    uint32_t sampleX) {
-  // Use the masks to decode to the destination
-  uint32_t* srcPtr = ((uint32_t*)srcRow) + startX;
-  SkPMColor* dstPtr = (SkPMColor*)dstRow;
-  for (int i = 0; i < width; i++) {
-    uint32_t p = srcPtr[0];
-    uint8_t red = masks->getRed(p);
-    uint8_t green = masks->getGreen(p);
-    uint8_t blue = masks->getBlue(p);
-    uint8_t alpha = masks->getAlpha(p);
-    dstPtr[i] = premultiply_argb_as_bgra(alpha, red, green, blue);
-    srcPtr += sampleX;
-  }
-}
-
 static void swizzle_mask32_to_565(
     void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
     uint32_t sampleX) {
@@ -367,95 +70,49 @@ static void swizzle_mask32_to_565(
 SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(
     const SkImageInfo& dstInfo, bool srcIsOpaque, SkMasks* masks, uint32_t bitsPerPixel,
     const SkCodec::Options& options) {
-  // Choose the appropriate row procedure
+  // Choose the appropriate row procedure.  8888 destinations don't need one; see swizzle().
   RowProc proc = nullptr;
-  switch (bitsPerPixel) {
-    case 16:
-      switch (dstInfo.colorType()) {
-        case kRGBA_8888_SkColorType:
-          if (srcIsOpaque) {
-            proc = &swizzle_mask16_to_rgba_opaque;
-          } else {
-            switch (dstInfo.alphaType()) {
-              case kUnpremul_SkAlphaType: proc = &swizzle_mask16_to_rgba_unpremul; break;
-              case kPremul_SkAlphaType: proc = &swizzle_mask16_to_rgba_premul; break;
-              default: break;
-            }
-          }
-          break;
-        case kBGRA_8888_SkColorType:
-          if (srcIsOpaque) {
-            proc = &swizzle_mask16_to_bgra_opaque;
-          } else {
-            switch (dstInfo.alphaType()) {
-              case kUnpremul_SkAlphaType: proc = &swizzle_mask16_to_bgra_unpremul; break;
-              case kPremul_SkAlphaType: proc = &swizzle_mask16_to_bgra_premul; break;
-              default: break;
-            }
-          }
-          break;
-        case kRGB_565_SkColorType: proc = &swizzle_mask16_to_565; break;
-        default: break;
-      }
-      break;
-    case 24:
-      switch (dstInfo.colorType()) {
-        case kRGBA_8888_SkColorType:
-          if (srcIsOpaque) {
-            proc = &swizzle_mask24_to_rgba_opaque;
-          } else {
-            switch (dstInfo.alphaType()) {
-              case kUnpremul_SkAlphaType: proc = &swizzle_mask24_to_rgba_unpremul; break;
-              case kPremul_SkAlphaType: proc = &swizzle_mask24_to_rgba_premul; break;
-              default: break;
-            }
-          }
-          break;
-        case kBGRA_8888_SkColorType:
-          if (srcIsOpaque) {
-            proc = &swizzle_mask24_to_bgra_opaque;
-          } else {
-            switch (dstInfo.alphaType()) {
-              case kUnpremul_SkAlphaType: proc = &swizzle_mask24_to_bgra_unpremul; break;
-              case kPremul_SkAlphaType: proc = &swizzle_mask24_to_bgra_premul; break;
-              default: break;
-            }
-          }
-          break;
-        case kRGB_565_SkColorType: proc = &swizzle_mask24_to_565; break;
-        default: break;
-      }
-      break;
-    case 32:
-      switch (dstInfo.colorType()) {
-        case kRGBA_8888_SkColorType:
-          if (srcIsOpaque) {
-            proc = &swizzle_mask32_to_rgba_opaque;
-          } else {
-            switch (dstInfo.alphaType()) {
-              case kUnpremul_SkAlphaType: proc = &swizzle_mask32_to_rgba_unpremul; break;
-              case kPremul_SkAlphaType: proc = &swizzle_mask32_to_rgba_premul; break;
-              default: break;
-            }
-          }
-          break;
-        case kBGRA_8888_SkColorType:
-          if (srcIsOpaque) {
-            proc = &swizzle_mask32_to_bgra_opaque;
-          } else {
-            switch (dstInfo.alphaType()) {
-              case kUnpremul_SkAlphaType: proc = &swizzle_mask32_to_bgra_unpremul; break;
-              case kPremul_SkAlphaType: proc = &swizzle_mask32_to_bgra_premul; break;
-              default: break;
-            }
-          }
-          break;
-        case kRGB_565_SkColorType: proc = &swizzle_mask32_to_565; break;
-        default: break;
+  switch (dstInfo.colorType()) {
+    case kRGBA_8888_SkColorType:
+    case kBGRA_8888_SkColorType: break;
+    case kRGB_565_SkColorType:
+      switch (bitsPerPixel) {
+        case 16: proc = &swizzle_mask16_to_565; break;
+        case 24: proc = &swizzle_mask24_to_565; break;
+        case 32: proc = &swizzle_mask32_to_565; break;
+        default: SkASSERT(false); return nullptr;
       }
       break;
     default: SkASSERT(false); return nullptr;
   }
+  if (16 != bitsPerPixel && 24 != bitsPerPixel && 32 != bitsPerPixel) {
+    SkASSERT(false);
+    return nullptr;
+  }
+
+  // Each 8888 channel is round((src & mask) >> shift) * 255 / ((1 << size) - 1)), which matches
+  // the lookup table SkMasks uses a pixel at a time.  Opaque sources just write 0xFF for alpha.
+  SkOpts::SwizzleMasks vectorMasks;
+  const bool isBGRA = kBGRA_8888_SkColorType == dstInfo.colorType();
+  const SkMasks::MaskInfo channels[4] = {
+      isBGRA ? masks->blue() : masks->red(),
+      masks->green(),
+      isBGRA ? masks->red() : masks->blue(),
+      masks->alpha(),
+  };
+  for (int i = 0; i < 4; i++) {
+    const SkMasks::MaskInfo& info = channels[i];
+    vectorMasks.mask[i] = info.mask;
+    vectorMasks.shift[i] = info.shift;
+    vectorMasks.scale[i] = info.size ? 255.0f / ((1 << info.size) - 1) : 0.0f;
+    vectorMasks.bias[i] = 0.5f;
+  }
+  if (srcIsOpaque) {
+    vectorMasks.mask[3] = 0;
+    vectorMasks.scale[3] = 0.0f;
+    vectorMasks.bias[3] = 255.0f;
+  }
+  const bool premul = !srcIsOpaque && kPremul_SkAlphaType == dstInfo.alphaType();
 
   int srcOffset = 0;
   int srcWidth = dstInfo.width();
@@ -464,7 +121,8 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(
     srcWidth = options.fSubset->width();
   }
 
-  return new SkMaskSwizzler(masks, proc, srcOffset, srcWidth);
+  return new SkMaskSwizzler(
+      masks, proc, vectorMasks, premul, bitsPerPixel / 8, srcOffset, srcWidth);
 }
 
 /*
@@ -472,9 +130,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(
  * Constructor for mask swizzler
  *
  */
-SkMaskSwizzler::SkMaskSwizzler(SkMasks* masks, RowProc proc, int srcOffset, int subsetWidth)
+SkMaskSwizzler::SkMaskSwizzler(
+    SkMasks* masks, RowProc proc, const SkOpts::SwizzleMasks& vectorMasks, bool premul,
+    int srcBPP, int srcOffset, int subsetWidth)
     : fMasks(masks),
       fRowProc(proc),
+      fVectorMasks(vectorMasks),
+      fPremul(premul),
+      fSrcBPP(srcBPP),
       fSubsetWidth(subsetWidth),
       fDstWidth(subsetWidth),
       fSampleX(1),
@@ -494,6 +157,22 @@ int SkMaskSwizzler::onSetSampleX(int sampleX) {
   return fDstWidth;
 }
 
+template <int kBPP>
+static void gather_pixels(uint32_t dst[], const uint8_t* src, int width, int deltaSrc) {
+  for (int i = 0; i < width; i++) {
+    if (2 == kBPP) {
+      uint16_t p;
+      memcpy(&p, src, 2);
+      dst[i] = p;
+    } else if (3 == kBPP) {
+      dst[i] = src[0] | (src[1] << 8) | src[2] << 16;
+    } else {
+      memcpy(&dst[i], src, 4);
+    }
+    src += deltaSrc;
+  }
+}
+
 /*
  *
  * Swizzle the specified row
@@ -501,5 +180,33 @@ int SkMaskSwizzler::onSetSampleX(int sampleX) {
  */
 void SkMaskSwizzler::swizzle(void* dst, const uint8_t* SK_RESTRICT src) {
   SkASSERT(nullptr != dst && nullptr != src);
-  fRowProc(dst, src, fDstWidth, fMasks, fX0, fSampleX);
+  if (fRowProc) {
+    fRowProc(dst, src, fDstWidth, fMasks, fX0, fSampleX);
+    return;
+  }
+
+  // 8888 destinations widen the (sampled) source pixels to 32 bits a chunk at a time, then
+  // unpack every channel at once with SkOpts::masks_to_8888().
+  uint32_t* dst32 = (uint32_t*)dst;
+  const uint8_t* srcPtr = src + fX0 * fSrcBPP;
+  const int deltaSrc = fSampleX * fSrcBPP;
+  if (4 == fSrcBPP && 1 == fSampleX) {
+    SkOpts::masks_to_8888(dst32, (const uint32_t*)srcPtr, fVectorMasks, fDstWidth);
+  } else {
+    constexpr int kChunk = 256;
+    uint32_t pixels[kChunk];
+    for (int x = 0; x < fDstWidth; x += kChunk) {
+      const int n = std::min(kChunk, fDstWidth - x);
+      switch (fSrcBPP) {
+        case 2: gather_pixels<2>(pixels, srcPtr, n, deltaSrc); break;
+        case 3: gather_pixels<3>(pixels, srcPtr, n, deltaSrc); break;
+        default: gather_pixels<4>(pixels, srcPtr, n, deltaSrc); break;
+      }
+      srcPtr += n * deltaSrc;
+      SkOpts::masks_to_8888(dst32 + x, pixels, fVectorMasks, n);
+    }
+  }
+  if (fPremul) {
+    SkOpts::RGBA_to_rgbA(dst32, dst32, fDstWidth);
+  }
 }
@@ -11,6 +11,7 @@
 #include "src/codec/SkMasks.h"
 #include "src/codec/SkSampler.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkOpts.h"
 
 /*
  *
@@ -49,12 +50,19 @@ class SkMaskSwizzler : public SkSampler {
       void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks, uint32_t startX,
       uint32_t sampleX);
 
-  SkMaskSwizzler(SkMasks* masks, RowProc proc, int subsetWidth, int srcOffset);
+  SkMaskSwizzler(
+      SkMasks* masks, RowProc proc, const SkOpts::SwizzleMasks& vectorMasks, bool premul,
+      int srcBPP, int srcOffset, int subsetWidth);
 
   int onSetSampleX(int) override;
 
   SkMasks* fMasks;  // unowned
-  const RowProc fRowProc;
+  const RowProc fRowProc;  // Only used for 565 destinations.
+
+  // 8888 destinations use SkOpts::masks_to_8888() instead.
+  const SkOpts::SwizzleMasks fVectorMasks;
+  const bool fPremul;
+  const int fSrcBPP;  // Bytes per source pixel.
 
   // FIXME: Can this class share more with SkSwizzler? These variables are all the same.
   const int fSubsetWidth;  // Width of the subset of source before any sampling.
@@ -44,6 +44,12 @@ class SkMasks {
   // The alpha mask may be used in other decoding modes
   uint32_t getAlphaMask() const { return fAlpha.mask; }
 
+  // The processed masks, for swizzling many pixels at once.
+  const MaskInfo& red() const { return fRed; }
+  const MaskInfo& green() const { return fGreen; }
+  const MaskInfo& blue() const { return fBlue; }
+  const MaskInfo& alpha() const { return fAlpha; }
+
  private:
   const MaskInfo fRed;
   const MaskInfo fGreen;
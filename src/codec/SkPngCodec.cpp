@@ -20,6 +20,7 @@
 #include "src/codec/SkPngPriv.h"
 #include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <png.h>
 #include <algorithm>
@@ -425,6 +426,7 @@ std::unique_ptr<SkEncodedInfo::ICCProfile> read_color_profile(
 }
 
 void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
+  fColorXformSrcRowBytes = 0;
   switch (fXformMode) {
     case kSwizzleOnly_XformMode: break;
     case kColorOnly_XformMode:
@@ -440,6 +442,7 @@ void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
       const size_t colorXformBytes = dstInfo.width() * bytesPerPixel;
       fStorage.reset(colorXformBytes);
       fColorXformSrcRow = fStorage.get();
+      fColorXformSrcRowBytes = colorXformBytes;
       break;
     }
   }
@@ -460,13 +463,13 @@ static skcms_PixelFormat png_select_xform_format(const SkEncodedInfo& info) {
   return skcms_PixelFormat_RGBA_8888;
 }
 
-void SkPngCodec::applyXformRow(void* dst, const void* src) {
+void SkPngCodec::applyXformRow(void* dst, const void* src, void* xformScratch) const {
   switch (fXformMode) {
     case kSwizzleOnly_XformMode: fSwizzler->swizzle(dst, (const uint8_t*)src); break;
     case kColorOnly_XformMode: this->applyColorXform(dst, src, fXformWidth); break;
     case kSwizzleColor_XformMode:
-      fSwizzler->swizzle(fColorXformSrcRow, (const uint8_t*)src);
-      this->applyColorXform(dst, fColorXformSrcRow, fXformWidth);
+      fSwizzler->swizzle(xformScratch, (const uint8_t*)src);
+      this->applyColorXform(dst, xformScratch, fXformWidth);
       break;
   }
 }
@@ -500,11 +503,32 @@ class SkPngNormalDecoder : public SkPngCodec {
     GetDecoder(png_ptr)->rowCallback(row, rowNum);
   }
 
+  static void AllRowsInBandsCallback(
+      png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int /*pass*/) {
+    GetDecoder(png_ptr)->allRowsInBandsCallback(row, rowNum);
+  }
+
  private:
   int fRowsWrittenToOutput;
   void* fDst;
   size_t fRowBytes;
 
+  // When decoding with an executor, we collect libpng's rows into bands, and swizzle and color
+  // transform each band on the executor while libpng decompresses the rows that follow.
+  static constexpr size_t kBandBytes = 256 * 1024;
+  static constexpr int kBandsInFlight = 8;
+
+  struct Band {
+    SkAutoTMalloc<uint8_t> fRows;
+    SkAutoTMalloc<uint8_t> fXformScratch;
+  };
+  Band fBands[kBandsInFlight];
+  SkTaskGroup* fBandTasks = nullptr;
+  size_t fPngRowBytes = 0;
+  int fBandRows = 0;
+  int fBandIndex = 0;
+  int fRowsInBand = 0;
+
   // Variables for partial decode
   int fFirstRow;  // FIXME: Move to baseclass?
   int fLastRow;
@@ -518,7 +542,9 @@ class SkPngNormalDecoder : public SkPngCodec {
 
   Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) override {
     const int height = this->dimensions().height();
-    png_set_progressive_read_fn(this->png_ptr(), this, nullptr, AllRowsCallback, nullptr);
+    png_set_progressive_read_fn(
+        this->png_ptr(), this, nullptr, fExecutor ? AllRowsInBandsCallback : AllRowsCallback,
+        nullptr);
     fDst = dst;
     fRowBytes = rowBytes;
 
@@ -526,7 +552,17 @@ class SkPngNormalDecoder : public SkPngCodec {
     fFirstRow = 0;
     fLastRow = height - 1;
 
-    const bool success = this->processData();
+    bool success;
+    if (fExecutor) {
+      SkTaskGroup bandTasks(*fExecutor);
+      this->startBands(&bandTasks);
+      success = this->processData();
+      this->dispatchBand();
+      bandTasks.wait();
+      fBandTasks = nullptr;
+    } else {
+      success = this->processData();
+    }
     if (success && fRowsWrittenToOutput == height) {
       return kSuccess;
     }
@@ -545,6 +581,47 @@ class SkPngNormalDecoder : public SkPngCodec {
     fDst = SkTAddOffset<void>(fDst, fRowBytes);
   }
 
+  void startBands(SkTaskGroup* bandTasks) {
+    fBandTasks = bandTasks;
+    fPngRowBytes = png_get_rowbytes(this->png_ptr(), this->info_ptr());
+    fBandRows = SkToInt(std::max<size_t>(1, kBandBytes / fPngRowBytes));
+    fBandIndex = 0;
+    fRowsInBand = 0;
+    for (Band& band : fBands) {
+      band.fRows.reset(fBandRows * fPngRowBytes);
+      band.fXformScratch.reset(this->xformScratchBytes());
+    }
+  }
+
+  void allRowsInBandsCallback(png_bytep row, int rowNum) {
+    SkASSERT(rowNum == fRowsWrittenToOutput);
+    fRowsWrittenToOutput++;
+    memcpy(fBands[fBandIndex].fRows.get() + fRowsInBand * fPngRowBytes, row, fPngRowBytes);
+    if (++fRowsInBand == fBandRows) {
+      this->dispatchBand();
+    }
+  }
+
+  void dispatchBand() {
+    if (fRowsInBand == 0) {
+      return;
+    }
+    fBandTasks->add([this, band = &fBands[fBandIndex], dst = fDst, rows = fRowsInBand] {
+      for (int y = 0; y < rows; y++) {
+        this->applyXformRow(
+            SkTAddOffset<void>(dst, y * fRowBytes), band->fRows.get() + y * fPngRowBytes,
+            band->fXformScratch.get());
+      }
+    });
+    fDst = SkTAddOffset<void>(fDst, fRowsInBand * fRowBytes);
+    fRowsInBand = 0;
+    if (++fBandIndex == kBandsInFlight) {
+      // Wait for every band to finish before reusing any of their rows.
+      fBandTasks->wait();
+      fBandIndex = 0;
+    }
+  }
+
   void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
     png_set_progressive_read_fn(this->png_ptr(), this, nullptr, RowCallback, nullptr);
     fFirstRow = firstRow;
@@ -672,12 +749,28 @@ class SkPngInterlacedDecoder : public SkPngCodec {
     fLinesDecoded = 0;
 
     const bool success = this->processData();
-    png_bytep srcRow = fInterlaceBuffer.get();
-    // FIXME: When resuming, this may rewrite rows that did not change.
-    for (int rowNum = 0; rowNum < fLinesDecoded; rowNum++) {
-      this->applyXformRow(dst, srcRow);
-      dst = SkTAddOffset<void>(dst, rowBytes);
-      srcRow = SkTAddOffset<png_byte>(srcRow, fPng_rowbytes);
+    if (fExecutor) {
+      // Every row is already decompressed, so we can swizzle and transform bands in parallel.
+      constexpr int kBandRows = 64;
+      SkTaskGroup tg(*fExecutor);
+      tg.batch((fLinesDecoded + kBandRows - 1) / kBandRows, [&](int band) {
+        SkAutoTMalloc<uint8_t> scratch(this->xformScratchBytes());
+        const int end = std::min(fLinesDecoded, (band + 1) * kBandRows);
+        for (int rowNum = band * kBandRows; rowNum < end; rowNum++) {
+          this->applyXformRow(
+              SkTAddOffset<void>(dst, rowNum * rowBytes),
+              fInterlaceBuffer.get() + rowNum * fPng_rowbytes, scratch.get());
+        }
+      });
+      tg.wait();
+    } else {
+      png_bytep srcRow = fInterlaceBuffer.get();
+      // FIXME: When resuming, this may rewrite rows that did not change.
+      for (int rowNum = 0; rowNum < fLinesDecoded; rowNum++) {
+        this->applyXformRow(dst, srcRow);
+        dst = SkTAddOffset<void>(dst, rowBytes);
+        srcRow = SkTAddOffset<png_byte>(srcRow, fPng_rowbytes);
+      }
     }
     if (success && fInterlacedComplete) {
       return kSuccess;
@@ -1136,7 +1229,10 @@ SkCodec::Result SkPngCodec::onGetPixels(
 
   this->allocateStorage(dstInfo);
   this->initializeXformParams();
-  return this->decodeAllRows(dst, rowBytes, rowsDecoded);
+  fExecutor = options.fExecutor;
+  result = this->decodeAllRows(dst, rowBytes, rowsDecoded);
+  fExecutor = nullptr;
+  return result;
 }
 
 SkCodec::Result SkPngCodec::onStartIncrementalDecode(
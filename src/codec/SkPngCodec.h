@@ -55,7 +55,12 @@ class SkPngCodec : public SkCodec {
   bool onRewind() override;
 
   SkSampler* getSampler(bool createIfNecessary) override;
-  void applyXformRow(void* dst, const void* src);
+  void applyXformRow(void* dst, const void* src) {
+    this->applyXformRow(dst, src, fColorXformSrcRow);
+  }
+  // Thread-safe, as long as each thread passes its own xformScratch of xformScratchBytes().
+  void applyXformRow(void* dst, const void* src, void* xformScratch) const;
+  size_t xformScratchBytes() const { return fColorXformSrcRowBytes; }
 
   voidp png_ptr() { return fPng_ptr; }
   voidp info_ptr() { return fInfo_ptr; }
@@ -86,8 +91,12 @@ class SkPngCodec : public SkCodec {
   std::unique_ptr<SkSwizzler> fSwizzler;
   SkAutoTMalloc<uint8_t> fStorage;
   void* fColorXformSrcRow;
+  size_t fColorXformSrcRowBytes = 0;
   const int fBitDepth;
 
+  // Set by onGetPixels() from its Options, and null for incremental decodes.
+  SkExecutor* fExecutor = nullptr;
+
  private:
   enum XformMode {
     // Requires only a swizzle pass.
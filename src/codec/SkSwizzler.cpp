@@ -240,6 +240,16 @@ static void swizzle_index_to_n32(
   }
 }
 
+static void fast_swizzle_index_to_n32(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::index_to_8888((uint32_t*)dst, src + offset, ctable, width);
+}
+
 static void swizzle_index_to_n32_skipZ(
     void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int dstWidth, int bpp, int deltaSrc,
     int offset, const SkPMColor ctable[]) {
@@ -527,6 +537,27 @@ static void swizzle_rgb16_to_bgra(
   }
 }
 
+static void fast_swizzle_rgb16_to_rgba(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::RGB16_to_RGB1((uint32_t*)dst, src + offset, width);
+}
+
+static void fast_swizzle_rgb16_to_bgra(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::RGB16_to_RGB1((uint32_t*)dst, src + offset, width);
+  SkOpts::RGBA_to_BGRA((uint32_t*)dst, (const uint32_t*)dst, width);
+}
+
 static void swizzle_rgb16_to_565(
     void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
     const SkPMColor ctable[]) {
@@ -600,6 +631,49 @@ static void swizzle_rgba16_to_bgra_premul(
   }
 }
 
+static void fast_swizzle_rgba16_to_rgba_unpremul(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::RGBA16_to_RGBA((uint32_t*)dst, src + offset, width);
+}
+
+static void fast_swizzle_rgba16_to_rgba_premul(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::RGBA16_to_RGBA((uint32_t*)dst, src + offset, width);
+  SkOpts::RGBA_to_rgbA((uint32_t*)dst, (const uint32_t*)dst, width);
+}
+
+static void fast_swizzle_rgba16_to_bgra_unpremul(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::RGBA16_to_RGBA((uint32_t*)dst, src + offset, width);
+  SkOpts::RGBA_to_BGRA((uint32_t*)dst, (const uint32_t*)dst, width);
+}
+
+static void fast_swizzle_rgba16_to_bgra_premul(
+    void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+    const SkPMColor ctable[]) {
+  // This function must not be called if we are sampling.  If we are not
+  // sampling, deltaSrc should equal bpp.
+  SkASSERT(deltaSrc == bpp);
+
+  SkOpts::RGBA16_to_RGBA((uint32_t*)dst, src + offset, width);
+  SkOpts::RGBA_to_bgrA((uint32_t*)dst, (const uint32_t*)dst, width);
+}
+
 // kCMYK
 //
 // CMYK is stored as four bytes per pixel.
@@ -870,6 +944,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(
                 proc = &swizzle_index_to_n32_skipZ;
               } else {
                 proc = &swizzle_index_to_n32;
+                fastProc = &fast_swizzle_index_to_n32;
               }
               break;
             case kRGB_565_SkColorType: proc = &swizzle_index_to_565; break;
@@ -888,6 +963,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(
         case kRGBA_8888_SkColorType:
           if (16 == encodedInfo.bitsPerComponent()) {
             proc = &swizzle_rgb16_to_rgba;
+            fastProc = &fast_swizzle_rgb16_to_rgba;
             break;
           }
 
@@ -898,6 +974,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(
         case kBGRA_8888_SkColorType:
           if (16 == encodedInfo.bitsPerComponent()) {
             proc = &swizzle_rgb16_to_bgra;
+            fastProc = &fast_swizzle_rgb16_to_bgra;
             break;
           }
 
@@ -920,7 +997,13 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(
       switch (dstInfo.colorType()) {
         case kRGBA_8888_SkColorType:
           if (16 == encodedInfo.bitsPerComponent()) {
-            proc = premultiply ? &swizzle_rgba16_to_rgba_premul : &swizzle_rgba16_to_rgba_unpremul;
+            if (premultiply) {
+              proc = &swizzle_rgba16_to_rgba_premul;
+              fastProc = &fast_swizzle_rgba16_to_rgba_premul;
+            } else {
+              proc = &swizzle_rgba16_to_rgba_unpremul;
+              fastProc = &fast_swizzle_rgba16_to_rgba_unpremul;
+            }
             break;
           }
 
@@ -945,7 +1028,13 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(
           break;
         case kBGRA_8888_SkColorType:
           if (16 == encodedInfo.bitsPerComponent()) {
-            proc = premultiply ? &swizzle_rgba16_to_bgra_premul : &swizzle_rgba16_to_bgra_unpremul;
+            if (premultiply) {
+              proc = &swizzle_rgba16_to_bgra_premul;
+              fastProc = &fast_swizzle_rgba16_to_bgra_premul;
+            } else {
+              proc = &swizzle_rgba16_to_bgra_unpremul;
+              fastProc = &fast_swizzle_rgba16_to_bgra_unpremul;
+            }
             break;
           }
 
@@ -1134,11 +1223,12 @@ int SkSwizzler::onSetSampleX(int sampleX) {
     }
   }
 
-  // The optimized swizzler functions do not support sampling.  Sampled swizzles
-  // are already fast because they skip pixels.  We haven't seen a situation
-  // where speeding up sampling has a significant impact on total decode time.
-  if (1 == fSampleX && fFastProc) {
+  // The optimized swizzler functions do not support sampling themselves.  Instead,
+  // swizzle() packs the sampled pixels into fSampledRow and runs fFastProc over that.
+  // Every fFastProc has a whole number of bytes per pixel, so fSrcBPP is in bytes here.
+  if (fFastProc) {
     fActualProc = fFastProc;
+    fSampledRow.reset(fSampleX > 1 ? fSwizzleWidth * fSrcBPP : 0);
   } else {
     fActualProc = fSlowProc;
   }
@@ -1146,8 +1236,35 @@ int SkSwizzler::onSetSampleX(int sampleX) {
   return fAllocatedWidth;
 }
 
+template <int kBPP>
+static void gather_samples(uint8_t* dst, const uint8_t* src, int width, int deltaSrc) {
+  for (int x = 0; x < width; x++) {
+    memcpy(dst, src, kBPP);
+    dst += kBPP;
+    src += deltaSrc;
+  }
+}
+
 void SkSwizzler::swizzle(void* dst, const uint8_t* SK_RESTRICT src) {
   SkASSERT(nullptr != dst && nullptr != src);
+  if (fSampledRow) {
+    uint8_t* row = fSampledRow.get();
+    const uint8_t* first = src + fSrcOffsetUnits;
+    const int deltaSrc = fSampleX * fSrcBPP;
+    switch (fSrcBPP) {
+      case 1: gather_samples<1>(row, first, fSwizzleWidth, deltaSrc); break;
+      case 2: gather_samples<2>(row, first, fSwizzleWidth, deltaSrc); break;
+      case 3: gather_samples<3>(row, first, fSwizzleWidth, deltaSrc); break;
+      case 4: gather_samples<4>(row, first, fSwizzleWidth, deltaSrc); break;
+      case 6: gather_samples<6>(row, first, fSwizzleWidth, deltaSrc); break;
+      case 8: gather_samples<8>(row, first, fSwizzleWidth, deltaSrc); break;
+      default: SkASSERT(false); return;
+    }
+    fActualProc(
+        SkTAddOffset<void>(dst, fDstOffsetBytes), row, fSwizzleWidth, fSrcBPP, fSrcBPP, 0,
+        fColorTable);
+    return;
+  }
   fActualProc(
       SkTAddOffset<void>(dst, fDstOffsetBytes), src, fSwizzleWidth, fSrcBPP, fSampleX * fSrcBPP,
       fSrcOffsetUnits, fColorTable);
@@ -11,6 +11,7 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkImageInfo.h"
+#include "include/private/SkTemplates.h"
 #include "src/codec/SkSampler.h"
 
 class SkSwizzler : public SkSampler {
@@ -119,6 +120,8 @@ class SkSwizzler : public SkSampler {
   // The actual RowProc we are using.  This depends on if fFastProc is non-NULL and
   // whether or not we are sampling.
   RowProc fActualProc;
+  // When sampling with fFastProc, the sampled source pixels are packed here first.
+  SkAutoTMalloc<uint8_t> fSampledRow;
 
   const SkPMColor* fColorTable;  // Unowned pointer
 
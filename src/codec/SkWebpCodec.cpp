@@ -418,6 +418,9 @@ SkCodec::Result SkWebpCodec::onGetPixels(
     config.options.scaled_height = scaledHeight;
   }
 
+  // libwebp can't use our executor, but it can run its filtering on a worker thread of its own.
+  config.options.use_threads = options.fExecutor ? 1 : 0;
+
   const bool blendWithPrevFrame =
       !independent && frame.blend_method == WEBP_MUX_BLEND && frame.has_alpha;
 
@@ -8,7 +8,9 @@
 #include "include/core/SkBBHFactory.h"
 #include "src/core/SkRTree.h"
 
-sk_sp<SkBBoxHierarchy> SkRTreeFactory::operator()() const { return sk_make_sp<SkRTree>(); }
+sk_sp<SkBBoxHierarchy> SkRTreeFactory::operator()() const {
+  return sk_make_sp<SkRTree>(fPacking);
+}
 
 void SkBBoxHierarchy::insert(const SkRect rects[], const Metadata[], int N) {
   // Ignore Metadata.
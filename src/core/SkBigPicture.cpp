@@ -32,6 +32,13 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
       useBBH ? fBBH.get() : nullptr, callback);
 }
 
+void SkBigPicture::parallelPlayback(SkCanvas* canvas, SkExecutor* executor) const {
+  SkASSERT(canvas);
+  SkRecordDrawParallel(
+      *fRecord, canvas, this->drawablePicts(), this->drawableCount(), fBBH.get(), fCullRect,
+      executor);
+}
+
 void SkBigPicture::partialPlayback(
     SkCanvas* canvas, int start, int stop, const SkM44& initialCTM) const {
   SkASSERT(canvas);
@@ -16,6 +16,7 @@
 #include "include/private/SkTemplates.h"
 
 class SkBBoxHierarchy;
+class SkExecutor;
 class SkMatrix;
 class SkRecord;
 
@@ -51,16 +52,20 @@ class SkBigPicture final : public SkPicture {
   size_t approximateBytesUsed() const override;
   const SkBigPicture* asSkBigPicture() const override { return this; }
 
+  // Used by SkPicture::parallelPlayback()
+  void parallelPlayback(SkCanvas*, SkExecutor*) const;
+
   // Used by GrLayerHoister
   void partialPlayback(SkCanvas*, int start, int stop, const SkM44& initialCTM) const;
   // Used by GrRecordReplaceDraw
   const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
   const SkRecord* record() const { return fRecord.get(); }
-
- private:
+  // Used by SkRecordReadsNeighborhood
   int drawableCount() const;
   SkPicture const* const* drawablePicts() const;
 
+ private:
+
   const SkRect fCullRect;
   const size_t fApproxBytesUsedBySubPictures;
   sk_sp<const SkRecord> fRecord;
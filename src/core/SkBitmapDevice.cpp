@@ -398,6 +398,22 @@ void SkBitmapDevice::drawImageRect(
   SkASSERT(dst.isFinite());
   SkASSERT(dst.isSorted());
 
+  // Images that can be drawn from YUV planes never get decoded to RGBA.  The image shader samples
+  // the planes directly, as long as we don't need to clamp to a strict subset.
+  const SkRect imageBounds = SkRect::Make(image->bounds());
+  if (!src || (imageBounds.contains(*src) &&
+               (*src == imageBounds || SkCanvas::kFast_SrcRectConstraint == constraint))) {
+    if (as_IB(image)->hasROYUVAPlanes()) {
+      SkMatrix matrix = SkMatrix::RectToRect(src ? *src : imageBounds, dst);
+      SkPaint paintWithShader(paint);
+      paintWithShader.setStyle(SkPaint::kFill_Style);
+      paintWithShader.setShader(
+          image->makeShader(SkTileMode::kClamp, SkTileMode::kClamp, sampling, &matrix));
+      this->drawRect(dst, paintWithShader);
+      return;
+    }
+  }
+
   SkBitmap bitmap;
   // TODO: Elevate direct context requirement to public API and remove cheat.
   auto dContext = as_IB(image)->directContext();
@@ -27,7 +27,9 @@
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTSearch.h"
 #include "src/core/SkTypefaceCache.h"
+#include "src/core/SkVMJITCache.h"
 
+#include <atomic>
 #include <stdlib.h>
 
 void SkGraphics::Init() {
@@ -140,3 +142,15 @@ SkGraphics::OpenTypeSVGDecoderFactory SkGraphics::GetOpenTypeSVGDecoderFactory()
 extern bool gSkVMAllowJIT;
 
 void SkGraphics::AllowJIT() { gSkVMAllowJIT = true; }
+
+bool SkGraphics::SetJITCachePath(const char* path) {
+  return SkVMJITCache::Global()->setPath(path);
+}
+
+int SkGraphics::GetJITCacheHitCount() { return SkVMJITCache::Global()->hitCount(); }
+
+int SkGraphics::GetJITCacheMissCount() { return SkVMJITCache::Global()->missCount(); }
+
+extern std::atomic<bool> gSkRasterYUVPlanes;
+
+bool SkGraphics::SetRasterYUVPlanes(bool enabled) { return gSkRasterYUVPlanes.exchange(enabled); }
@@ -15,7 +15,11 @@
 #include "include/core/SkString.h"
 #include "include/private/SkTemplates.h"
 
-enum SkFILE_Flags { kRead_SkFILE_Flag = 0x01, kWrite_SkFILE_Flag = 0x02 };
+enum SkFILE_Flags {
+  kRead_SkFILE_Flag = 0x01,
+  kWrite_SkFILE_Flag = 0x02,
+  kAppend_SkFILE_Flag = 0x04,
+};
 
 FILE* sk_fopen(const char path[], SkFILE_Flags);
 void sk_fclose(FILE*);
@@ -44,6 +44,7 @@
 #include "src/opts/SkBlitRow_opts.h"
 #include "src/opts/SkChecksum_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
+#include "src/opts/SkScan_opts.h"
 #include "src/opts/SkSwizzler_opts.h"
 #include "src/opts/SkUtils_opts.h"
 #include "src/opts/SkVM_opts.h"
@@ -72,6 +73,10 @@ DEFINE_DEFAULT(grayA_to_RGBA);
 DEFINE_DEFAULT(grayA_to_rgbA);
 DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
 DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
+DEFINE_DEFAULT(RGB16_to_RGB1);
+DEFINE_DEFAULT(RGBA16_to_RGBA);
+DEFINE_DEFAULT(index_to_8888);
+DEFINE_DEFAULT(masks_to_8888);
 
 DEFINE_DEFAULT(memset16);
 DEFINE_DEFAULT(memset32);
@@ -83,6 +88,11 @@ DEFINE_DEFAULT(rect_memset64);
 
 DEFINE_DEFAULT(cubic_solver);
 
+DEFINE_DEFAULT(add_alphas);
+DEFINE_DEFAULT(add_alpha_span);
+DEFINE_DEFAULT(sub_alphas);
+DEFINE_DEFAULT(alpha_ramp);
+
 DEFINE_DEFAULT(hash_fn);
 
 DEFINE_DEFAULT(S32_alpha_D32_filter_DX);
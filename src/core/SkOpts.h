@@ -47,7 +47,20 @@ extern Swizzle_8888_u8 RGB_to_RGB1,  // i.e. insert an opaque alpha
     RGB_to_BGR1,                     // i.e. swap RB and insert an opaque alpha
     gray_to_RGB1,                    // i.e. expand to color channels + an opaque alpha
     grayA_to_RGBA,                   // i.e. expand to color channels
-    grayA_to_rgbA;                   // i.e. expand to color channels and premultiply
+    grayA_to_rgbA,                   // i.e. expand to color channels and premultiply
+    RGB16_to_RGB1,                   // i.e. keep the high bytes and insert an opaque alpha
+    RGBA16_to_RGBA;                  // i.e. keep the high bytes
+
+// Look up each 8-bit index in a 256 entry table of 8888 colors.
+extern void (*index_to_8888)(uint32_t dst[], const uint8_t* src, const uint32_t table[], int);
+
+// Expand pixels whose channels are bit fields (e.g. BMP bit masks) to 8888.  Channel i of each
+// dst pixel is ((src & mask[i]) >> shift[i]) * scale[i] + bias[i], truncated to an integer.
+struct SwizzleMasks {
+  uint32_t mask[4], shift[4];
+  float scale[4], bias[4];
+};
+extern void (*masks_to_8888)(uint32_t dst[], const uint32_t src[], const SwizzleMasks&, int);
 
 extern void (*memset16)(uint16_t[], uint16_t, int);
 extern void SK_SPI (*memset32)(uint32_t[], uint32_t, int);
@@ -59,6 +72,12 @@ extern void (*rect_memset64)(uint64_t[], uint64_t, int, size_t, int);
 
 extern float (*cubic_solver)(float, float, float, float);
 
+// Coverage accumulation for analytic AA; see src/opts/SkScan_opts.h.
+extern void (*add_alphas)(SkAlpha dst[], const SkAlpha src[], int n);
+extern void (*add_alpha_span)(SkAlpha dst[], SkAlpha alpha, int n);
+extern void (*sub_alphas)(SkAlpha dst[], const SkAlpha src[], int n);
+extern void (*alpha_ramp)(SkAlpha dst[], int32_t alpha16, int32_t dY, int n);
+
 static inline uint32_t hash(const void* data, size_t bytes, uint32_t seed = 0) {
   return hash_fn(data, bytes, seed);
 }
@@ -11,6 +11,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkPictureCommon.h"
@@ -150,6 +151,33 @@ sk_sp<SkPicture> SkPicture::Forwardport(
   return r.finishRecordingAsPicture();
 }
 
+// A picture made by MakeDeferredFromData().  Instead of re-recording its SkPictureData into an
+// SkRecord as Forwardport() does, we play the SkPictureData's ops back directly every time.
+class SkDeferredPicture final : public SkPicture {
+ public:
+  explicit SkDeferredPicture(std::unique_ptr<const SkPictureData> data) : fData(std::move(data)) {}
+
+  void playback(SkCanvas* canvas, AbortCallback* callback) const override {
+    SkPicturePlayback playback(fData.get());
+    playback.draw(canvas, callback, nullptr);
+  }
+
+  // We don't parse the ops until playback, so estimate their count from their size.
+  int approximateOpCount(bool) const override {
+    return SkToInt(std::min<size_t>(fData->opData()->size() / kBytesPerOp, SK_MaxS32));
+  }
+  size_t approximateBytesUsed() const override {
+    return sizeof(*this) + fData->opData()->size();
+  }
+  SkRect cullRect() const override { return fData->info().fCullRect; }
+
+ private:
+  // A typical op is a header, a paint index, and a rect or a few scalars.
+  static constexpr size_t kBytesPerOp = 16;
+
+  std::unique_ptr<const SkPictureData> fData;
+};
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procs) {
   return MakeFromStream(stream, procs, nullptr);
 }
@@ -171,8 +199,18 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
   return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeDeferredFromData(
+    sk_sp<SkData> data, const SkDeserialProcs* procs) {
+  if (!data) {
+    return nullptr;
+  }
+  SkMemoryStream stream(data);
+  return MakeFromStream(&stream, procs, nullptr, data.get());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(
-    SkStream* stream, const SkDeserialProcs* procsPtr, SkTypefacePlayback* typefaces) {
+    SkStream* stream, const SkDeserialProcs* procsPtr, SkTypefacePlayback* typefaces,
+    const SkData* backing) {
   SkPictInfo info;
   if (!StreamIsSKP(stream, &info)) {
     return nullptr;
@@ -190,7 +228,13 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(
   switch (trailingStreamByteAfterPictInfo) {
     case kPictureData_TrailingStreamByteAfterPictInfo: {
       std::unique_ptr<SkPictureData> data(
-          SkPictureData::CreateFromStream(stream, info, procs, typefaces));
+          SkPictureData::CreateFromStream(stream, info, procs, typefaces, backing));
+      if (backing) {
+        if (!data || !data->opData()) {
+          return nullptr;
+        }
+        return sk_make_sp<SkDeferredPicture>(std::move(data));
+      }
       return Forwardport(info, data.get(), nullptr);
     }
     case kCustom_TrailingStreamByteAfterPictInfo: {
@@ -336,6 +380,14 @@ void SkPicturePriv::Flatten(const sk_sp<const SkPicture> picture, SkWriteBuffer&
   }
 }
 
+void SkPicture::parallelPlayback(SkCanvas* canvas, SkExecutor* executor) const {
+  const SkBigPicture* big = this->asSkBigPicture();
+  if (!executor || !big) {
+    return this->playback(canvas);
+  }
+  big->parallelPlayback(canvas, executor);
+}
+
 sk_sp<SkPicture> SkPicture::MakePlaceholder(SkRect cull) {
   struct Placeholder : public SkPicture {
     explicit Placeholder(SkRect cull) : fCull(cull) {}
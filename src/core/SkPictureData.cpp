@@ -10,7 +10,6 @@
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTo.h"
-#include "src/core/SkAutoMalloc.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
 #include "src/core/SkReadBuffer.h"
@@ -97,6 +96,18 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
   stream->write32(SkToU32(size));
 }
 
+// Pads stream so the data of the section written next starts 4-byte aligned in it, so that
+// readers of a page-aligned mapping of the stream can share that data instead of copying it.
+static void write_section_padding(SkWStream* stream) {
+  // Our own tag and size, like the next section's, are 8 bytes and don't change the alignment.
+  const size_t padding = SkAlign4(stream->bytesWritten()) - stream->bytesWritten();
+  if (padding) {
+    static constexpr uint8_t kZeros[3] = {0, 0, 0};
+    write_tag_size(stream, SK_PICT_PADDING_TAG, padding);
+    stream->write(kZeros, padding);
+  }
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
   int count = rec.count();
 
@@ -222,6 +233,7 @@ void SkPictureData::serialize(
     SkWStream* stream, const SkSerialProcs& procs, SkRefCntSet* topLevelTypeFaceSet,
     bool textBlobsOnly) const {
   // This can happen at pretty much any time, so might as well do it first.
+  write_section_padding(stream);
   write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
   stream->write(fOpData->bytes(), fOpData->size());
 
@@ -265,6 +277,7 @@ void SkPictureData::serialize(
   WriteTypefaces(stream, *typefaceSet, procs);
 
   // Write the buffer.
+  write_section_padding(stream);
   write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
   buffer.writeToStream(stream);
 
@@ -304,13 +317,33 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Reads the next size bytes of stream.  If stream is reading from backing and those bytes are
+// 4-byte aligned, as SkReadBuffer requires, we share them rather than copy them.  Since v93 the
+// writer pads sections to be aligned within the stream, so this only copies for older pictures
+// or backing data that doesn't itself start 4-byte aligned.
+static sk_sp<SkData> read_section(SkStream* stream, size_t size, const SkData* backing) {
+  if (backing) {
+    const size_t offset = stream->getPosition();
+    if (offset <= backing->size() && size <= backing->size() - offset &&
+        SkIsAlign4(reinterpret_cast<uintptr_t>(backing->bytes() + offset))) {
+      return stream->skip(size) == size ? SkData::MakeSubset(backing, offset, size) : nullptr;
+    }
+  }
+  return SkData::MakeFromStream(stream, size);
+}
+
 bool SkPictureData::parseStreamTag(
     SkStream* stream, uint32_t tag, uint32_t size, const SkDeserialProcs& procs,
-    SkTypefacePlayback* topLevelTFPlayback) {
+    SkTypefacePlayback* topLevelTFPlayback, const SkData* backing) {
   switch (tag) {
+    case SK_PICT_PADDING_TAG:
+      if (size > 3 || stream->skip(size) != size) {
+        return false;
+      }
+      break;
     case SK_PICT_READER_TAG:
       SkASSERT(nullptr == fOpData);
-      fOpData = SkData::MakeFromStream(stream, size);
+      fOpData = read_section(stream, size, backing);
       if (!fOpData) {
         return false;
       }
@@ -355,7 +388,7 @@ bool SkPictureData::parseStreamTag(
       fPictures.reserve_back(SkToInt(size));
 
       for (uint32_t i = 0; i < size; i++) {
-        auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+        auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback, backing);
         if (!pic) {
           return false;
         }
@@ -363,13 +396,17 @@ bool SkPictureData::parseStreamTag(
       }
     } break;
     case SK_PICT_BUFFER_SIZE_TAG: {
-      SkAutoMalloc storage(size);
-      if (stream->read(storage.get(), size) != size) {
+      sk_sp<SkData> storage = read_section(stream, size, backing);
+      if (!storage) {
         return false;
       }
 
-      SkReadBuffer buffer(storage.get(), size);
+      SkReadBuffer buffer(storage->data(), size);
       buffer.setVersion(fInfo.getVersion());
+      if (backing) {
+        // Let encoded images share storage instead of copying their bytes out of it.
+        buffer.setBackingData(std::move(storage));
+      }
 
       if (!fFactoryPlayback) {
         return false;
@@ -501,13 +538,13 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 
 SkPictureData* SkPictureData::CreateFromStream(
     SkStream* stream, const SkPictInfo& info, const SkDeserialProcs& procs,
-    SkTypefacePlayback* topLevelTFPlayback) {
+    SkTypefacePlayback* topLevelTFPlayback, const SkData* backing) {
   std::unique_ptr<SkPictureData> data(new SkPictureData(info));
   if (!topLevelTFPlayback) {
     topLevelTFPlayback = &data->fTFPlayback;
   }
 
-  if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+  if (!data->parseStream(stream, procs, topLevelTFPlayback, backing)) {
     return nullptr;
   }
   return data.release();
@@ -524,7 +561,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer, const SkPic
 }
 
 bool SkPictureData::parseStream(
-    SkStream* stream, const SkDeserialProcs& procs, SkTypefacePlayback* topLevelTFPlayback) {
+    SkStream* stream, const SkDeserialProcs& procs, SkTypefacePlayback* topLevelTFPlayback,
+    const SkData* backing) {
   for (;;) {
     uint32_t tag;
     if (!stream->readU32(&tag)) {
@@ -538,7 +576,7 @@ bool SkPictureData::parseStream(
     if (!stream->readU32(&size)) {
       return false;
     }
-    if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback)) {
+    if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, backing)) {
       return false;  // we're invalid
     }
   }
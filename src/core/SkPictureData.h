@@ -56,6 +56,8 @@ struct SkPictInfo {
 #define SK_PICT_TYPEFACE_TAG SkSetFourByteTag('t', 'p', 'f', 'c')
 #define SK_PICT_PICTURE_TAG SkSetFourByteTag('p', 'c', 't', 'r')
 #define SK_PICT_DRAWABLE_TAG SkSetFourByteTag('d', 'r', 'a', 'w')
+// Zero bytes that 4-byte align the next section's data in the stream (v93 and later)
+#define SK_PICT_PADDING_TAG SkSetFourByteTag('p', 'a', 'd', ' ')
 
 // This tag specifies the size of the ReadBuffer, needed for the following tags
 #define SK_PICT_BUFFER_SIZE_TAG SkSetFourByteTag('a', 'r', 'a', 'y')
@@ -79,9 +81,11 @@ T* read_index_base_1_or_null(SkReadBuffer* reader, const SkTArray<sk_sp<T>>& arr
 class SkPictureData {
  public:
   SkPictureData(const SkPictureRecord& record, const SkPictInfo&);
-  // Does not affect ownership of SkStream.
+  // Does not affect ownership of SkStream.  If backing is not null, stream reads from it,
+  // and the ops and encoded images may reference it rather than copy it.
   static SkPictureData* CreateFromStream(
-      SkStream*, const SkPictInfo&, const SkDeserialProcs&, SkTypefacePlayback*);
+      SkStream*, const SkPictInfo&, const SkDeserialProcs&, SkTypefacePlayback*,
+      const SkData* backing = nullptr);
   static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
 
   void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*, bool textBlobsOnly = false) const;
@@ -95,7 +99,7 @@ class SkPictureData {
   explicit SkPictureData(const SkPictInfo& info);
 
   // Does not affect ownership of SkStream.
-  bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*);
+  bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*, const SkData* backing);
   bool parseBuffer(SkReadBuffer& buffer);
 
  public:
@@ -143,7 +147,8 @@ class SkPictureData {
   // these help us with reading/writing
   // Does not affect ownership of SkStream.
   bool parseStreamTag(
-      SkStream*, uint32_t tag, uint32_t size, const SkDeserialProcs&, SkTypefacePlayback*);
+      SkStream*, uint32_t tag, uint32_t size, const SkDeserialProcs&, SkTypefacePlayback*,
+      const SkData* backing);
   void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
   void flattenToBuffer(SkWriteBuffer&, bool textBlobsOnly) const;
 
@@ -100,6 +100,7 @@ class SkPicturePriv {
   // V90: Private API for backdrop scale factor in SaveLayerRec
   // V91: Added raw image shaders
   // V92: Added anisotropic filtering to SkSamplingOptions
+  // V93: Streamed picture data pads its sections to 4-byte alignment
 
   enum Version {
     kPictureShaderFilterParam_Version = 82,
@@ -113,6 +114,7 @@ class SkPicturePriv {
     kBackdropScaleFactor = 90,
     kRawImageShaders = 91,
     kAnisotropicFilter = 92,
+    kAlignedSections = 93,
 
     // Only SKPs within the min/current picture version range (inclusive) can be read.
     //
@@ -139,7 +141,7 @@ class SkPicturePriv {
     // Contact the Infra Gardener (or directly ping rmistry@) if the above steps do not work
     // for you.
     kMin_Version = kPictureShaderFilterParam_Version,
-    kCurrent_Version = kAnisotropicFilter
+    kCurrent_Version = kAlignedSections
   };
 };
 
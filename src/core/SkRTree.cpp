@@ -7,7 +7,25 @@
 
 #include "src/core/SkRTree.h"
 
-SkRTree::SkRTree() : fCount(0) {}
+#include "include/private/SkTPin.h"
+#include "include/private/SkVx.h"
+
+#include <algorithm>
+
+SkRTree::SkRTree(Packing packing) : fPacking(packing), fCount(0) {}
+
+void SkRTree::Node::setChild(int i, const Branch& branch) {
+  SkASSERT(i < kMaxChildren);
+  fLeft[i] = branch.fBounds.fLeft;
+  fTop[i] = branch.fBounds.fTop;
+  fRight[i] = branch.fBounds.fRight;
+  fBottom[i] = branch.fBounds.fBottom;
+  if (0 == fLevel) {
+    fChildren[i].fOpIndex = branch.fOpIndex;
+  } else {
+    fChildren[i].fSubtree = branch.fSubtree;
+  }
+}
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
   SkASSERT(0 == fCount);
@@ -33,16 +51,68 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
       fNodes.reserve(1);
       Node* n = this->allocateNodeAtLevel(0);
       n->fNumChildren = 1;
-      n->fChildren[0] = branches[0];
+      n->setChild(0, branches[0]);
       fRoot.fSubtree = n;
       fRoot.fBounds = branches[0].fBounds;
     } else {
+      if (Packing::kHilbert == fPacking) {
+        SkRect bounds = branches[0].fBounds;
+        for (const Branch& b : branches) {
+          bounds.join(b.fBounds);
+        }
+        HilbertSort(&branches, bounds);
+      }
       fNodes.reserve(CountNodes(fCount));
       fRoot = this->bulkLoad(&branches);
     }
   }
 }
 
+// Maps (x,y) in a 2^16 x 2^16 grid to its distance along the Hilbert curve filling that grid.
+static uint32_t hilbert_index(uint32_t x, uint32_t y) {
+  constexpr uint32_t kN = 1 << 16;
+  uint32_t d = 0;
+  for (uint32_t s = kN / 2; s > 0; s /= 2) {
+    const uint32_t rx = (x & s) ? 1 : 0;
+    const uint32_t ry = (y & s) ? 1 : 0;
+    d += s * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant so the curve inside it has the canonical orientation.
+    if (0 == ry) {
+      if (1 == rx) {
+        x = kN - 1 - x;
+        y = kN - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+void SkRTree::HilbertSort(std::vector<Branch>* branches, const SkRect& bounds) {
+  const float kGridMax = (1 << 16) - 1;
+  const float sx = bounds.width() > 0 ? kGridMax / bounds.width() : 0,
+              sy = bounds.height() > 0 ? kGridMax / bounds.height() : 0;
+
+  struct Keyed {
+    uint32_t fKey;
+    Branch fBranch;
+  };
+  std::vector<Keyed> keyed;
+  keyed.reserve(branches->size());
+  for (const Branch& b : *branches) {
+    // Pin, as the centers of huge rects may land outside the (float) union bounds.
+    const float cx = SkTPin((b.fBounds.centerX() - bounds.fLeft) * sx, 0.f, kGridMax),
+                cy = SkTPin((b.fBounds.centerY() - bounds.fTop) * sy, 0.f, kGridMax);
+    keyed.push_back({hilbert_index((uint32_t)cx, (uint32_t)cy), b});
+  }
+  std::stable_sort(keyed.begin(), keyed.end(), [](const Keyed& a, const Keyed& b) {
+    return a.fKey < b.fKey;
+  });
+  for (size_t i = 0; i < keyed.size(); ++i) {
+    (*branches)[i] = keyed[i].fBranch;
+  }
+}
+
 SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
   SkDEBUGCODE(Node* p = fNodes.data());
   fNodes.push_back(Node{});
@@ -50,6 +120,10 @@ SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
   SkASSERT(fNodes.data() == p);  // If this fails, we didn't reserve() enough.
   out.fNumChildren = 0;
   out.fLevel = level;
+  std::fill_n(out.fLeft, kLanes, SK_ScalarInfinity);
+  std::fill_n(out.fTop, kLanes, SK_ScalarInfinity);
+  std::fill_n(out.fRight, kLanes, SK_ScalarNegativeInfinity);
+  std::fill_n(out.fBottom, kLanes, SK_ScalarNegativeInfinity);
   return &out;
 }
 
@@ -123,14 +197,14 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
     }
     Node* n = allocateNodeAtLevel(level);
     n->fNumChildren = 1;
-    n->fChildren[0] = (*branches)[currentBranch];
+    n->setChild(0, (*branches)[currentBranch]);
     Branch b;
     b.fBounds = (*branches)[currentBranch].fBounds;
     b.fSubtree = n;
     ++currentBranch;
     for (int k = 1; k < incrementBy && currentBranch < (int)branches->size(); ++k) {
       b.fBounds.join((*branches)[currentBranch].fBounds);
-      n->fChildren[k] = (*branches)[currentBranch];
+      n->setChild(k, (*branches)[currentBranch]);
       ++n->fNumChildren;
       ++currentBranch;
     }
@@ -143,13 +217,26 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
 
 void SkRTree::search(const SkRect& query, std::vector<int>* results) const {
   if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
+    const size_t start = results->size();
     this->search(fRoot.fSubtree, query, results);
+    if (Packing::kHilbert == fPacking) {
+      // Callers play back ops in the order we return them.
+      std::sort(results->begin() + start, results->end());
+    }
   }
 }
 
-void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results) const {
+void SkRTree::search(const Node* node, const SkRect& query, std::vector<int>* results) const {
+  using F = skvx::Vec<kLanes, float>;
+  // Both rects are non-empty (the root test above rejected empty or NaN queries, and insert()
+  // skipped empty bounds), so SkRect::Intersects() reduces to these four compares.
+  const auto hit = (F::Load(node->fLeft) < query.fRight) & (query.fLeft < F::Load(node->fRight)) &
+                   (F::Load(node->fTop) < query.fBottom) & (query.fTop < F::Load(node->fBottom));
+  if (!any(hit)) {
+    return;
+  }
   for (int i = 0; i < node->fNumChildren; ++i) {
-    if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
+    if (hit[i]) {
       if (0 == node->fLevel) {
         results->push_back(node->fChildren[i].fOpIndex);
       } else {
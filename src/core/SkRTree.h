@@ -16,11 +16,14 @@
  * bounding rectangles.
  *
  * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
- * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
+ * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm, packing
+ * the rects in the order they're given, or optionally the Hilbert pack variant, which first
+ * groups rects by the position of their centers on the Hilbert curve.
  *
- * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
- * which groups rects by position on the Hilbert curve, is probably worth a look). There also
- * exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
+ * Nodes store their children's bounds as a structure of arrays, so a query tests every child of
+ * a node with a handful of SIMD compares.
+ *
+ * TODO: There also exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
  *
  * For more details see:
  *
@@ -29,7 +32,11 @@
  */
 class SkRTree : public SkBBoxHierarchy {
  public:
-  SkRTree();
+  // With kHilbert, insert() costs a sort, and search() must sort its results back into insertion
+  // order.
+  using Packing = SkRTreeFactory::Packing;
+
+  explicit SkRTree(Packing = Packing::kInsertionOrder);
 
   void insert(const SkRect[], int N) override;
   void search(const SkRect& query, std::vector<int>* results) const override;
@@ -56,13 +63,30 @@ class SkRTree : public SkBBoxHierarchy {
     SkRect fBounds;
   };
 
+  // kMaxChildren rounded up to a power of two, the width of the SIMD bounds test.
+  static constexpr int kLanes = 16;
+  static_assert(kMaxChildren <= kLanes);
+
   struct Node {
+    // Child bounds, structure-of-arrays. Unused lanes hold inverted bounds that never intersect.
+    float fLeft[kLanes];
+    float fTop[kLanes];
+    float fRight[kLanes];
+    float fBottom[kLanes];
+    union {
+      Node* fSubtree;
+      int fOpIndex;
+    } fChildren[kMaxChildren];
     uint16_t fNumChildren;
     uint16_t fLevel;
-    Branch fChildren[kMaxChildren];
+
+    void setChild(int i, const Branch&);
   };
 
-  void search(Node* root, const SkRect& query, std::vector<int>* results) const;
+  void search(const Node* root, const SkRect& query, std::vector<int>* results) const;
+
+  // Reorders branches by the Hilbert index of their centers.
+  static void HilbertSort(std::vector<Branch>* branches, const SkRect& bounds);
 
   // Consumes the input array.
   Branch bulkLoad(std::vector<Branch>* branches, int level = 0);
@@ -72,6 +96,7 @@ class SkRTree : public SkBBoxHierarchy {
 
   Node* allocateNodeAtLevel(uint16_t level);
 
+  Packing fPacking;
   // This is the count of data elements (rather than total nodes in the tree)
   int fCount;
   Branch fRoot;
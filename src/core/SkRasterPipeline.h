@@ -51,7 +51,7 @@ struct skcms_TransferFunction;
                   M(load_rg88_dst) M(store_rg88) M(gather_rg88) M(load_a16) M(load_a16_dst) M(                                                \
                       store_a16) M(gather_a16) M(store_r8) M(load_rg1616) M(load_rg1616_dst) M(store_rg1616)                                  \
                       M(gather_rg1616) M(load_16161616) M(load_16161616_dst) M(store_16161616) M(                                             \
-                          gather_16161616) M(load_1010102) M(load_1010102_dst) M(store_1010102) M(gather_1010102)                             \
+                          gather_16161616) M(load_1010102) M(load_1010102_dst) M(store_1010102) M(gather_1010102) M(gather_yuv_8)            \
                           M(alpha_to_gray) M(alpha_to_gray_dst) M(alpha_to_red) M(alpha_to_red_dst) M(                                        \
                               bt709_luminance_or_luma_to_alpha) M(bt709_luminance_or_luma_to_rgb)                                             \
                               M(bilerp_clamp_8888) M(bicubic_clamp_8888) M(store_u16_be) M(load_src) M(store_src) M(                          \
@@ -112,6 +112,15 @@ struct SkRasterPipeline_GatherCtx {
   float weights[16];  // for bicubic and bicubic_clamp_8888
 };
 
+// For gather_yuv_8: separate 8-bit Y, U, and V planes, any of which may be subsampled.
+struct SkRasterPipeline_GatherYUVCtx {
+  const uint8_t* planes[3];
+  int stride[3];
+  float width[3], height[3];   // Each plane's own dimensions.
+  float scaleX[3], scaleY[3];  // Image coordinates to plane coordinates.
+  float rgbFromYUV[12];        // Row-major 3x4; the last column is added.
+};
+
 // State shared by save_xy, accumulate, and bilinear_* / bicubic_*.
 struct SkRasterPipeline_SamplerCtx {
   float x[SkRasterPipeline_kMaxStride];
@@ -290,6 +290,15 @@ const void* SkReadBuffer::skipByteArray(size_t* size) {
 }
 
 sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
+  if (fBackingData) {
+    size_t numBytes;
+    const char* bytes = static_cast<const char*>(this->skipByteArray(&numBytes));
+    if (!bytes) {
+      return nullptr;
+    }
+    return SkData::MakeSubset(fBackingData.get(), bytes - fBase, numBytes);
+  }
+
   size_t numBytes = this->getArrayCount();
   if (!this->validate(this->isAvailable(numBytes))) {
     return nullptr;
@@ -8,6 +8,7 @@
 #ifndef SkReadBuffer_DEFINED
 #define SkReadBuffer_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkPath.h"
@@ -30,7 +31,6 @@
 #  include "include/core/SkDrawLooper.h"
 #endif
 
-class SkData;
 class SkImage;
 
 class SkReadBuffer {
@@ -144,6 +144,7 @@ class SkReadBuffer {
 
   const void* skipByteArray(size_t* size);
 
+  // Shares the bytes with the backing data when there is some, otherwise copies them.
   sk_sp<SkData> readByteArrayAsData();
 
   // helpers to get info about arrays and binary data
@@ -172,6 +173,15 @@ class SkReadBuffer {
   void setDeserialProcs(const SkDeserialProcs& procs);
   const SkDeserialProcs& getDeserialProcs() const { return fProcs; }
 
+  /**
+   *  Call this with the SkData this buffer is reading from to let byte arrays read from the
+   *  buffer (e.g. encoded images) reference it rather than copy it.
+   */
+  void setBackingData(sk_sp<SkData> data) {
+    SkASSERT(!data || (data->data() == fBase && data->size() == this->size()));
+    fBackingData = std::move(data);
+  }
+
   /**
    *  If isValid is false, sets the buffer to be "invalid". Returns true if the buffer
    *  is still valid.
@@ -235,6 +245,7 @@ class SkReadBuffer {
   int fFactoryCount = 0;
 
   SkDeserialProcs fProcs;
+  sk_sp<SkData> fBackingData;
 
   static bool IsPtrAlign4(const void* ptr) { return SkIsAlign4((uintptr_t)ptr); }
 
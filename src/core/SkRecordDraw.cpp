@@ -6,12 +6,17 @@
  */
 
 #include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
 #include "include/private/SkTDArray.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkPicturePriv.h"
 #include "src/core/SkRecordDraw.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkPatchUtils.h"
 
 void SkRecordDraw(
@@ -56,6 +61,74 @@ void SkRecordDraw(
   }
 }
 
+void SkRecordDrawParallel(
+    const SkRecord& record, SkCanvas* canvas, SkPicture const* const drawablePicts[],
+    int drawableCount, const SkBBoxHierarchy* bbh, const SkRect& cullRect, SkExecutor* executor) {
+  // Big enough that replaying the state ops on each tile stays cheap next to the drawing,
+  // small enough to spread the work of a typical picture across a handful of threads.
+  static constexpr int kTileSize = 256;
+
+  auto drawSerially = [&] {
+    SkRecordDraw(record, canvas, drawablePicts, nullptr, drawableCount, bbh, nullptr);
+  };
+
+  // We're about to write the pixels behind the canvas's back, so let its surface copy them
+  // first if a snapshot is holding on to them.
+  if (SkSurface* surface = canvas->getSurface()) {
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  }
+
+  // Each tile draws through a fresh SkCanvas, so we can only split up canvases whose matrix we can
+  // hand along and whose clip is the whole of the pixels they draw into.
+  SkImageInfo info;
+  size_t rowBytes;
+  SkIPoint origin;
+  SkSurfaceProps props;
+  void* pixels = executor ? canvas->accessTopLayerPixels(&info, &rowBytes, &origin) : nullptr;
+  if (!pixels || !origin.isZero() || !canvas->getProps(&props) || !canvas->isClipRect() ||
+      canvas->getDeviceClipBounds() != info.bounds()) {
+    return drawSerially();
+  }
+
+  const int tilesX = (info.width() + kTileSize - 1) / kTileSize,
+            tilesY = (info.height() + kTileSize - 1) / kTileSize;
+  if (tilesX * tilesY <= 1 || record.count() == 0) {
+    return drawSerially();
+  }
+
+  // A tile can't see past its own edges, so a blur or backdrop would show seams between tiles.
+  if (SkRecordReadsNeighborhood(record, 0, record.count(), drawablePicts, drawableCount)) {
+    return drawSerially();
+  }
+
+  sk_sp<SkBBoxHierarchy> bounds;
+  if (!bbh) {
+    SkAutoTMalloc<SkRect> rects(record.count());
+    SkAutoTMalloc<SkBBoxHierarchy::Metadata> meta(record.count());
+    SkRecordFillBounds(cullRect, record, rects, meta);
+    bounds = SkRTreeFactory()();
+    bounds->insert(rects, meta, record.count());
+    bbh = bounds.get();
+  }
+
+  const SkM44 ctm = canvas->getLocalToDevice();
+  const SkPixmap pixmap(info, pixels, rowBytes);
+  SkTaskGroup(*executor).batch(tilesX * tilesY, [&](int i) {
+    const SkIRect tile =
+        SkIRect::MakeXYWH((i % tilesX) * kTileSize, (i / tilesX) * kTileSize, kTileSize, kTileSize);
+    SkPixmap tilePixmap;
+    SkBitmap tileBitmap;
+    if (!pixmap.extractSubset(&tilePixmap, tile) || !tileBitmap.installPixels(tilePixmap)) {
+      return;
+    }
+
+    SkCanvas tileCanvas(tileBitmap, props);
+    tileCanvas.translate(-SkIntToScalar(tile.left()), -SkIntToScalar(tile.top()));
+    tileCanvas.concat(ctm);
+    SkRecordDraw(record, &tileCanvas, drawablePicts, nullptr, drawableCount, bbh, nullptr);
+  });
+}
+
 void SkRecordPartialDraw(
     const SkRecord& record, SkCanvas* canvas, SkPicture const* const drawablePicts[],
     int drawableCount, int start, int stop, const SkM44& initialCTM) {
@@ -68,6 +141,73 @@ void SkRecordPartialDraw(
   }
 }
 
+namespace {
+
+// Visits one op, and returns true if its pixels depend on the pixels around them.
+class ReadsNeighborhood {
+ public:
+  ReadsNeighborhood(SkPicture const* const drawablePicts[], int drawableCount)
+      : fDrawablePicts(drawablePicts), fDrawableCount(drawableCount) {}
+
+  bool operator()(const SkRecords::SaveLayer& op) const {
+    return op.backdrop || HasImageFilter(op.paint);
+  }
+  bool operator()(const SkRecords::DrawPicture& op) const {
+    return HasImageFilter(op.paint) || PictureReadsNeighborhood(op.picture.get());
+  }
+  bool operator()(const SkRecords::DrawDrawable& op) const {
+    // Without a snapshot of the drawable we can't look inside, so assume the worst.
+    return !fDrawablePicts || op.index >= fDrawableCount ||
+           PictureReadsNeighborhood(fDrawablePicts[op.index]);
+  }
+  template <typename T>
+  std::enable_if_t<(T::kTags & SkRecords::kHasPaint_Tag) != 0, bool> operator()(
+      const T& op) const {
+    return HasImageFilter(op.paint);
+  }
+  template <typename T>
+  std::enable_if_t<!(T::kTags & SkRecords::kHasPaint_Tag), bool> operator()(const T&) const {
+    return false;
+  }
+
+ private:
+  static bool HasImageFilter(const SkPaint& paint) { return paint.getImageFilter() != nullptr; }
+  static bool HasImageFilter(const SkRecords::Optional<SkPaint>& paint) {
+    return paint && paint->getImageFilter();
+  }
+
+  static bool PictureReadsNeighborhood(const SkPicture* picture) {
+    if (!picture) {
+      return false;
+    }
+    if (const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture))) {
+      return SkRecordReadsNeighborhood(
+          *big->record(), 0, big->record()->count(), big->drawablePicts(),
+          big->drawableCount());
+    }
+    // Other kinds of pictures don't expose their ops, so only empty ones are known to be safe.
+    return picture->approximateOpCount() > 0;
+  }
+
+  SkPicture const* const* fDrawablePicts;
+  int fDrawableCount;
+};
+
+}  // namespace
+
+bool SkRecordReadsNeighborhood(
+    const SkRecord& record, int start, int stop, SkPicture const* const drawablePicts[],
+    int drawableCount) {
+  ReadsNeighborhood visitor(drawablePicts, drawableCount);
+  stop = std::min(stop, record.count());
+  for (int i = start; i < stop; ++i) {
+    if (record.visit(i, visitor)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 namespace SkRecords {
 
 // NoOps draw nothing.
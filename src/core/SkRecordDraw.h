@@ -15,6 +15,7 @@
 #include "src/core/SkRecord.h"
 
 class SkDrawable;
+class SkExecutor;
 class SkLayerInfo;
 
 // Calculate conservative identity space bounds for each op in the record.
@@ -34,6 +35,23 @@ void SkRecordDraw(
     SkDrawable* const drawables[], int drawableCount, const SkBBoxHierarchy*,
     SkPicture::AbortCallback*);
 
+// Draw an SkRecord into a raster SkCanvas, splitting the canvas into tiles that are rasterized
+// concurrently on the executor.  Each tile replays, in order, only the ops whose bounds touch it,
+// found with the bbh or, if there is none, an SkRTree built from SkRecordFillBounds().  Canvases
+// that can't be split this way (not raster, or clipped) and records with image filters or
+// backdrops (see SkRecordReadsNeighborhood()) are drawn serially with SkRecordDraw().
+void SkRecordDrawParallel(
+    const SkRecord&, SkCanvas*, SkPicture const* const drawablePicts[], int drawableCount,
+    const SkBBoxHierarchy*, const SkRect& cullRect, SkExecutor*);
+
+// Returns true if any op in [start, stop) produces pixels that depend on the pixels around them: a
+// saveLayer with a backdrop or an image filter, or a draw whose paint has an image filter, looking
+// into nested pictures and drawables too. Replaying such ops separately on parts of a canvas would
+// show seams where the parts meet, since each part only sees its own pixels.
+bool SkRecordReadsNeighborhood(
+    const SkRecord&, int start, int stop, SkPicture const* const drawablePicts[],
+    int drawableCount);
+
 // Draw a portion of an SkRecord into an SkCanvas.
 // When drawing a portion of an SkRecord the CTM on the passed in canvas must be
 // the composition of the replay matrix with the record-time CTM (for the portion
@@ -14,6 +14,7 @@
 #include "include/private/chromium/Slug.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
+#include "src/core/SkDevice.h"
 #include "src/core/SkGlyphRun.h"
 #include "src/utils/SkPatchUtils.h"
 
@@ -69,6 +70,12 @@ SkRecorder::SkRecorder(SkRecord* record, const SkRect& bounds, SkMiniRecorder* m
   SkASSERT(this->imageInfo().width() >= 0 && this->imageInfo().height() >= 0);
 }
 
+SkRecorder::SkRecorder(SkRecord* record, sk_sp<SkBaseDevice> device)
+    : SkCanvasVirtualEnforcer<SkNoDrawCanvas>(std::move(device)),
+      fApproxBytesUsedBySubPictures(0),
+      fRecord(record),
+      fMiniRecorder(nullptr) {}
+
 void SkRecorder::reset(SkRecord* record, const SkRect& bounds, SkMiniRecorder* mr) {
   this->forgetRecord();
   fRecord = record;
@@ -89,6 +96,12 @@ void SkRecorder::append(Args&&... args) {
   if (fMiniRecorder) {
     this->flushMiniRecorder();
   }
+  if constexpr ((T::kTags & SkRecords::kDraw_Tag) != 0) {
+    // A threaded raster surface records through us; give it a chance to copy-on-write.
+    if (this->getSurfaceBase() && !this->predrawNotify()) {
+      return;
+    }
+  }
   new (fRecord->append<T>()) T{std::forward<Args>(args)...};
 }
 
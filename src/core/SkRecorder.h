@@ -44,8 +44,16 @@ class SkRecorder final : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
   SkRecorder(SkRecord*, int width, int height, SkMiniRecorder* = nullptr);  // TODO: remove
   SkRecorder(SkRecord*, const SkRect& bounds, SkMiniRecorder* = nullptr);
 
+  // Records into the SkRecord while tracking matrix and clip state on a real device, so that
+  // imageInfo(), readPixels() and friends reflect that device.
+  SkRecorder(SkRecord*, sk_sp<SkBaseDevice>);
+
   void reset(SkRecord*, const SkRect& bounds, SkMiniRecorder* = nullptr);
 
+  // Start appending to a different SkRecord, leaving the canvas state (save stack, matrix and
+  // clip) untouched.  Does not take ownership of the SkRecord.
+  void setRecord(SkRecord* record) noexcept { fRecord = record; }
+
   size_t approxBytesUsedBySubPictures() const { return fApproxBytesUsedBySubPictures; }
 
   SkDrawableList* getDrawableList() const { return fDrawableList.get(); }
@@ -8,7 +8,7 @@
 #include "src/core/SkResourceCache.h"
 
 #include "include/core/SkTraceMemoryDump.h"
-#include "include/private/SkMutex.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkDiscardableMemory.h"
 #include "src/core/SkImageFilter_Base.h"
@@ -39,6 +39,13 @@ static inline bool SkShouldPostMessageToBus(
 #  define SK_DEFAULT_IMAGE_CACHE_LIMIT (32 * 1024 * 1024)
 #endif
 
+// Number of independently locked shards in the global cache. Clients that hit the cache from
+// many raster threads can raise this to cut lock contention, at the cost of each shard only
+// getting 1/N of the budget.
+#ifndef SK_RESOURCE_CACHE_SHARD_COUNT
+#  define SK_RESOURCE_CACHE_SHARD_COUNT 1
+#endif
+
 void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataSize) {
   SkASSERT(SkAlign4(dataSize) == dataSize);
 
@@ -84,6 +91,7 @@ void SkResourceCache::init() {
   fTotalBytesUsed = 0;
   fCount = 0;
   fSingleAllocationByteLimit = 0;
+  fDiscardableCountLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
 
   // One of these should be explicit set by the caller after we return.
   fTotalByteLimit = 0;
@@ -206,7 +214,7 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
   int countLimit;
 
   if (fDiscardableFactory) {
-    countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+    countLimit = fDiscardableCountLimit;
     byteLimit = UINT32_MAX;  // no limit based on bytes
   } else {
     countLimit = SK_MaxS32;  // no limit based on count
@@ -452,94 +460,192 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-  static SkMutex& mutex = *(new SkMutex);
-  return mutex;
+struct SkShardedResourceCache::Shard {
+  template <typename... Args>
+  Shard(Args&&... args) : fCache(std::forward<Args>(args)...) {}
+
+  mutable SkMutex fMutex;
+  SkResourceCache fCache;  // Guarded by fMutex.
+};
+
+SkShardedResourceCache::SkShardedResourceCache(
+    SkResourceCache::DiscardableFactory factory, int shardCount)
+    : fDiscardableFactory(factory), fTotalByteLimit(0) {
+  SkASSERT(shardCount > 0);
+  // Keep the whole cache's Rec count near what a single discardable cache would allow.
+  int countLimit =
+      std::max(1, SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT / shardCount);
+  for (int i = 0; i < shardCount; ++i) {
+    fShards.push_back(std::make_unique<Shard>(factory));
+    fShards.back()->fCache.fDiscardableCountLimit = countLimit;
+  }
 }
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-  // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in
-  // here.
-  resource_cache_mutex().assertHeld();
-  if (nullptr == gResourceCache) {
-#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-    gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
-#else
-    gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
-#endif
+SkShardedResourceCache::SkShardedResourceCache(size_t byteLimit, int shardCount)
+    : fDiscardableFactory(nullptr), fTotalByteLimit(byteLimit) {
+  SkASSERT(shardCount > 0);
+  for (int i = 0; i < shardCount; ++i) {
+    fShards.push_back(std::make_unique<Shard>(byteLimit / shardCount));
+  }
+}
+
+SkShardedResourceCache::~SkShardedResourceCache() = default;
+
+SkShardedResourceCache::Shard& SkShardedResourceCache::shardFor(const Key& key) const {
+  // Use the high bits of the hash: each shard's own hash table indexes with the low bits, and
+  // we don't want all the keys of one shard to collide there.
+  uint32_t index = (uint32_t)(((uint64_t)key.hash() * (uint32_t)fShards.count()) >> 32);
+  return *fShards[index];
+}
+
+bool SkShardedResourceCache::find(
+    const Key& key, SkResourceCache::FindVisitor visitor, void* context) {
+  Shard& shard = this->shardFor(key);
+  SkAutoMutexExclusive am(shard.fMutex);
+  return shard.fCache.find(key, visitor, context);
+}
+
+void SkShardedResourceCache::add(Rec* rec, void* payload) {
+  Shard& shard = this->shardFor(rec->getKey());
+  SkAutoMutexExclusive am(shard.fMutex);
+  shard.fCache.add(rec, payload);
+}
+
+void SkShardedResourceCache::visitAll(SkResourceCache::Visitor visitor, void* context) {
+  for (auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    shard->fCache.visitAll(visitor, context);
+  }
+}
+
+size_t SkShardedResourceCache::getTotalBytesUsed() const {
+  size_t used = 0;
+  for (const auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    used += shard->fCache.getTotalBytesUsed();
+  }
+  return used;
+}
+
+size_t SkShardedResourceCache::setTotalByteLimit(size_t newLimit) {
+  size_t prevLimit = fTotalByteLimit.exchange(newLimit, std::memory_order_relaxed);
+  for (auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    shard->fCache.setTotalByteLimit(newLimit / fShards.count());
+  }
+  return prevLimit;
+}
+
+size_t SkShardedResourceCache::setSingleAllocationByteLimit(size_t newLimit) {
+  size_t prevLimit = 0;
+  for (auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    prevLimit = shard->fCache.setSingleAllocationByteLimit(newLimit);
+  }
+  return prevLimit;
+}
+
+size_t SkShardedResourceCache::getSingleAllocationByteLimit() const {
+  SkAutoMutexExclusive am(fShards[0]->fMutex);
+  return fShards[0]->fCache.getSingleAllocationByteLimit();
+}
+
+size_t SkShardedResourceCache::getEffectiveSingleAllocationByteLimit() const {
+  // Every shard has the same limits, so any of them can answer for all.
+  SkAutoMutexExclusive am(fShards[0]->fMutex);
+  return fShards[0]->fCache.getEffectiveSingleAllocationByteLimit();
+}
+
+void SkShardedResourceCache::purgeAll() {
+  for (auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    shard->fCache.purgeAll();
+  }
+}
+
+void SkShardedResourceCache::checkMessages() {
+  for (auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    shard->fCache.checkMessages();
+  }
+}
+
+SkCachedData* SkShardedResourceCache::newCachedData(size_t bytes) {
+  // No shard state is needed to allocate, so don't take any lock here. Pending purge messages
+  // are picked up by the next find() or add() on each shard.
+  if (fDiscardableFactory) {
+    SkDiscardableMemory* dm = fDiscardableFactory(bytes);
+    return dm ? new SkCachedData(bytes, dm) : nullptr;
+  } else {
+    return new SkCachedData(sk_malloc_throw(bytes), bytes);
   }
-  return gResourceCache;
 }
 
-size_t SkResourceCache::GetTotalBytesUsed() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
-  return get_cache()->getTotalBytesUsed();
+void SkShardedResourceCache::dump() const {
+  for (const auto& shard : fShards) {
+    SkAutoMutexExclusive am(shard->fMutex);
+    shard->fCache.dump();
+  }
 }
 
-size_t SkResourceCache::GetTotalByteLimit() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
-  return get_cache()->getTotalByteLimit();
+///////////////////////////////////////////////////////////////////////////////
+
+static SkShardedResourceCache* get_cache() {
+  static SkOnce once;
+  static SkShardedResourceCache* cache;
+  once([] {
+#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    cache = new SkShardedResourceCache(
+        SkDiscardableMemory::Create, SK_RESOURCE_CACHE_SHARD_COUNT);
+#else
+    cache = new SkShardedResourceCache(
+        SK_DEFAULT_IMAGE_CACHE_LIMIT, SK_RESOURCE_CACHE_SHARD_COUNT);
+#endif
+  });
+  return cache;
 }
 
+size_t SkResourceCache::GetTotalBytesUsed() { return get_cache()->getTotalBytesUsed(); }
+
+size_t SkResourceCache::GetTotalByteLimit() { return get_cache()->getTotalByteLimit(); }
+
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->newCachedData(bytes);
 }
 
-void SkResourceCache::Dump() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
-  get_cache()->dump();
-}
+void SkResourceCache::Dump() { get_cache()->dump(); }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->setSingleAllocationByteLimit(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->getEffectiveSingleAllocationByteLimit();
 }
 
-void SkResourceCache::PurgeAll() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
-  return get_cache()->purgeAll();
-}
+void SkResourceCache::PurgeAll() { get_cache()->purgeAll(); }
 
-void SkResourceCache::CheckMessages() {
-  SkAutoMutexExclusive am(resource_cache_mutex());
-  return get_cache()->checkMessages();
-}
+void SkResourceCache::CheckMessages() { get_cache()->checkMessages(); }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   return get_cache()->find(key, visitor, context);
 }
 
-void SkResourceCache::Add(Rec* rec, void* payload) {
-  SkAutoMutexExclusive am(resource_cache_mutex());
-  get_cache()->add(rec, payload);
-}
+void SkResourceCache::Add(Rec* rec, void* payload) { get_cache()->add(rec, payload); }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-  SkAutoMutexExclusive am(resource_cache_mutex());
   get_cache()->visitAll(visitor, context);
 }
 
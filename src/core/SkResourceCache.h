@@ -9,9 +9,14 @@
 #define SkResourceCache_DEFINED
 
 #include "include/core/SkBitmap.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTArray.h"
 #include "include/private/SkTDArray.h"
 #include "src/core/SkMessageBus.h"
 
+#include <atomic>
+#include <memory>
+
 class SkCachedData;
 class SkDiscardableMemory;
 class SkTraceMemoryDump;
@@ -25,6 +30,7 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  That global instance is an SkShardedResourceCache (see below).
  */
 class SkResourceCache {
  public:
@@ -266,6 +272,7 @@ class SkResourceCache {
   size_t fTotalByteLimit;
   size_t fSingleAllocationByteLimit;
   int fCount;
+  int fDiscardableCountLimit;  // only used with fDiscardableFactory
 
   SkMessageBus<PurgeSharedIDMessage, uint32_t>::Inbox fPurgeSharedIDInbox;
 
@@ -285,5 +292,60 @@ class SkResourceCache {
 #else
   void validate() const {}
 #endif
+
+  friend class SkShardedResourceCache;
+};
+
+/**
+ *  A thread-safe cache built from several independent SkResourceCache shards. Each key is
+ *  routed to one shard by its hash, and each shard has its own mutex, LRU list and an equal
+ *  slice of the byte (or discardable count) budget, so threads looking up different keys
+ *  rarely wait on each other.
+ *
+ *  The total budget is still respected: the shard slices add up to it. Since a Rec has to fit
+ *  in its shard's slice, getEffectiveSingleAllocationByteLimit() is capped to one slice.
+ *  With a single shard this behaves exactly like one SkResourceCache behind one mutex.
+ */
+class SkShardedResourceCache {
+ public:
+  using Key = SkResourceCache::Key;
+  using Rec = SkResourceCache::Rec;
+
+  SkShardedResourceCache(SkResourceCache::DiscardableFactory, int shardCount);
+  SkShardedResourceCache(size_t byteLimit, int shardCount);
+  ~SkShardedResourceCache();
+
+  int shardCount() const { return fShards.count(); }
+
+  bool find(const Key&, SkResourceCache::FindVisitor, void* context);
+  void add(Rec*, void* payload = nullptr);
+  // Visits each shard in turn, holding only that shard's lock.
+  void visitAll(SkResourceCache::Visitor, void* context);
+
+  size_t getTotalBytesUsed() const;
+  size_t getTotalByteLimit() const { return fTotalByteLimit.load(std::memory_order_relaxed); }
+  size_t setTotalByteLimit(size_t newLimit);
+
+  size_t setSingleAllocationByteLimit(size_t maximumAllocationSize);
+  size_t getSingleAllocationByteLimit() const;
+  size_t getEffectiveSingleAllocationByteLimit() const;
+
+  void purgeAll();
+  void checkMessages();
+
+  SkResourceCache::DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
+
+  SkCachedData* newCachedData(size_t bytes);
+
+  void dump() const;
+
+ private:
+  struct Shard;
+
+  Shard& shardFor(const Key&) const;
+
+  SkTArray<std::unique_ptr<Shard>> fShards;
+  const SkResourceCache::DiscardableFactory fDiscardableFactory;
+  std::atomic<size_t> fTotalByteLimit;
 };
 #endif
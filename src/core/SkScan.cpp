@@ -11,6 +11,7 @@
 
 std::atomic<bool> gSkUseAnalyticAA{true};
 std::atomic<bool> gSkForceAnalyticAA{false};
+std::atomic<bool> gSkUseSparseStrips{false};
 
 static inline void blitrect(SkBlitter* blitter, const SkIRect& r) {
   blitter->blitRect(r.fLeft, r.fTop, r.width(), r.height());
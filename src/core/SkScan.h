@@ -24,6 +24,7 @@ typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
+extern std::atomic<bool> gSkUseSparseStrips;
 
 class AdditiveBlitter;
 
@@ -94,6 +95,9 @@ class SkScan {
   static void SAAFillPath(
       const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR, const SkIRect& clipBounds,
       bool forceRLE);
+  static void SparseStripFillPath(
+      const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR, const SkIRect& clipBounds,
+      bool forceRLE);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
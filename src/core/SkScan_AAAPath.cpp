@@ -16,6 +16,7 @@
 #include "src/core/SkEdge.h"
 #include "src/core/SkEdgeBuilder.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkQuadClipper.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkScan.h"
@@ -239,10 +240,7 @@ void MaskAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
 
 void MaskAdditiveBlitter::blitAntiH(int x, int y, int width, const SkAlpha alpha) {
   SkASSERT(x >= fMask.fBounds.fLeft - 1);
-  uint8_t* row = this->getRow(y);
-  for (int i = 0; i < width; ++i) {
-    add_alpha(&row[x + i], alpha);
-  }
+  SkOpts::add_alpha_span(this->getRow(y) + x, alpha, width);
 }
 
 void MaskAdditiveBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -594,10 +592,7 @@ static void compute_alpha_above_line(
     SkFixed firstH = SkFixedMul(first, dY);  // vertical edge of the left-most triangle
     alphas[0] = SkFixedMul(first, firstH) >> 9;  // triangle alpha
     SkFixed alpha16 = firstH + (dY >> 1);        // rectangle plus triangle
-    for (int i = 1; i < R - 1; ++i) {
-      alphas[i] = alpha16 >> 8;
-      alpha16 += dY;
-    }
+    SkOpts::alpha_ramp(alphas + 1, alpha16, dY, R - 2);
     alphas[R - 1] = fullAlpha - partial_triangle_to_alpha(last, dY);
   }
 }
@@ -618,10 +613,8 @@ static void compute_alpha_below_line(
     SkFixed lastH = SkFixedMul(last, dY);  // vertical edge of the right-most triangle
     alphas[R - 1] = SkFixedMul(last, lastH) >> 9;  // triangle alpha
     SkFixed alpha16 = lastH + (dY >> 1);           // rectangle plus triangle
-    for (int i = R - 2; i > 0; i--) {
-      alphas[i] = (alpha16 >> 8) & 0xFF;
-      alpha16 += dY;
-    }
+    // alphas[R-2] gets alpha16 and each pixel left of it gets dY more, so ramp down from alphas[1].
+    SkOpts::alpha_ramp(alphas + 1, alpha16 + (R - 3) * dY, -dY, R - 2);
     alphas[0] = fullAlpha - partial_triangle_to_alpha(first, dY);
   }
 }
@@ -672,13 +665,8 @@ static SK_ALWAYS_INLINE void blit_full_alpha(
     AdditiveBlitter* blitter, int y, int x, int len, SkAlpha fullAlpha, SkAlpha* maskRow,
     bool isUsingMask, bool noRealBlitter, bool needSafeCheck) {
   if (isUsingMask) {
-    for (int i = 0; i < len; ++i) {
-      if (needSafeCheck) {
-        safely_add_alpha(&maskRow[x + i], fullAlpha);
-      } else {
-        add_alpha(&maskRow[x + i], fullAlpha);
-      }
-    }
+    // add_alpha() and safely_add_alpha() agree whenever add_alpha() is safe to use.
+    SkOpts::add_alpha_span(maskRow + x, fullAlpha, len);
   } else {
     if (fullAlpha == 0xFF && !noRealBlitter) {
       blitter->getRealBlitter()->blitH(x, y, len);
@@ -715,11 +703,9 @@ static void blit_aaa_trapezoid_row(
   SkAlpha* tempAlphas = alphas + len + 1;
   int16_t* runs = (int16_t*)(alphas + (len + 1) * 2);
 
-  for (int i = 0; i < len; ++i) {
-    runs[i] = 1;
-    alphas[i] = fullAlpha;
-  }
+  sk_memset16(reinterpret_cast<uint16_t*>(runs), 1, len);
   runs[len] = 0;
+  memset(alphas, fullAlpha, len);
 
   int uL = SkFixedFloorToInt(ul);
   int lL = SkFixedCeilToInt(ll);
@@ -733,13 +719,7 @@ static void blit_aaa_trapezoid_row(
   } else {
     compute_alpha_below_line(
         tempAlphas + uL - L, ul - SkIntToFixed(uL), ll - SkIntToFixed(uL), lDY, fullAlpha);
-    for (int i = uL; i < lL; ++i) {
-      if (alphas[i - L] > tempAlphas[i - L]) {
-        alphas[i - L] -= tempAlphas[i - L];
-      } else {
-        alphas[i - L] = 0;
-      }
-    }
+    SkOpts::sub_alphas(alphas + uL - L, tempAlphas + uL - L, lL - uL);
   }
 
   int uR = SkFixedFloorToInt(ur);
@@ -754,23 +734,11 @@ static void blit_aaa_trapezoid_row(
   } else {
     compute_alpha_above_line(
         tempAlphas + uR - L, ur - SkIntToFixed(uR), lr - SkIntToFixed(uR), rDY, fullAlpha);
-    for (int i = uR; i < lR; ++i) {
-      if (alphas[i - L] > tempAlphas[i - L]) {
-        alphas[i - L] -= tempAlphas[i - L];
-      } else {
-        alphas[i - L] = 0;
-      }
-    }
+    SkOpts::sub_alphas(alphas + uR - L, tempAlphas + uR - L, lR - uR);
   }
 
   if (isUsingMask) {
-    for (int i = 0; i < len; ++i) {
-      if (needSafeCheck) {
-        safely_add_alpha(&maskRow[L + i], alphas[i]);
-      } else {
-        add_alpha(&maskRow[L + i], alphas[i]);
-      }
-    }
+    SkOpts::add_alphas(maskRow + L, alphas, len);
   } else {
     if (fullAlpha == 0xFF && !noRealBlitter) {
       // Real blitter is faster than RunBasedAdditiveBlitter
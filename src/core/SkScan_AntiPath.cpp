@@ -660,6 +660,14 @@ static bool ShouldUseAAA(const SkPath& path, SkScalar avgLength, SkScalar comple
 #endif
 }
 
+// Sparse strips only spend time on a path's edges, so they're only worth their per-strip
+// bookkeeping once there are plenty of pixels between the edges.
+static bool ShouldUseSparseStrips(const SkPath& path, const SkIRect& clippedIR) {
+  static constexpr int64_t kMinArea = 256 * 256;
+  return gSkUseSparseStrips && !path.isInverseFillType() &&
+         (int64_t)clippedIR.width() * clippedIR.height() >= kMinArea;
+}
+
 void SkScan::SAAFillPath(
     const SkPath& path, SkBlitter* blitter, const SkIRect& ir, const SkIRect& clipBounds,
     bool forceRLE) {
@@ -772,7 +780,9 @@ void SkScan::AntiFillPath(
   SkScalar avgLength, complexity;
   compute_complexity(path, avgLength, complexity);
 
-  if (ShouldUseAAA(path, avgLength, complexity)) {
+  if (ShouldUseSparseStrips(path, clippedIR)) {
+    SkScan::SparseStripFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+  } else if (ShouldUseAAA(path, avgLength, complexity)) {
     // Do not use AAA if path is too complicated:
     // there won't be any speedup or significant visual improvement.
     SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
@@ -0,0 +1,683 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/private/SkTPin.h"
+#include "include/private/SkTemplates.h"
+#include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/*
+  A sparse-strip path filler, for large paths where supersampling and AAA spend most of their
+  time on the pixels between the edges.
+
+  The path is flattened into lines, which we sweep top to bottom in strips of kStripHeight rows.
+  In each row, a line deposits its signed area coverage only into the pixels it passes through,
+  as in font-rs: the coverage of a pixel is the sum of the deposits at and to the left of it.
+  Deposits land in small tiles that exist only where there are edges.  Summing a strip's tiles
+  left to right, all its rows at once, gives exact area coverage within them, and a constant
+  winding between them.  Between tiles that are fully covered in every row of the strip, we
+  blit one rectangle; otherwise each row gets a single run.  So the coverage work scales with
+  the length of the path's edges, not its area.
+
+  Summing signed areas is exact in a pixel as long as the winding inside it takes only two
+  neighboring values, which is the case wherever a single y-monotone chain of the path's lines
+  passes through it.  Where lines of two chains meet in a pixel (the path crosses itself, or
+  overlaps itself there), the fill rule can't be applied to the summed area.  Those pixels are
+  recomputed from the windings along kComplexSamples horizontal lines through them.  Horizontal
+  edges deposit nothing, but count as chains of their own for this.
+*/
+
+namespace {
+
+constexpr int kStripHeight = 4;
+
+// Curves are flattened until they're within this many pixels of the true curve.
+constexpr float kFlattenTolerance = 0.125f;
+constexpr int kMaxCurveLines = 256;
+
+// Pixels where the path crosses or overlaps itself are sampled at this many rows per pixel.
+constexpr int kComplexSamples = 16;
+
+struct Line {
+  float x0, y0, x1, y1;  // y0 < y1, or for horizontal lines, x0 < x1.
+  float dxdy;
+  float dir;  // +1 if the path's edge points down, -1 if it points up, 0 if horizontal.
+  int chain;  // Lines of a contour between turns in y share a chain.
+};
+
+// Flattens a path into Lines, clipped to the clip bounds.
+class LineBuilder {
+ public:
+  LineBuilder(const SkIRect& clip, std::vector<Line>* lines)
+      : fClip(SkRect::Make(clip)), fLines(lines) {}
+
+  void addPath(const SkPath& path) {
+    SkAutoConicToQuads conicToQuads;
+    SkPathEdgeIter iter(path);
+    while (auto e = iter.next()) {
+      if (e.fIsNewContour) {
+        this->finishContour();
+      }
+      switch (e.fEdge) {
+        case SkPathEdgeIter::Edge::kLine:
+          this->addLine(e.fPts[0], e.fPts[1]);
+          break;
+        case SkPathEdgeIter::Edge::kQuad:
+          this->addQuad(e.fPts);
+          break;
+        case SkPathEdgeIter::Edge::kConic: {
+          const SkPoint* quadPts =
+              conicToQuads.computeQuads(e.fPts, iter.conicWeight(), kFlattenTolerance);
+          for (int i = 0; i < conicToQuads.countQuads(); i++) {
+            this->addQuad(quadPts + 2 * i);
+          }
+        } break;
+        case SkPathEdgeIter::Edge::kCubic:
+          this->addCubic(e.fPts);
+          break;
+      }
+    }
+    this->finishContour();
+  }
+
+ private:
+  // Wang's formula: the number of lines that keeps a degree-n curve within tolerance.
+  static int CurveLines(float secondDifference, float degreeFactor) {
+    float n = std::ceil(std::sqrt(degreeFactor * secondDifference / kFlattenTolerance));
+    return SkTPin(sk_float_saturate2int(n), 1, kMaxCurveLines);
+  }
+
+  void addQuad(const SkPoint pts[3]) {
+    const int n = CurveLines((pts[0] - pts[1] * 2 + pts[2]).length(), 2 * 1 / 8.0f);
+    SkPoint prev = pts[0];
+    for (int i = 1; i <= n; i++) {
+      SkPoint next = i == n ? pts[2] : SkEvalQuadAt(pts, (float)i / n);
+      this->addLine(prev, next);
+      prev = next;
+    }
+  }
+
+  void addCubic(const SkPoint pts[4]) {
+    const float dd = std::max((pts[0] - pts[1] * 2 + pts[2]).length(),
+                              (pts[1] - pts[2] * 2 + pts[3]).length());
+    const int n = CurveLines(dd, 3 * 2 / 8.0f);
+    SkPoint prev = pts[0];
+    for (int i = 1; i <= n; i++) {
+      SkPoint next = pts[3];
+      if (i < n) {
+        SkEvalCubicAt(pts, (float)i / n, &next, nullptr, nullptr);
+      }
+      this->addLine(prev, next);
+      prev = next;
+    }
+  }
+
+  // A contour's first and last chains meet at its starting point.  If they head the same way in
+  // y, they're one chain.
+  void finishContour() {
+    if (fFirstChain >= 0 && fChain != fFirstChain && fDir == fFirstDir) {
+      for (size_t i = fContourStart; i < fLines->size(); i++) {
+        if ((*fLines)[i].chain == fChain) {
+          (*fLines)[i].chain = fFirstChain;
+        }
+      }
+    }
+    fContourStart = fLines->size();
+    fFirstChain = -1;
+    fDir = 0;
+  }
+
+  void addLine(SkPoint p0, SkPoint p1) {
+    if (p0.fY == p1.fY) {
+      this->addHorizontal(p0.fY, std::min(p0.fX, p1.fX), std::max(p0.fX, p1.fX));
+      return;
+    }
+    float dir = 1;
+    if (p0.fY > p1.fY) {
+      std::swap(p0, p1);
+      dir = -1;
+    }
+    if (dir != fDir) {
+      fDir = dir;
+      fChain = fNextChain++;
+      if (fFirstChain < 0) {
+        fFirstChain = fChain;
+        fFirstDir = dir;
+      }
+    }
+
+    // Lines above or below the clip, and lines right of the clip, can't change the coverage of
+    // any pixel in the clip.
+    if (!(p0.fY < p1.fY) || p1.fY <= fClip.fTop || p0.fY >= fClip.fBottom ||
+        std::min(p0.fX, p1.fX) >= fClip.fRight) {
+      return;
+    }
+
+    const float dxdy = (p1.fX - p0.fX) / (p1.fY - p0.fY);
+    auto xAt = [&](float y) { return p0.fX + (y - p0.fY) * dxdy; };
+    if (p0.fY < fClip.fTop) {
+      p0 = {xAt(fClip.fTop), fClip.fTop};
+    }
+    if (p1.fY > fClip.fBottom) {
+      p1 = {xAt(fClip.fBottom), fClip.fBottom};
+    }
+
+    // Split where the line crosses the left or right clip edges.  Pieces left of the clip still
+    // contribute their winding to every pixel, so they become vertical lines on the left edge.
+    // Pieces right of the clip don't affect it at all.
+    float ys[4] = {p0.fY, 0, 0, p1.fY};
+    int count = 1;
+    for (float edge : {fClip.fLeft, fClip.fRight}) {
+      if (std::min(p0.fX, p1.fX) < edge && edge < std::max(p0.fX, p1.fX)) {
+        ys[count++] = SkTPin(p0.fY + (edge - p0.fX) / dxdy, p0.fY, p1.fY);
+      }
+    }
+    ys[count++] = p1.fY;
+    std::sort(ys + 1, ys + count - 1);
+
+    for (int i = 0; i + 1 < count; i++) {
+      const float top = ys[i], bottom = ys[i + 1];
+      if (!(top < bottom)) {
+        continue;
+      }
+      const float mid = xAt((top + bottom) * 0.5f);
+      if (mid >= fClip.fRight) {
+        continue;
+      }
+      if (mid <= fClip.fLeft) {
+        fLines->push_back({fClip.fLeft, top, fClip.fLeft, bottom, 0, dir, fChain});
+      } else {
+        const float x0 = SkTPin(xAt(top), fClip.fLeft, fClip.fRight),
+                    x1 = SkTPin(xAt(bottom), fClip.fLeft, fClip.fRight);
+        fLines->push_back({x0, top, x1, bottom, (x1 - x0) / (bottom - top), dir, fChain});
+      }
+    }
+  }
+
+  // Horizontal lines don't change the winding along a row, and don't break a chain.  But the
+  // winding changes across them, so where one passes through a pixel with another chain, the
+  // winding in the pixel takes more than two values.  They're kept as chains of their own that
+  // deposit no coverage, just to find those pixels.
+  void addHorizontal(float y, float x0, float x1) {
+    x0 = std::max(x0, fClip.fLeft);
+    x1 = std::min(x1, fClip.fRight);
+    if (fClip.fTop <= y && y < fClip.fBottom && x0 < x1) {
+      fLines->push_back({x0, y, x1, y, 0, 0, fNextChain++});
+    }
+  }
+
+  const SkRect fClip;
+  std::vector<Line>* fLines;
+
+  int fNextChain = 0;
+  int fChain = -1;
+  float fDir = 0;  // Of the current chain, or 0 at the start of a contour.
+  size_t fContourStart = 0;
+  int fFirstChain = -1;
+  float fFirstDir = 0;
+};
+
+// The alpha of each lane's winding, which may be fractional, from 0 to 255.
+SK_ALWAYS_INLINE skvx::int4 winding_to_alpha(skvx::float4 winding, bool evenOdd) {
+  // Adding 2^23 rounds a float in [0, 2^22) to an integer, leaving it in the low mantissa bits.
+  constexpr float kRound = 1 << 23;
+  skvx::float4 coverage = max(winding, -winding);
+  if (evenOdd) {
+    // The distance to the nearest even winding.
+    coverage -= 2 * ((coverage * 0.5f + kRound) - kRound);
+    coverage = max(coverage, -coverage);
+  }
+  return skvx::bit_pun<skvx::int4>(min(coverage, 1.0f) * 255 + kRound) & 0xFF;
+}
+
+// The coverage deposited by one strip's lines, binned into kTileWidth x kStripHeight tiles.
+// Only tiles that an edge passes through exist; most of a large path's strip falls between them.
+class Strip {
+ public:
+  Strip(int left, int right)
+      : fLeft(left)
+      , fRight(right)
+      , fTileOf(TileCount(left, right))
+      , fAlphas(kStripHeight * RowStride(left, right))
+      , fRuns(kStripHeight * RowStride(left, right)) {
+    sk_memset32(reinterpret_cast<uint32_t*>(fTileOf.get()), ~0u, TileCount(left, right));
+  }
+
+  // Deposits the coverage of the part of line between rows top and bottom, working out where it
+  // enters and leaves each row all at once.
+  void addLine(const Line& line, int top, int bottom) {
+    if (line.y0 == line.y1) {
+      const int row = (int)std::floor(line.y0) - top, right = (int)std::ceil(line.x1);
+      for (int x = (int)line.x0; x < right; x++) {
+        this->deposit(row, x, 0, line.chain);
+      }
+      return;
+    }
+    const skvx::float4 rowTop = top + skvx::float4{0, 1, 2, 3};
+    const skvx::float4 y0 = max(line.y0, rowTop), y1 = min(line.y1, min(rowTop + 1, bottom));
+    const skvx::float4 xmin = std::min(line.x0, line.x1), xmax = std::max(line.x0, line.x1);
+    const skvx::float4 x0 = pin(line.x0 + (y0 - line.y0) * line.dxdy, xmin, xmax),
+                       x1 = pin(line.x0 + (y1 - line.y0) * line.dxdy, xmin, xmax),
+                       d = (y1 - y0) * line.dir;
+    const skvx::int4 inRow = y0 < y1;
+    for (int row = 0; row < kStripHeight; row++) {
+      if (inRow[row]) {
+        this->addRow(row, x0[row], x1[row], d[row], line.chain);
+      }
+    }
+  }
+
+  // Sums the strip's deposits left to right and blits them.  lines are those the strip was
+  // built from, for pixels where the path crosses itself.  If forceRLE, rows are blitted whole,
+  // one after another.
+  void blit(
+      int top, int bottom, bool evenOdd, bool forceRLE, const std::vector<const Line*>& lines,
+      SkBlitter* blitter) {
+    if (fTiles.empty()) {
+      return;
+    }
+    std::sort(fOrder.begin(), fOrder.end());
+
+    // Sum all the rows at once, a column at a time, leaving each pixel's alpha in fAlphas.
+    skvx::float4 winding = 0;
+    for (int tx : fOrder) {
+      Tile& tile = fTiles[fTileOf[tx]];
+      const int x = fLeft + tx * kTileWidth;
+      skvx::int4 alphas = 0;  // A row to a lane, four pixels to a lane.
+      for (int i = 0; i < kTileWidth; i++) {
+        winding += tile.cover[i];
+        alphas |= winding_to_alpha(winding, evenOdd) << (8 * i);
+      }
+      for (int row = 0; row < kStripHeight; row++) {
+        sk_unaligned_store(this->alphas(row) + (x - fLeft), alphas[row]);
+      }
+      tile.winding = winding;
+      if (tile.complex) {
+        for (int row = 0; row < kStripHeight; row++) {
+          for (int i = 0; i < kTileWidth; i++) {
+            if ((tile.complex & CellBit(row, i)) && x + i < fRight) {
+              fComplex[row].push_back(x + i);
+            }
+          }
+        }
+      }
+    }
+    this->resolveComplex(top, bottom, evenOdd, lines);
+
+    // Blit the tiles' pixels, and the constant coverage between them.
+    RowRuns rows[kStripHeight];
+    auto flush = [&] {
+      for (int row = 0; row < bottom - top; row++) {
+        rows[row].blit(fLeft, top + row, this->alphas(row), this->runs(row), blitter);
+      }
+    };
+    for (size_t t = 0; t < fOrder.size(); t++) {
+      const int x = fLeft + fOrder[t] * kTileWidth;
+      const int tileRight = std::min(x + kTileWidth, fRight);
+      for (int row = 0; row < bottom - top; row++) {
+        for (int i = x; i < tileRight; i++) {
+          rows[row].add(i, 1, this->alphas(row)[i - fLeft], fLeft, this->alphas(row),
+                        this->runs(row));
+        }
+      }
+
+      const int gapRight =
+          t + 1 < fOrder.size() ? std::min(fLeft + fOrder[t + 1] * kTileWidth, fRight) : fRight;
+      if (tileRight >= gapRight) {
+        continue;
+      }
+      const skvx::int4 alpha = winding_to_alpha(fTiles[fTileOf[fOrder[t]]].winding, evenOdd);
+      const int rowCount = bottom - top;
+      bool solid = true, empty = true;
+      for (int row = 0; row < rowCount; row++) {
+        solid = solid && alpha[row] == 0xFF;
+        empty = empty && alpha[row] == 0;
+      }
+      if (!forceRLE && (solid || empty)) {
+        flush();
+        if (solid) {
+          blitter->blitRect(tileRight, top, gapRight - tileRight, rowCount);
+        }
+        continue;
+      }
+      for (int row = 0; row < rowCount; row++) {
+        rows[row].add(tileRight, gapRight - tileRight, alpha[row], fLeft, this->alphas(row),
+                      this->runs(row));
+      }
+    }
+    flush();
+    for (int tx : fOrder) {
+      fTileOf[tx] = -1;
+    }
+    fTiles.clear();
+    fOrder.clear();
+  }
+
+ private:
+  static constexpr int kTileShift = 2;
+  static constexpr int kTileWidth = 1 << kTileShift;
+
+  // Lines can deposit into the pixel just right of the one they end in, so one past right.
+  static int TileCount(int left, int right) { return ((right + 1 - left) >> kTileShift) + 1; }
+  // Room for whole tiles up to one past right.
+  static int RowStride(int left, int right) { return right - left + kTileWidth; }
+
+  static uint16_t CellBit(int row, int i) { return 1 << (row * kTileWidth + i); }
+
+  struct Tile {
+    skvx::float4 cover[kTileWidth];  // Each column's deposits, a row to a lane.
+    skvx::float4 winding;            // The winding just right of the tile, once summed.
+    int chain[kStripHeight][kTileWidth];  // The chain passing through each pixel, or -1.
+    uint16_t complex;  // CellBit()s of the pixels that more than one chain passes through.
+  };
+
+  // Accumulates a row of runs as they're added left to right, merging neighbors with the same
+  // alpha and trimming zeros at either end.
+  class RowRuns {
+   public:
+    void add(int x, int width, SkAlpha alpha, int left, SkAlpha alphas[], int16_t runs[]) {
+      if (fStart < 0) {
+        if (alpha == 0) {
+          return;
+        }
+        fStart = x;
+      } else if (alphas[fLast - left] == alpha && fLast + runs[fLast - left] == x) {
+        runs[fLast - left] += width;
+        return;
+      }
+      alphas[x - left] = alpha;
+      runs[x - left] = SkToS16(width);
+      fLast = x;
+    }
+
+    void blit(int left, int y, SkAlpha alphas[], int16_t runs[], SkBlitter* blitter) {
+      if (fStart < 0) {
+        return;
+      }
+      const int end = alphas[fLast - left] ? fLast + runs[fLast - left] : fLast;
+      runs[end - left] = 0;
+      blitter->blitAntiH(fStart, y, alphas + (fStart - left), runs + (fStart - left));
+      fStart = -1;
+    }
+
+   private:
+    int fStart = -1;  // Where the first nonzero run starts, or -1 if there hasn't been one.
+    int fLast = 0;    // Where the last run starts.
+  };
+
+  SkAlpha* alphas(int row) { return fAlphas.get() + row * RowStride(fLeft, fRight); }
+  int16_t* runs(int row) { return fRuns.get() + row * RowStride(fLeft, fRight); }
+
+  Tile& tileAt(int x) {
+    const int tx = (x - fLeft) >> kTileShift;
+    int& index = fTileOf[tx];
+    if (index < 0) {
+      index = SkToInt(fTiles.size());
+      fOrder.push_back(tx);
+      Tile& tile = fTiles.emplace_back();
+      std::fill(tile.cover, tile.cover + kTileWidth, skvx::float4(0));
+      sk_memset32(reinterpret_cast<uint32_t*>(tile.chain), ~0u, kStripHeight * kTileWidth);
+      tile.complex = 0;
+    }
+    return fTiles[index];
+  }
+
+  // Adds cover to pixel x.  If chain >= 0, the chain's line passes through the pixel; otherwise
+  // this just carries coverage to the pixels right of the line.
+  void deposit(int row, int x, float cover, int chain) {
+    Tile& tile = this->tileAt(x);
+    const int i = (x - fLeft) & (kTileWidth - 1);
+    tile.cover[i][row] += cover;
+    if (chain >= 0) {
+      int& cellChain = tile.chain[row][i];
+      if (cellChain < 0) {
+        cellChain = chain;
+      } else if (cellChain != chain) {
+        tile.complex |= CellBit(row, i);
+      }
+    }
+  }
+
+  // Deposits the coverage of the piece of a line from (x, y) to (xNext, y + dy) within one row.
+  // d is dy signed by the line's direction.  (This is font-rs's accumulate step.)
+  void addRow(int row, float x, float xNext, float d, int chain) {
+    const float x0 = std::min(x, xNext), x1 = std::max(x, xNext);
+    const float x0floor = std::floor(x0), x1ceil = std::ceil(x1);
+    const int x0i = (int)x0floor, x1i = (int)x1ceil;
+
+    if (x1i <= x0i + 1) {
+      // The line stays within one pixel.
+      const float xmf = 0.5f * (x + xNext) - x0floor;
+      this->deposit(row, x0i, d - d * xmf, chain);
+      this->deposit(row, x0i + 1, d * xmf, -1);
+      return;
+    }
+
+    const float s = 1 / (x1 - x0);
+    const float x0f = x0 - x0floor;
+    const float a0 = 0.5f * s * (1 - x0f) * (1 - x0f);
+    const float x1f = x1 - x1ceil + 1;
+    const float am = 0.5f * s * x1f * x1f;
+
+    this->deposit(row, x0i, d * a0, chain);
+    if (x1i == x0i + 2) {
+      this->deposit(row, x0i + 1, d * (1 - a0 - am), chain);
+    } else {
+      const float a1 = s * (1.5f - x0f);
+      this->deposit(row, x0i + 1, d * (a1 - a0), chain);
+      for (int xi = x0i + 2; xi < x1i - 1; xi++) {
+        this->deposit(row, xi, d * s, chain);
+      }
+      const float a2 = a1 + (x1i - x0i - 3) * s;
+      this->deposit(row, x1i - 1, d * (1 - a2 - am), chain);
+    }
+    this->deposit(row, x1i, d * am, -1);
+  }
+
+  // Recomputes the alphas of the pixels in fComplex, whose summed areas can't be trusted, from
+  // the exact coverage along kComplexSamples horizontal lines through each of them.
+  void resolveComplex(int top, int bottom, bool evenOdd, const std::vector<const Line*>& lines) {
+    bool anyComplex = false;
+    for (int row = 0; row < bottom - top; row++) {
+      anyComplex = anyComplex || !fComplex[row].empty();
+      fRowLines[row].clear();
+    }
+    if (!anyComplex) {
+      return;
+    }
+
+    // Most of the strip's lines miss a row's complex pixels, and just add their direction to the
+    // winding between the pixels they fall between, from their first sample to their last.  Sort
+    // the lines out for all the rows at once.
+    const skvx::float4 rowTop = top + skvx::float4{0, 1, 2, 3};
+    for (int row = 0; row < bottom - top; row++) {
+      fGapWindings[row].assign((fComplex[row].size() + 1) * (kComplexSamples + 1), 0);
+    }
+    for (const Line* line : lines) {
+      const skvx::float4 y0 = max(line->y0, rowTop), y1 = min(line->y1, rowTop + 1);
+      const skvx::float4 x0 = line->x0 + (y0 - line->y0) * line->dxdy,
+                         x1 = line->x0 + (y1 - line->y0) * line->dxdy;
+      const skvx::float4 xmin = min(x0, x1), xmax = max(x0, x1);
+      // The first sample at or below the line's top, and the one below its bottom.
+      const skvx::float4 first = (line->y0 - rowTop) * kComplexSamples - 0.5f,
+                         last = (line->y1 - rowTop) * kComplexSamples - 0.5f;
+      for (int row = 0; row < bottom - top; row++) {
+        const std::vector<int>& xs = fComplex[row];
+        if (xs.empty() || !(y0[row] < y1[row]) || xmin[row] >= xs.back() + 1) {
+          continue;
+        }
+        const int firstSample = SkTPin((int)std::ceil(first[row]), 0, kComplexSamples),
+                  lastSample = SkTPin((int)std::ceil(last[row]), 0, kComplexSamples);
+        const size_t k = upper_bound(xs, xmin[row]);
+        if ((k == 0 || xmin[row] >= xs[k - 1] + 1) && (k == xs.size() || xmax[row] < xs[k])) {
+          fGapWindings[row][firstSample * (xs.size() + 1) + k] += (int)line->dir;
+          fGapWindings[row][lastSample * (xs.size() + 1) + k] -= (int)line->dir;
+        } else {
+          fRowLines[row].push_back(
+              {line->x0 + (rowTop[row] + 0.5f / kComplexSamples - line->y0) * line->dxdy,
+               line->dxdy / kComplexSamples, xmin[row], xmax[row], firstSample, lastSample,
+               (int)line->dir});
+        }
+      }
+    }
+
+    for (int row = 0; row < bottom - top; row++) {
+      if (!fComplex[row].empty()) {
+        this->resolveComplexRow(row, evenOdd);
+        fComplex[row].clear();
+      }
+    }
+  }
+
+  // The number of xs at or left of x.
+  static size_t upper_bound(const std::vector<int>& xs, float x) {
+    return std::upper_bound(xs.begin(), xs.end(), x, [](float x, int left) { return x < left; }) -
+           xs.begin();
+  }
+
+  // Resolves one row's complex pixels, given the windings between them from fGapWindings.
+  void resolveComplexRow(int row, bool evenOdd) {
+    const std::vector<int>& xs = fComplex[row];
+    const size_t count = xs.size();
+    fCoverage.assign(count, 0);
+    fGaps.assign(count + 1, 0);
+    for (int sample = 0; sample < kComplexSamples; sample++) {
+      // fWindings[k] sums the crossings between pixels k - 1 and k; fCrossings are those inside
+      // the pixels.
+      const int* gapChanges = fGapWindings[row].data() + sample * (count + 1);
+      for (size_t k = 0; k < count; k++) {
+        fGaps[k] += gapChanges[k];
+      }
+      fWindings = fGaps;
+      fCrossings.clear();
+      for (const RowLine& line : fRowLines[row]) {
+        if (sample < line.first || sample >= line.last) {
+          continue;
+        }
+        const float x = SkTPin(line.x + sample * line.dx, line.xmin, line.xmax);
+        const size_t k = upper_bound(xs, x);
+        fWindings[k] += line.dir;
+        if (k > 0 && x < xs[k - 1] + 1) {
+          fCrossings.push_back({SkToInt(k - 1), x, line.dir});
+        }
+      }
+      std::sort(fCrossings.begin(), fCrossings.end(), [](const Crossing& a, const Crossing& b) {
+        return a.pixel < b.pixel || (a.pixel == b.pixel && a.x < b.x);
+      });
+
+      auto covered = [evenOdd](int winding) { return evenOdd ? winding & 1 : winding != 0; };
+      int winding = 0;
+      size_t c = 0;
+      for (size_t k = 0; k < count; k++) {
+        winding += fWindings[k];
+        int w = winding;
+        float x = xs[k], coverage = 0;
+        for (; c < fCrossings.size() && fCrossings[c].pixel == SkToInt(k); c++) {
+          coverage += covered(w) * (fCrossings[c].x - x);
+          x = fCrossings[c].x;
+          w += fCrossings[c].dir;
+        }
+        fCoverage[k] += coverage + covered(w) * (xs[k] + 1 - x);
+      }
+    }
+    for (size_t k = 0; k < count; k++) {
+      this->alphas(row)[xs[k] - fLeft] =
+          (SkAlpha)(std::min(fCoverage[k] / kComplexSamples, 1.0f) * 255 + 0.5f);
+    }
+  }
+
+  // A line crossing a row of complex pixels.
+  struct RowLine {
+    float x, dx;       // At the first sample, and from one sample to the next.
+    float xmin, xmax;  // Within the row.
+    int first, last;   // The samples it crosses.
+    int dir;
+  };
+
+  struct Crossing {
+    int pixel;  // Index into fComplex[row].
+    float x;
+    int dir;
+  };
+
+  const int fLeft, fRight;
+  SkAutoTMalloc<int> fTileOf;  // Index into fTiles of each tile in the strip, or -1.
+  std::vector<Tile> fTiles;
+  std::vector<int> fOrder;  // The tiles' indices into fTileOf, sorted left to right by blit().
+  SkAutoTMalloc<SkAlpha> fAlphas;  // kStripHeight rows of RowStride().
+  SkAutoTMalloc<int16_t> fRuns;
+
+  // Scratch for resolveComplex().
+  std::vector<int> fComplex[kStripHeight];  // Each row's pixels that chains overlap in, sorted.
+  std::vector<RowLine> fRowLines[kStripHeight];
+  // The change in the winding between each row's complex pixels at each sample, from lines that
+  // miss them: kComplexSamples + 1 rows of fComplex[row].size() + 1.
+  std::vector<int> fGapWindings[kStripHeight];
+  std::vector<int> fGaps;      // The sum of fGapWindings up to the current sample.
+  std::vector<int> fWindings;
+  std::vector<Crossing> fCrossings;
+  std::vector<float> fCoverage;
+};
+
+}  // namespace
+
+void SkScan::SparseStripFillPath(
+    const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR, const SkIRect& clipBounds,
+    bool forceRLE) {
+  SkASSERT(!path.isInverseFillType());
+  SkIRect bounds;
+  if (!bounds.intersect(pathIR, clipBounds)) {
+    return;
+  }
+
+  std::vector<Line> lines;
+  LineBuilder(bounds, &lines).addPath(path);
+  if (lines.empty()) {
+    return;
+  }
+  std::sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.y0 < b.y0; });
+
+  const bool evenOdd = path.getFillType() == SkPathFillType::kEvenOdd;
+  Strip strip(bounds.fLeft, bounds.fRight);
+  std::vector<const Line*> active;
+  size_t next = 0;
+  for (int top = bounds.fTop; top < bounds.fBottom;) {
+    if (active.empty()) {
+      if (next == lines.size()) {
+        break;
+      }
+      // Skip straight to the next line rather than sweeping through empty strips.
+      top = std::max(top, (int)std::floor(lines[next].y0));
+    }
+    const int bottom = std::min(top + kStripHeight, bounds.fBottom);
+    for (; next < lines.size() && lines[next].y0 < bottom; next++) {
+      active.push_back(&lines[next]);
+    }
+
+    for (const Line* line : active) {
+      strip.addLine(*line, top, bottom);
+    }
+    strip.blit(top, bottom, evenOdd, forceRLE, active, blitter);
+
+    top = bottom;
+    active.erase(
+        std::remove_if(
+            active.begin(), active.end(), [top](const Line* line) { return line->y1 <= top; }),
+        active.end());
+  }
+}
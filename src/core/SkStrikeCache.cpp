@@ -7,7 +7,9 @@
 
 #include "src/core/SkStrikeCache.h"
 
+#include <algorithm>
 #include <cctype>
+#include <vector>
 
 #include "include/core/SkGraphics.h"
 #include "include/core/SkRefCnt.h"
@@ -23,6 +25,85 @@
 
 bool gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental = false;
 
+namespace {
+// A tiny direct-mapped, per-thread memo of strikes, indexed by descriptor checksum. Entries
+// hold a ref, so every memo is registered with MemoRegistry, and a cache that removes strikes
+// clears them out of all threads' memos before letting go of fLock.
+struct ThreadStrikeMemo {
+  static constexpr int kSlots = 8;
+
+  struct Slot {
+    uint32_t fCacheID{0};
+    sk_sp<SkStrike> fStrike;
+  };
+
+  ThreadStrikeMemo();
+  ~ThreadStrikeMemo();
+
+  Slot& slotFor(const SkDescriptor& desc) { return fSlots[desc.getChecksum() % kSlots]; }
+
+  // Guards fSlots. Only ever contended while another thread is purging.
+  SkSpinlock fLock;
+  Slot fSlots[kSlots];
+};
+
+struct MemoRegistry {
+  SkMutex fLock;
+  std::vector<ThreadStrikeMemo*> fMemos SK_GUARDED_BY(fLock);
+};
+
+MemoRegistry& memo_registry() {
+  // Leaked, since threads may still exit and unregister during static destruction.
+  static auto* registry = new MemoRegistry;
+  return *registry;
+}
+
+ThreadStrikeMemo::ThreadStrikeMemo() {
+  MemoRegistry& registry = memo_registry();
+  SkAutoMutexExclusive lock{registry.fLock};
+  registry.fMemos.push_back(this);
+}
+
+ThreadStrikeMemo::~ThreadStrikeMemo() {
+  MemoRegistry& registry = memo_registry();
+  SkAutoMutexExclusive lock{registry.fLock};
+  registry.fMemos.erase(std::find(registry.fMemos.begin(), registry.fMemos.end(), this));
+}
+
+ThreadStrikeMemo& thread_strike_memo() {
+  static thread_local ThreadStrikeMemo memo;
+  return memo;
+}
+
+// Drops every thread's memo entries for strikes of cache cacheID that match forget.
+template <typename Fn>
+void forget_memoized_strikes(uint32_t cacheID, Fn&& forget) {
+  std::vector<sk_sp<SkStrike>> dropped;  // Unreffed once all locks are released.
+  MemoRegistry& registry = memo_registry();
+  SkAutoMutexExclusive lock{registry.fLock};
+  for (ThreadStrikeMemo* memo : registry.fMemos) {
+    SkAutoSpinlock memoLock{memo->fLock};
+    for (ThreadStrikeMemo::Slot& slot : memo->fSlots) {
+      if (slot.fCacheID == cacheID && forget(slot.fStrike.get())) {
+        dropped.push_back(std::move(slot.fStrike));
+        slot = ThreadStrikeMemo::Slot{};
+      }
+    }
+  }
+}
+
+uint32_t next_strike_cache_id() {
+  static std::atomic<uint32_t> nextID{1};
+  return nextID.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace
+
+SkStrikeCache::SkStrikeCache() : fUniqueID{next_strike_cache_id()} {}
+
+SkStrikeCache::~SkStrikeCache() {
+  forget_memoized_strikes(fUniqueID, [](const SkStrike*) { return true; });
+}
+
 SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
   if (gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental) {
     static thread_local auto* cache = new SkStrikeCache;
@@ -33,12 +114,17 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
+  if (sk_sp<SkStrike> strike = this->findStrikeInThreadMemo(strikeSpec.descriptor())) {
+    return strike;
+  }
+
   SkAutoMutexExclusive ac(fLock);
   sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
   if (strike == nullptr) {
     strike = this->internalCreateStrike(strikeSpec);
   }
   this->internalPurge();
+  this->memoizeStrike(strike);
   return strike;
 }
 
@@ -114,12 +200,53 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
+  if (sk_sp<SkStrike> strike = this->findStrikeInThreadMemo(desc)) {
+    return strike;
+  }
+
   SkAutoMutexExclusive ac(fLock);
   sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
   this->internalPurge();
+  if (result != nullptr) {
+    this->memoizeStrike(result);
+  }
   return result;
 }
 
+sk_sp<SkStrike> SkStrikeCache::findStrikeInThreadMemo(const SkDescriptor& desc) const {
+  if (fOverBudget.load(std::memory_order_relaxed)) {
+    return nullptr;  // Take the locked path, which purges.
+  }
+
+  ThreadStrikeMemo& memo = thread_strike_memo();
+  SkAutoSpinlock lock{memo.fLock};
+  ThreadStrikeMemo::Slot& slot = memo.slotFor(desc);
+  if (slot.fCacheID != fUniqueID || !(slot.fStrike->getDescriptor() == desc)) {
+    return nullptr;
+  }
+  // Moving the strike to the head of the LRU list needs fLock, so just leave a mark for
+  // internalPurge(). Check first to keep hot strikes' cache lines from bouncing between threads.
+  if (!slot.fStrike->fUsedSinceMoved.load(std::memory_order_relaxed)) {
+    slot.fStrike->fUsedSinceMoved.store(true, std::memory_order_relaxed);
+  }
+  return slot.fStrike;
+}
+
+void SkStrikeCache::memoizeStrike(const sk_sp<SkStrike>& strike) {
+  if (strike->fRemoved) {
+    return;  // Purged before we could even hand it out.
+  }
+  ThreadStrikeMemo& memo = thread_strike_memo();
+  SkAutoSpinlock lock{memo.fLock};
+  memo.slotFor(strike->getDescriptor()) = {fUniqueID, strike};
+}
+
+void SkStrikeCache::updateOverBudget() {
+  fOverBudget.store(
+      fTotalMemoryUsed > fCacheSizeLimit || fCacheCount > fCacheCountLimit,
+      std::memory_order_relaxed);
+}
+
 auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
   // Check head because it is likely the strike we are looking for.
   if (fHead != nullptr && fHead->getDescriptor() == desc) {
@@ -133,20 +260,25 @@ auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<
   }
   SkStrike* strikePtr = strikeHandle->get();
   SkASSERT(strikePtr != nullptr);
-  if (fHead != strikePtr) {
+  this->internalMoveToHead(strikePtr);
+  return sk_ref_sp(strikePtr);
+}
+
+void SkStrikeCache::internalMoveToHead(SkStrike* strike) {
+  strike->fUsedSinceMoved.store(false, std::memory_order_relaxed);
+  if (fHead != strike) {
     // Make most recently used
-    strikePtr->fPrev->fNext = strikePtr->fNext;
-    if (strikePtr->fNext != nullptr) {
-      strikePtr->fNext->fPrev = strikePtr->fPrev;
+    strike->fPrev->fNext = strike->fNext;
+    if (strike->fNext != nullptr) {
+      strike->fNext->fPrev = strike->fPrev;
     } else {
-      fTail = strikePtr->fPrev;
+      fTail = strike->fPrev;
     }
-    fHead->fPrev = strikePtr;
-    strikePtr->fNext = fHead;
-    strikePtr->fPrev = nullptr;
-    fHead = strikePtr;
+    fHead->fPrev = strike;
+    strike->fNext = fHead;
+    strike->fPrev = nullptr;
+    fHead = strike;
   }
-  return sk_ref_sp(strikePtr);
 }
 
 sk_sp<SkStrike> SkStrikeCache::createStrike(
@@ -243,6 +375,7 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
 
   // early exit
   if (!countNeeded && !bytesNeeded) {
+    this->updateOverBudget();
     return 0;
   }
 
@@ -255,8 +388,15 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
   while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
     SkStrike* prev = strike->fPrev;
 
-    // Only delete if the strike is not pinned.
-    if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
+    if (strike->fUsedSinceMoved.load(std::memory_order_relaxed)) {
+      // Found through a thread memo since it was last moved, so it isn't really this old.
+      // The walk reaches it again at the head, after everything that was truly unused.
+      this->internalMoveToHead(strike);
+      if (prev == nullptr) {
+        continue;  // It already was the head; look at it again now that it's unmarked.
+      }
+    } else if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
+      // Only delete if the strike is not pinned.
       bytesFreed += strike->fMemoryUsed;
       countFreed += 1;
       this->internalRemoveStrike(strike);
@@ -264,7 +404,12 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     strike = prev;
   }
 
+  if (countFreed) {
+    forget_memoized_strikes(fUniqueID, [](const SkStrike* strike) { return strike->fRemoved; });
+  }
+
   this->validate();
+  this->updateOverBudget();
 
 #ifdef SPEW_PURGE_STATUS
   if (countFreed) {
@@ -354,6 +499,7 @@ void SkStrike::updateDelta(size_t increase) {
     fMemoryUsed += increase;
     if (!fRemoved) {
       fStrikeCache->fTotalMemoryUsed += increase;
+      fStrikeCache->updateOverBudget();
     }
   }
 }
@@ -8,6 +8,7 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -162,11 +163,20 @@ class SkStrike final : public SkRefCnt, public SkStrikeForGPU {
   std::unique_ptr<SkStrikePinner> fPinner;
   size_t fMemoryUsed{sizeof(SkScalerCache)};
   bool fRemoved{false};
+  // Set by thread memo hits, which don't take the lock needed to move the strike in the LRU list.
+  std::atomic<bool> fUsedSinceMoved{false};
 };  // SkStrike
 
+// Lookups through findStrike() and findOrCreateStrike() first check a small per-thread memo
+// of recently used strikes, so threads drawing text with strikes they already hold do not
+// take fLock at all. Memo hits mark the strike as used, and internalPurge() moves marked
+// strikes to the head instead of evicting them. Strikes that leave the cache are cleared from
+// every thread's memo, and the memo is bypassed while the cache is over budget so that
+// purging still happens promptly.
 class SkStrikeCache final : public SkStrikeForGPUCacheInterface {
  public:
-  SkStrikeCache() = default;
+  SkStrikeCache();
+  ~SkStrikeCache() override;
 
   static SkStrikeCache* GlobalStrikeCache();
 
@@ -208,6 +218,7 @@ class SkStrikeCache final : public SkStrikeForGPUCacheInterface {
   // The following methods can only be called when mutex is already held.
   void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
   void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+  void internalMoveToHead(SkStrike* strike) SK_REQUIRES(fLock);
 
   // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
   // and attempt to purge caches to match.
@@ -217,6 +228,11 @@ class SkStrikeCache final : public SkStrikeForGPUCacheInterface {
   // A simple accounting of what each glyph cache reports and the strike cache total.
   void validate() const SK_REQUIRES(fLock);
 
+  // The lock-free front for findStrike() and findOrCreateStrike(); see SkStrikeCache.cpp.
+  sk_sp<SkStrike> findStrikeInThreadMemo(const SkDescriptor& desc) const;
+  void memoizeStrike(const sk_sp<SkStrike>& strike) SK_REQUIRES(fLock);
+  void updateOverBudget() SK_REQUIRES(fLock);
+
   void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
 
   mutable SkMutex fLock;
@@ -234,6 +250,10 @@ class SkStrikeCache final : public SkStrikeForGPUCacheInterface {
   size_t fTotalMemoryUsed SK_GUARDED_BY(fLock){0};
   int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
   int32_t fCacheCount SK_GUARDED_BY(fLock){0};
+
+  // Identifies this cache's entries in the thread memos.
+  const uint32_t fUniqueID;
+  std::atomic<bool> fOverBudget{false};
 };
 
 #endif  // SkStrikeCache_DEFINED
@@ -17,6 +17,7 @@
 #include "src/core/SkOpts.h"
 #include "src/core/SkStreamPriv.h"
 #include "src/core/SkVM.h"
+#include "src/core/SkVMJITCache.h"
 #include "src/utils/SkVMVisualizer.h"
 #include <algorithm>
 #include <atomic>
@@ -4684,8 +4685,40 @@ bool Program::jit(
   return true;
 }
 
+// Identifies the code Program::jit() will generate for these instructions, for SkVMJITCache.
+// We hash field by field, as OptimizedInstruction has padding we can't trust to be zeroed.
+static uint64_t jit_cache_key(
+    const std::vector<OptimizedInstruction>& instructions, const std::vector<int>& strides) {
+  uint32_t lo = SkOpts::hash(strides.data(), strides.size() * sizeof(int), 0),
+           hi = SkOpts::hash(strides.data(), strides.size() * sizeof(int), 1);
+  for (const OptimizedInstruction& inst : instructions) {
+    const int fields[] = {
+        (int)inst.op, inst.x,    inst.y,    inst.z,     inst.w,
+        inst.immA,    inst.immB, inst.immC, inst.death, inst.can_hoist,
+    };
+    lo = SkOpts::hash(fields, sizeof(fields), lo);
+    hi = SkOpts::hash(fields, sizeof(fields), hi);
+  }
+  return (uint64_t)hi << 32 | lo;
+}
+
 void Program::setupJIT(
     const std::vector<OptimizedInstruction>& instructions, const char* debug_name) {
+  SkVMJITCache* cache = SkVMJITCache::Global();
+  const bool useCache = cache->enabled() && !gSkVMJITViaDylib;
+  const uint64_t key = useCache ? jit_cache_key(instructions, fImpl->strides) : 0;
+  if (useCache) {
+    if (sk_sp<SkData> code = cache->find(key)) {
+      fImpl->jit_size = code->size();
+      void* jit_entry = alloc_jit_buffer(&fImpl->jit_size);
+      memcpy(jit_entry, code->data(), code->size());
+      remap_as_executable(jit_entry, fImpl->jit_size);
+      notify_vtune(debug_name, jit_entry, fImpl->jit_size);
+      fImpl->jit_entry.store(jit_entry);
+      return;
+    }
+  }
+
   // Assemble with no buffer to determine a.size() (the number of bytes we'll assemble)
   // and stack_hint/registers_used to feed forward into the next jit() call.
   Assembler a{nullptr};
@@ -4709,6 +4742,10 @@ void Program::setupJIT(
 
   notify_vtune(debug_name, jit_entry, fImpl->jit_size);
 
+  if (useCache) {
+    cache->add(key, jit_entry, a.size());
+  }
+
 #  if !defined(SK_BUILD_FOR_WIN)
   // For profiling and debugging, it's helpful to have this code loaded
   // dynamically rather than just jumping info fImpl->jit_entry.
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkVMJITCache.h"
+
+#include "include/core/SkMilestone.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkCpu.h"
+#include "src/core/SkOSFile.h"
+#include "src/core/SkOpts.h"
+
+#include <string.h>
+
+namespace {
+
+struct Header {
+  uint32_t magic, version, milestone, arch, features, padding;
+};
+
+struct Record {
+  uint64_t key;
+  uint32_t size, checksum;
+};
+
+Header expected_header() {
+  uint32_t features = 0;
+  for (int i = 0; i < 32; i++) {
+    if (SkCpu::Supports(1u << i)) {
+      features |= 1u << i;
+    }
+  }
+#if defined(__x86_64__) || defined(_M_X64)
+  const uint32_t arch = 1;
+#elif defined(__aarch64__)
+  const uint32_t arch = 2;
+#else
+  const uint32_t arch = 0;
+#endif
+  return {
+      SkSetFourByteTag('s', 'k', 'v', 'j'),
+      SkVMJITCache::kVersion,
+      SK_MILESTONE,
+      arch,
+      features,
+      0,
+  };
+}
+
+bool write_record(FILE* file, uint64_t key, const void* code, size_t size) {
+  Record rec = {key, SkToU32(size), SkOpts::hash(code, size)};
+  bool ok = sk_fwrite(&rec, sizeof(rec), file) == sizeof(rec) &&
+            sk_fwrite(code, size, file) == size;
+  sk_fflush(file);
+  return ok;
+}
+
+}  // namespace
+
+SkVMJITCache::~SkVMJITCache() {
+  SkAutoMutexExclusive lock(fMutex);
+  this->reset();
+}
+
+SkVMJITCache* SkVMJITCache::Global() {
+  static auto* cache = new SkVMJITCache;
+  return cache;
+}
+
+void SkVMJITCache::reset() {
+  fEnabled.store(false, std::memory_order_relaxed);
+  if (fAppend) {
+    sk_fclose(fAppend);
+    fAppend = nullptr;
+  }
+  fEntries.reset();
+  fFile.reset();
+}
+
+bool SkVMJITCache::setPath(const char* path) {
+  SkAutoMutexExclusive lock(fMutex);
+  this->reset();
+  if (!path) {
+    return true;
+  }
+
+  this->load(path);
+  if (!fAppend && !this->startFile(path)) {
+    this->reset();
+    return false;
+  }
+  fEnabled.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void SkVMJITCache::load(const char* path) {
+  sk_sp<SkData> file = SkData::MakeFromFileName(path);
+  const Header header = expected_header();
+  if (!file || file->size() < sizeof(Header) ||
+      0 != memcmp(file->data(), &header, sizeof(Header))) {
+    return;  // Missing, or written by some other build or CPU.  startFile() will start over.
+  }
+
+  const uint8_t* bytes = file->bytes();
+  size_t offset = sizeof(Header);
+  while (file->size() - offset >= sizeof(Record)) {
+    Record rec;
+    memcpy(&rec, bytes + offset, sizeof(Record));
+    if (rec.size > file->size() - offset - sizeof(Record) ||
+        rec.checksum != SkOpts::hash(bytes + offset + sizeof(Record), rec.size)) {
+      break;
+    }
+    fEntries.set(rec.key, SkData::MakeSubset(file.get(), offset + sizeof(Record), rec.size));
+    offset += sizeof(Record) + rec.size;
+  }
+
+  if (offset == file->size()) {
+    // The whole file is good, so we can keep it mapped and append to it.
+    fAppend = sk_fopen(path, kAppend_SkFILE_Flag);
+    if (fAppend) {
+      fFile = std::move(file);
+      return;
+    }
+  }
+
+  // Something was truncated or corrupt.  Copy out what we could read so startFile() can
+  // rewrite the file without pulling it out from under our mapping.
+  fEntries.foreach ([](uint64_t, sk_sp<SkData>* code) {
+    *code = SkData::MakeWithCopy((*code)->data(), (*code)->size());
+  });
+}
+
+bool SkVMJITCache::startFile(const char* path) {
+  fFile.reset();
+  fAppend = sk_fopen(path, kWrite_SkFILE_Flag);
+  if (!fAppend) {
+    return false;
+  }
+
+  const Header header = expected_header();
+  if (sk_fwrite(&header, sizeof(header), fAppend) != sizeof(header)) {
+    return false;
+  }
+  bool ok = true;
+  fEntries.foreach ([&](uint64_t key, sk_sp<SkData>* code) {
+    ok = ok && write_record(fAppend, key, (*code)->data(), (*code)->size());
+  });
+  return ok;
+}
+
+sk_sp<SkData> SkVMJITCache::find(uint64_t key) {
+  if (!this->enabled()) {
+    return nullptr;
+  }
+  SkAutoMutexExclusive lock(fMutex);
+  if (sk_sp<SkData>* code = fEntries.find(key)) {
+    fHits.fetch_add(1, std::memory_order_relaxed);
+    return *code;
+  }
+  fMisses.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+void SkVMJITCache::add(uint64_t key, const void* code, size_t size) {
+  if (!this->enabled()) {
+    return;
+  }
+  SkAutoMutexExclusive lock(fMutex);
+  if (!fAppend || fEntries.find(key)) {
+    return;
+  }
+  fEntries.set(key, SkData::MakeWithCopy(code, size));
+  if (!write_record(fAppend, key, code, size)) {
+    // Stop writing rather than leave a torn record for the next run to skip over.
+    sk_fclose(fAppend);
+    fAppend = nullptr;
+  }
+}
+
+int SkVMJITCache::count() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fEntries.count();
+}
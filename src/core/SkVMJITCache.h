@@ -0,0 +1,68 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkVMJITCache_DEFINED
+#define SkVMJITCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkThreadAnnotations.h"
+
+#include <atomic>
+#include <stdio.h>
+
+// A persistent cache of machine code generated by skvm::Program's JIT, so a process doesn't have
+// to re-assemble the same programs every time it starts up.
+//
+// The cache file starts with a header identifying the Skia milestone, JIT version, architecture,
+// and CPU features it was written for, followed by records of {key, size, checksum, code}.  The
+// file is memory-mapped when opened, and a header mismatch starts the file over.  Each record's
+// code is checksummed, and we stop reading at the first truncated or corrupt record.  New code is
+// appended to the file as it's JITted.
+//
+// Keys are hashes of a Program's optimized instructions and argument strides; see SkVM.cpp.
+// JITted code is position-independent, so cached code can be copied into any executable buffer.
+class SkVMJITCache {
+ public:
+  SkVMJITCache() = default;
+  ~SkVMJITCache();
+
+  static SkVMJITCache* Global();
+
+  // Start using the cache file at path, loading any valid entries already there.
+  // Pass nullptr to stop using a cache file.  Returns false if path can't be written.
+  bool setPath(const char* path);
+  bool enabled() const { return fEnabled.load(std::memory_order_relaxed); }
+
+  // Returns the cached code for this key, or nullptr.  Counts a hit or miss.
+  sk_sp<SkData> find(uint64_t key);
+  // Remember this code for key, and append it to the cache file.
+  void add(uint64_t key, const void* code, size_t size);
+
+  int hitCount() const { return fHits.load(std::memory_order_relaxed); }
+  int missCount() const { return fMisses.load(std::memory_order_relaxed); }
+  int count() const;
+
+  // Bump this whenever Program::jit() changes the code it generates.
+  static constexpr uint32_t kVersion = 1;
+
+ private:
+  void reset() SK_REQUIRES(fMutex);
+  void load(const char* path) SK_REQUIRES(fMutex);
+  bool startFile(const char* path) SK_REQUIRES(fMutex);
+
+  mutable SkMutex fMutex;
+  SkTHashMap<uint64_t, sk_sp<SkData>> fEntries SK_GUARDED_BY(fMutex);
+  sk_sp<SkData> fFile SK_GUARDED_BY(fMutex);  // The memory-mapped file the entries came from.
+  FILE* fAppend SK_GUARDED_BY(fMutex) = nullptr;
+
+  std::atomic<bool> fEnabled{false};
+  std::atomic<int> fHits{0}, fMisses{0};
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include "src/gpu/ganesh/GrThreadSafeCache.h"
 #include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h"
 #include "src/gpu/ganesh/effects/GrSkSLFP.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/image/SkSurface_Gpu.h"
 
 #ifdef SK_VULKAN
@@ -42,6 +43,9 @@ void GrContextThreadSafeProxy::init(
   fCaps = std::move(caps);
   fTextBlobRedrawCoordinator = std::make_unique<sktext::gpu::TextBlobRedrawCoordinator>(fContextID);
   fThreadSafeCache = std::make_unique<GrThreadSafeCache>();
+  if (size_t byteLimit = fOptions.fTriangulatorCacheByteLimit) {
+    fTriangulatorCache = std::make_unique<GrTriangulatorCache>(byteLimit);
+  }
   fPipelineBuilder = std::move(pipelineBuilder);
 }
 
@@ -44,6 +44,10 @@ class GrContextThreadSafeProxyPriv {
   GrThreadSafeCache* threadSafeCache() { return fProxy->fThreadSafeCache.get(); }
   const GrThreadSafeCache* threadSafeCache() const { return fProxy->fThreadSafeCache.get(); }
 
+  // Null unless GrContextOptions::fTriangulatorCacheByteLimit is set.
+  GrTriangulatorCache* triangulatorCache() { return fProxy->fTriangulatorCache.get(); }
+  const GrTriangulatorCache* triangulatorCache() const { return fProxy->fTriangulatorCache.get(); }
+
   void abandonContext() { fProxy->abandonContext(); }
   bool abandoned() const { return fProxy->abandoned(); }
 
@@ -24,6 +24,7 @@
 #include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h"
 #include "src/gpu/ganesh/SurfaceContext.h"
 #include "src/gpu/ganesh/effects/GrSkSLFP.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/gpu/ganesh/mock/GrMockGpu.h"
 #include "src/gpu/ganesh/text/GrAtlasManager.h"
 #include "src/image/SkImage_GpuBase.h"
@@ -852,6 +853,16 @@ bool GrDirectContext::precompileShader(const SkData& key, const SkData& data) {
   return fGpu->precompileShader(key, data);
 }
 
+sk_sp<SkData> GrDirectContext::serializeTriangulatorCache() const {
+  const GrTriangulatorCache* cache = fThreadSafeProxy->priv().triangulatorCache();
+  return cache ? cache->serialize() : nullptr;
+}
+
+bool GrDirectContext::loadTriangulatorCache(const SkData& data) {
+  GrTriangulatorCache* cache = this->triangulatorCache();
+  return cache && cache->deserialize(data.data(), data.size());
+}
+
 #ifdef SK_ENABLE_DUMP_GPU
 #  include "include/core/SkString.h"
 #  include "src/utils/SkJSONWriter.h"
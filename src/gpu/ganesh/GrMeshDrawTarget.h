@@ -13,6 +13,7 @@
 
 class GrAtlasManager;
 class GrThreadSafeCache;
+class GrTriangulatorCache;
 
 namespace skgpu {
 namespace v1 {
@@ -137,6 +138,8 @@ class GrMeshDrawTarget {
   virtual GrLoadOp colorLoadOp() const = 0;
 
   virtual GrThreadSafeCache* threadSafeCache() const = 0;
+  // Null unless GrContextOptions::fTriangulatorCacheByteLimit is set.
+  virtual GrTriangulatorCache* triangulatorCache() const = 0;
   virtual GrResourceProvider* resourceProvider() const = 0;
   uint32_t contextUniqueID() const;
 
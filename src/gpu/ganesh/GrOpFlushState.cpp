@@ -37,6 +37,10 @@ GrThreadSafeCache* GrOpFlushState::threadSafeCache() const {
   return fGpu->getContext()->priv().threadSafeCache();
 }
 
+GrTriangulatorCache* GrOpFlushState::triangulatorCache() const {
+  return fGpu->getContext()->priv().triangulatorCache();
+}
+
 void GrOpFlushState::executeDrawsAndUploadsForMeshDrawOp(
     const GrOp* op, const SkRect& chainBounds, const GrPipeline* pipeline,
     const GrUserStencilSettings* userStencilSettings) {
@@ -170,6 +170,7 @@ class GrOpFlushState final : public GrDeferredUploadTarget, public GrMeshDrawTar
   GrDeferredUploadTarget* deferredUploadTarget() final { return this; }
   const GrCaps& caps() const final;
   GrThreadSafeCache* threadSafeCache() const final;
+  GrTriangulatorCache* triangulatorCache() const final;
   GrResourceProvider* resourceProvider() const final { return fResourceProvider; }
 
   sktext::gpu::StrikeCache* strikeCache() const final;
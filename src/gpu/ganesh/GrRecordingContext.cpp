@@ -144,6 +144,10 @@ const GrThreadSafeCache* GrRecordingContext::threadSafeCache() const {
   return fThreadSafeProxy->priv().threadSafeCache();
 }
 
+GrTriangulatorCache* GrRecordingContext::triangulatorCache() {
+  return fThreadSafeProxy->priv().triangulatorCache();
+}
+
 void GrRecordingContext::addOnFlushCallbackObject(GrOnFlushCallbackObject* onFlushCBObject) {
   this->drawingManager()->addOnFlushCallbackObject(onFlushCBObject);
 }
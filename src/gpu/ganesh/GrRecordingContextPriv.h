@@ -60,6 +60,9 @@ class GrRecordingContextPriv : public GrImageContextPriv {
 
   GrThreadSafeCache* threadSafeCache() { return this->context()->threadSafeCache(); }
 
+  // Null unless GrContextOptions::fTriangulatorCacheByteLimit is set.
+  GrTriangulatorCache* triangulatorCache() { return this->context()->triangulatorCache(); }
+
   void moveRenderTasksToDDL(SkDeferredDisplayList*);
 
   /**
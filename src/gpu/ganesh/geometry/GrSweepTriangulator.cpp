@@ -0,0 +1,1152 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/geometry/GrSweepTriangulator.h"
+
+#include "include/core/SkSpan.h"
+#include "include/utils/SkRandom.h"
+#include "src/gpu/ganesh/GrEagerVertexAllocator.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
+namespace {
+
+constexpr int kNull = -1;
+
+// Rounding the vertices made by one round of splits can make new intersections, though it rarely
+// does more than once. Give up after this many rounds.
+constexpr int kMaxSplitRounds = 4;
+
+bool sweep_lt(float ax, float ay, float bx, float by) { return ay < by || (ay == by && ax < bx); }
+
+// Positive if c is left of the line through a and b, looking from a to b with b below a.
+double orient(double ax, double ay, double bx, double by, double cx, double cy) {
+  return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+bool opposite_sides(double a, double b) { return (a < 0 && b > 0) || (a > 0 && b < 0); }
+
+// The active edges of a sweep, left to right, in a treap: a binary tree kept balanced by random
+// priorities. Edges are placed by position rather than by a comparator, since only the sweep knows
+// how to order the edges that meet at its current point. For the same reason, edges that swap
+// places just trade nodes, without changing the tree.
+class ActiveEdges {
+ public:
+  void reset(int edgeCount) {
+    fNode.assign(edgeCount, kNull);
+    fEdge.clear();
+    fLeft.clear();
+    fRight.clear();
+    fParent.clear();
+    fPriority.clear();
+    fFreeNodes.clear();
+    fRoot = kNull;
+  }
+
+  // Makes room for a new edge, numbered after the others.
+  void addEdge() { fNode.push_back(kNull); }
+
+  bool empty() const { return fRoot == kNull; }
+  bool contains(int edge) const { return fNode[edge] != kNull; }
+  int first() const { return fRoot == kNull ? kNull : fEdge[this->leftmost(fRoot)]; }
+
+  int next(int edge) const {
+    int node = this->nextNode(fNode[edge]);
+    return node == kNull ? kNull : fEdge[node];
+  }
+
+  int prev(int edge) const {
+    int node = fNode[edge];
+    if (fLeft[node] != kNull) {
+      return fEdge[this->rightmost(fLeft[node])];
+    }
+    int parent = fParent[node];
+    for (; parent != kNull && fLeft[parent] == node; parent = fParent[parent]) {
+      node = parent;
+    }
+    return parent == kNull ? kNull : fEdge[parent];
+  }
+
+  // Inserts 'edge' just right of 'prev', or leftmost if 'prev' is kNull.
+  void insertAfter(int prev, int edge) {
+    SkASSERT(!this->contains(edge));
+    int node = this->newNode(edge);
+    if (fRoot == kNull) {
+      fRoot = node;
+      return;
+    }
+    int parent;
+    if (prev == kNull) {
+      parent = this->leftmost(fRoot);
+      fLeft[parent] = node;
+    } else if (fRight[fNode[prev]] == kNull) {
+      parent = fNode[prev];
+      fRight[parent] = node;
+    } else {
+      parent = this->leftmost(fRight[fNode[prev]]);
+      fLeft[parent] = node;
+    }
+    fParent[node] = parent;
+    while (fParent[node] != kNull && fPriority[fParent[node]] < fPriority[node]) {
+      this->rotateUp(node);
+    }
+  }
+
+  void remove(int edge) {
+    int node = fNode[edge];
+    while (fLeft[node] != kNull || fRight[node] != kNull) {
+      int left = fLeft[node], right = fRight[node];
+      bool leftUp = right == kNull || (left != kNull && fPriority[left] > fPriority[right]);
+      this->rotateUp(leftUp ? left : right);
+    }
+    this->replaceChild(fParent[node], node, kNull);
+    fNode[edge] = kNull;
+    fFreeNodes.push_back(node);
+  }
+
+  // Puts 'newEdge' in the place of 'oldEdge', which leaves.
+  void replace(int oldEdge, int newEdge) {
+    int node = fNode[oldEdge];
+    fEdge[node] = newEdge;
+    fNode[newEdge] = node;
+    fNode[oldEdge] = kNull;
+  }
+
+  // Puts 'edges', which are adjacent, starting with 'first', in the given order instead.
+  void reorder(int first, const std::vector<int>& edges) {
+    int node = fNode[first];
+    for (int edge : edges) {
+      fEdge[node] = edge;
+      fNode[edge] = node;
+      node = this->nextNode(node);
+    }
+  }
+
+  // Returns the rightmost edge that 'isRightOfPoint' is false for, i.e. the edge just left of the
+  // point, or kNull.
+  template <typename Fn>
+  int findLeftOf(Fn isRightOfPoint) const {
+    int found = kNull;
+    for (int node = fRoot; node != kNull;) {
+      if (isRightOfPoint(fEdge[node])) {
+        node = fLeft[node];
+      } else {
+        found = node;
+        node = fRight[node];
+      }
+    }
+    return found == kNull ? kNull : fEdge[found];
+  }
+
+ private:
+  int newNode(int edge) {
+    int node;
+    if (!fFreeNodes.empty()) {
+      node = fFreeNodes.back();
+      fFreeNodes.pop_back();
+    } else {
+      node = SkToInt(fEdge.size());
+      fEdge.push_back(edge);
+      fLeft.push_back(kNull);
+      fRight.push_back(kNull);
+      fParent.push_back(kNull);
+      fPriority.push_back(0);
+    }
+    fEdge[node] = edge;
+    fLeft[node] = fRight[node] = fParent[node] = kNull;
+    fPriority[node] = fRandom.nextU();
+    fNode[edge] = node;
+    return node;
+  }
+
+  int nextNode(int node) const {
+    if (fRight[node] != kNull) {
+      return this->leftmost(fRight[node]);
+    }
+    int parent = fParent[node];
+    for (; parent != kNull && fRight[parent] == node; parent = fParent[parent]) {
+      node = parent;
+    }
+    return parent;
+  }
+
+  int leftmost(int node) const {
+    while (fLeft[node] != kNull) {
+      node = fLeft[node];
+    }
+    return node;
+  }
+
+  int rightmost(int node) const {
+    while (fRight[node] != kNull) {
+      node = fRight[node];
+    }
+    return node;
+  }
+
+  void replaceChild(int parent, int oldChild, int newChild) {
+    if (parent == kNull) {
+      fRoot = newChild;
+    } else if (fLeft[parent] == oldChild) {
+      fLeft[parent] = newChild;
+    } else {
+      fRight[parent] = newChild;
+    }
+    if (newChild != kNull) {
+      fParent[newChild] = parent;
+    }
+  }
+
+  // Moves 'node' above its parent.
+  void rotateUp(int node) {
+    int parent = fParent[node];
+    this->replaceChild(fParent[parent], parent, node);
+    if (fLeft[parent] == node) {
+      fLeft[parent] = fRight[node];
+      if (fLeft[parent] != kNull) {
+        fParent[fLeft[parent]] = parent;
+      }
+      fRight[node] = parent;
+    } else {
+      fRight[parent] = fLeft[node];
+      if (fRight[parent] != kNull) {
+        fParent[fRight[parent]] = parent;
+      }
+      fLeft[node] = parent;
+    }
+    fParent[parent] = node;
+  }
+
+  std::vector<int> fNode;  // By edge.
+  std::vector<int> fEdge, fLeft, fRight, fParent;
+  std::vector<uint32_t> fPriority;
+  std::vector<int> fFreeNodes;
+  int fRoot = kNull;
+  SkRandom fRandom;
+};
+
+}  // namespace
+
+// Vertices and edges, each as parallel arrays. Once sorted, a vertex's index is its place in sweep
+// order, and each edge runs from its top (lower index) to its bottom.
+class GrSweepTriangulator::Mesh {
+ public:
+  enum class Result { kFailed, kFoundIntersection, kSuccess };
+
+  explicit Mesh(const GrSweepTriangulator* triangulator) : fTriangulator(triangulator) {}
+
+  // Stage 2: Builds an edge between each pair of consecutive points, then sorts the vertices.
+  void addContours(const std::vector<SkPoint>& points, const std::vector<int>& contourEnds);
+
+  // Stage 3: Triangulates the filled regions into 'triangles', three points each, splitting edges
+  // where they cross on the way. Stops if it comes to edges that meet some other way, or if
+  // rounding a crossing puts it out of order.
+  Result triangulate(std::vector<SkPoint>* triangles);
+
+  // Stage 4: Splits the edges at every intersection, before trying stage 3 again.
+  void simplify();
+
+ private:
+  enum class Chain { kNone, kLeft, kRight };
+
+  // A monotone polygon being triangulated: its vertices not yet cut off, oldest first. All but
+  // the first are on one chain, which is reflex.
+  struct Monotone {
+    std::vector<int> fStack;
+    Chain fChain;
+  };
+
+  struct Split {
+    int fEdge;
+    int fVertex;
+  };
+
+  struct Crossing {
+    float fX, fY;
+    int fLeft, fRight;
+    // For std::priority_queue, which keeps its greatest element on top.
+    bool operator<(const Crossing& other) const {
+      return sweep_lt(other.fX, other.fY, fX, fY);
+    }
+  };
+
+  int addVertex(float x, float y) {
+    fX.push_back(x);
+    fY.push_back(y);
+    return SkToInt(fX.size()) - 1;
+  }
+
+  void addEdge(int from, int to, int winding) {
+    fTop.push_back(from);
+    fBottom.push_back(to);
+    fWinding.push_back(winding);
+  }
+
+  // Sorts and merges the vertices, of which the first 'sortedCount' are in order already, and
+  // likely the rest too. Then orients and merges the edges to match.
+  void sortVertices(int sortedCount);
+
+  double orientToEdge(int edge, float x, float y) const {
+    return orient(fX[fTop[edge]], fY[fTop[edge]], fX[fBottom[edge]], fY[fBottom[edge]], x, y);
+  }
+
+  double orientToEdge(int edge, int v) const { return this->orientToEdge(edge, fX[v], fY[v]); }
+
+  // Whether the point is strictly between the ends of the edge in sweep order.
+  bool insideEdge(int edge, float x, float y) const {
+    return sweep_lt(fX[fTop[edge]], fY[fTop[edge]], x, y) &&
+           sweep_lt(x, y, fX[fBottom[edge]], fY[fBottom[edge]]);
+  }
+
+  bool insideEdge(int edge, int v) const { return this->insideEdge(edge, fX[v], fY[v]); }
+
+  // Whether edge a is left of edge b just below a point that both pass through.
+  bool leftBelow(int a, int b) const {
+    double adx = (double)fX[fBottom[a]] - fX[fTop[a]], ady = (double)fY[fBottom[a]] - fY[fTop[a]];
+    double bdx = (double)fX[fBottom[b]] - fX[fTop[b]], bdy = (double)fY[fBottom[b]] - fY[fTop[b]];
+    double cross = adx * bdy - ady * bdx;
+    return cross < 0 || (cross == 0 && a < b);
+  }
+
+  int edgeLeftOf(int v) const {
+    return fActive.findLeftOf([&](int edge) { return this->orientToEdge(edge, v) > 0; });
+  }
+
+  // Whether the edges cross, overlap, or one passes through an end of the other.
+  bool intersects(int a, int b) const;
+
+  // Where edges a and b cross, rounded, and moved onto the end of either if rounding put it past
+  // that end. Sets 'end' to that vertex, or kNull.
+  SkPoint crossingPoint(int a, int b, int* end) const;
+
+  // The triangulation sweep. 'in' and 'out' are the edges ending and starting at v, the latter
+  // left to right.
+  Result triangulateVertex(int v, SkSpan<const int> in, SkSpan<const int> out);
+  bool findEndingEdges(int v, SkSpan<const int> in, int* first, int* last) const;
+  // Checks edges that just became neighbors, left then right, and queues their crossing if they
+  // cross.
+  Result queueCrossing(int left, int right);
+  // Splits the edges of a crossing that the sweep has reached, and triangulates the new vertex.
+  Result crossAndTriangulate(const Crossing&);
+  int newMonotone(int v);
+  void addToMonotone(int monotone, int v, Chain);
+  void closeMonotone(int monotone, int v);
+  void emitTriangle(int a, int b, int c);
+
+  // The Bentley-Ottmann sweep.
+  void intersectVertex(int v);
+  void crossEdges();
+  void checkPair(int left, int right);
+  bool splitAtVertex(int edge, int v);
+  // Splits the edges at the vertices that the sweep made, from 'sortedCount' on.
+  void splitEdges(int sortedCount);
+
+  const GrSweepTriangulator* const fTriangulator;
+
+  std::vector<float> fX, fY;
+  std::vector<int> fTop, fBottom, fWinding;
+  // The edges starting at vertex v are fOutEdges[fFirstOut[v]..fFirstOut[v + 1]), left to right.
+  // Likewise for the edges ending at v, in no particular order.
+  std::vector<int> fFirstOut, fOutEdges;
+  std::vector<int> fFirstIn, fInEdges;
+
+  ActiveEdges fActive;
+
+  // Triangulation. Each gap between active edges is known by the edge on its left.
+  std::vector<int> fGapWinding;
+  std::vector<int> fGapMonotone;
+  // Below a merge vertex, the gap holds the polygons from either side of it until the next vertex
+  // in the gap connects to it. This is the right one.
+  std::vector<int> fGapMergeMonotone;
+  std::vector<Monotone> fMonotones;
+  std::vector<int> fFreeMonotones;
+  std::vector<SkPoint>* fTriangles = nullptr;
+  // Vertices from fSortedCount on are crossings the triangulation sweep made. Each has two edges
+  // in and two out, in fCrossingEdges.
+  int fSortedCount;
+  std::vector<int> fCrossingEdges;
+
+  // Intersection finding, for both sweeps.
+  float fSweepX, fSweepY;
+  std::priority_queue<Crossing> fCrossings;
+  std::vector<Split> fSplits;
+  std::vector<int> fGroup, fRun;  // Edges to reorder at the sweep point.
+  std::vector<int> fMarks;
+  int fMark = 0;
+};
+
+void GrSweepTriangulator::Mesh::addContours(
+    const std::vector<SkPoint>& points, const std::vector<int>& contourEnds) {
+  fX.reserve(points.size());
+  fY.reserve(points.size());
+  for (const SkPoint& p : points) {
+    fX.push_back(p.fX);
+    fY.push_back(p.fY);
+  }
+  int start = 0;
+  for (int end : contourEnds) {
+    for (int i = start; i < end; ++i) {
+      this->addEdge(i == start ? end - 1 : i - 1, i, 1);
+    }
+    start = end;
+  }
+  this->sortVertices(0);
+}
+
+void GrSweepTriangulator::Mesh::sortVertices(int sortedCount) {
+  int vertexCount = SkToInt(fX.size());
+  std::vector<int> order(vertexCount);
+  std::iota(order.begin(), order.end(), 0);
+  auto lessThan = [this](int a, int b) { return sweep_lt(fX[a], fY[a], fX[b], fY[b]); };
+  if (!std::is_sorted(order.begin() + sortedCount, order.end(), lessThan)) {
+    std::sort(order.begin() + sortedCount, order.end(), lessThan);
+  }
+  std::inplace_merge(order.begin(), order.begin() + sortedCount, order.end(), lessThan);
+  std::vector<int> remap(vertexCount);
+  std::vector<float> xs, ys;
+  xs.reserve(vertexCount);
+  ys.reserve(vertexCount);
+  for (int i : order) {
+    if (xs.empty() || fX[i] != xs.back() || fY[i] != ys.back()) {
+      xs.push_back(fX[i]);
+      ys.push_back(fY[i]);
+    }
+    remap[i] = SkToInt(xs.size()) - 1;
+  }
+  fX.swap(xs);
+  fY.swap(ys);
+  vertexCount = SkToInt(fX.size());
+
+  // Point each edge down and bucket the edges by top.
+  fFirstOut.assign(vertexCount + 1, 0);
+  for (size_t e = 0; e < fTop.size(); ++e) {
+    int top = remap[fTop[e]], bottom = remap[fBottom[e]];
+    if (top > bottom) {
+      std::swap(top, bottom);
+      fWinding[e] = -fWinding[e];
+    }
+    fTop[e] = top;
+    fBottom[e] = bottom;
+    if (top != bottom) {
+      ++fFirstOut[top + 1];
+    }
+  }
+  std::partial_sum(fFirstOut.begin(), fFirstOut.end(), fFirstOut.begin());
+  std::vector<int> byTop(fFirstOut.back());
+  std::vector<int> cursor(fFirstOut.begin(), fFirstOut.end() - 1);
+  for (size_t e = 0; e < fTop.size(); ++e) {
+    if (fTop[e] != fBottom[e]) {
+      byTop[cursor[fTop[e]]++] = SkToInt(e);
+    }
+  }
+
+  // Sum the windings of edges between the same vertices. Edges whose windings cancel out don't
+  // bound anything.
+  std::vector<int> tops, bottoms, windings;
+  tops.reserve(byTop.size());
+  bottoms.reserve(byTop.size());
+  windings.reserve(byTop.size());
+  for (int v = 0; v < vertexCount; ++v) {
+    auto begin = byTop.begin() + fFirstOut[v], end = byTop.begin() + fFirstOut[v + 1];
+    std::sort(begin, end, [this](int a, int b) { return fBottom[a] < fBottom[b]; });
+    fFirstOut[v] = SkToInt(tops.size());
+    for (auto e = begin; e != end;) {
+      int bottom = fBottom[*e];
+      int winding = 0;
+      for (; e != end && fBottom[*e] == bottom; ++e) {
+        winding += fWinding[*e];
+      }
+      if (winding != 0) {
+        tops.push_back(v);
+        bottoms.push_back(bottom);
+        windings.push_back(winding);
+      }
+    }
+  }
+  fFirstOut[vertexCount] = SkToInt(tops.size());
+  fTop.swap(tops);
+  fBottom.swap(bottoms);
+  fWinding.swap(windings);
+  int edgeCount = SkToInt(fTop.size());
+
+  fOutEdges.resize(edgeCount);
+  std::iota(fOutEdges.begin(), fOutEdges.end(), 0);
+  for (int v = 0; v < vertexCount; ++v) {
+    if (fFirstOut[v + 1] - fFirstOut[v] > 1) {
+      std::sort(
+          fOutEdges.begin() + fFirstOut[v], fOutEdges.begin() + fFirstOut[v + 1],
+          [this](int a, int b) { return this->leftBelow(a, b); });
+    }
+  }
+  fFirstIn.assign(vertexCount + 1, 0);
+  for (int e = 0; e < edgeCount; ++e) {
+    ++fFirstIn[fBottom[e] + 1];
+  }
+  std::partial_sum(fFirstIn.begin(), fFirstIn.end(), fFirstIn.begin());
+  fInEdges.resize(edgeCount);
+  cursor.assign(fFirstIn.begin(), fFirstIn.end() - 1);
+  for (int e = 0; e < edgeCount; ++e) {
+    fInEdges[cursor[fBottom[e]]++] = e;
+  }
+}
+
+bool GrSweepTriangulator::Mesh::intersects(int a, int b) const {
+  if (a == kNull || b == kNull) {
+    return false;
+  }
+  double bTopSide = this->orientToEdge(a, fTop[b]);
+  double bBottomSide = this->orientToEdge(a, fBottom[b]);
+  double aTopSide = this->orientToEdge(b, fTop[a]);
+  double aBottomSide = this->orientToEdge(b, fBottom[a]);
+  if ((bTopSide == 0 && this->insideEdge(a, fTop[b])) ||
+      (bBottomSide == 0 && this->insideEdge(a, fBottom[b])) ||
+      (aTopSide == 0 && this->insideEdge(b, fTop[a])) ||
+      (aBottomSide == 0 && this->insideEdge(b, fBottom[a]))) {
+    return true;
+  }
+  return opposite_sides(bTopSide, bBottomSide) && opposite_sides(aTopSide, aBottomSide);
+}
+
+SkPoint GrSweepTriangulator::Mesh::crossingPoint(int a, int b, int* end) const {
+  double ax = fX[fTop[a]], ay = fY[fTop[a]];
+  double adx = fX[fBottom[a]] - ax, ady = fY[fBottom[a]] - ay;
+  double bdx = (double)fX[fBottom[b]] - fX[fTop[b]], bdy = (double)fY[fBottom[b]] - fY[fTop[b]];
+  double denom = adx * bdy - ady * bdx;
+  double s = denom == 0 ? 0 : ((fX[fTop[b]] - ax) * bdy - (fY[fTop[b]] - ay) * bdx) / denom;
+  s = SkTPin(s, 0.0, 1.0);
+  float x = (float)(ax + s * adx), y = (float)(ay + s * ady);
+  *end = kNull;
+  for (int edge : {a, b}) {
+    if (!sweep_lt(fX[fTop[edge]], fY[fTop[edge]], x, y)) {
+      *end = fTop[edge];
+    } else if (!sweep_lt(x, y, fX[fBottom[edge]], fY[fBottom[edge]])) {
+      *end = fBottom[edge];
+    } else {
+      continue;
+    }
+    x = fX[*end];
+    y = fY[*end];
+  }
+  return {x, y};
+}
+
+// Stage 3: Triangulation.
+//
+// The sweep tracks the winding number of each gap between active edges. Each filled gap has a
+// monotone polygon, triangulated as its vertices arrive: a vertex on the same chain as the stack
+// cuts off the convex vertices before it, and one on the other chain sees, and fans to, the whole
+// stack. A vertex that starts new edges inside a filled gap splits its polygon in two, by way of a
+// diagonal up to the polygon's newest vertex. A vertex where two filled gaps join leaves both
+// polygons in the joined gap, until the next vertex there connects to it.
+//
+// Like Bentley-Ottmann, it checks edges for crossings as they become neighbors, and queues the
+// crossings to be reached in sweep order. There, both edges split at a new vertex, which is
+// triangulated like any other, so a path that crosses itself costs one sweep, not two. Anything
+// harder, like overlapping edges, a vertex on an edge, or a crossing that rounds out of order,
+// stops the sweep, and leaves the rest to simplify().
+
+GrSweepTriangulator::Mesh::Result GrSweepTriangulator::Mesh::triangulate(
+    std::vector<SkPoint>* triangles) {
+  int edgeCount = SkToInt(fTop.size());
+  fActive.reset(edgeCount);
+  fGapWinding.assign(edgeCount, 0);
+  fGapMonotone.assign(edgeCount, kNull);
+  fGapMergeMonotone.assign(edgeCount, kNull);
+  fMonotones.clear();
+  fFreeMonotones.clear();
+  fTriangles = triangles;
+  fSortedCount = SkToInt(fX.size());
+  fCrossingEdges.clear();
+  fCrossings = {};
+  Result result = Result::kSuccess;
+  for (int v = 0; result == Result::kSuccess && (v < fSortedCount || !fCrossings.empty());) {
+    if (!fCrossings.empty() && (v == fSortedCount || sweep_lt(fCrossings.top().fX,
+                                                              fCrossings.top().fY, fX[v], fY[v]))) {
+      Crossing crossing = fCrossings.top();
+      fCrossings.pop();
+      result = this->crossAndTriangulate(crossing);
+    } else {
+      fSweepX = fX[v];
+      fSweepY = fY[v];
+      SkSpan<const int> in(fInEdges.data() + fFirstIn[v], fFirstIn[v + 1] - fFirstIn[v]);
+      SkSpan<const int> out(fOutEdges.data() + fFirstOut[v], fFirstOut[v + 1] - fFirstOut[v]);
+      result = this->triangulateVertex(v, in, out);
+      ++v;
+    }
+  }
+  if (result == Result::kSuccess && !fActive.empty()) {
+    result = Result::kFailed;
+  }
+  if (result == Result::kFoundIntersection && SkToInt(fX.size()) > fSortedCount) {
+    // Put the crossings made so far in order with the other vertices, for simplify().
+    this->sortVertices(fSortedCount);
+  }
+  return result;
+}
+
+GrSweepTriangulator::Mesh::Result GrSweepTriangulator::Mesh::queueCrossing(int left, int right) {
+  if (left == kNull || right == kNull) {
+    return Result::kSuccess;
+  }
+  double rightTopSide = this->orientToEdge(left, fTop[right]);
+  double rightBottomSide = this->orientToEdge(left, fBottom[right]);
+  double leftTopSide = this->orientToEdge(right, fTop[left]);
+  double leftBottomSide = this->orientToEdge(right, fBottom[left]);
+  if (!opposite_sides(rightTopSide, rightBottomSide) ||
+      !opposite_sides(leftTopSide, leftBottomSide)) {
+    bool touching = rightTopSide == 0 || rightBottomSide == 0 || leftTopSide == 0 ||
+                    leftBottomSide == 0;
+    return touching && this->intersects(left, right) ? Result::kFoundIntersection
+                                                     : Result::kSuccess;
+  }
+  int end;
+  SkPoint p = this->crossingPoint(left, right, &end);
+  if (end != kNull || !sweep_lt(fSweepX, fSweepY, p.fX, p.fY)) {
+    return Result::kFoundIntersection;
+  }
+  fCrossings.push({p.fX, p.fY, left, right});
+  return Result::kSuccess;
+}
+
+GrSweepTriangulator::Mesh::Result GrSweepTriangulator::Mesh::crossAndTriangulate(
+    const Crossing& crossing) {
+  int a = crossing.fLeft, b = crossing.fRight;
+  if (!fActive.contains(a) || !fActive.contains(b)) {
+    return Result::kSuccess;  // One of them already split at another crossing.
+  }
+  int left = fActive.prev(a), right = fActive.next(b);
+  if (fActive.next(a) != b || (crossing.fX == fSweepX && crossing.fY == fSweepY)) {
+    return Result::kFoundIntersection;  // Something else meets them here.
+  }
+  fSweepX = crossing.fX;
+  fSweepY = crossing.fY;
+  int v = this->addVertex(crossing.fX, crossing.fY);
+  if ((left != kNull && this->orientToEdge(left, v) >= 0) ||
+      (right != kNull && this->orientToEdge(right, v) <= 0)) {
+    return Result::kFoundIntersection;  // Rounding moved it past a neighbor.
+  }
+
+  // a and b end at v, and carry on below it as new edges, in the other order. The vertices they
+  // used to end at have the new edges in their places.
+  int edges[4] = {a, b, kNull, kNull};
+  for (int i : {0, 1}) {
+    int edge = edges[i], bottom = fBottom[edge];
+    int newEdge = SkToInt(fTop.size());
+    this->addEdge(v, bottom, fWinding[edge]);
+    fActive.addEdge();
+    fGapWinding.push_back(0);
+    fGapMonotone.push_back(kNull);
+    fGapMergeMonotone.push_back(kNull);
+    auto inEdge = std::find(
+        fInEdges.begin() + fFirstIn[bottom], fInEdges.begin() + fFirstIn[bottom + 1], edge);
+    SkASSERT(bottom < fSortedCount && *inEdge == edge);
+    *inEdge = newEdge;
+    fBottom[edge] = v;
+    edges[3 - i] = newEdge;
+  }
+  if (!this->leftBelow(edges[2], edges[3])) {
+    return Result::kFoundIntersection;
+  }
+  fCrossingEdges.insert(fCrossingEdges.end(), edges, edges + 4);
+  return this->triangulateVertex(v, SkSpan<const int>(edges, 2), SkSpan<const int>(edges + 2, 2));
+}
+
+bool GrSweepTriangulator::Mesh::findEndingEdges(
+    int v, SkSpan<const int> in, int* first, int* last) const {
+  int count = 1;
+  *first = *last = in[0];
+  for (int prev; (prev = fActive.prev(*first)) != kNull && fBottom[prev] == v; *first = prev) {
+    ++count;
+  }
+  for (int next; (next = fActive.next(*last)) != kNull && fBottom[next] == v; *last = next) {
+    ++count;
+  }
+  return count == SkToInt(in.size());
+}
+
+GrSweepTriangulator::Mesh::Result GrSweepTriangulator::Mesh::triangulateVertex(
+    int v, SkSpan<const int> in, SkSpan<const int> out) {
+  // The polygons in the gaps to the left and right of v's edges.
+  int leftMonotone = kNull, rightMonotone = kNull;
+  int left, right;
+  // The ending edges, left to right, whose places in the tree the new edges can take.
+  int first = kNull, last = kNull;
+  if (!in.empty()) {
+    if (!this->findEndingEdges(v, in, &first, &last)) {
+      // Something ends between them, out of order.
+      return Result::kFoundIntersection;
+    }
+    left = fActive.prev(first);
+    right = fActive.next(last);
+    if (left != kNull && (leftMonotone = fGapMonotone[left]) != kNull) {
+      if (fGapMergeMonotone[left] != kNull) {
+        this->closeMonotone(fGapMergeMonotone[left], v);
+        fGapMergeMonotone[left] = kNull;
+      }
+      this->addToMonotone(leftMonotone, v, Chain::kRight);
+    }
+    for (int edge = first; edge != last; edge = fActive.next(edge)) {
+      for (int monotone : {fGapMonotone[edge], fGapMergeMonotone[edge]}) {
+        if (monotone != kNull) {
+          this->closeMonotone(monotone, v);
+        }
+      }
+    }
+    if ((rightMonotone = fGapMonotone[last]) != kNull) {
+      if (fGapMergeMonotone[last] != kNull) {
+        this->closeMonotone(rightMonotone, v);
+        rightMonotone = fGapMergeMonotone[last];
+      }
+      this->addToMonotone(rightMonotone, v, Chain::kLeft);
+    }
+    if (out.empty()) {
+      // Nothing continues below v, so the gaps either side of it join.
+      for (int edge : in) {
+        fActive.remove(edge);
+      }
+      Result result = this->queueCrossing(left, right);
+      if (result != Result::kSuccess) {
+        return result;
+      }
+      if ((leftMonotone == kNull) != (rightMonotone == kNull)) {
+        return Result::kFailed;
+      }
+      if (leftMonotone != kNull) {
+        fGapMergeMonotone[left] = rightMonotone;
+      }
+      return Result::kSuccess;
+    }
+  } else {
+    if (out.empty()) {
+      return Result::kSuccess;  // All of its edges cancelled out.
+    }
+    left = this->edgeLeftOf(v);
+    right = left == kNull ? fActive.first() : fActive.next(left);
+    if (left != kNull && (leftMonotone = fGapMonotone[left]) != kNull) {
+      if ((rightMonotone = fGapMergeMonotone[left]) != kNull) {
+        // Connect to the merge vertex from both sides.
+        fGapMergeMonotone[left] = kNull;
+      } else {
+        // Connect to the newest vertex of the gap's polygon, splitting it. The side with the
+        // reflex chain keeps the stack.
+        int newest = fMonotones[leftMonotone].fStack.back();
+        if (fMonotones[leftMonotone].fChain == Chain::kLeft) {
+          rightMonotone = leftMonotone;
+          leftMonotone = this->newMonotone(newest);
+          fGapMonotone[left] = leftMonotone;
+        } else {
+          rightMonotone = this->newMonotone(newest);
+        }
+      }
+      this->addToMonotone(leftMonotone, v, Chain::kRight);
+      this->addToMonotone(rightMonotone, v, Chain::kLeft);
+    }
+  }
+
+  int winding = left == kNull ? 0 : fGapWinding[left];
+  int prev = left;
+  for (size_t i = 0; i < out.size(); ++i) {
+    int edge = out[i];
+    if (i > 0 && this->intersects(prev, edge)) {
+      return Result::kFoundIntersection;  // They overlap.
+    }
+    if (first != kNull) {
+      int next = first == last ? kNull : fActive.next(first);
+      fActive.replace(first, edge);
+      first = next;
+    } else {
+      fActive.insertAfter(prev, edge);
+    }
+    prev = edge;
+    winding += fWinding[edge];
+    fGapWinding[edge] = winding;
+    fGapMergeMonotone[edge] = kNull;
+    bool filled = fTriangulator->applyFillType(winding);
+    if (i + 1 < out.size()) {
+      fGapMonotone[edge] = filled ? this->newMonotone(v) : kNull;
+    } else if (filled != (rightMonotone != kNull)) {
+      return Result::kFailed;
+    } else {
+      fGapMonotone[edge] = rightMonotone;
+    }
+  }
+  while (first != kNull) {
+    int next = first == last ? kNull : fActive.next(first);
+    fActive.remove(first);
+    first = next;
+  }
+  Result result = this->queueCrossing(left, out.front());
+  return result == Result::kSuccess ? this->queueCrossing(prev, right) : result;
+}
+
+int GrSweepTriangulator::Mesh::newMonotone(int v) {
+  int monotone;
+  if (!fFreeMonotones.empty()) {
+    monotone = fFreeMonotones.back();
+    fFreeMonotones.pop_back();
+  } else {
+    monotone = SkToInt(fMonotones.size());
+    fMonotones.emplace_back();
+  }
+  fMonotones[monotone].fStack.assign(1, v);
+  fMonotones[monotone].fChain = Chain::kNone;
+  return monotone;
+}
+
+void GrSweepTriangulator::Mesh::addToMonotone(int monotone, int v, Chain chain) {
+  std::vector<int>& stack = fMonotones[monotone].fStack;
+  if (stack.size() > 1 && chain != fMonotones[monotone].fChain) {
+    for (size_t i = 1; i < stack.size(); ++i) {
+      this->emitTriangle(stack[i - 1], stack[i], v);
+    }
+    stack[0] = stack.back();
+    stack.resize(1);
+  } else {
+    while (stack.size() > 1) {
+      int a = stack.back(), b = stack[stack.size() - 2];
+      double side = orient(fX[b], fY[b], fX[a], fY[a], fX[v], fY[v]);
+      if (chain == Chain::kLeft ? side >= 0 : side <= 0) {
+        break;  // Reflex.
+      }
+      this->emitTriangle(b, a, v);
+      stack.pop_back();
+    }
+  }
+  stack.push_back(v);
+  fMonotones[monotone].fChain = chain;
+}
+
+void GrSweepTriangulator::Mesh::closeMonotone(int monotone, int v) {
+  const std::vector<int>& stack = fMonotones[monotone].fStack;
+  for (size_t i = 1; i < stack.size(); ++i) {
+    this->emitTriangle(stack[i - 1], stack[i], v);
+  }
+  fFreeMonotones.push_back(monotone);
+}
+
+void GrSweepTriangulator::Mesh::emitTriangle(int a, int b, int c) {
+  if (orient(fX[a], fY[a], fX[b], fY[b], fX[c], fY[c]) == 0) {
+    return;
+  }
+  for (int v : {a, b, c}) {
+    fTriangles->push_back({fX[v], fY[v]});
+  }
+}
+
+// Stage 4: Simplification.
+//
+// This sweeps the whole mesh once, as in Bentley-Ottmann: only neighboring active edges are tested
+// for intersection, and the crossings found wait in a priority queue until the sweep reaches them,
+// where the edges swap places. Nothing is split during the sweep. Instead each crossing becomes a
+// vertex, and each edge collects the vertices it should split at, all to be split at once
+// afterwards. Since the sweep reaches the crossings in order, the new vertices are in order too,
+// and need no sorting. Edges that overlap, or that a vertex lands exactly on, split at the shared
+// vertices.
+
+void GrSweepTriangulator::Mesh::simplify() {
+  int vertexCount = SkToInt(fX.size());
+  int edgeCount = SkToInt(fTop.size());
+  fActive.reset(edgeCount);
+  fCrossings = {};
+  fSplits.clear();
+  fMarks.assign(edgeCount, 0);
+  fMark = 0;
+  for (int v = 0; v < vertexCount || !fCrossings.empty();) {
+    if (!fCrossings.empty() &&
+        (v == vertexCount || sweep_lt(fCrossings.top().fX, fCrossings.top().fY, fX[v], fY[v]))) {
+      this->crossEdges();
+    } else {
+      this->intersectVertex(v++);
+    }
+  }
+  this->splitEdges(vertexCount);
+}
+
+void GrSweepTriangulator::Mesh::intersectVertex(int v) {
+  fSweepX = fX[v];
+  fSweepY = fY[v];
+  // The edges ending at v should be adjacent, but rounding can leave others between them, so find
+  // v's place again without them. Anything out of order gets found in the next round.
+  for (int i = fFirstIn[v]; i < fFirstIn[v + 1]; ++i) {
+    fActive.remove(fInEdges[i]);
+  }
+  int left = this->edgeLeftOf(v);
+  int right = left == kNull ? fActive.first() : fActive.next(left);
+
+  // Edges passing right through v split there, and carry on below it among v's own edges.
+  fGroup.clear();
+  while (left != kNull && this->orientToEdge(left, v) == 0) {
+    fSplits.push_back({left, v});
+    fGroup.push_back(left);
+    int prev = fActive.prev(left);
+    fActive.remove(left);
+    left = prev;
+  }
+  while (right != kNull && this->orientToEdge(right, v) == 0) {
+    fSplits.push_back({right, v});
+    fGroup.push_back(right);
+    int next = fActive.next(right);
+    fActive.remove(right);
+    right = next;
+  }
+  bool sorted = fGroup.empty();
+  fGroup.insert(
+      fGroup.end(), fOutEdges.begin() + fFirstOut[v], fOutEdges.begin() + fFirstOut[v + 1]);
+  if (!sorted) {
+    std::sort(fGroup.begin(), fGroup.end(), [this](int a, int b) { return this->leftBelow(a, b); });
+  }
+
+  int prev = left;
+  for (int edge : fGroup) {
+    fActive.insertAfter(prev, edge);
+    prev = edge;
+  }
+  if (fGroup.empty()) {
+    this->checkPair(left, right);
+    return;
+  }
+  // Checking pairs can reorder the active edges, so note the ends of the group first.
+  int first = fGroup.front(), last = fGroup.back();
+  this->checkPair(left, first);
+  for (int i = fFirstOut[v] + 1; i < fFirstOut[v + 1]; ++i) {
+    // Only overlapping edges can meet again after starting at the same vertex.
+    this->checkPair(fOutEdges[i - 1], fOutEdges[i]);
+  }
+  this->checkPair(last, right);
+}
+
+void GrSweepTriangulator::Mesh::crossEdges() {
+  Crossing crossing = fCrossings.top();
+  fSweepX = crossing.fX;
+  fSweepY = crossing.fY;
+  ++fMark;
+  fGroup.clear();
+  while (!fCrossings.empty() && fCrossings.top().fX == crossing.fX &&
+         fCrossings.top().fY == crossing.fY) {
+    for (int edge : {fCrossings.top().fLeft, fCrossings.top().fRight}) {
+      if (fActive.contains(edge) && fMarks[edge] != fMark) {
+        fMarks[edge] = fMark;
+        fGroup.push_back(edge);
+      }
+    }
+    fCrossings.pop();
+  }
+  int v = kNull;
+  for (int edge : fGroup) {
+    if (this->insideEdge(edge, crossing.fX, crossing.fY)) {
+      if (v == kNull) {
+        v = this->addVertex(crossing.fX, crossing.fY);
+      }
+      fSplits.push_back({edge, v});
+    }
+  }
+
+  // The edges that cross here should be adjacent, but rounding can leave others between them.
+  // Below here, each run of adjacent ones is in the opposite order.
+  for (int edge : fGroup) {
+    if (fMarks[edge] != fMark) {
+      continue;  // Already reordered with its run.
+    }
+    int first = edge, last = edge;
+    for (int prev; (prev = fActive.prev(first)) != kNull && fMarks[prev] == fMark; first = prev) {
+    }
+    for (int next; (next = fActive.next(last)) != kNull && fMarks[next] == fMark; last = next) {
+    }
+    fRun.clear();
+    for (int e = first;; e = fActive.next(e)) {
+      fRun.push_back(e);
+      fMarks[e] = 0;
+      if (e == last) {
+        break;
+      }
+    }
+    if (fRun.size() < 2) {
+      continue;
+    }
+    int left = fActive.prev(first), right = fActive.next(last);
+    std::sort(fRun.begin(), fRun.end(), [this](int a, int b) { return this->leftBelow(a, b); });
+    fActive.reorder(first, fRun);
+    this->checkPair(left, fRun.front());
+    this->checkPair(fRun.back(), right);
+  }
+}
+
+bool GrSweepTriangulator::Mesh::splitAtVertex(int edge, int v) {
+  if (!this->insideEdge(edge, v)) {
+    return false;
+  }
+  fSplits.push_back({edge, v});
+  return true;
+}
+
+void GrSweepTriangulator::Mesh::checkPair(int left, int right) {
+  if (left == kNull || right == kNull) {
+    return;
+  }
+  int a = left, b = right;
+  double bTopSide = this->orientToEdge(a, fTop[b]);
+  double bBottomSide = this->orientToEdge(a, fBottom[b]);
+  double aTopSide = this->orientToEdge(b, fTop[a]);
+  double aBottomSide = this->orientToEdge(b, fBottom[a]);
+  if (bTopSide == 0 && bBottomSide == 0) {
+    // Collinear. Split each edge at the other's ends, so the overlap becomes one edge.
+    this->splitAtVertex(a, fTop[b]);
+    this->splitAtVertex(a, fBottom[b]);
+    this->splitAtVertex(b, fTop[a]);
+    this->splitAtVertex(b, fBottom[a]);
+    return;
+  }
+  bool touched = false;
+  if (bTopSide == 0) {
+    touched |= this->splitAtVertex(a, fTop[b]);
+  }
+  if (bBottomSide == 0) {
+    touched |= this->splitAtVertex(a, fBottom[b]);
+  }
+  if (aTopSide == 0) {
+    touched |= this->splitAtVertex(b, fTop[a]);
+  }
+  if (aBottomSide == 0) {
+    touched |= this->splitAtVertex(b, fBottom[a]);
+  }
+  if (touched || !opposite_sides(bTopSide, bBottomSide) ||
+      !opposite_sides(aTopSide, aBottomSide)) {
+    return;
+  }
+
+  // Rounding can leave the crossing outside one of the edges. Then it crosses at that edge's end.
+  int end;
+  SkPoint p = this->crossingPoint(a, b, &end);
+  float x = p.fX, y = p.fY;
+  if (end != kNull) {
+    this->splitAtVertex(a, end);
+    this->splitAtVertex(b, end);
+    return;
+  }
+  if (sweep_lt(fSweepX, fSweepY, x, y)) {
+    fCrossings.push({x, y, a, b});
+    return;
+  }
+  // Rounding put the crossing behind the sweep. Its vertex is out of order, and the edges swap
+  // now, if an earlier swap hasn't moved them apart.
+  int v = this->addVertex(x, y);
+  fSplits.push_back({a, v});
+  fSplits.push_back({b, v});
+  if (fActive.next(a) == b && this->leftBelow(b, a)) {
+    fRun.assign({b, a});
+    fActive.reorder(a, fRun);
+    this->checkPair(fActive.prev(b), b);
+    this->checkPair(a, fActive.next(a));
+  }
+}
+
+void GrSweepTriangulator::Mesh::splitEdges(int sortedCount) {
+  // Bucket the splits by edge, then sort each edge's along it.
+  int edgeCount = SkToInt(fTop.size());
+  std::vector<int> firstSplit(edgeCount + 1, 0);
+  for (const Split& split : fSplits) {
+    ++firstSplit[split.fEdge + 1];
+  }
+  std::partial_sum(firstSplit.begin(), firstSplit.end(), firstSplit.begin());
+  std::vector<Split> splits(fSplits.size());
+  std::vector<int> cursor(firstSplit.begin(), firstSplit.end() - 1);
+  for (const Split& split : fSplits) {
+    splits[cursor[split.fEdge]++] = split;
+  }
+
+  for (int edge = 0; edge < edgeCount; ++edge) {
+    if (firstSplit[edge] == firstSplit[edge + 1]) {
+      continue;
+    }
+    auto begin = splits.begin() + firstSplit[edge], end = splits.begin() + firstSplit[edge + 1];
+    auto lessThan = [this](const Split& a, const Split& b) {
+      return sweep_lt(fX[a.fVertex], fY[a.fVertex], fX[b.fVertex], fY[b.fVertex]);
+    };
+    // Crossings are found in order along each edge, so this is usually sorted already.
+    if (!std::is_sorted(begin, end, lessThan)) {
+      std::sort(begin, end, lessThan);
+    }
+    int top = fTop[edge], bottom = fBottom[edge];
+    for (auto split = begin; split != end; ++split) {
+      int v = split->fVertex;
+      if (split == begin) {
+        fBottom[edge] = v;
+      } else {
+        this->addEdge(top, v, fWinding[edge]);
+      }
+      top = v;
+    }
+    this->addEdge(top, bottom, fWinding[edge]);
+  }
+  // Vertices at the same point merge here.
+  this->sortVertices(sortedCount);
+}
+
+void GrSweepTriangulator::pathToPoints(
+    float tolerance, const SkRect& clipBounds, std::vector<SkPoint>* points,
+    std::vector<int>* contourEnds, bool* isLinear) const {
+  if (!fPath.getSegmentMasks()) {
+    // Like pathToPolys(), draw nothing for a path of moves, even with an inverse fill.
+    *isLinear = true;
+    return;
+  }
+  // pathToContours() starts a contour at each move, plus one for the clip of an inverse fill.
+  int maxContourCount = fPath.countVerbs() + 2;
+  std::unique_ptr<VertexList[]> contours(new VertexList[maxContourCount]);
+  this->pathToContours(tolerance, clipBounds, contours.get(), isLinear);
+  for (int i = 0; i < maxContourCount && contours[i].fHead; ++i) {
+    this->sanitizeContours(&contours[i], 1);
+    for (Vertex* v = contours[i].fHead; v; v = v->fNext) {
+      points->push_back(v->fPoint);
+    }
+    if (contourEnds->empty() || contourEnds->back() != SkToInt(points->size())) {
+      contourEnds->push_back(SkToInt(points->size()));
+    }
+  }
+}
+
+bool GrSweepTriangulator::PathToTriangles(
+    const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+    GrEagerVertexAllocator* vertexAllocator, bool* isLinear, int* vertexCount) {
+  SkArenaAlloc alloc(kArenaDefaultChunkSize);
+  GrSweepTriangulator triangulator(path, &alloc);
+  std::vector<SkPoint> points;
+  std::vector<int> contourEnds;
+  triangulator.pathToPoints(tolerance, clipBounds, &points, &contourEnds, isLinear);
+
+  Mesh mesh(&triangulator);
+  mesh.addContours(points, contourEnds);
+  std::vector<SkPoint> triangles;
+  for (int round = 0;; ++round) {
+    triangles.clear();
+    Mesh::Result result = mesh.triangulate(&triangles);
+    if (result == Mesh::Result::kSuccess) {
+      break;
+    }
+    if (result == Mesh::Result::kFailed || round == kMaxSplitRounds) {
+      return false;
+    }
+    mesh.simplify();
+  }
+
+  *vertexCount = 0;
+  if (triangles.empty() || triangles.size() > SK_MaxS32) {
+    return true;
+  }
+  int count = SkToInt(triangles.size());
+  void* verts = vertexAllocator->lock(sizeof(SkPoint), count);
+  if (!verts) {
+    SkDebugf("Could not allocate vertices\n");
+    return true;
+  }
+  memcpy(verts, triangles.data(), count * sizeof(SkPoint));
+  vertexAllocator->unlock(count);
+  *vertexCount = count;
+  return true;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrSweepTriangulator_DEFINED
+#define GrSweepTriangulator_DEFINED
+
+#include "src/gpu/ganesh/geometry/GrTriangulator.h"
+
+#include <vector>
+
+/**
+ * An alternative to GrTriangulator's mesh stages that scales better to paths with many edges.
+ * The path is linearized and cleaned up the same way, but then:
+ *
+ * 1) Vertices and edges live in flat arrays (structure of arrays), indexed by sweep order, instead
+ *    of in linked lists.
+ * 2) A sweep cuts the filled regions into monotone polygons and triangulates each one as its
+ *    vertices arrive. It finds where edges cross as Bentley-Ottmann does, by checking neighbors,
+ *    and splits them when it gets there, so a self-intersecting path takes one pass, and nothing
+ *    is rewound.
+ * 3) If edges meet any other way, e.g. they overlap or rounding puts a crossing out of order, one
+ *    Bentley-Ottmann sweep finds every intersection, the edges are split at all of them in a
+ *    batch, and 2) starts over. This repeats in the rare case that rounding the new vertices made
+ *    new intersections.
+ *
+ * Both sweeps keep the active edges in a balanced tree, so finding where a vertex lands among them
+ * is O(log n) rather than O(n).
+ *
+ * Floating point can make the sweep's predicates disagree with each other on near-degenerate
+ * input. Where GrTriangulator patches the mesh up, this gives up instead, and
+ * GrTriangulator::PathToTriangles() falls back on the mesh engine.
+ */
+class GrSweepTriangulator : private GrTriangulator {
+ public:
+  // Returns false if the path was too degenerate for this engine. Otherwise returns the number of
+  // vertices written in 'vertexCount', as GrTriangulator::PathToTriangles() would.
+  static bool PathToTriangles(
+      const SkPath&, SkScalar tolerance, const SkRect& clipBounds, GrEagerVertexAllocator*,
+      bool* isLinear, int* vertexCount);
+
+ private:
+  class Mesh;
+
+  GrSweepTriangulator(const SkPath& path, SkArenaAlloc* alloc) : GrTriangulator(path, alloc) {}
+
+  // Stage 1: Linearizes the path as GrTriangulator does, into one array of points. Contour i ends
+  // at contourEnds[i].
+  void pathToPoints(
+      float tolerance, const SkRect& clipBounds, std::vector<SkPoint>* points,
+      std::vector<int>* contourEnds, bool* isLinear) const;
+};
+
+#endif  // GrSweepTriangulator_DEFINED
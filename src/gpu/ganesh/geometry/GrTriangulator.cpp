@@ -10,6 +10,7 @@
 #include "src/gpu/BufferWriter.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/geometry/GrPathUtils.h"
+#include "src/gpu/ganesh/geometry/GrSweepTriangulator.h"
 
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPointPriv.h"
@@ -1541,6 +1542,27 @@ std::tuple<Poly*, bool> GrTriangulator::contoursToPolys(VertexList* contours, in
   return this->tessellate(mesh, c);
 }
 
+int GrTriangulator::PathToTriangles(
+    const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+    GrEagerVertexAllocator* vertexAllocator, bool* isLinear, Engine engine) {
+  if (!path.isFinite()) {
+    return 0;
+  }
+  int count;
+  if (engine == Engine::kSweep &&
+      GrSweepTriangulator::PathToTriangles(
+          path, tolerance, clipBounds, vertexAllocator, isLinear, &count)) {
+    return count;
+  }
+  SkArenaAlloc alloc(kArenaDefaultChunkSize);
+  GrTriangulator triangulator(path, &alloc);
+  auto [polys, success] = triangulator.pathToPolys(tolerance, clipBounds, isLinear);
+  if (!success) {
+    return 0;
+  }
+  return triangulator.polysToTriangles(polys, vertexAllocator);
+}
+
 // Stage 6: Triangulate the monotone polygons into a vertex buffer.
 skgpu::VertexWriter GrTriangulator::polysToTriangles(
     Poly* polys, SkPathFillType overrideFillType, skgpu::VertexWriter data) const {
@@ -27,21 +27,14 @@ class GrTriangulator {
  public:
   constexpr static int kArenaDefaultChunkSize = 16 * 1024;
 
+  enum class Engine {
+    kMesh,   // The six stages below, on a linked list mesh.
+    kSweep,  // GrSweepTriangulator. Falls back on kMesh for paths too degenerate for it.
+  };
+
   static int PathToTriangles(
       const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
-      GrEagerVertexAllocator* vertexAllocator, bool* isLinear) {
-    if (!path.isFinite()) {
-      return 0;
-    }
-    SkArenaAlloc alloc(kArenaDefaultChunkSize);
-    GrTriangulator triangulator(path, &alloc);
-    auto [polys, success] = triangulator.pathToPolys(tolerance, clipBounds, isLinear);
-    if (!success) {
-      return 0;
-    }
-    int count = triangulator.polysToTriangles(polys, vertexAllocator);
-    return count;
-  }
+      GrEagerVertexAllocator* vertexAllocator, bool* isLinear, Engine = Engine::kMesh);
 
   // Enums used by GrTriangulator internals.
   typedef enum { kLeft_Side, kRight_Side } Side;
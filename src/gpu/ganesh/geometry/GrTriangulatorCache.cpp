@@ -0,0 +1,332 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
+
+#include "src/core/SkOpts.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
+
+namespace {
+
+// Bump this whenever the triangulator's output or the format below changes.
+constexpr uint32_t kSerializedVersion = 2;
+
+size_t bytes_used(const std::vector<SkPoint>& pts) { return pts.size() * sizeof(SkPoint); }
+
+void write_points(SkWriteBuffer& buffer, const std::vector<SkPoint>& pts) {
+  buffer.writePointArray(pts.data(), SkToU32(pts.size()));
+}
+
+// Same rule as TriangulatingPathRenderer applies to the meshes in GrThreadSafeCache: a curved mesh
+// serves tolerances down to a third of the one it was flattened with.
+bool mesh_matches(const GrTriangulatorCache::Mesh& mesh, SkScalar tolerance) {
+  return mesh.fIsLinear || mesh.fTolerance < 3.0f * tolerance;
+}
+
+bool read_points(SkReadBuffer& buffer, std::vector<SkPoint>* pts) {
+  uint32_t count = buffer.getArrayCount();
+  if (!buffer.validate(count % 3 == 0 && count <= buffer.available() / sizeof(SkPoint))) {
+    return false;
+  }
+  pts->resize(count);
+  return buffer.readPointArray(pts->data(), count);
+}
+
+}  // namespace
+
+void GrTriangulatorCache::InnerFan::appendBreadcrumbs(
+    SkArenaAlloc* alloc, BreadcrumbTriangleList* list) const {
+  for (const std::vector<SkPoint>* pts : {&fSplitBreadcrumbs->fPts, &fWindingBreadcrumbs}) {
+    for (size_t i = 0; i < pts->size(); i += 3) {
+      list->append(alloc, (*pts)[i], (*pts)[i + 1], (*pts)[i + 2], 1);
+    }
+  }
+}
+
+GrTriangulatorCache::~GrTriangulatorCache() { this->purgeAll(); }
+
+uint32_t GrTriangulatorCache::Hash(const SkPath& path) {
+  uint32_t hash = SkOpts::hash(SkPathPriv::VerbData(path), path.countVerbs());
+  hash = SkOpts::hash(SkPathPriv::PointData(path), path.countPoints() * sizeof(SkPoint), hash);
+  return SkOpts::hash(
+      SkPathPriv::ConicWeightData(path), SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar),
+      hash);
+}
+
+GrTriangulatorCache::Entry* GrTriangulatorCache::find(const SkPath& path) {
+  uint32_t genID = path.getGenerationID();
+  if (Entry** entry = fGenIDs.find(genID)) {
+    return *entry;
+  }
+  Entry** entry = fEntries.find(Hash(path));
+  if (!entry) {
+    return nullptr;
+  }
+  SkPath windingPath = path;
+  windingPath.setFillType(SkPathFillType::kWinding);
+  if ((*entry)->fPath != windingPath) {
+    return nullptr;
+  }
+  if ((*entry)->fGenIDs.count() < kMaxGenIDsPerEntry) {
+    (*entry)->fGenIDs.push_back(genID);
+    fGenIDs.set(genID, *entry);
+  }
+  return *entry;
+}
+
+GrTriangulatorCache::Entry* GrTriangulatorCache::findOrAdd(const SkPath& path) {
+  Entry* entry = this->find(path);
+  if (entry) {
+    fLRU.remove(entry);
+    fLRU.addToHead(entry);
+    return entry;
+  }
+  uint32_t hash = Hash(path);
+  if (Entry** collision = fEntries.find(hash)) {
+    this->remove(*collision);
+  }
+  entry = new Entry;
+  entry->fPath = path;
+  entry->fPath.setFillType(SkPathFillType::kWinding);
+  entry->fHash = hash;
+  entry->fBytes = sizeof(Entry) + path.approximateBytesUsed();
+  // find() didn't know this genID, so register it now rather than on the next lookup.
+  entry->fGenIDs.push_back(path.getGenerationID());
+  fGenIDs.set(path.getGenerationID(), entry);
+  fEntries.set(hash, entry);
+  fLRU.addToHead(entry);
+  fBytesUsed += entry->fBytes;
+  return entry;
+}
+
+void GrTriangulatorCache::add(const SkPath& path, sk_sp<InnerFan> fan) {
+  size_t fanBytes = sizeof(InnerFan) + bytes_used(fan->fVertices) +
+                    bytes_used(fan->fWindingBreadcrumbs);
+  Entry* entry = this->findOrAdd(path);
+  sk_sp<const InnerFan>& slot = entry->fFans[(int)path.getFillType()];
+  if (slot) {
+    // Another op triangulated the same path at the same time. Keep the first one.
+    return;
+  }
+  // The split breadcrumbs are the same for every fill type.
+  if (!entry->fSplitBreadcrumbs) {
+    entry->fSplitBreadcrumbs = fan->fSplitBreadcrumbs;
+    fanBytes += bytes_used(entry->fSplitBreadcrumbs->fPts);
+  }
+  fan->fSplitBreadcrumbs = entry->fSplitBreadcrumbs;
+  slot = std::move(fan);
+  entry->fBytes += fanBytes;
+  fBytesUsed += fanBytes;
+  this->purge();
+}
+
+void GrTriangulatorCache::add(const SkPath& path, sk_sp<Mesh> mesh) {
+  Entry* entry = this->findOrAdd(path);
+  sk_sp<const Mesh>& slot = entry->fMeshes[(int)path.getFillType()];
+  if (slot && (slot->fIsLinear || slot->fTolerance <= mesh->fTolerance)) {
+    return;
+  }
+  size_t meshBytes = sizeof(Mesh) + bytes_used(mesh->fVertices);
+  if (slot) {
+    meshBytes -= sizeof(Mesh) + bytes_used(slot->fVertices);
+  }
+  slot = std::move(mesh);
+  entry->fBytes += meshBytes;
+  fBytesUsed += meshBytes;
+  this->purge();
+}
+
+void GrTriangulatorCache::remove(Entry* entry) {
+  for (uint32_t genID : entry->fGenIDs) {
+    fGenIDs.remove(genID);
+  }
+  fLRU.remove(entry);
+  fEntries.remove(entry->fHash);
+  fBytesUsed -= entry->fBytes;
+  delete entry;
+}
+
+void GrTriangulatorCache::purge() {
+  while (fBytesUsed > fByteLimit) {
+    this->remove(fLRU.tail());
+  }
+}
+
+sk_sp<const GrTriangulatorCache::InnerFan> GrTriangulatorCache::findInnerFan(const SkPath& path) {
+  SkAutoMutexExclusive lock(fMutex);
+  Entry* entry = this->find(path);
+  if (!entry || !entry->fFans[(int)path.getFillType()]) {
+    ++fMisses;
+    return nullptr;
+  }
+  ++fHits;
+  fLRU.remove(entry);
+  fLRU.addToHead(entry);
+  return entry->fFans[(int)path.getFillType()];
+}
+
+sk_sp<const GrTriangulatorCache::Mesh> GrTriangulatorCache::findMesh(
+    const SkPath& path, SkScalar tolerance) {
+  SkAutoMutexExclusive lock(fMutex);
+  Entry* entry = this->find(path);
+  const sk_sp<const Mesh>* mesh = entry ? &entry->fMeshes[(int)path.getFillType()] : nullptr;
+  if (!mesh || !*mesh || !mesh_matches(**mesh, tolerance)) {
+    ++fMisses;
+    return nullptr;
+  }
+  ++fHits;
+  fLRU.remove(entry);
+  fLRU.addToHead(entry);
+  return *mesh;
+}
+
+void GrTriangulatorCache::addMesh(
+    const SkPath& path, SkScalar tolerance, bool isLinear, const SkPoint* vertices,
+    int vertexCount) {
+  SkASSERT(!path.isVolatile());
+  auto mesh = sk_make_sp<Mesh>();
+  mesh->fIsLinear = isLinear;
+  mesh->fTolerance = tolerance;
+  mesh->fVertices.assign(vertices, vertices + vertexCount);
+
+  SkAutoMutexExclusive lock(fMutex);
+  this->add(path, std::move(mesh));
+}
+
+void GrTriangulatorCache::addInnerFan(
+    const SkPath& path, bool isLinear, const SkPoint* vertices, int vertexCount,
+    const BreadcrumbTriangleList& breadcrumbs, int splitBreadcrumbCount) {
+  SkASSERT(!path.isVolatile());
+  SkASSERT(splitBreadcrumbCount <= breadcrumbs.count());
+  auto split = sk_make_sp<Breadcrumbs>();
+  auto fan = sk_make_sp<InnerFan>();
+  fan->fIsLinear = isLinear;
+  fan->fVertices.assign(vertices, vertices + vertexCount);
+  split->fPts.reserve(splitBreadcrumbCount * 3);
+  fan->fWindingBreadcrumbs.reserve((breadcrumbs.count() - splitBreadcrumbCount) * 3);
+  int i = 0;
+  for (auto* node = breadcrumbs.head(); node; node = node->fNext, ++i) {
+    auto& pts = (i < splitBreadcrumbCount) ? split->fPts : fan->fWindingBreadcrumbs;
+    pts.insert(pts.end(), node->fPts, node->fPts + 3);
+  }
+  fan->fSplitBreadcrumbs = std::move(split);
+
+  SkAutoMutexExclusive lock(fMutex);
+  this->add(path, std::move(fan));
+}
+
+sk_sp<SkData> GrTriangulatorCache::serialize() const {
+  SkBinaryWriteBuffer buffer;
+  buffer.writeUInt(kSerializedVersion);
+  SkAutoMutexExclusive lock(fMutex);
+  buffer.writeUInt(fEntries.count());
+  for (Entry* entry = fLRU.tail(); entry; entry = entry->fPrev) {
+    buffer.writePath(entry->fPath);
+    write_points(buffer, entry->fSplitBreadcrumbs ? entry->fSplitBreadcrumbs->fPts
+                                                  : std::vector<SkPoint>());
+    uint32_t fillTypes = 0;
+    for (int i = 0; i < kFillTypeCount; ++i) {
+      fillTypes |= entry->fFans[i] ? 1 << i : 0;
+      fillTypes |= entry->fMeshes[i] ? 1 << (kFillTypeCount + i) : 0;
+    }
+    buffer.writeUInt(fillTypes);
+    for (const sk_sp<const InnerFan>& fan : entry->fFans) {
+      if (fan) {
+        buffer.writeBool(fan->fIsLinear);
+        write_points(buffer, fan->fVertices);
+        write_points(buffer, fan->fWindingBreadcrumbs);
+      }
+    }
+    for (const sk_sp<const Mesh>& mesh : entry->fMeshes) {
+      if (mesh) {
+        buffer.writeBool(mesh->fIsLinear);
+        buffer.writeScalar(mesh->fTolerance);
+        write_points(buffer, mesh->fVertices);
+      }
+    }
+  }
+  return buffer.snapshotAsData();
+}
+
+bool GrTriangulatorCache::deserialize(const void* data, size_t size) {
+  SkReadBuffer buffer(data, size);
+  if (buffer.readUInt() != kSerializedVersion) {
+    return false;
+  }
+  uint32_t entryCount = buffer.readUInt();
+  std::vector<std::pair<SkPath, sk_sp<InnerFan>>> fans;
+  std::vector<std::pair<SkPath, sk_sp<Mesh>>> meshes;
+  for (uint32_t i = 0; i < entryCount; ++i) {
+    SkPath path;
+    buffer.readPath(&path);
+    auto split = sk_make_sp<Breadcrumbs>();
+    read_points(buffer, &split->fPts);
+    uint32_t fillTypes = buffer.readUInt();
+    if (!buffer.validate(fillTypes < (1 << (2 * kFillTypeCount)))) {
+      return false;
+    }
+    for (int fillType = 0; fillType < kFillTypeCount; ++fillType) {
+      if (fillTypes & (1 << fillType)) {
+        auto fan = sk_make_sp<InnerFan>();
+        fan->fIsLinear = buffer.readBool();
+        read_points(buffer, &fan->fVertices);
+        read_points(buffer, &fan->fWindingBreadcrumbs);
+        fan->fSplitBreadcrumbs = split;
+        path.setFillType((SkPathFillType)fillType);
+        fans.emplace_back(path, std::move(fan));
+      }
+    }
+    for (int fillType = 0; fillType < kFillTypeCount; ++fillType) {
+      if (fillTypes & (1 << (kFillTypeCount + fillType))) {
+        auto mesh = sk_make_sp<Mesh>();
+        mesh->fIsLinear = buffer.readBool();
+        mesh->fTolerance = buffer.readScalar();
+        read_points(buffer, &mesh->fVertices);
+        path.setFillType((SkPathFillType)fillType);
+        meshes.emplace_back(path, std::move(mesh));
+      }
+    }
+    if (!buffer.isValid()) {
+      return false;
+    }
+  }
+
+  SkAutoMutexExclusive lock(fMutex);
+  for (auto& [path, fan] : fans) {
+    this->add(path, std::move(fan));
+  }
+  for (auto& [path, mesh] : meshes) {
+    this->add(path, std::move(mesh));
+  }
+  return true;
+}
+
+size_t GrTriangulatorCache::bytesUsed() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fBytesUsed;
+}
+
+int GrTriangulatorCache::hits() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fHits;
+}
+
+int GrTriangulatorCache::misses() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fMisses;
+}
+
+void GrTriangulatorCache::purgeAll() {
+  SkAutoMutexExclusive lock(fMutex);
+  while (Entry* entry = fLRU.head()) {
+    this->remove(entry);
+  }
+  SkASSERT(fBytesUsed == 0);
+  SkASSERT(fGenIDs.count() == 0);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrTriangulatorCache_DEFINED
+#define GrTriangulatorCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTDArray.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkThreadAnnotations.h"
+#include "src/core/SkTInternalLList.h"
+#include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
+
+#include <vector>
+
+/**
+ * Triangulations of static paths, kept across flushes so a path drawn again needn't be
+ * triangulated again: the inner fans that the tessellating path renderer fills
+ * (GrInnerFanTriangulator), and the meshes that TriangulatingPathRenderer draws without
+ * antialiasing (GrTriangulator). Both are in the path's own space, so they serve the path under
+ * other view matrices too. Shared by all the contexts of a GrContextThreadSafeProxy, and limited
+ * to a budget of CPU memory.
+ *
+ * Paths are found by their generation ID, or failing that by their contents, so copies of a path
+ * and identical paths built each frame share an entry. The breadcrumb triangles from edge splits
+ * don't depend on the fill rule, so an entry keeps one list of them for every fill type it has
+ * triangulations of.
+ *
+ * The whole cache can be written to a blob and read back, e.g. by the next run of the app, so that
+ * paths it has seen before are never triangulated.
+ */
+class GrTriangulatorCache {
+ public:
+  using BreadcrumbTriangleList = GrInnerFanTriangulator::BreadcrumbTriangleList;
+
+  // Three points per triangle.
+  struct Breadcrumbs : public SkNVRefCnt<Breadcrumbs> {
+    std::vector<SkPoint> fPts;
+  };
+
+  struct InnerFan : public SkNVRefCnt<InnerFan> {
+    bool fIsLinear;
+    std::vector<SkPoint> fVertices;  // Triangles, as GrInnerFanTriangulator writes them.
+    sk_sp<const Breadcrumbs> fSplitBreadcrumbs;  // From edge splits. Shared by every fill type.
+    std::vector<SkPoint> fWindingBreadcrumbs;    // From polysToTriangles().
+
+    int vertexCount() const { return SkToInt(fVertices.size()); }
+
+    // Appends the breadcrumb triangles, as GrInnerFanTriangulator would have made them.
+    void appendBreadcrumbs(SkArenaAlloc*, BreadcrumbTriangleList*) const;
+  };
+
+  struct Mesh : public SkNVRefCnt<Mesh> {
+    bool fIsLinear;
+    SkScalar fTolerance;  // How closely curves were flattened, in the path's space.
+    std::vector<SkPoint> fVertices;
+
+    int vertexCount() const { return SkToInt(fVertices.size()); }
+  };
+
+  explicit GrTriangulatorCache(size_t byteLimit) : fByteLimit(byteLimit) {}
+  ~GrTriangulatorCache();
+
+  // Returns the triangulation of a path with its fill type, or nullptr.
+  sk_sp<const InnerFan> findInnerFan(const SkPath&);
+
+  // Adds the triangulation of a path. The first 'splitBreadcrumbCount' breadcrumbs are the ones
+  // GrInnerFanTriangulator::pathToPolys() made.
+  void addInnerFan(
+      const SkPath&, bool isLinear, const SkPoint* vertices, int vertexCount,
+      const BreadcrumbTriangleList&, int splitBreadcrumbCount);
+
+  // Returns a mesh of a path with its fill type that's flattened finely enough for 'tolerance', or
+  // nullptr. Translating the view matrix doesn't change the tolerance, so a translated path still
+  // finds its mesh.
+  sk_sp<const Mesh> findMesh(const SkPath&, SkScalar tolerance);
+
+  // Adds a mesh of a path, unless there's already one at least as accurate.
+  void addMesh(
+      const SkPath&, SkScalar tolerance, bool isLinear, const SkPoint* vertices, int vertexCount);
+
+  // Writes out every triangulation, least recently used first.
+  sk_sp<SkData> serialize() const;
+  // Adds the triangulations from serialize(). Returns false, having added none, if the data is
+  // malformed or from a different version of Skia.
+  bool deserialize(const void* data, size_t size);
+
+  size_t bytesUsed() const;
+  int hits() const;
+  int misses() const;
+  void purgeAll();
+
+ private:
+  inline static constexpr int kFillTypeCount = 4;
+  // Generation IDs that an entry answers to, besides hashing the path.
+  inline static constexpr int kMaxGenIDsPerEntry = 8;
+
+  struct Entry {
+    SkPath fPath;  // With kWinding fill, so it matches paths with any fill type.
+    uint32_t fHash;
+    sk_sp<const Breadcrumbs> fSplitBreadcrumbs;  // Null until there's an inner fan.
+    sk_sp<const InnerFan> fFans[kFillTypeCount];
+    sk_sp<const Mesh> fMeshes[kFillTypeCount];
+    SkTDArray<uint32_t> fGenIDs;
+    size_t fBytes;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+  };
+
+  static uint32_t Hash(const SkPath&);
+
+  Entry* find(const SkPath&) SK_REQUIRES(fMutex);
+  // Finds or makes the entry for a path, and makes it the most recently used.
+  Entry* findOrAdd(const SkPath&) SK_REQUIRES(fMutex);
+  void add(const SkPath&, sk_sp<InnerFan>) SK_REQUIRES(fMutex);
+  void add(const SkPath&, sk_sp<Mesh>) SK_REQUIRES(fMutex);
+  void remove(Entry*) SK_REQUIRES(fMutex);
+  void purge() SK_REQUIRES(fMutex);
+
+  mutable SkMutex fMutex;
+  SkTHashMap<uint32_t, Entry*> fEntries SK_GUARDED_BY(fMutex);  // By hash.
+  SkTHashMap<uint32_t, Entry*> fGenIDs SK_GUARDED_BY(fMutex);
+  SkTInternalLList<Entry> fLRU SK_GUARDED_BY(fMutex);  // Most recently used at the head.
+  size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+  int fHits SK_GUARDED_BY(fMutex) = 0;
+  int fMisses SK_GUARDED_BY(fMutex) = 0;
+  const size_t fByteLimit;
+};
+
+#endif  // GrTriangulatorCache_DEFINED
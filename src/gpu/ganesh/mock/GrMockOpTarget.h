@@ -30,6 +30,9 @@ class GrMockOpTarget : public GrMeshDrawTarget {
   GrThreadSafeCache* threadSafeCache() const override {
     return fMockContext->priv().threadSafeCache();
   }
+  GrTriangulatorCache* triangulatorCache() const override {
+    return fMockContext->priv().triangulatorCache();
+  }
   GrResourceProvider* resourceProvider() const override {
     return fMockContext->priv().resourceProvider();
   }
@@ -28,6 +28,8 @@
 #include "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h"
 #include "src/gpu/ganesh/v1/SurfaceDrawContext_v1.h"
 
+#include <vector>
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace skgpu::v1 {
 
@@ -178,6 +180,15 @@ class AAFlatteningConvexPathOp final : public GrMeshDrawOp {
     fMeshes.push_back(mesh);
   }
 
+  bool hasConcurrentPrepare() const override { return fTessellators.empty(); }
+
+  void onPrepareConcurrently(GrRecordingContext*) override {
+    fTessellators.reserve(fPaths.count());
+    for (const PathData& args : fPaths) {
+      fTessellators.push_back(Tessellate(args));
+    }
+  }
+
   void onPrepareDraws(GrMeshDrawTarget* target) override {
     if (!fProgramInfo) {
       this->createProgramInfo(target);
@@ -197,13 +208,13 @@ class AAFlatteningConvexPathOp final : public GrMeshDrawOp {
     uint16_t* indices = (uint16_t*)sk_malloc_throw(maxIndices * sizeof(uint16_t));
     for (int i = 0; i < instanceCount; i++) {
       const PathData& args = fPaths[i];
-      GrAAConvexTessellator tess(args.fStyle, args.fStrokeWidth, args.fJoin, args.fMiterLimit);
-
-      if (!tess.tessellate(args.fViewMatrix, args.fPath)) {
+      std::unique_ptr<GrAAConvexTessellator> tess =
+          fTessellators.empty() ? Tessellate(args) : std::move(fTessellators[i]);
+      if (!tess) {
         continue;
       }
 
-      int currentVertices = tess.numPts();
+      int currentVertices = tess->numPts();
       if (vertexCount + currentVertices > static_cast<int>(UINT16_MAX)) {
         // if we added the current instance, we would overflow the indices we can store in a
         // uint16_t. Draw what we've got so far and reset.
@@ -220,7 +231,7 @@ class AAFlatteningConvexPathOp final : public GrMeshDrawOp {
         }
         vertices = (uint8_t*)sk_realloc_throw(vertices, maxVertices * vertexStride);
       }
-      int currentIndices = tess.numIndices();
+      int currentIndices = tess->numIndices();
       if (indexCount + currentIndices > maxIndices) {
         maxIndices = std::max(indexCount + currentIndices, maxIndices * 2);
         if (maxIndices * sizeof(uint16_t) > SK_MaxS32) {
@@ -241,7 +252,7 @@ class AAFlatteningConvexPathOp final : public GrMeshDrawOp {
       }
 
       extract_verts(
-          tess, localCoordsMatrix, vertices + vertexStride * vertexCount,
+          *tess, localCoordsMatrix, vertices + vertexStride * vertexCount,
           VertexColor(args.fColor, fWideColor), vertexCount, indices + indexCount);
       vertexCount += currentVertices;
       indexCount += currentIndices;
@@ -300,10 +311,23 @@ class AAFlatteningConvexPathOp final : public GrMeshDrawOp {
     SkPaint::Join fJoin;
   };
 
+  // Returns null if the path can't be tessellated.
+  static std::unique_ptr<GrAAConvexTessellator> Tessellate(const PathData& args) {
+    auto tess = std::make_unique<GrAAConvexTessellator>(
+        args.fStyle, args.fStrokeWidth, args.fJoin, args.fMiterLimit);
+    if (!tess->tessellate(args.fViewMatrix, args.fPath)) {
+      return nullptr;
+    }
+    return tess;
+  }
+
   SkSTArray<1, PathData, true> fPaths;
   Helper fHelper;
   bool fWideColor;
 
+  // One for each of fPaths, null where it couldn't be tessellated, if onPrepareConcurrently()
+  // has been called.
+  std::vector<std::unique_ptr<GrAAConvexTessellator>> fTessellators;
   SkTDArray<GrSimpleMesh*> fMeshes;
   GrProgramInfo* fProgramInfo = nullptr;
 
@@ -181,6 +181,23 @@ class GrOp : private SkNoncopyable {
     this->onPrePrepare(context, dstView, clip, dstProxyView, renderPassXferBarriers, colorLoadOp);
   }
 
+  /**
+   * Ops that spend a lot of CPU time building their vertex data can return true here and do that
+   * work in onPrepareConcurrently() instead of prepare(). When the context's options ask for it,
+   * OpsTask calls prepareConcurrently() for all such ops at once on the context's executor, and
+   * then prepares them in order as usual.
+   */
+  virtual bool hasConcurrentPrepare() const { return false; }
+
+  /**
+   * Called at most once, before 'prepare', and possibly on another thread at the same time as
+   * other ops. The op may only use its own data and the context's thread-safe cache.
+   */
+  void prepareConcurrently(GrRecordingContext* context) {
+    TRACE_EVENT0_ALWAYS("skia.gpu", name());
+    this->onPrepareConcurrently(context);
+  }
+
   /**
    * Called prior to executing. The op should perform any resource creation or data transfers
    * necessary before execute() is called.
@@ -308,6 +325,7 @@ class GrOp : private SkNoncopyable {
   virtual void onPrePrepare(
       GrRecordingContext*, const GrSurfaceProxyView& writeView, GrAppliedClip*,
       const GrDstProxyView&, GrXferBarrierFlags renderPassXferBarriers, GrLoadOp colorLoadOp) = 0;
+  virtual void onPrepareConcurrently(GrRecordingContext*) {}
   virtual void onPrepare(GrOpFlushState*) = 0;
   // If this op is chained then chainBounds is the union of the bounds of all ops in the chain.
   // Otherwise, this op's bounds.
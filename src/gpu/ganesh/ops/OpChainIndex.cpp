@@ -0,0 +1,160 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/ops/OpChainIndex.h"
+
+#include "include/private/SkTPin.h"
+#include "src/gpu/ganesh/geometry/GrRect.h"
+
+#include <algorithm>
+
+namespace skgpu::v1 {
+
+namespace {
+
+// Adds 'index' to a list sorted in increasing order, unless it's already there. It's almost
+// always the greatest so far.
+void insert_sorted(SkTDArray<int>* list, int index) {
+  if (list->empty() || list->back() < index) {
+    list->push_back(index);
+    return;
+  }
+  int* pos = std::lower_bound(list->begin(), list->end(), index);
+  if (*pos != index) {
+    *list->insert(SkToInt(pos - list->begin())) = index;
+  }
+}
+
+}  // namespace
+
+void OpChainIndex::reset(const SkRect& targetBounds) {
+  fTargetBounds = targetBounds;
+  fCellsPerPixel = {
+      targetBounds.width() > 0 ? kGridSize / targetBounds.width() : 0,
+      targetBounds.height() > 0 ? kGridSize / targetBounds.height() : 0};
+  fChains.reset();
+  fCells.clear();
+  fCells.resize(kGridSize * kGridSize);
+  fLargeChains.reset();
+  fClasses.reset();
+}
+
+void OpChainIndex::clear() {
+  fChains.reset();
+  std::vector<SkTDArray<int>>().swap(fCells);
+  fLargeChains.reset();
+  fClasses.reset();
+}
+
+SkIRect OpChainIndex::cellsFor(const SkRect& bounds) const {
+  // Pin in float, so huge bounds can't overflow the conversion to int.
+  auto toCell = [](float pixel, float origin, float cellsPerPixel) {
+    return (int)SkTPin((pixel - origin) * cellsPerPixel, 0.f, (float)(kGridSize - 1));
+  };
+  return {
+      toCell(bounds.fLeft, fTargetBounds.fLeft, fCellsPerPixel.fX),
+      toCell(bounds.fTop, fTargetBounds.fTop, fCellsPerPixel.fY),
+      toCell(bounds.fRight, fTargetBounds.fLeft, fCellsPerPixel.fX),
+      toCell(bounds.fBottom, fTargetBounds.fTop, fCellsPerPixel.fY)};
+}
+
+void OpChainIndex::addChain(uint32_t classID, const SkRect& bounds) {
+  SkASSERT(!fCells.empty());
+  int index = fChains.count();
+  // Inverted cells, so growChain() files it everywhere.
+  fChains.push_back({bounds, SkIRect::MakeLTRB(0, 0, -1, -1), false});
+  this->growChain(index, bounds);
+  if (SkTDArray<int>* list = fClasses.find(classID)) {
+    list->push_back(index);
+  } else {
+    fClasses.set(classID, SkTDArray<int>())->push_back(index);
+  }
+}
+
+void OpChainIndex::growChain(int index, const SkRect& bounds) {
+  Chain& chain = fChains[index];
+  chain.fBounds = bounds;
+  if (chain.fLarge) {
+    return;
+  }
+  const SkIRect cells = this->cellsFor(bounds);
+  if ((cells.width() + 1) * (cells.height() + 1) > kMaxCellsPerChain) {
+    // Entries left behind in cells are harmless; queries check the chain's bounds.
+    chain.fLarge = true;
+    insert_sorted(&fLargeChains, index);
+    return;
+  }
+  for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+    for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+      if (x >= chain.fCells.fLeft && x <= chain.fCells.fRight &&
+          y >= chain.fCells.fTop && y <= chain.fCells.fBottom) {
+        continue;  // Already filed here.
+      }
+      insert_sorted(&this->cell(x, y), index);
+    }
+  }
+  chain.fCells = cells;
+}
+
+int OpChainIndex::lastOverlap(const SkRect& bounds, int end) const {
+  int found = -1;
+  auto search = [&](const SkTDArray<int>& list) {
+    // Walk back from the last index before 'end', until we pass what we've already found.
+    const int* it = std::lower_bound(list.begin(), list.end(), end);
+    while (it != list.begin()) {
+      int index = *--it;
+      if (index <= found) {
+        return;
+      }
+      if (GrRectsOverlap(fChains[index].fBounds, bounds)) {
+        found = index;
+        return;
+      }
+    }
+  };
+  search(fLargeChains);
+  const SkIRect cells = this->cellsFor(bounds);
+  for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+    for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+      search(this->cell(x, y));
+    }
+  }
+  return found;
+}
+
+int OpChainIndex::firstOverlap(const SkRect& bounds, int start) const {
+  int found = fChains.count();
+  auto search = [&](const SkTDArray<int>& list) {
+    for (const int* it = std::upper_bound(list.begin(), list.end(), start); it != list.end();
+         ++it) {
+      if (*it >= found) {
+        return;
+      }
+      if (GrRectsOverlap(fChains[*it].fBounds, bounds)) {
+        found = *it;
+        return;
+      }
+    }
+  };
+  search(fLargeChains);
+  const SkIRect cells = this->cellsFor(bounds);
+  for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+    for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+      search(this->cell(x, y));
+    }
+  }
+  return found;
+}
+
+SkSpan<const int> OpChainIndex::chainsOfClass(uint32_t classID) const {
+  if (const SkTDArray<int>* list = fClasses.find(classID)) {
+    return {list->begin(), SkToSizeT(list->count())};
+  }
+  return {};
+}
+
+}  // namespace skgpu::v1
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef OpChainIndex_DEFINED
+#define OpChainIndex_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/core/SkSpan.h"
+#include "include/private/SkTArray.h"
+#include "include/private/SkTDArray.h"
+#include "include/private/SkTHash.h"
+
+#include <vector>
+
+namespace skgpu::v1 {
+
+/**
+ * Finds an OpsTask's op chains by bounds and by op class without visiting every chain, so the task
+ * can look for merge candidates past the few chains it checks one at a time.
+ *
+ * Chains are identified by their index in the task and added in order. Each is filed in the cells
+ * of a coarse grid over the target that its bounds touch, or in a separate list if it covers much
+ * of the grid. Bounds may only grow, which files the chain in any new cells it touches.
+ */
+class OpChainIndex {
+ public:
+  OpChainIndex() = default;
+
+  // Empties the index and sets the area the grid covers. Chains may extend past it.
+  void reset(const SkRect& targetBounds);
+  // Empties the index and frees its memory.
+  void clear();
+
+  int count() const { return fChains.count(); }
+
+  void addChain(uint32_t classID, const SkRect& bounds);
+  void growChain(int index, const SkRect& bounds);
+
+  // Returns the greatest index less than 'end' of a chain that overlaps 'bounds', or -1.
+  int lastOverlap(const SkRect& bounds, int end) const;
+
+  // Returns the least index greater than 'start' of a chain that overlaps 'bounds', or count().
+  int firstOverlap(const SkRect& bounds, int start) const;
+
+  // The indices of the chains whose ops have this class ID, in increasing order.
+  SkSpan<const int> chainsOfClass(uint32_t classID) const;
+
+ private:
+  static constexpr int kGridSize = 16;
+  // Chains that cover more cells than this are kept in fLargeChains instead.
+  static constexpr int kMaxCellsPerChain = kGridSize * kGridSize / 4;
+
+  struct Chain {
+    SkRect fBounds;
+    SkIRect fCells;  // Inclusive.
+    bool fLarge;
+  };
+
+  SkIRect cellsFor(const SkRect&) const;
+  SkTDArray<int>& cell(int x, int y) { return fCells[y * kGridSize + x]; }
+  const SkTDArray<int>& cell(int x, int y) const { return fCells[y * kGridSize + x]; }
+
+  SkRect fTargetBounds = SkRect::MakeEmpty();
+  SkVector fCellsPerPixel = {0, 0};
+  SkTArray<Chain> fChains;
+  std::vector<SkTDArray<int>> fCells;
+  SkTDArray<int> fLargeChains;
+  SkTHashMap<uint32_t, SkTDArray<int>> fClasses;
+};
+
+}  // namespace skgpu::v1
+
+#endif  // OpChainIndex_DEFINED
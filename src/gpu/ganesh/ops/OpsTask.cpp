@@ -7,13 +7,16 @@
 
 #include "src/gpu/ganesh/ops/OpsTask.h"
 
+#include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkScopeExit.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/GrAttachment.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
@@ -32,6 +35,9 @@ namespace {
 // Experimentally we have found that most combining occurs within the first 10 comparisons.
 static const int kMaxOpMergeDistance = 10;
 static const int kMaxOpChainDistance = 10;
+// Past kMaxOpChainDistance, chains of the op's class that fChainIndex finds can be reached without
+// reordering anything that overlaps. Only try this many of them, nearest first.
+static const int kMaxIndexedCandidates = 10;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -395,6 +401,7 @@ void OpsTask::deleteOps() {
     chain.deleteOps();
   }
   fOpChains.reset();
+  fChainIndex.clear();
 }
 
 OpsTask::~OpsTask() { this->deleteOps(); }
@@ -493,6 +500,8 @@ void OpsTask::onPrepare(GrOpFlushState* flushState) {
   }
   TRACE_EVENT0_ALWAYS("skia.gpu", TRACE_FUNC);
 
+  this->prepareOpsConcurrently(flushState->gpu()->getContext());
+
   flushState->setSampledProxyArray(&fSampledProxies);
   GrSurfaceProxyView dstView(sk_ref_sp(this->target(0)), fTargetOrigin, fTargetSwizzle);
   // Loop over the ops that haven't yet been prepared.
@@ -517,6 +526,32 @@ void OpsTask::onPrepare(GrOpFlushState* flushState) {
   flushState->setSampledProxyArray(nullptr);
 }
 
+void OpsTask::prepareOpsConcurrently(GrDirectContext* dContext) {
+  const GrContextOptions& options = dContext->priv().options();
+  if (!options.fPrepareOpsInParallel || !options.fExecutor) {
+    return;
+  }
+  SkSTArray<16, GrOp*> ops;
+  for (const auto& chain : fOpChains) {
+    if (chain.shouldExecute()) {
+      for (GrOp* op = chain.head(); op; op = op->nextInChain()) {
+        if (op->hasConcurrentPrepare()) {
+          ops.push_back(op);
+        }
+      }
+    }
+  }
+  if (ops.count() < 2) {
+    // The op will be prepared soon enough on this thread.
+    return;
+  }
+  TRACE_EVENT1("skia.gpu", TRACE_FUNC, "ops", ops.count());
+  // Our own group, so we don't wait on the software path renderer's masks.
+  SkTaskGroup taskGroup(*options.fExecutor);
+  taskGroup.batch(ops.count(), [&ops, dContext](int i) { ops[i]->prepareConcurrently(dContext); });
+  taskGroup.wait();
+}
+
 // TODO: this is where GrOp::renderTarget is used (which is fine since it
 // is at flush time). However, we need to store the RenderTargetProxy in the
 // Ops and instantiate them here.
@@ -936,6 +971,7 @@ void OpsTask::recordOp(
           std::move(op), processorAnalysis, dstProxyView, clip, caps, fArenas->arenaAlloc(),
           fAuditTrail);
       if (!op) {
+        this->chainGrew(fOpChains.count() - 1 - i);
         return;
       }
       // Stop going backwards if we would cause a painter's order violation.
@@ -950,6 +986,29 @@ void OpsTask::recordOp(
         break;
       }
     }
+    if (i == kMaxOpChainDistance && fOpChains.count() > kMaxOpChainDistance) {
+      // Nothing nearby blocked us, so look further back for chains of the same class. We can
+      // append to any of them that come after the last chain the op overlaps.
+      this->indexOpChains();
+      int end = fOpChains.count() - kMaxOpChainDistance;
+      int blocker = fChainIndex.lastOverlap(op->bounds(), end);
+      SkSpan<const int> sameClass = fChainIndex.chainsOfClass(op->classID());
+      auto it = std::lower_bound(sameClass.begin(), sameClass.end(), end);
+      for (int tries = 0; it != sameClass.begin() && tries < kMaxIndexedCandidates; ++tries) {
+        int index = *--it;
+        if (index < blocker) {
+          break;
+        }
+        op = fOpChains[index].appendOp(
+            std::move(op), processorAnalysis, dstProxyView, clip, caps, fArenas->arenaAlloc(),
+            fAuditTrail);
+        if (!op) {
+          GrOP_INFO("\t\tBackward: Appended to indexed chain %d\n", index);
+          fChainIndex.growChain(index, fOpChains[index].bounds());
+          return;
+        }
+      }
+    }
   } else {
     GrOP_INFO("\t\tBackward: FirstOp\n");
   }
@@ -963,6 +1022,10 @@ void OpsTask::recordOp(
 void OpsTask::forwardCombine(const GrCaps& caps) {
   SkASSERT(!this->isClosed());
   GrOP_INFO("opsTask: %d ForwardCombine %d ops:\n", this->uniqueID(), fOpChains.count());
+  if (fOpChains.count() > kMaxOpChainDistance + 1) {
+    // Index every chain before any are emptied below.
+    this->indexOpChains();
+  }
 
   for (int i = 0; i < fOpChains.count() - 1; ++i) {
     OpChain& chain = fOpChains[i];
@@ -971,6 +1034,7 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
     while (true) {
       OpChain& candidate = fOpChains[j];
       if (candidate.prependChain(&chain, caps, fArenas->arenaAlloc(), fAuditTrail)) {
+        this->chainGrew(j);
         break;
       }
       // Stop traversing if we would cause a painter's order violation.
@@ -986,15 +1050,50 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
         GrOP_INFO(
             "\t\t%d: chain (%s opID: %u) -> Reached max lookahead or end of array\n", i,
             chain.head()->name(), chain.head()->uniqueID());
+        if (j < fOpChains.count()) {
+          this->forwardCombineIndexed(i, j, caps);
+        }
         break;
       }
     }
   }
 }
 
+void OpsTask::forwardCombineIndexed(int i, int start, const GrCaps& caps) {
+  // Nothing up to 'start' blocked chain i, so look further ahead for chains of the same class. We
+  // can prepend it to any of them up to and including the first chain it overlaps.
+  SkASSERT(fChainIndex.count() == fOpChains.count());
+  OpChain& chain = fOpChains[i];
+  int blocker = fChainIndex.firstOverlap(chain.bounds(), start - 1);
+  SkSpan<const int> sameClass = fChainIndex.chainsOfClass(chain.head()->classID());
+  auto it = std::lower_bound(sameClass.begin(), sameClass.end(), start);
+  for (int tries = 0; it != sameClass.end() && tries < kMaxIndexedCandidates; ++it, ++tries) {
+    int j = *it;
+    if (j > blocker) {
+      break;
+    }
+    if (fOpChains[j].prependChain(&chain, caps, fArenas->arenaAlloc(), fAuditTrail)) {
+      GrOP_INFO("\t\t%d: chain -> Prepended to indexed chain %d\n", i, j);
+      fChainIndex.growChain(j, fOpChains[j].bounds());
+      return;
+    }
+  }
+}
+
+void OpsTask::indexOpChains() {
+  if (!fChainIndex.count()) {
+    fChainIndex.reset(this->target(0)->backingStoreBoundsRect());
+  }
+  for (int i = fChainIndex.count(); i < fOpChains.count(); ++i) {
+    SkASSERT(fOpChains[i].head());
+    fChainIndex.addChain(fOpChains[i].head()->classID(), fOpChains[i].bounds());
+  }
+}
+
 GrRenderTask::ExpectedOutcome OpsTask::onMakeClosed(
     GrRecordingContext* rContext, SkIRect* targetUpdateBounds) {
   this->forwardCombine(*rContext->priv().caps());
+  fChainIndex.clear();
   if (!this->isColorNoOp()) {
     GrSurfaceProxy* proxy = this->target(0);
     // Use the entire backing store bounds since the GPU doesn't clip automatically to the
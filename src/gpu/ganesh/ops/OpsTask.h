@@ -26,6 +26,7 @@
 #include "src/gpu/ganesh/GrProcessorSet.h"
 #include "src/gpu/ganesh/GrRenderTask.h"
 #include "src/gpu/ganesh/ops/GrOp.h"
+#include "src/gpu/ganesh/ops/OpChainIndex.h"
 
 class GrAuditTrail;
 class GrCaps;
@@ -238,8 +239,22 @@ class OpsTask : public GrRenderTask {
 
   void gatherProxyIntervals(GrResourceAllocator*) const override;
 
+  // Lets the ops that build their vertex data on the CPU do so in parallel, if the context allows.
+  void prepareOpsConcurrently(GrDirectContext*);
+
   void forwardCombine(const GrCaps&);
 
+  // Tries the chains after index 'start' that fChainIndex says chain i could be prepended to.
+  void forwardCombineIndexed(int i, int start, const GrCaps&);
+  // Brings fChainIndex up to date with fOpChains, creating it if need be.
+  void indexOpChains();
+  // Tells fChainIndex that a chain's bounds may have grown, if it has been indexed.
+  void chainGrew(int index) {
+    if (index < fChainIndex.count()) {
+      fChainIndex.growChain(index, fOpChains[index].bounds());
+    }
+  }
+
   // Remove all ops, proxies, etc. Used in the merging algorithm when tasks can be skipped.
   void reset();
 
@@ -271,6 +286,9 @@ class OpsTask : public GrRenderTask {
 
   // For ops/opsTask we have mean: 5 stdDev: 28
   SkSTArray<25, OpChain> fOpChains;
+  // Used to look for merge candidates beyond kMaxOpChainDistance while the task is open. Only
+  // built once there are that many chains.
+  OpChainIndex fChainIndex;
 
   sk_sp<GrArenas> fArenas;
   SkDEBUGCODE(int fNumClips;)
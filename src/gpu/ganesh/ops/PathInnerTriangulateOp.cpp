@@ -7,6 +7,8 @@
 
 #include "src/gpu/ganesh/ops/PathInnerTriangulateOp.h"
 
+#include "include/gpu/GrDirectContext.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
@@ -173,6 +175,20 @@ std::unique_ptr<GrGeometryProcessor::ProgramImpl> HullShader::makeProgramImpl(
   return std::make_unique<Impl>();
 }
 
+// Copies triangles made on the CPU into a vertex buffer. Returns how many vertices it wrote.
+int copy_fan_vertices(GrEagerVertexAllocator* alloc, const SkPoint* vertices, int vertexCount) {
+  if (!vertexCount) {
+    return 0;
+  }
+  void* data = alloc->lock(sizeof(SkPoint), vertexCount);
+  if (!data) {
+    return 0;
+  }
+  memcpy(data, vertices, vertexCount * sizeof(SkPoint));
+  alloc->unlock(vertexCount);
+  return vertexCount;
+}
+
 }  // anonymous namespace
 
 void PathInnerTriangulateOp::visitProxies(const GrVisitProxyFunc& func) const {
@@ -217,8 +233,10 @@ void PathInnerTriangulateOp::pushFanFillProgram(
 }
 
 void PathInnerTriangulateOp::prePreparePrograms(
-    const GrTessellationShader::ProgramArgs& args, GrAppliedClip&& appliedClip) {
+    const GrTessellationShader::ProgramArgs& args, GrAppliedClip&& appliedClip,
+    GrTriangulatorCache* triangulatorCache) {
   SkASSERT(!fFanTriangulator);
+  SkASSERT(!fCachedFan);
   SkASSERT(!fFanPolys);
   SkASSERT(!fPipelineForFills);
   SkASSERT(!fTessellator);
@@ -236,9 +254,21 @@ void PathInnerTriangulateOp::prePreparePrograms(
       (fPathFlags & (FillPathFlags::kStencilOnly | FillPathFlags::kWireframe));
   bool doFill = !(fPathFlags & FillPathFlags::kStencilOnly);
 
+  // The fan is triangulated in the path's own space, so a static path can reuse it from an
+  // earlier flush no matter how it's transformed now.
+  if (!fPath.isVolatile()) {
+    fTriangulatorCache = triangulatorCache;
+  }
   bool isLinear;
-  fFanTriangulator = args.fArena->make<GrInnerFanTriangulator>(fPath, args.fArena);
-  fFanPolys = fFanTriangulator->pathToPolys(&fFanBreadcrumbs, &isLinear);
+  if (fTriangulatorCache && (fCachedFan = fTriangulatorCache->findInnerFan(fPath))) {
+    isLinear = fCachedFan->fIsLinear;
+    fCachedFan->appendBreadcrumbs(args.fArena, &fFanBreadcrumbs);
+  } else {
+    fFanTriangulator = args.fArena->make<GrInnerFanTriangulator>(fPath, args.fArena);
+    fFanPolys = fFanTriangulator->pathToPolys(&fFanBreadcrumbs, &isLinear);
+    fFanSplitBreadcrumbCount = fFanBreadcrumbs.count();
+  }
+  bool hasFan = fCachedFan ? fCachedFan->vertexCount() > 0 : fFanPolys != nullptr;
 
   // Create a pipeline for stencil passes if needed.
   const GrPipeline* pipelineForStencils = nullptr;
@@ -270,7 +300,7 @@ void PathInnerTriangulateOp::prePreparePrograms(
   }
 
   // Pass 2: Fill the path's inner fan with a stencil test against the curves.
-  if (fFanPolys) {
+  if (hasFan) {
     if (forceRedbookStencilPass) {
       // Use a standard Redbook "stencil then cover" algorithm instead of bypassing the
       // stencil buffer to fill the fan directly.
@@ -366,7 +396,7 @@ void PathInnerTriangulateOp::onPrePrepare(
   this->prePreparePrograms(
       {context->priv().recordTimeAllocator(), writeView, usesMSAASurface, &dstProxyView,
        renderPassXferBarriers, colorLoadOp, context->priv().caps()},
-      (clip) ? std::move(*clip) : GrAppliedClip::Disabled());
+      (clip) ? std::move(*clip) : GrAppliedClip::Disabled(), context->priv().triangulatorCache());
   if (fStencilCurvesProgram) {
     context->priv().recordProgramInfo(fStencilCurvesProgram);
   }
@@ -383,18 +413,39 @@ SKGPU_DECLARE_STATIC_UNIQUE_KEY(gHullVertexBufferKey);
 void PathInnerTriangulateOp::onPrepare(GrOpFlushState* flushState) {
   const GrCaps& caps = flushState->caps();
 
-  if (!fFanTriangulator) {
+  if (!fFanTriangulator && !fCachedFan) {
+    GrDirectContext* dContext = flushState->gpu()->getContext();
     this->prePreparePrograms(
         {flushState->allocator(), flushState->writeView(), flushState->usesMSAASurface(),
          &flushState->dstProxyView(), flushState->renderPassBarriers(), flushState->colorLoadOp(),
          &caps},
-        flushState->detachAppliedClip());
-    if (!fFanTriangulator) {
+        flushState->detachAppliedClip(), dContext->priv().triangulatorCache());
+    if (!fFanTriangulator && !fCachedFan) {
       return;
     }
   }
 
-  if (fFanPolys) {
+  if (fCachedFan) {
+    GrEagerDynamicVertexAllocator alloc(flushState, &fFanBuffer, &fBaseFanVertex);
+    fFanVertexCount =
+        copy_fan_vertices(&alloc, fCachedFan->fVertices.data(), fCachedFan->vertexCount());
+  } else if (fFanPolys && fTriangulatorCache) {
+    // Triangulate into CPU memory first, so the triangles can be cached for later flushes.
+    GrCpuVertexAllocator cpuAlloc;
+    int vertexCount = fFanTriangulator->polysToTriangles(fFanPolys, &cpuAlloc, &fFanBreadcrumbs);
+    sk_sp<GrThreadSafeCache::VertexData> vertexData;
+    const SkPoint* vertices = nullptr;
+    if (vertexCount) {
+      vertexData = cpuAlloc.detachVertexData();
+      vertices = static_cast<const SkPoint*>(vertexData->vertices());
+    }
+    // Only paths with curves get a tessellator.
+    fTriangulatorCache->addInnerFan(
+        fPath, /*isLinear=*/!fTessellator, vertices, vertexCount, fFanBreadcrumbs,
+        fFanSplitBreadcrumbCount);
+    GrEagerDynamicVertexAllocator alloc(flushState, &fFanBuffer, &fBaseFanVertex);
+    fFanVertexCount = copy_fan_vertices(&alloc, vertices, vertexCount);
+  } else if (fFanPolys) {
     GrEagerDynamicVertexAllocator alloc(flushState, &fFanBuffer, &fBaseFanVertex);
     fFanVertexCount = fFanTriangulator->polysToTriangles(fFanPolys, &alloc, &fFanBreadcrumbs);
   }
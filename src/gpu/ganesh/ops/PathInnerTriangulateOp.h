@@ -9,6 +9,7 @@
 #define PathInnerTriangulateOp_DEFINED
 
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/gpu/ganesh/ops/FillPathFlags.h"
 #include "src/gpu/ganesh/ops/GrDrawOp.h"
 #include "src/gpu/ganesh/tessellate/GrTessellationShader.h"
@@ -53,7 +54,8 @@ class PathInnerTriangulateOp final : public GrDrawOp {
       const GrTessellationShader::ProgramArgs&, const GrPipeline* pipelineForStencils,
       const GrUserStencilSettings*);
   void pushFanFillProgram(const GrTessellationShader::ProgramArgs&, const GrUserStencilSettings*);
-  void prePreparePrograms(const GrTessellationShader::ProgramArgs&, GrAppliedClip&&);
+  void prePreparePrograms(
+      const GrTessellationShader::ProgramArgs&, GrAppliedClip&&, GrTriangulatorCache*);
 
   void onPrePrepare(
       GrRecordingContext*, const GrSurfaceProxyView&, GrAppliedClip*, const GrDstProxyView&,
@@ -68,10 +70,14 @@ class PathInnerTriangulateOp final : public GrDrawOp {
   SkPMColor4f fColor;
   GrProcessorSet fProcessors;
 
-  // Triangulates the inner fan.
+  // Triangulates the inner fan, unless fCachedFan was found in fTriangulatorCache. The cache is
+  // null if disabled or if the path is volatile.
+  GrTriangulatorCache* fTriangulatorCache = nullptr;
+  sk_sp<const GrTriangulatorCache::InnerFan> fCachedFan;
   GrInnerFanTriangulator* fFanTriangulator = nullptr;
   GrTriangulator::Poly* fFanPolys = nullptr;
   GrInnerFanTriangulator::BreadcrumbTriangleList fFanBreadcrumbs;
+  int fFanSplitBreadcrumbCount = 0;  // How many of fFanBreadcrumbs came from pathToPolys().
 
   // This pipeline is shared by all programs that do filling.
   const GrPipeline* fPipelineForFills = nullptr;
@@ -89,7 +95,7 @@ class PathInnerTriangulateOp final : public GrDrawOp {
   // Pass 3: Draw convex hulls around each curve.
   const GrProgramInfo* fCoverHullsProgram = nullptr;
 
-  // This buffer gets created by fFanTriangulator during onPrepare.
+  // This buffer gets created by fFanTriangulator, or from fCachedFan, during onPrepare.
   sk_sp<const GrBuffer> fFanBuffer;
   int fBaseFanVertex = 0;
   int fFanVertexCount = 0;
@@ -26,6 +26,7 @@
 #include "src/gpu/ganesh/geometry/GrPathUtils.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/gpu/ganesh/ops/GrMeshDrawOp.h"
 #include "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h"
 #include "src/gpu/ganesh/v1/SurfaceDrawContext_v1.h"
@@ -36,6 +37,12 @@
 #  define GR_AA_TESSELLATOR_MAX_VERB_COUNT 10
 #endif
 
+// Paths with at least this many points are triangulated by GrSweepTriangulator, which scales better
+// than GrTriangulator's mesh, but costs more to set up.
+#ifndef GR_TRIANGULATOR_SWEEP_MIN_POINT_COUNT
+#  define GR_TRIANGULATOR_SWEEP_MIN_POINT_COUNT 256
+#endif
+
 /*
  * This path renderer linearizes and decomposes the path into triangles using GrTriangulator,
  * uploads the triangles to a vertex buffer, and renders them with a single draw call. It can do
@@ -260,7 +267,44 @@ class TriangulatingPathOp final : public GrMeshDrawOp {
     SkPath path;
     shape.asPath(&path);
 
-    return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear);
+    GrTriangulator::Engine engine = path.countPoints() >= GR_TRIANGULATOR_SWEEP_MIN_POINT_COUNT
+                                        ? GrTriangulator::Engine::kSweep
+                                        : GrTriangulator::Engine::kMesh;
+    return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear, engine);
+  }
+
+  // Triangulates the path into CPU memory, or copies a triangulation from the
+  // GrTriangulatorCache. Unlike GrThreadSafeCache, that cache is shared by every context, can be
+  // saved between runs, and finds paths by their contents, so a path that's rebuilt each frame
+  // still hits. Its meshes are in path space, so moving the path with a translate still hits too.
+  // On a hit, 'tol' becomes the tolerance the cached mesh was made with.
+  sk_sp<GrThreadSafeCache::VertexData> triangulateWithCache(
+      GrTriangulatorCache* cache, SkScalar* tol, bool* isLinear) const {
+    SkASSERT(!fAntiAlias && !fShape.inverseFilled());
+    SkPath path = this->getPath();
+    SkASSERT(!path.isVolatile());
+    if (sk_sp<const GrTriangulatorCache::Mesh> mesh = cache->findMesh(path, *tol)) {
+      size_t size = mesh->fVertices.size() * sizeof(SkPoint);
+      void* verts = sk_malloc_throw(size);
+      memcpy(verts, mesh->fVertices.data(), size);
+      *tol = mesh->fTolerance;
+      *isLinear = mesh->fIsLinear;
+      return GrThreadSafeCache::MakeVertexData(verts, mesh->vertexCount(), sizeof(SkPoint));
+    }
+    GrCpuVertexAllocator allocator;
+    int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, *tol, isLinear);
+    if (vertexCount == 0) {
+      return nullptr;
+    }
+    sk_sp<GrThreadSafeCache::VertexData> vertexData = allocator.detachVertexData();
+    cache->addMesh(
+        path, *tol, *isLinear, static_cast<const SkPoint*>(vertexData->vertices()), vertexCount);
+    return vertexData;
+  }
+
+  // Inverse fills depend on the clip bounds, which aren't part of the GrTriangulatorCache's key.
+  GrTriangulatorCache* triangulatorCacheFor(GrTriangulatorCache* cache) const {
+    return (!fShape.inverseFilled() && !this->getPath().isVolatile()) ? cache : nullptr;
   }
 
   void createNonAAMesh(GrMeshDrawTarget* target) {
@@ -299,16 +343,34 @@ class TriangulatingPathOp final : public GrMeshDrawOp {
       return;
     }
 
-    bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
-    StaticVertexAllocator allocator(rp, canMapVB);
-
     bool isLinear;
-    int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol, &isLinear);
-    if (vertexCount == 0) {
-      return;
-    }
+    int vertexCount;
+    if (GrTriangulatorCache* cache = this->triangulatorCacheFor(target->triangulatorCache())) {
+      sk_sp<GrThreadSafeCache::VertexData> vertexData =
+          this->triangulateWithCache(cache, &tol, &isLinear);
+      if (!vertexData) {
+        return;
+      }
+      sk_sp<GrGpuBuffer> buffer = rp->createBuffer(
+          vertexData->vertices(), vertexData->size(), GrGpuBufferType::kVertex,
+          kStatic_GrAccessPattern);
+      if (!buffer) {
+        return;
+      }
+      vertexData->setGpuBuffer(std::move(buffer));
+      vertexCount = vertexData->numVertices();
+      fVertexData = std::move(vertexData);
+    } else {
+      bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
+      StaticVertexAllocator allocator(rp, canMapVB);
 
-    fVertexData = allocator.detachVertexData();
+      vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol, &isLinear);
+      if (vertexCount == 0) {
+        return;
+      }
+
+      fVertexData = allocator.detachVertexData();
+    }
 
     key.setCustomData(create_data(vertexCount, isLinear, tol));
 
@@ -329,8 +391,20 @@ class TriangulatingPathOp final : public GrMeshDrawOp {
   }
 
   void createAAMesh(GrMeshDrawTarget* target) {
-    SkASSERT(!fVertexData);
     SkASSERT(fAntiAlias);
+    if (fVertexData) {
+      // onPrepareConcurrently() already triangulated the path.
+      sk_sp<const GrBuffer> vertexBuffer;
+      int firstVertex;
+      void* verts = target->makeVertexSpace(
+          fVertexData->vertexSize(), fVertexData->numVertices(), &vertexBuffer, &firstVertex);
+      if (!verts) {
+        return;
+      }
+      memcpy(verts, fVertexData->vertices(), fVertexData->size());
+      fMesh = CreateMesh(target, std::move(vertexBuffer), firstVertex, fVertexData->numVertices());
+      return;
+    }
     SkPath path = this->getPath();
     if (path.isEmpty()) {
       return;
@@ -414,6 +488,41 @@ class TriangulatingPathOp final : public GrMeshDrawOp {
       return;
     }
 
+    this->triangulateOnCpu(rContext);
+  }
+
+  bool hasConcurrentPrepare() const override { return !fVertexData; }
+
+  void onPrepareConcurrently(GrRecordingContext* rContext) override {
+    if (fAntiAlias) {
+      this->triangulateAAOnCpu();
+    } else {
+      this->triangulateOnCpu(rContext);
+    }
+  }
+
+  // Triangulates the AA path into CPU memory, for createAAMesh() to copy into a vertex buffer.
+  // There's no key for AA triangulations, so they aren't cached.
+  void triangulateAAOnCpu() {
+    SkASSERT(fAntiAlias && !fVertexData);
+    SkPath path = this->getPath();
+    if (path.isEmpty()) {
+      return;
+    }
+    path.transform(fViewMatrix);
+    GrCpuVertexAllocator allocator;
+    int vertexCount = GrAATriangulator::PathToAATriangles(
+        path, GrPathUtils::kDefaultTolerance, SkRect::Make(fDevClipBounds), &allocator);
+    if (vertexCount == 0) {
+      return;
+    }
+    fVertexData = allocator.detachVertexData();
+  }
+
+  // Finds or makes a non-AA triangulation in CPU memory, and adds it to the thread-safe cache.
+  // createNonAAMesh() uploads it.
+  void triangulateOnCpu(GrRecordingContext* rContext) {
+    SkASSERT(!fAntiAlias);
     auto threadSafeViewCache = rContext->priv().threadSafeCache();
 
     skgpu::UniqueKey key;
@@ -428,17 +537,21 @@ class TriangulatingPathOp final : public GrMeshDrawOp {
       return;
     }
 
-    GrCpuVertexAllocator allocator;
-
     bool isLinear;
-    int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol, &isLinear);
-    if (vertexCount == 0) {
+    GrTriangulatorCache* cache = this->triangulatorCacheFor(rContext->priv().triangulatorCache());
+    if (cache) {
+      fVertexData = this->triangulateWithCache(cache, &tol, &isLinear);
+    } else {
+      GrCpuVertexAllocator allocator;
+      if (Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol, &isLinear)) {
+        fVertexData = allocator.detachVertexData();
+      }
+    }
+    if (!fVertexData) {
       return;
     }
 
-    fVertexData = allocator.detachVertexData();
-
-    key.setCustomData(create_data(vertexCount, isLinear, tol));
+    key.setCustomData(create_data(fVertexData->numVertices(), isLinear, tol));
 
     // If some other thread created and cached its own triangulation, the 'is_newer_better'
     // predicate will replace the version in the cache if 'fVertexData' is a more accurate
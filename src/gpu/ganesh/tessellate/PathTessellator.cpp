@@ -25,6 +25,59 @@ namespace {
 
 using namespace skgpu::tess;
 
+// Gathers mapped quadratics and cubics into batches for PatchWriter's writeQuadratics() and
+// writeCubics(). The patches of a path don't depend on each other's order, so the two kinds are
+// batched separately. flush() must be called before the writer's attribs change, and when done.
+template <typename Writer>
+class CurveBatcher {
+ public:
+  using float2 = skvx::float2;
+  using float4 = skvx::float4;
+
+  static constexpr int kBatchSize = 8;
+
+  explicit CurveBatcher(Writer* writer) : fWriter(writer) {}
+
+  SK_ALWAYS_INLINE void addQuadratic(float4 p0p1, float2 p2) {
+    fQuadP0P1[fQuadCount] = p0p1;
+    fQuadP2[fQuadCount] = p2;
+    if (++fQuadCount == kBatchSize) {
+      fWriter->writeQuadratics(fQuadP0P1, fQuadP2);
+      fQuadCount = 0;
+    }
+  }
+
+  SK_ALWAYS_INLINE void addCubic(float4 p0p1, float4 p2p3) {
+    fCubicP0P1[fCubicCount] = p0p1;
+    fCubicP2P3[fCubicCount] = p2p3;
+    if (++fCubicCount == kBatchSize) {
+      fWriter->writeCubics(fCubicP0P1, fCubicP2P3);
+      fCubicCount = 0;
+    }
+  }
+
+  // Writes any partial batches one curve at a time.
+  void flush() {
+    for (int i = 0; i < fQuadCount; ++i) {
+      fWriter->writeQuadratic(fQuadP0P1[i].lo, fQuadP0P1[i].hi, fQuadP2[i]);
+    }
+    for (int i = 0; i < fCubicCount; ++i) {
+      fWriter->writeCubic(
+          fCubicP0P1[i].lo, fCubicP0P1[i].hi, fCubicP2P3[i].lo, fCubicP2P3[i].hi);
+    }
+    fQuadCount = fCubicCount = 0;
+  }
+
+ private:
+  Writer* fWriter;
+  float4 fQuadP0P1[kBatchSize];
+  float2 fQuadP2[kBatchSize];
+  int fQuadCount = 0;
+  float4 fCubicP0P1[kBatchSize];
+  float4 fCubicP2P3[kBatchSize];
+  int fCubicCount = 0;
+};
+
 using CurveWriter = PatchWriter<
     VertexChunkPatchAllocator, Optional<PatchAttribs::kColor>,
     Optional<PatchAttribs::kWideColorIfEnabled>, Optional<PatchAttribs::kExplicitCurveType>,
@@ -34,18 +87,17 @@ void write_curve_patches(
     CurveWriter&& patchWriter, const SkMatrix& shaderMatrix,
     const PathTessellator::PathDrawList& pathDrawList) {
   patchWriter.setShaderTransform(wangs_formula::VectorXform{shaderMatrix});
+  CurveBatcher<CurveWriter> batcher(&patchWriter);
   for (auto [pathMatrix, path, color] : pathDrawList) {
     AffineMatrix m(pathMatrix);
     if (patchWriter.attribs() & PatchAttribs::kColor) {
+      batcher.flush();
       patchWriter.updateColorAttrib(color);
     }
     for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
       switch (verb) {
         case SkPathVerb::kQuad: {
-          auto [p0, p1] = m.map2Points(pts);
-          auto p2 = m.map1Point(pts + 2);
-
-          patchWriter.writeQuadratic(p0, p1, p2);
+          batcher.addQuadratic(m.map2Points(pts), m.map1Point(pts + 2));
           break;
         }
 
@@ -58,10 +110,7 @@ void write_curve_patches(
         }
 
         case SkPathVerb::kCubic: {
-          auto [p0, p1] = m.map2Points(pts);
-          auto [p2, p3] = m.map2Points(pts + 2);
-
-          patchWriter.writeCubic(p0, p1, p2, p3);
+          batcher.addCubic(m.map2Points(pts), m.map2Points(pts + 2));
           break;
         }
 
@@ -69,6 +118,7 @@ void write_curve_patches(
       }
     }
   }
+  batcher.flush();
 }
 
 using WedgeWriter = PatchWriter<
@@ -79,13 +129,16 @@ void write_wedge_patches(
     WedgeWriter&& patchWriter, const SkMatrix& shaderMatrix,
     const PathTessellator::PathDrawList& pathDrawList) {
   patchWriter.setShaderTransform(wangs_formula::VectorXform{shaderMatrix});
+  CurveBatcher<WedgeWriter> batcher(&patchWriter);
   for (auto [pathMatrix, path, color] : pathDrawList) {
     AffineMatrix m(pathMatrix);
     if (patchWriter.attribs() & PatchAttribs::kColor) {
+      batcher.flush();
       patchWriter.updateColorAttrib(color);
     }
     MidpointContourParser parser(path);
     while (parser.parseNextContour()) {
+      batcher.flush();
       patchWriter.updateFanPointAttrib(m.mapPoint(parser.currentMidpoint()));
       SkPoint lastPoint = {0, 0};
       SkPoint startPoint = {0, 0};
@@ -105,10 +158,7 @@ void write_wedge_patches(
           }
 
           case SkPathVerb::kQuad: {
-            auto [p0, p1] = m.map2Points(pts);
-            auto p2 = m.map1Point(pts + 2);
-
-            patchWriter.writeQuadratic(p0, p1, p2);
+            batcher.addQuadratic(m.map2Points(pts), m.map1Point(pts + 2));
             lastPoint = pts[2];
             break;
           }
@@ -123,10 +173,7 @@ void write_wedge_patches(
           }
 
           case SkPathVerb::kCubic: {
-            auto [p0, p1] = m.map2Points(pts);
-            auto [p2, p3] = m.map2Points(pts + 2);
-
-            patchWriter.writeCubic(p0, p1, p2, p3);
+            batcher.addCubic(m.map2Points(pts), m.map2Points(pts + 2));
             lastPoint = pts[3];
             break;
           }
@@ -142,6 +189,7 @@ void write_wedge_patches(
       }
     }
   }
+  batcher.flush();
 }
 
 }  // namespace
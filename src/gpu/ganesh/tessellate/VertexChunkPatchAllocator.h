@@ -27,9 +27,9 @@ class VertexChunkPatchAllocator {
       : fWorstCaseTolerances(worstCaseTolerances),
         fBuilder(target, chunks, stride, minVerticesPerChunk) {}
 
-  VertexWriter append(const tess::LinearTolerances& tolerances) {
+  VertexWriter append(const tess::LinearTolerances& tolerances, int count) {
     fWorstCaseTolerances->accumulate(tolerances);
-    return fBuilder.appendVertices(1);
+    return fBuilder.appendVertices(count);
   }
 
  private:
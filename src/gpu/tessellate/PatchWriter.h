@@ -56,10 +56,10 @@ namespace skgpu::tess {
  *
  * In addition to variable traits, PatchWriter's first template argument defines the type used for
  * allocating the GPU instance data. The templated "PatchAllocator" can be any type that provides:
- *    // A GPU-backed vertex writer for a single instance worth of data. The provided
- *    // LinearTolerances value represents the tolerances for the curve that will be written to the
- *    // returned vertex space.
- *    skgpu::VertexWriter append(const LinearTolerances&);
+ *    // A GPU-backed vertex writer for 'count' contiguous instances worth of data. The provided
+ *    // LinearTolerances value represents the worst-case tolerances of the curves that will be
+ *    // written to the returned vertex space.
+ *    skgpu::VertexWriter append(const LinearTolerances&, int count);
  *
  * Additionally, it must have a constructor that takes the stride as its first argument.
  * PatchWriter forwards any additional constructor args from its ctor to the allocator after
@@ -309,7 +309,7 @@ class PatchWriter {
       // to set the parametric segments in order to recover the LinearTolerances state at the
       // time the deferred patch was recorded.
       fTolerances.setParametricSegments(fDeferredPatch.fN_p4);
-      if (VertexWriter vw = fPatchAllocator.append(fTolerances)) {
+      if (VertexWriter vw = fPatchAllocator.append(fTolerances, 1)) {
         vw << VertexWriter::Array<char>(fDeferredPatch.fData, PatchStride(fAttribs));
       }
     }
@@ -397,6 +397,27 @@ class PatchWriter {
     this->writeCubic(p0p1.lo, p0p1.hi, p2p3.lo, p2p3.hi);
   }
 
+  // Write N cubics at once. Cubic i's control points are {p0p1[i].lo, p0p1[i].hi, p2p3[i].lo,
+  // p2p3[i].hi}. Wang's formula is evaluated for all N together with skvx, and if none of them
+  // need chopping (or discarding), the N patches are appended to the allocator as one block
+  // without per-curve branching. Otherwise each cubic is handled as if by writeCubic(). Join
+  // control points are not tracked across a batch.
+  template <int N>
+  AI void writeCubics(const float4 (&p0p1)[N], const float4 (&p2p3)[N]) {
+    static_assert(!kTrackJoinControlPoints);
+    skvx::Vec<N, float> x[4], y[4];
+    skvx::strided_load4(reinterpret_cast<const float*>(p0p1), x[0], y[0], x[1], y[1]);
+    skvx::strided_load4(reinterpret_cast<const float*>(p2p3), x[2], y[2], x[3], y[3]);
+    skvx::Vec<N, float> n4 = wangs_formula::cubic_p4(kPrecision, x, y, fApproxTransform);
+    if (!IsUniformBatch(n4)) {
+      for (int i = 0; i < N; ++i) {
+        this->writeCubic(p0p1[i].lo, p0p1[i].hi, p2p3[i].lo, p2p3[i].hi);
+      }
+      return;
+    }
+    this->writeCubicPatches(p0p1, p2p3, max(n4));
+  }
+
   // Write a conic curve with three control points and 'w', with the last coord of the last
   // control point signaling a conic by being set to infinity.
   AI void writeConic(float2 p0, float2 p1, float2 p2, float w) {
@@ -443,6 +464,31 @@ class PatchWriter {
         skvx::bit_pun<float2>(pts[2]));
   }
 
+  // Write N quadratics at once, converting each to an equivalent cubic. Quadratic i's control
+  // points are {p0p1[i].lo, p0p1[i].hi, p2[i]}. Works like writeCubics().
+  template <int N>
+  AI void writeQuadratics(const float4 (&p0p1)[N], const float2 (&p2)[N]) {
+    static_assert(!kTrackJoinControlPoints);
+    skvx::Vec<N, float> x[3], y[3];
+    skvx::strided_load4(reinterpret_cast<const float*>(p0p1), x[0], y[0], x[1], y[1]);
+    skvx::strided_load2(reinterpret_cast<const float*>(p2), x[2], y[2]);
+    skvx::Vec<N, float> n4 = wangs_formula::quadratic_p4(kPrecision, x, y, fApproxTransform);
+    if (!IsUniformBatch(n4)) {
+      for (int i = 0; i < N; ++i) {
+        this->writeQuadratic(p0p1[i].lo, p0p1[i].hi, p2[i]);
+      }
+      return;
+    }
+    float4 cubicP0P1[N], cubicP2P3[N];
+    for (int i = 0; i < N; ++i) {
+      // Same conversion as writeQuadPatch().
+      float4 p1p2 = mix(float4(p0p1[i].lo, p2[i]), p0p1[i].hi.xyxy(), 2 / 3.f);
+      cubicP0P1[i] = float4(p0p1[i].lo, p1p2.lo);
+      cubicP2P3[i] = float4(p1p2.hi, p2[i]);
+    }
+    this->writeCubicPatches(cubicP0P1, cubicP2P3, max(n4));
+  }
+
   // Write a line that is automatically converted into an equivalent cubic.
   AI void writeLine(float4 p0p1) {
     // No chopping needed, a line only ever requires one segment (the minimum required already).
@@ -484,15 +530,15 @@ class PatchWriter {
     // This does not use writePatch() because it uses its own location as the join attribute
     // value instead of fJoin and never defers.
     fTolerances.setParametricSegments(0.f);
-    if (VertexWriter vw = fPatchAllocator.append(fTolerances)) {
+    if (VertexWriter vw = fPatchAllocator.append(fTolerances, 1)) {
       vw << VertexWriter::Repeat<4>(p);  // p0,p1,p2,p3 = p -> 4 copies
-      this->emitPatchAttribs(std::move(vw), {fAttribs, p}, kCubicCurveType);
+      this->emitPatchAttribs(vw, {fAttribs, p}, kCubicCurveType);
     }
   }
 
  private:
   AI void emitPatchAttribs(
-      VertexWriter vertexWriter, const JoinAttrib& join, float explicitCurveType) {
+      VertexWriter& vertexWriter, const JoinAttrib& join, float explicitCurveType) {
     // NOTE: operator<< overrides automatically handle optional and disabled attribs.
     vertexWriter << join << fFanPoint << fStrokeParams << fColor << fDepth
                  << CurveTypeAttrib{fAttribs, explicitCurveType};
@@ -509,7 +555,7 @@ class PatchWriter {
         return {fDeferredPatch.fData, PatchStride(fAttribs)};
       }
     }
-    return fPatchAllocator.append(fTolerances);
+    return fPatchAllocator.append(fTolerances, 1);
   }
 
   AI void writePatch(float2 p0, float2 p1, float2 p2, float2 p3, float explicitCurveType) {
@@ -518,7 +564,7 @@ class PatchWriter {
       // case, correct data will overwrite it when the contour is closed (this is fine since a
       // deferred patch writes to CPU memory instead of directly to the GPU buffer).
       vw << p0 << p1 << p2 << p3;
-      this->emitPatchAttribs(std::move(vw), fJoin, explicitCurveType);
+      this->emitPatchAttribs(vw, fJoin, explicitCurveType);
 
       // Automatically update join control point for next patch.
       if constexpr (kTrackJoinControlPoints) {
@@ -537,6 +583,24 @@ class PatchWriter {
     }
   }
 
+  // Appends N cubic patches as one block, all sharing the given n^4 tolerance.
+  template <int N>
+  AI void writeCubicPatches(const float4 (&p0p1)[N], const float4 (&p2p3)[N], float maxN4) {
+    // Every patch in the batch has the same attribs, so emit them once and copy them after each
+    // patch's points.
+    char attribs[kMaxStride];
+    const size_t attribsSize = PatchStride(fAttribs) - 2 * sizeof(float4);
+    VertexWriter attribsWriter{attribs, attribsSize};
+    this->emitPatchAttribs(attribsWriter, fJoin, kCubicCurveType);
+
+    fTolerances.setParametricSegments(maxN4);
+    if (VertexWriter vw = fPatchAllocator.append(fTolerances, N)) {
+      for (int i = 0; i < N; ++i) {
+        vw << p0p1[i] << p2p3[i] << VertexWriter::Array<char>(attribs, attribsSize);
+      }
+    }
+  }
+
   // Helpers that normalize curves to a generic patch, but do no other work.
   AI void writeCubicPatch(float2 p0, float2 p1, float2 p2, float2 p3) {
     this->writePatch(p0, p1, p2, p3, kCubicCurveType);
@@ -551,6 +615,17 @@ class PatchWriter {
     this->writePatch(p0, p1, p2, {w, SK_FloatInfinity}, kConicCurveType);
   }
 
+  // True if a batch of curves can be written as-is: none of them need chopping, and none are
+  // discarded. NaN fails the comparisons, which leaves it to the per-curve path.
+  template <int N>
+  static AI bool IsUniformBatch(const skvx::Vec<N, float>& n4) {
+    if constexpr (kDiscardFlatCurves) {
+      return all((n4 > 1.f) & (n4 <= kMaxParametricSegments_p4));
+    } else {
+      return all(n4 <= kMaxParametricSegments_p4);
+    }
+  }
+
   int accountForCurve(float n4) {
     if (n4 <= kMaxParametricSegments_p4) {
       // Record n^4 and return 0 to signal no chopping
@@ -53,6 +53,16 @@ AI int nextlog4(float x) { return (sk_float_nextlog2(x) + 1) >> 1; }
 //
 AI int nextlog16(float x) { return (sk_float_nextlog2(x) + 3) >> 2; }
 
+// Returns nextlog16() of N values at once, using the same exponent trick as sk_float_nextlog2().
+template <int N>
+AI skvx::Vec<N, int> nextlog16(const skvx::Vec<N, float>& x) {
+  auto bits = skvx::bit_pun<skvx::Vec<N, uint32_t>>(x);
+  bits += (1u << 23) - 1u;  // Increment the exponent for non-powers-of-2.
+  skvx::Vec<N, int> exp = (skvx::bit_pun<skvx::Vec<N, int>>(bits) >> 23) - 127;
+  exp &= ~(exp >> 31);  // 0 for negative or denormalized floats, and exponents < 0.
+  return (exp + 3) >> 2;
+}
+
 // Represents the upper-left 2x2 matrix of an affine transform for applying to vectors:
 //
 //     VectorXform(p1 - p0) == M * float3(p1, 1) - M * float3(p0, 1)
@@ -95,6 +105,24 @@ class VectorXform {
     }
     SkUNREACHABLE;
   }
+  // Transforms N vectors in place, given in structure-of-arrays form as their x and y components.
+  template <int N>
+  AI void mapVectors(skvx::Vec<N, float>* x, skvx::Vec<N, float>* y) const {
+    switch (fType) {
+      case Type::kIdentity: return;
+      case Type::kScale:
+        *x *= fScaleXY[0];
+        *y *= fScaleXY[1];
+        return;
+      case Type::kAffine: {
+        skvx::Vec<N, float> mappedX = fScaleXSkewY[0] * *x + fSkewXScaleY[0] * *y;
+        *y = fScaleXSkewY[1] * *x + fSkewXScaleY[1] * *y;
+        *x = mappedX;
+        return;
+      }
+    }
+    SkUNREACHABLE;
+  }
 
  private:
   enum class Type { kIdentity, kScale, kAffine } fType;
@@ -169,6 +197,42 @@ AI int cubic_log2(
   return nextlog16(cubic_p4(precision, pts, vectorXform));
 }
 
+// Batch versions of the above that evaluate Wang's formula for N curves at once. The control points
+// are given in structure-of-arrays form: curve i's control point j is {x[j][i], y[j][i]}.
+template <int N>
+AI skvx::Vec<N, float> quadratic_p4(
+    float precision, const skvx::Vec<N, float> x[3], const skvx::Vec<N, float> y[3],
+    const VectorXform& vectorXform = VectorXform()) {
+  skvx::Vec<N, float> vx = -2 * x[1] + x[0] + x[2];
+  skvx::Vec<N, float> vy = -2 * y[1] + y[0] + y[2];
+  vectorXform.mapVectors(&vx, &vy);
+  return (vx * vx + vy * vy) * length_term_p2<2>(precision);
+}
+template <int N>
+AI skvx::Vec<N, int> quadratic_log2(
+    float precision, const skvx::Vec<N, float> x[3], const skvx::Vec<N, float> y[3],
+    const VectorXform& vectorXform = VectorXform()) {
+  return nextlog16(quadratic_p4(precision, x, y, vectorXform));
+}
+template <int N>
+AI skvx::Vec<N, float> cubic_p4(
+    float precision, const skvx::Vec<N, float> x[4], const skvx::Vec<N, float> y[4],
+    const VectorXform& vectorXform = VectorXform()) {
+  skvx::Vec<N, float> ux = -2 * x[1] + x[0] + x[2];
+  skvx::Vec<N, float> uy = -2 * y[1] + y[0] + y[2];
+  skvx::Vec<N, float> vx = -2 * x[2] + x[1] + x[3];
+  skvx::Vec<N, float> vy = -2 * y[2] + y[1] + y[3];
+  vectorXform.mapVectors(&ux, &uy);
+  vectorXform.mapVectors(&vx, &vy);
+  return max(ux * ux + uy * uy, vx * vx + vy * vy) * length_term_p2<3>(precision);
+}
+template <int N>
+AI skvx::Vec<N, int> cubic_log2(
+    float precision, const skvx::Vec<N, float> x[4], const skvx::Vec<N, float> y[4],
+    const VectorXform& vectorXform = VectorXform()) {
+  return nextlog16(cubic_p4(precision, x, y, vectorXform));
+}
+
 // Returns the maximum number of line segments a cubic with the given device-space bounding box size
 // would ever need to be divided into, raised to the 4th power. This is simply a special case of the
 // cubic formula where we maximize its value by placing control points on specific corners of the
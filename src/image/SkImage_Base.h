@@ -33,6 +33,7 @@ class GrDirectContext;
 class GrImageContext;
 class GrSamplerState;
 class SkCachedData;
+class SkYUVAPixmaps;
 
 enum { kNeedNewImageUniqueID = 0 };
 
@@ -124,6 +125,12 @@ class SkImage_Base : public SkImage {
   // but only inspect them (or encode them).
   virtual bool getROPixels(GrDirectContext*, SkBitmap*, CachingHint = kAllow_CachingHint) const = 0;
 
+  // Raster drawing may sample an image from read-only Y, U, and V planes instead of calling
+  // getROPixels().  On success the planes live in the returned data and are described by pixmaps.
+  virtual sk_sp<SkCachedData> getROYUVAPlanes(SkYUVAPixmaps*) const { return nullptr; }
+  // Whether getROYUVAPlanes() is expected to succeed, found without decoding the planes.
+  virtual bool hasROYUVAPlanes() const { return false; }
+
   virtual sk_sp<SkImage> onMakeSubset(const SkIRect&, GrDirectContext*) const = 0;
 
   virtual sk_sp<SkData> onRefEncoded() const { return nullptr; }
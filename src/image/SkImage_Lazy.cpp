@@ -15,12 +15,14 @@
 #include "src/core/SkCachedData.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkNextID.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkYUVPlanesCache.h"
+
+#include <atomic>
 
 #if SK_SUPPORT_GPU
 #  include "include/gpu/GrDirectContext.h"
 #  include "include/gpu/GrRecordingContext.h"
-#  include "src/core/SkResourceCache.h"
-#  include "src/core/SkYUVPlanesCache.h"
 #  include "src/gpu/ResourceKey.h"
 #  include "src/gpu/ganesh/GrCaps.h"
 #  include "src/gpu/ganesh/GrColorSpaceXform.h"
@@ -158,6 +160,81 @@ bool SkImage_Lazy::getROPixels(
   return true;
 }
 
+std::atomic<bool> gSkRasterYUVPlanes{false};
+
+// The planes SkImageShader can sample; see gather_yuv_8.
+static SkYUVAPixmapInfo::SupportedDataTypes ro_yuva_data_types() {
+  SkYUVAPixmapInfo::SupportedDataTypes supportedDataTypes;
+  supportedDataTypes.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8, 1);
+  return supportedDataTypes;
+}
+
+bool SkImage_Lazy::hasROYUVAPlanes() const {
+  if (!gSkRasterYUVPlanes.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  // Subsets and color type/space changes have to be drawn from their own pixels.
+  if (fSharedGenerator->fGenerator->uniqueID() != this->uniqueID()) {
+    return false;
+  }
+  // If we've already paid for an RGBA copy, we may as well draw from it.
+  SkBitmap bitmap;
+  if (SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), &bitmap)) {
+    return false;
+  }
+
+  // SkImageShader only knows how to sample three upright 8-bit planes, which is what JPEGs are.
+  // Asking the generator only reads the header, not the planes.
+  SkYUVAPixmapInfo yuvaPixmapInfo;
+  ScopedGenerator generator(fSharedGenerator);
+  if (!generator->queryYUVAInfo(ro_yuva_data_types(), &yuvaPixmapInfo)) {
+    return false;
+  }
+  const SkYUVAInfo& yuvaInfo = yuvaPixmapInfo.yuvaInfo();
+  return yuvaInfo.planeConfig() == SkYUVAInfo::PlaneConfig::kY_U_V &&
+         yuvaInfo.origin() == kTopLeft_SkEncodedOrigin &&
+         yuvaPixmapInfo.dataType() == SkYUVAPixmapInfo::DataType::kUnorm8;
+}
+
+sk_sp<SkCachedData> SkImage_Lazy::getROYUVAPlanes(SkYUVAPixmaps* yuvaPixmaps) const {
+  if (!this->hasROYUVAPlanes()) {
+    return nullptr;
+  }
+  return this->getPlanes(ro_yuva_data_types(), yuvaPixmaps);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkCachedData> SkImage_Lazy::getPlanes(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
+    SkYUVAPixmaps* yuvaPixmaps) const {
+  ScopedGenerator generator(fSharedGenerator);
+
+  sk_sp<SkCachedData> data(SkYUVPlanesCache::FindAndRef(generator->uniqueID(), yuvaPixmaps));
+
+  if (data) {
+    SkASSERT(yuvaPixmaps->isValid());
+    SkASSERT(yuvaPixmaps->yuvaInfo().dimensions() == this->dimensions());
+    return data;
+  }
+  SkYUVAPixmapInfo yuvaPixmapInfo;
+  if (!generator->queryYUVAInfo(supportedDataTypes, &yuvaPixmapInfo) ||
+      yuvaPixmapInfo.yuvaInfo().dimensions() != this->dimensions()) {
+    return nullptr;
+  }
+  data.reset(SkResourceCache::NewCachedData(yuvaPixmapInfo.computeTotalBytes()));
+  SkYUVAPixmaps tempPixmaps =
+      SkYUVAPixmaps::FromExternalMemory(yuvaPixmapInfo, data->writable_data());
+  SkASSERT(tempPixmaps.isValid());
+  if (!generator->getYUVAPlanes(tempPixmaps)) {
+    return nullptr;
+  }
+  // Decoding is done, cache the resulting YUV planes
+  *yuvaPixmaps = tempPixmaps;
+  SkYUVPlanesCache::Add(this->uniqueID(), data.get(), *yuvaPixmaps);
+  return data;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool SkImage_Lazy::onReadPixels(
@@ -338,36 +415,6 @@ GrSurfaceProxyView SkImage_Lazy::textureProxyViewFromPlanes(
   return sfc->readSurfaceView();
 }
 
-sk_sp<SkCachedData> SkImage_Lazy::getPlanes(
-    const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
-    SkYUVAPixmaps* yuvaPixmaps) const {
-  ScopedGenerator generator(fSharedGenerator);
-
-  sk_sp<SkCachedData> data(SkYUVPlanesCache::FindAndRef(generator->uniqueID(), yuvaPixmaps));
-
-  if (data) {
-    SkASSERT(yuvaPixmaps->isValid());
-    SkASSERT(yuvaPixmaps->yuvaInfo().dimensions() == this->dimensions());
-    return data;
-  }
-  SkYUVAPixmapInfo yuvaPixmapInfo;
-  if (!generator->queryYUVAInfo(supportedDataTypes, &yuvaPixmapInfo) ||
-      yuvaPixmapInfo.yuvaInfo().dimensions() != this->dimensions()) {
-    return nullptr;
-  }
-  data.reset(SkResourceCache::NewCachedData(yuvaPixmapInfo.computeTotalBytes()));
-  SkYUVAPixmaps tempPixmaps =
-      SkYUVAPixmaps::FromExternalMemory(yuvaPixmapInfo, data->writable_data());
-  SkASSERT(tempPixmaps.isValid());
-  if (!generator->getYUVAPlanes(tempPixmaps)) {
-    return nullptr;
-  }
-  // Decoding is done, cache the resulting YUV planes
-  *yuvaPixmaps = tempPixmaps;
-  SkYUVPlanesCache::Add(this->uniqueID(), data.get(), *yuvaPixmaps);
-  return data;
-}
-
 /*
  *  We have 4 ways to try to return a texture (in sorted order)
  *
@@ -8,14 +8,11 @@
 #ifndef SkImage_Lazy_DEFINED
 #define SkImage_Lazy_DEFINED
 
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkIDChangeListener.h"
 #include "include/private/SkMutex.h"
 #include "src/image/SkImage_Base.h"
 
-#if SK_SUPPORT_GPU
-#  include "include/core/SkYUVAPixmaps.h"
-#endif
-
 class SharedGenerator;
 
 class SkImage_Lazy : public SkImage_Base {
@@ -45,6 +42,8 @@ class SkImage_Lazy : public SkImage_Base {
   sk_sp<SkData> onRefEncoded() const override;
   sk_sp<SkImage> onMakeSubset(const SkIRect&, GrDirectContext*) const override;
   bool getROPixels(GrDirectContext*, SkBitmap*, CachingHint) const override;
+  bool hasROYUVAPlanes() const override;
+  sk_sp<SkCachedData> getROYUVAPlanes(SkYUVAPixmaps*) const override;
   bool onIsLazyGenerated() const override { return true; }
   sk_sp<SkImage> onMakeColorTypeAndColorSpace(
       SkColorType, sk_sp<SkColorSpace>, GrDirectContext*) const override;
@@ -75,9 +74,9 @@ class SkImage_Lazy : public SkImage_Base {
       const SkRect*) const override;
 
   GrSurfaceProxyView textureProxyViewFromPlanes(GrRecordingContext*, SkBudgeted) const;
+#endif
   sk_sp<SkCachedData> getPlanes(
       const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes, SkYUVAPixmaps* pixmaps) const;
-#endif
 
   class ScopedGenerator;
 
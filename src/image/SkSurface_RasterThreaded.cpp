@@ -0,0 +1,372 @@
+/*
+ * Copyright 2026 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkCapabilities.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMallocPixelRef.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkBitmapDevice.h"
+#include "src/core/SkImagePriv.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/image/SkSurface_Base.h"
+
+#include <vector>
+
+// A raster surface that defers drawing: the canvas records into an SkRecord, and whenever the
+// pixels are observed (snapshot, read, peek, write) the pending ops are replayed on horizontal
+// bands of the bitmap in parallel. Each band gets its own SkCanvas, and with it its own clip and
+// blitters, so bands never touch each other's pixels. Pending ops with image filters or backdrops
+// are replayed on the whole bitmap at once instead, since they read across band edges.
+class SkSurface_RasterThreaded : public SkSurface_Base {
+ public:
+  SkSurface_RasterThreaded(
+      const SkImageInfo&, sk_sp<SkPixelRef>, SkExecutor*, const SkSurfaceProps*);
+  ~SkSurface_RasterThreaded() override;
+
+  SkCanvas* onNewCanvas() override;
+  sk_sp<SkSurface> onNewSurface(const SkImageInfo&) override;
+  sk_sp<SkImage> onNewImageSnapshot(const SkIRect* subset) override;
+  void onWritePixels(const SkPixmap&, int x, int y) override;
+  void onDraw(SkCanvas*, SkScalar, SkScalar, const SkSamplingOptions&, const SkPaint*) override;
+  bool onCopyOnWrite(ContentChangeMode) override;
+  void onRestoreBackingMutability() override;
+  sk_sp<const SkCapabilities> onCapabilities() override;
+
+  // Replays every recorded op that can be resolved into fBitmap.
+  void flushPendingDraws();
+
+ private:
+  class Device;
+
+  int bandCount() const;
+
+  // Drops the already-replayed draws from the front of fRecord, keeping only the save/matrix/clip
+  // ops that are still in effect, so the next flush can re-establish that state on each band.
+  void compactFlushedOps(int stop);
+
+  SkBitmap fBitmap;
+  SkExecutor* fExecutor;
+  sk_sp<Device> fDevice;
+  sk_sp<SkRecord> fRecord;
+  SkRecorder* fRecorder = nullptr;  // Owned by SkSurface_Base as the cached canvas.
+
+  // Ops [0, fFlushedCount) of fRecord have been replayed; only state ops remain in that range.
+  int fFlushedCount = 0;
+
+  using INHERITED = SkSurface_Base;
+};
+
+// The base device of the recording canvas. It never rasterizes (SkRecorder intercepts every
+// draw), but it tracks the matrix and clip and exposes fBitmap, flushing before each access.
+class SkSurface_RasterThreaded::Device final : public SkBitmapDevice {
+ public:
+  Device(const SkBitmap& bitmap, const SkSurfaceProps& props, SkSurface_RasterThreaded* surface)
+      : INHERITED(bitmap, props), fSurface(surface) {}
+
+  void detachSurface() noexcept { fSurface = nullptr; }
+
+ protected:
+  bool onReadPixels(const SkPixmap& pm, int x, int y) override {
+    this->flush();
+    return INHERITED::onReadPixels(pm, x, y);
+  }
+  bool onWritePixels(const SkPixmap& pm, int x, int y) override {
+    this->flush();
+    return INHERITED::onWritePixels(pm, x, y);
+  }
+  bool onPeekPixels(SkPixmap* pmap) override {
+    this->flush();
+    return INHERITED::onPeekPixels(pmap);
+  }
+  bool onAccessPixels(SkPixmap* pmap) override {
+    this->flush();
+    return INHERITED::onAccessPixels(pmap);
+  }
+
+ private:
+  void flush() {
+    if (fSurface) {
+      fSurface->flushPendingDraws();
+    }
+  }
+
+  SkSurface_RasterThreaded* fSurface;
+
+  using INHERITED = SkBitmapDevice;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Bands shorter than this spend more time re-walking the op list than rasterizing.
+constexpr int kMinBandHeight = 64;
+constexpr int kMaxBandCount = 64;
+
+struct OpType {
+  template <typename T>
+  SkRecords::Type operator()(const T&) {
+    return T::kType;
+  }
+};
+
+// Ops that leave no trace once they have been replayed.
+struct IsTransient {
+  template <typename T>
+  bool operator()(const T&) {
+    return (T::kTags & SkRecords::kDraw_Tag) || T::kType == SkRecords::Flush_Type ||
+           T::kType == SkRecords::DrawAnnotation_Type;
+  }
+};
+
+}  // namespace
+
+SkSurface_RasterThreaded::SkSurface_RasterThreaded(
+    const SkImageInfo& info, sk_sp<SkPixelRef> pr, SkExecutor* executor,
+    const SkSurfaceProps* props)
+    : INHERITED(pr->width(), pr->height(), props),
+      fExecutor(executor),
+      fRecord(sk_make_sp<SkRecord>()) {
+  fBitmap.setInfo(info, pr->rowBytes());
+  fBitmap.setPixelRef(std::move(pr), 0, 0);
+  fDevice = sk_make_sp<Device>(fBitmap, this->props(), this);
+}
+
+SkSurface_RasterThreaded::~SkSurface_RasterThreaded() {
+  // The cached canvas outlives us by a little (SkSurface_Base owns it). Close it off now so its
+  // destructor doesn't append Restores to a record we've already freed.
+  if (fRecorder) {
+    fRecorder->restoreToCount(1);
+    fRecorder->forgetRecord();
+  }
+  fDevice->detachSurface();
+}
+
+SkCanvas* SkSurface_RasterThreaded::onNewCanvas() {
+  SkASSERT(!fRecorder);
+  fRecorder = new SkRecorder(fRecord.get(), fDevice);
+  return fRecorder;
+}
+
+sk_sp<SkSurface> SkSurface_RasterThreaded::onNewSurface(const SkImageInfo& info) {
+  return SkSurface::MakeRasterThreaded(info, fExecutor, &this->props());
+}
+
+int SkSurface_RasterThreaded::bandCount() const {
+  return SkTPin(fBitmap.height() / kMinBandHeight, 1, kMaxBandCount);
+}
+
+void SkSurface_RasterThreaded::flushPendingDraws() {
+  const int count = fRecord->count();
+  if (fFlushedCount == count) {
+    return;
+  }
+
+  // Content drawn into a layer that's still open isn't visible yet, so we can only resolve up to
+  // the outermost unmatched SaveLayer. The rest waits for its Restore.
+  int stop = count;
+  {
+    std::vector<std::pair<int, bool>> saves;  // (op index, is layer)
+    for (int i = fFlushedCount; i < count; ++i) {
+      switch (fRecord->visit(i, OpType())) {
+        case SkRecords::Save_Type: saves.push_back({i, false}); break;
+        case SkRecords::SaveLayer_Type:
+        case SkRecords::SaveBehind_Type: saves.push_back({i, true}); break;
+        case SkRecords::Restore_Type:
+          if (!saves.empty()) {
+            saves.pop_back();
+          }
+          break;
+        default: break;
+      }
+    }
+    for (const auto& [index, isLayer] : saves) {
+      if (isLayer) {
+        stop = index;
+        break;
+      }
+    }
+  }
+  if (stop == fFlushedCount) {
+    return;
+  }
+
+  // Outstanding snapshots already got their own copy of the pixels: SkRecorder notifies us
+  // (copy-on-write) as each draw is recorded, just like a regular raster canvas would.
+  std::unique_ptr<SkBigPicture::SnapshotArray> drawablePicts;
+  if (SkDrawableList* drawables = fRecorder ? fRecorder->getDrawableList() : nullptr) {
+    drawablePicts.reset(drawables->newDrawableSnapshot());
+  }
+  const SkPicture* const* pics = drawablePicts ? drawablePicts->begin() : nullptr;
+  const int picCount = drawablePicts ? drawablePicts->count() : 0;
+
+  // Image filters and backdrops read pixels around the ones they write, which a band can't see
+  // past its edges. Records that use them are replayed unbanded.
+  const bool unbanded = SkRecordReadsNeighborhood(*fRecord, fFlushedCount, stop, pics, picCount);
+  const int bands = unbanded ? 1 : this->bandCount();
+  const int bandHeight = (fBitmap.height() + bands - 1) / bands;
+  auto drawBand = [&](int band) {
+    const int top = band * bandHeight;
+    SkIRect bandBounds = SkIRect::MakeLTRB(
+        0, top, fBitmap.width(), std::min(top + bandHeight, fBitmap.height()));
+    SkBitmap bandBitmap;
+    if (bandBounds.isEmpty() || !fBitmap.extractSubset(&bandBitmap, bandBounds)) {
+      return;
+    }
+    SkCanvas canvas(bandBitmap, this->props());
+    canvas.translate(0, -SkIntToScalar(top));
+
+    SkRecords::Draw draw(&canvas, pics, nullptr, picCount);
+    for (int i = 0; i < stop; ++i) {
+      fRecord->visit(i, draw);
+    }
+  };
+
+  if (bands > 1) {
+    SkTaskGroup(*fExecutor).batch(bands, drawBand);
+  } else {
+    drawBand(0);
+  }
+
+  this->compactFlushedOps(stop);
+}
+
+void SkSurface_RasterThreaded::compactFlushedOps(int stop) {
+  // Matched Save/Restore pairs and everything between them no longer affect anything, nor do
+  // draws outside of them. What's left is the state the next flush has to start from.
+  std::vector<int> saves;
+  for (int i = 0; i < stop; ++i) {
+    const SkRecords::Type type = fRecord->visit(i, OpType());
+    if (type == SkRecords::Save_Type || type == SkRecords::SaveLayer_Type ||
+        type == SkRecords::SaveBehind_Type) {
+      saves.push_back(i);
+    } else if (type == SkRecords::Restore_Type && !saves.empty()) {
+      for (int j = saves.back(); j <= i; ++j) {
+        fRecord->replace<SkRecords::NoOp>(j);
+      }
+      saves.pop_back();
+    } else if (fRecord->visit(i, IsTransient())) {
+      fRecord->replace<SkRecords::NoOp>(i);
+    }
+  }
+
+  const int before = fRecord->count();
+  fRecord->defrag();
+  fFlushedCount = stop - (before - fRecord->count());
+
+  // With nothing left pending, move the surviving state ops into a fresh record so the arena
+  // doesn't grow without bound over the lifetime of the surface.
+  if (fFlushedCount == fRecord->count() && fRecorder) {
+    auto fresh = sk_make_sp<SkRecord>();
+    SkRecorder copier(fresh.get(), SkRect::MakeWH(fBitmap.width(), fBitmap.height()));
+    const SkM44 identity;
+    SkRecords::Draw draw(&copier, nullptr, nullptr, 0, &identity);
+    for (int i = 0; i < fFlushedCount; ++i) {
+      fRecord->visit(i, draw);
+    }
+    // Unwind the copier so it can be destroyed, then drop the Restores that appended.
+    const int copied = fresh->count();
+    copier.restoreToCount(1);
+    for (int i = copied; i < fresh->count(); ++i) {
+      fresh->replace<SkRecords::NoOp>(i);
+    }
+    fresh->defrag();
+    copier.forgetRecord();
+    fRecorder->setRecord(fresh.get());
+    fRecorder->detachDrawableList();
+    fRecord = std::move(fresh);
+    fFlushedCount = fRecord->count();
+  }
+}
+
+void SkSurface_RasterThreaded::onDraw(
+    SkCanvas* canvas, SkScalar x, SkScalar y, const SkSamplingOptions& sampling,
+    const SkPaint* paint) {
+  this->flushPendingDraws();
+  canvas->drawImage(fBitmap.asImage().get(), x, y, sampling, paint);
+}
+
+sk_sp<SkImage> SkSurface_RasterThreaded::onNewImageSnapshot(const SkIRect* subset) {
+  this->flushPendingDraws();
+
+  if (subset) {
+    SkASSERT(SkIRect::MakeWH(fBitmap.width(), fBitmap.height()).contains(*subset));
+    SkBitmap dst;
+    dst.allocPixels(fBitmap.info().makeDimensions(subset->size()));
+    SkAssertResult(fBitmap.readPixels(dst.pixmap(), subset->left(), subset->top()));
+    dst.setImmutable();  // key, so MakeFromBitmap doesn't make a copy of the buffer
+    return dst.asImage();
+  }
+
+  // SkImage_raster requires these pixels are immutable for its full lifetime.
+  // We'll undo this via onRestoreBackingMutability() if we can avoid the COW.
+  if (SkPixelRef* pr = fBitmap.pixelRef()) {
+    pr->setTemporarilyImmutable();
+  }
+  return SkMakeImageFromRasterBitmap(fBitmap, kIfMutable_SkCopyPixelsMode);
+}
+
+void SkSurface_RasterThreaded::onWritePixels(const SkPixmap& src, int x, int y) {
+  this->flushPendingDraws();
+  fBitmap.writePixels(src, x, y);
+}
+
+void SkSurface_RasterThreaded::onRestoreBackingMutability() {
+  SkASSERT(!this->hasCachedImage());  // Shouldn't be any snapshots out there.
+  if (SkPixelRef* pr = fBitmap.pixelRef()) {
+    pr->restoreMutability();
+  }
+}
+
+bool SkSurface_RasterThreaded::onCopyOnWrite(ContentChangeMode mode) {
+  sk_sp<SkImage> cached(this->refCachedImage());
+  SkASSERT(cached);
+  if (SkBitmapImageGetPixelRef(cached.get()) == fBitmap.pixelRef()) {
+    if (kDiscard_ContentChangeMode == mode) {
+      if (!fBitmap.tryAllocPixels()) {
+        return false;
+      }
+    } else {
+      SkBitmap prev(fBitmap);
+      if (!fBitmap.tryAllocPixels()) {
+        return false;
+      }
+      SkASSERT(prev.info() == fBitmap.info());
+      SkASSERT(prev.rowBytes() == fBitmap.rowBytes());
+      memcpy(fBitmap.getPixels(), prev.getPixels(), fBitmap.computeByteSize());
+    }
+    // Bands are carved out of fBitmap at flush time, so only the recording device needs to hear
+    // about the new pixels.
+    fDevice->replaceBitmapBackendForRasterSurface(fBitmap);
+  }
+  return true;
+}
+
+sk_sp<const SkCapabilities> SkSurface_RasterThreaded::onCapabilities() {
+  return SkCapabilities::RasterBackend();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkSurface> SkSurface::MakeRasterThreaded(
+    const SkImageInfo& info, SkExecutor* executor, const SkSurfaceProps* props) {
+  if (!executor) {
+    return MakeRaster(info, props);
+  }
+  if (!SkSurfaceValidateRasterInfo(info)) {
+    return nullptr;
+  }
+
+  sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeAllocate(info, 0);
+  if (!pr) {
+    return nullptr;
+  }
+  return sk_make_sp<SkSurface_RasterThreaded>(info, std::move(pr), executor, props);
+}
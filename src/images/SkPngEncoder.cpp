@@ -9,17 +9,21 @@
 
 #ifdef SK_ENCODE_PNG
 
+#  include "include/core/SkExecutor.h"
 #  include "include/core/SkStream.h"
 #  include "include/core/SkString.h"
 #  include "include/encode/SkPngEncoder.h"
 #  include "include/private/SkImageInfoPriv.h"
 #  include "src/codec/SkColorTable.h"
 #  include "src/codec/SkPngPriv.h"
+#  include "src/core/SkEndian.h"
 #  include "src/core/SkMSAN.h"
+#  include "src/core/SkTaskGroup.h"
 #  include "src/images/SkImageEncoderFns.h"
 #  include <vector>
 
 #  include <png.h>
+#  include "zlib.h"
 
 static_assert(PNG_FILTER_NONE == (int)SkPngEncoder::FilterFlag::kNone, "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB == (int)SkPngEncoder::FilterFlag::kSub, "Skia libpng filter err.");
@@ -62,16 +66,35 @@ class SkPngEncoderMgr final : SkNoncopyable {
   png_infop infoPtr() { return fInfoPtr; }
   int pngBytesPerPixel() const { return fPngBytesPerPixel; }
   transform_scanline_proc proc() const { return fProc; }
+  SkExecutor* executor() const { return fExecutor; }
+
+  /*
+   * Filters, compresses, and writes rows [top, bottom) of src as IDAT chunks, in parallel on
+   * executor().  Writes IEND after the last row.
+   */
+  bool encodeRowsInParallel(const SkPixmap& src, int top, int bottom);
 
   ~SkPngEncoderMgr() { png_destroy_write_struct(&fPngPtr, &fInfoPtr); }
 
  private:
-  SkPngEncoderMgr(png_structp pngPtr, png_infop infoPtr) : fPngPtr(pngPtr), fInfoPtr(infoPtr) {}
+  struct DeflatedChunk;
+
+  SkPngEncoderMgr(png_structp pngPtr, png_infop infoPtr, SkWStream* stream)
+      : fPngPtr(pngPtr), fInfoPtr(infoPtr), fStream(stream) {}
+
+  void deflateChunk(const SkPixmap& src, int top, int bottom, DeflatedChunk* chunk) const;
 
   png_structp fPngPtr;
   png_infop fInfoPtr;
   int fPngBytesPerPixel;
   transform_scanline_proc fProc;
+
+  // Used only when encoding in parallel, where we do libpng's filtering and compression.
+  SkWStream* fStream;
+  SkExecutor* fExecutor = nullptr;
+  int fFilters = 0;
+  int fZLibLevel = 0;
+  uLong fAdler = 1;  // The Adler-32 of every filtered row written so far.
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -88,7 +111,7 @@ std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
   }
 
   png_set_write_fn(pngPtr, (void*)stream, sk_write_fn, nullptr);
-  return std::unique_ptr<SkPngEncoderMgr>(new SkPngEncoderMgr(pngPtr, infoPtr));
+  return std::unique_ptr<SkPngEncoderMgr>(new SkPngEncoderMgr(pngPtr, infoPtr, stream));
 }
 
 bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::Options& options) {
@@ -193,6 +216,10 @@ bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::
   SkASSERT(zlibLevel == options.fZLibLevel);
   png_set_compression_level(fPngPtr, zlibLevel);
 
+  fExecutor = options.fExecutor;
+  fFilters = filters ? filters : PNG_FILTER_NONE;
+  fZLibLevel = zlibLevel;
+
   // Set comments in tEXt chunk
   const sk_sp<SkDataTable>& comments = options.fComments;
   if (comments != nullptr) {
@@ -341,6 +368,8 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
     // For kOpaque, kRGBA_F16, we will keep the row as RGBA and tell libpng
     // to skip the alpha channel.
     png_set_filler(fPngPtr, 0, PNG_FILLER_AFTER);
+    // Only libpng knows how to do that, so we can't encode in parallel.
+    fExecutor = nullptr;
   }
 
   return true;
@@ -348,6 +377,208 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
 
 void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) { fProc = choose_proc(srcInfo); }
 
+// When encoding in parallel, rows are filtered and compressed in chunks of about this many
+// bytes, each as an independent raw deflate stream.  Every chunk but the last ends with a sync
+// flush, so the chunks concatenate into one deflate stream.
+static constexpr size_t kParallelChunkBytes = 128 << 10;
+// Each chunk's deflate stream is primed with up to this much of the filtered data before it,
+// so it can still find matches there, as if the image were compressed serially.
+static constexpr size_t kParallelWindowBytes = 32 << 10;
+
+static int paeth_predictor(int a, int b, int c) {
+  const int p = a + b - c;
+  const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+// Applies PNG filter type (0-4) to the n bytes of row, given the previous row.
+static void apply_filter(
+    int type, int bpp, const uint8_t* row, const uint8_t* prev, int n, uint8_t* dst) {
+  const int m = std::min(bpp, n);
+  switch (type) {
+    case 0: memcpy(dst, row, n); break;
+    case 1:
+      memcpy(dst, row, m);
+      for (int i = m; i < n; i++) {
+        dst[i] = row[i] - row[i - bpp];
+      }
+      break;
+    case 2:
+      for (int i = 0; i < n; i++) {
+        dst[i] = row[i] - prev[i];
+      }
+      break;
+    case 3:
+      for (int i = 0; i < m; i++) {
+        dst[i] = row[i] - (prev[i] >> 1);
+      }
+      for (int i = m; i < n; i++) {
+        dst[i] = row[i] - ((row[i - bpp] + prev[i]) >> 1);
+      }
+      break;
+    case 4:
+      for (int i = 0; i < m; i++) {
+        dst[i] = row[i] - prev[i];
+      }
+      for (int i = m; i < n; i++) {
+        dst[i] = row[i] - paeth_predictor(row[i - bpp], prev[i], prev[i - bpp]);
+      }
+      break;
+  }
+}
+
+// Writes a filter type byte and the filtered row to dst.  If there's more than one filter to
+// choose from, we choose the way libpng does: the smallest sum of the output's signed bytes.
+static void filter_row(
+    int filters, int bpp, const uint8_t* row, const uint8_t* prev, int n, uint8_t* dst,
+    uint8_t* scratch) {
+  const bool choose = (filters & (filters - 1)) != 0;
+  int best = -1;
+  int bestCost = 0;
+  for (int type = 0; type < 5; type++) {
+    if (!(filters & (PNG_FILTER_NONE << type))) {
+      continue;
+    }
+    uint8_t* out = best < 0 ? dst + 1 : scratch;
+    apply_filter(type, bpp, row, prev, n, out);
+    if (!choose) {
+      best = type;
+      break;
+    }
+    int cost = 0;
+    for (int i = 0; i < n; i++) {
+      cost += std::abs((int8_t)out[i]);
+    }
+    if (best < 0 || cost < bestCost) {
+      if (out != dst + 1) {
+        memcpy(dst + 1, out, n);
+      }
+      best = type;
+      bestCost = cost;
+    }
+  }
+  dst[0] = SkToU8(best);
+}
+
+static bool write_png_chunk(SkWStream* stream, const char tag[4], const uint8_t* data, size_t len) {
+  uLong crc = crc32(0, (const Bytef*)tag, 4);
+  if (len > 0) {
+    crc = crc32(crc, data, SkToUInt(len));  // crc32() with no data would reset crc.
+  }
+  return stream->write32(SkEndian_SwapBE32(SkToU32(len))) && stream->write(tag, 4) &&
+         stream->write(data, len) && stream->write32(SkEndian_SwapBE32(SkToU32(crc)));
+}
+
+struct SkPngEncoderMgr::DeflatedChunk {
+  std::vector<uint8_t> fData;
+  uLong fAdler = 1;
+  size_t fFilteredBytes = 0;
+  bool fOk = false;
+};
+
+void SkPngEncoderMgr::deflateChunk(
+    const SkPixmap& src, int top, int bottom, DeflatedChunk* chunk) const {
+  const int rowBytes = fPngBytesPerPixel * src.width();
+  const size_t filteredRowBytes = rowBytes + 1;
+
+  // Filter the rows before top that prime the deflate window along with our own.
+  const int windowRows = SkToInt(
+      std::min<size_t>(top, (kParallelWindowBytes + filteredRowBytes - 1) / filteredRowBytes));
+  const int first = top - windowRows;
+
+  std::vector<uint8_t> rows(3 * rowBytes);
+  uint8_t* prev = rows.data();
+  uint8_t* curr = prev + rowBytes;
+  uint8_t* scratch = curr + rowBytes;
+  const int srcBPP = SkColorTypeBytesPerPixel(src.colorType());
+  if (first > 0) {
+    fProc((char*)prev, (const char*)src.addr(0, first - 1), src.width(), srcBPP);
+  }
+
+  std::vector<uint8_t> filtered((bottom - first) * filteredRowBytes);
+  for (int y = first; y < bottom; y++) {
+    fProc((char*)curr, (const char*)src.addr(0, y), src.width(), srcBPP);
+    filter_row(
+        fFilters, fPngBytesPerPixel, curr, prev, rowBytes,
+        filtered.data() + (y - first) * filteredRowBytes, scratch);
+    std::swap(prev, curr);
+  }
+
+  const size_t windowBytes = std::min(windowRows * filteredRowBytes, kParallelWindowBytes);
+  const uint8_t* data = filtered.data() + windowRows * filteredRowBytes;
+  const size_t size = (bottom - top) * filteredRowBytes;
+
+  // This matches the window, memory level, and strategy libpng would use.
+  z_stream zs = {};
+  const int strategy = fFilters == PNG_FILTER_NONE ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+  if (deflateInit2(&zs, fZLibLevel, Z_DEFLATED, -MAX_WBITS, 8, strategy) != Z_OK) {
+    return;
+  }
+  if (windowBytes > 0) {
+    deflateSetDictionary(&zs, data - windowBytes, SkToUInt(windowBytes));
+  }
+  // A sync flush adds at most an empty stored block to what deflateBound() allows for.
+  chunk->fData.resize(deflateBound(&zs, size) + 8);
+  zs.next_in = const_cast<Bytef*>(data);
+  zs.avail_in = SkToUInt(size);
+  zs.next_out = chunk->fData.data();
+  zs.avail_out = SkToUInt(chunk->fData.size());
+  const bool last = bottom == src.height();
+  const int ret = deflate(&zs, last ? Z_FINISH : Z_SYNC_FLUSH);
+  chunk->fOk = last ? ret == Z_STREAM_END : ret == Z_OK && zs.avail_in == 0 && zs.avail_out > 0;
+  chunk->fData.resize(zs.total_out);
+  deflateEnd(&zs);
+
+  chunk->fAdler = adler32(adler32(0, nullptr, 0), data, SkToUInt(size));
+  chunk->fFilteredBytes = size;
+}
+
+bool SkPngEncoderMgr::encodeRowsInParallel(const SkPixmap& src, int top, int bottom) {
+  SkASSERT(fExecutor);
+  const size_t filteredRowBytes = fPngBytesPerPixel * src.width() + 1;
+  const int rowsPerChunk = SkToInt(std::max<size_t>(1, kParallelChunkBytes / filteredRowBytes));
+  const int count = (bottom - top + rowsPerChunk - 1) / rowsPerChunk;
+
+  std::vector<DeflatedChunk> chunks(count);
+  SkTaskGroup tg(*fExecutor);
+  tg.batch(count, [&](int i) {
+    const int chunkTop = top + i * rowsPerChunk;
+    this->deflateChunk(src, chunkTop, std::min(bottom, chunkTop + rowsPerChunk), &chunks[i]);
+  });
+  tg.wait();
+
+  for (int i = 0; i < count; i++) {
+    DeflatedChunk& chunk = chunks[i];
+    if (!chunk.fOk) {
+      return false;
+    }
+    if (top == 0 && i == 0) {
+      // The zlib header: deflate with a 32K window, and a hint of how hard we compressed.
+      const int level = fZLibLevel < 2 ? 0 : fZLibLevel < 6 ? 1 : fZLibLevel == 6 ? 2 : 3;
+      int header = (0x78 << 8) | (level << 6);
+      header += 31 - header % 31;
+      chunk.fData.insert(chunk.fData.begin(), {SkToU8(header >> 8), SkToU8(header)});
+    }
+    fAdler = adler32_combine(fAdler, chunk.fAdler, chunk.fFilteredBytes);
+    if (bottom == src.height() && i == count - 1) {
+      const uint32_t adler = SkEndian_SwapBE32(SkToU32(fAdler));
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&adler);
+      chunk.fData.insert(chunk.fData.end(), bytes, bytes + 4);
+    }
+    if (!write_png_chunk(fStream, "IDAT", chunk.fData.data(), chunk.fData.size())) {
+      return false;
+    }
+  }
+
+  if (bottom == src.height()) {
+    return write_png_chunk(fStream, "IEND", nullptr, 0);
+  }
+  return true;
+}
+
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(
     SkWStream* dst, const SkPixmap& src, const Options& options) {
   if (!SkPixmapIsValid(src)) {
@@ -383,6 +614,14 @@ SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const Sk
 SkPngEncoder::~SkPngEncoder() {}
 
 bool SkPngEncoder::onEncodeRows(int numRows) {
+  if (fEncoderMgr->executor()) {
+    if (!fEncoderMgr->encodeRowsInParallel(fSrc, fCurrRow, fCurrRow + numRows)) {
+      return false;
+    }
+    fCurrRow += numRows;
+    return true;
+  }
+
   if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
     return false;
   }
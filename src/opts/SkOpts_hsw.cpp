@@ -12,6 +12,7 @@
 #include "src/opts/SkBitmapProcState_opts.h"
 #include "src/opts/SkBlitRow_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
+#include "src/opts/SkScan_opts.h"
 #include "src/opts/SkSwizzler_opts.h"
 #include "src/opts/SkUtils_opts.h"
 #include "src/opts/SkVM_opts.h"
@@ -33,6 +34,10 @@ void Init_hsw() {
   grayA_to_rgbA = SK_OPTS_NS::grayA_to_rgbA;
   inverted_CMYK_to_RGB1 = SK_OPTS_NS::inverted_CMYK_to_RGB1;
   inverted_CMYK_to_BGR1 = SK_OPTS_NS::inverted_CMYK_to_BGR1;
+  RGB16_to_RGB1 = SK_OPTS_NS::RGB16_to_RGB1;
+  RGBA16_to_RGBA = SK_OPTS_NS::RGBA16_to_RGBA;
+  index_to_8888 = SK_OPTS_NS::index_to_8888;
+  masks_to_8888 = SK_OPTS_NS::masks_to_8888;
 
 #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
   SK_RASTER_PIPELINE_STAGES(M)
@@ -47,5 +52,10 @@ void Init_hsw() {
 #undef M
 
   interpret_skvm = SK_OPTS_NS::interpret_skvm;
+
+  add_alphas = SK_OPTS_NS::add_alphas;
+  add_alpha_span = SK_OPTS_NS::add_alpha_span;
+  sub_alphas = SK_OPTS_NS::sub_alphas;
+  alpha_ramp = SK_OPTS_NS::alpha_ramp;
 }
 }  // namespace SkOpts
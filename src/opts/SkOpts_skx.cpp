@@ -8,8 +8,29 @@
 #include "src/core/SkOpts.h"
 
 #define SK_OPTS_NS skx
+#include "src/opts/SkRasterPipeline_opts.h"
+#include "src/opts/SkScan_opts.h"
+#include "src/opts/SkSwizzler_opts.h"
 #include "src/opts/SkVM_opts.h"
 
 namespace SkOpts {
-void Init_skx() { interpret_skvm = SK_OPTS_NS::interpret_skvm; }
+void Init_skx() {
+  // highp stays with Init_hsw()'s 8-wide stages; lowp doubles to 32 pixels per zmm.
+#define M(st) stages_lowp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::lowp::st;
+  SK_RASTER_PIPELINE_STAGES(M)
+  just_return_lowp = (StageFn)SK_OPTS_NS::lowp::just_return;
+  start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
+#undef M
+
+  interpret_skvm = SK_OPTS_NS::interpret_skvm;
+
+  add_alphas = SK_OPTS_NS::add_alphas;
+  add_alpha_span = SK_OPTS_NS::add_alpha_span;
+  sub_alphas = SK_OPTS_NS::sub_alphas;
+  alpha_ramp = SK_OPTS_NS::alpha_ramp;
+
+  RGBA16_to_RGBA = SK_OPTS_NS::RGBA16_to_RGBA;
+  index_to_8888 = SK_OPTS_NS::index_to_8888;
+  masks_to_8888 = SK_OPTS_NS::masks_to_8888;
+}
 }  // namespace SkOpts
@@ -27,6 +27,9 @@ void Init_ssse3() {
   grayA_to_rgbA = ssse3::grayA_to_rgbA;
   inverted_CMYK_to_RGB1 = ssse3::inverted_CMYK_to_RGB1;
   inverted_CMYK_to_BGR1 = ssse3::inverted_CMYK_to_BGR1;
+  RGB16_to_RGB1 = ssse3::RGB16_to_RGB1;
+  RGBA16_to_RGBA = ssse3::RGBA16_to_RGBA;
+  masks_to_8888 = ssse3::masks_to_8888;
 
   S32_alpha_D32_filter_DX = ssse3::S32_alpha_D32_filter_DX;
 }
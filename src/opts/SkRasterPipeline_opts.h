@@ -2245,6 +2245,37 @@ STAGE(gather_1010102, const SkRasterPipeline_GatherCtx* ctx) {
   U32 ix = ix_and_ptr(&ptr, ctx, r, g);
   from_1010102(gather(ptr, ix), &r, &g, &b, &a);
 }
+
+// Point-samples luma and converts to RGB.  Chroma planes are upsampled bilinearly to the center
+// of that luma pixel from their own samples, which sit centered among the luma pixels they cover
+// (JPEG's chroma siting; libjpeg's fancy upsampling weighs them the same way).
+STAGE(gather_yuv_8, const SkRasterPipeline_GatherYUVCtx* ctx) {
+  const F lx = floor_(clamp(r * ctx->scaleX[0], ctx->width[0])) + 0.5f,
+          ly = floor_(clamp(g * ctx->scaleY[0], ctx->height[0])) + 0.5f;
+  F yuv[3];
+  for (int i = 0; i < 3; i++) {
+    const uint8_t* plane = ctx->planes[i];
+    const int stride = ctx->stride[i];
+    if (i == 0 || (ctx->scaleX[i] == ctx->scaleX[0] && ctx->scaleY[i] == ctx->scaleY[0])) {
+      yuv[i] = from_byte(gather(plane, trunc_(ly) * stride + trunc_(lx)));
+      continue;
+    }
+    F x = lx * (ctx->scaleX[i] / ctx->scaleX[0]) - 0.5f,
+      y = ly * (ctx->scaleY[i] / ctx->scaleY[0]) - 0.5f;
+    const F fx = x - floor_(x), fy = y - floor_(y);
+    const U32 x0 = trunc_(clamp(x, ctx->width[i])), x1 = trunc_(clamp(x + 1, ctx->width[i])),
+              y0 = trunc_(clamp(y, ctx->height[i])) * stride,
+              y1 = trunc_(clamp(y + 1, ctx->height[i])) * stride;
+    const F top = lerp(from_byte(gather(plane, y0 + x0)), from_byte(gather(plane, y0 + x1)), fx),
+            bot = lerp(from_byte(gather(plane, y1 + x0)), from_byte(gather(plane, y1 + x1)), fx);
+    yuv[i] = lerp(top, bot, fy);
+  }
+  const float* m = ctx->rgbFromYUV;
+  r = clamp_01(mad(yuv[0], m[0], mad(yuv[1], m[1], mad(yuv[2], m[2], m[3]))));
+  g = clamp_01(mad(yuv[0], m[4], mad(yuv[1], m[5], mad(yuv[2], m[6], m[7]))));
+  b = clamp_01(mad(yuv[0], m[8], mad(yuv[1], m[9], mad(yuv[2], m[10], m[11]))));
+  a = 1.0f;
+}
 STAGE(store_1010102, const SkRasterPipeline_MemoryCtx* ctx) {
   auto ptr = ptr_at_xy<uint32_t>(ctx, dx, dy);
 
@@ -3012,7 +3043,17 @@ static void start_pipeline(size_t, size_t, size_t, size_t, void**) {}
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if defined(JUMPER_IS_SKX)
+// With AVX-512BW a U16 fills a whole zmm register, so we run 32 pixels at a time.
+using U8 = uint8_t __attribute__((ext_vector_type(32)));
+using U16 = uint16_t __attribute__((ext_vector_type(32)));
+using I16 = int16_t __attribute__((ext_vector_type(32)));
+using I32 = int32_t __attribute__((ext_vector_type(32)));
+using U32 = uint32_t __attribute__((ext_vector_type(32)));
+using I64 = int64_t __attribute__((ext_vector_type(32)));
+using U64 = uint64_t __attribute__((ext_vector_type(32)));
+using F = float __attribute__((ext_vector_type(32)));
+#  elif defined(JUMPER_IS_HSW)
 using U8 = uint8_t __attribute__((ext_vector_type(16)));
 using U16 = uint16_t __attribute__((ext_vector_type(16)));
 using I16 = int16_t __attribute__((ext_vector_type(16)));
@@ -3034,6 +3075,9 @@ using F = float __attribute__((ext_vector_type(8)));
 
 static const size_t N = sizeof(U16) / sizeof(uint16_t);
 
+// Stages like store_src and decal_x write a U16 per pixel into buffers sized for highp floats.
+static_assert(N * sizeof(uint16_t) <= SkRasterPipeline_kMaxStride * sizeof(float), "");
+
 // Once again, some platforms benefit from a restricted Stage calling convention,
 // but others can pass tons and tons of registers and we're happy to exploit that.
 // It's exactly the same decision and implementation strategy as the F stages above.
@@ -3274,7 +3318,16 @@ SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 // Use approximate instructions and one Newton-Raphson step to calculate 1/x.
 SI F rcp_precise(F x) {
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if defined(JUMPER_IS_SKX)
+  // One Newton-Raphson step takes the 14-bit estimate to full float precision.
+  auto rcp = [](__m512 v) {
+    __m512 est = _mm512_rcp14_ps(v);
+    return _mm512_mul_ps(_mm512_fnmadd_ps(v, est, _mm512_set1_ps(2.0f)), est);
+  };
+  __m512 lo, hi;
+  split(x, &lo, &hi);
+  return join<F>(rcp(lo), rcp(hi));
+#  elif defined(JUMPER_IS_HSW)
   __m256 lo, hi;
   split(x, &lo, &hi);
   return join<F>(SK_OPTS_NS::rcp_precise(lo), SK_OPTS_NS::rcp_precise(hi));
@@ -3291,7 +3344,11 @@ SI F rcp_precise(F x) {
 #  endif
 }
 SI F sqrt_(F x) {
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if defined(JUMPER_IS_SKX)
+  __m512 lo, hi;
+  split(x, &lo, &hi);
+  return join<F>(_mm512_sqrt_ps(lo), _mm512_sqrt_ps(hi));
+#  elif defined(JUMPER_IS_HSW)
   __m256 lo, hi;
   split(x, &lo, &hi);
   return join<F>(_mm256_sqrt_ps(lo), _mm256_sqrt_ps(hi));
@@ -3326,7 +3383,13 @@ SI F floor_(F x) {
   float32x4_t lo, hi;
   split(x, &lo, &hi);
   return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
-#  elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  elif defined(JUMPER_IS_SKX)
+  __m512 lo, hi;
+  split(x, &lo, &hi);
+  return join<F>(
+      _mm512_roundscale_ps(lo, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+      _mm512_roundscale_ps(hi, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+#  elif defined(JUMPER_IS_HSW)
   __m256 lo, hi;
   split(x, &lo, &hi);
   return join<F>(_mm256_floor_ps(lo), _mm256_floor_ps(hi));
@@ -3346,7 +3409,9 @@ SI F floor_(F x) {
 // The result is a number on [-1, 1).
 // Note: on neon this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if defined(JUMPER_IS_SKX)
+  return _mm512_mulhrs_epi16(a, b);
+#  elif defined(JUMPER_IS_HSW)
   return _mm256_mulhrs_epi16(a, b);
 #  elif defined(JUMPER_IS_SSE41) || defined(JUMPER_IS_AVX)
   return _mm_mulhrs_epi16(a, b);
@@ -3384,8 +3449,9 @@ SI F abs_(F x) { return sk_bit_cast<F>(sk_bit_cast<I32>(x) & 0x7fffffff); }
 
 STAGE_GG(seed_shader, Ctx::None) {
   static const float iota[] = {
-      0.5f, 1.5f, 2.5f,  3.5f,  4.5f,  5.5f,  6.5f,  7.5f,
-      8.5f, 9.5f, 10.5f, 11.5f, 12.5f, 13.5f, 14.5f, 15.5f,
+      0.5f,  1.5f,  2.5f,  3.5f,  4.5f,  5.5f,  6.5f,  7.5f,  8.5f,  9.5f,  10.5f,
+      11.5f, 12.5f, 13.5f, 14.5f, 15.5f, 16.5f, 17.5f, 18.5f, 19.5f, 20.5f, 21.5f,
+      22.5f, 23.5f, 24.5f, 25.5f, 26.5f, 27.5f, 28.5f, 29.5f, 30.5f, 31.5f,
   };
   x = cast<F>(I32(dx)) + sk_unaligned_load<F>(iota);
   y = cast<F>(I32(dy)) + 0.5f;
@@ -3592,9 +3658,13 @@ SI U32 ix_and_ptr(T** ptr, const SkRasterPipeline_GatherCtx* ctx, I32 x, I32 y)
 template <typename V, typename T>
 SI V load(const T* ptr, size_t tail) {
   V v = 0;
+#  if defined(JUMPER_IS_SKX)
+  // Too many lanes to unroll the tail; let memcpy() pick the widest moves it can.
+  memcpy(&v, ptr, (tail ? tail : N) * sizeof(T));
+#  else
   switch (tail & (N - 1)) {
     case 0: memcpy(&v, ptr, sizeof(v)); break;
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#    if defined(JUMPER_IS_HSW)
     case 15: v[14] = ptr[14]; [[fallthrough]];
     case 14: v[13] = ptr[13]; [[fallthrough]];
     case 13: v[12] = ptr[12]; [[fallthrough]];
@@ -3603,7 +3673,7 @@ SI V load(const T* ptr, size_t tail) {
     case 10: v[9] = ptr[9]; [[fallthrough]];
     case 9: v[8] = ptr[8]; [[fallthrough]];
     case 8: memcpy(&v, ptr, 8 * sizeof(T)); break;
-#  endif
+#    endif
     case 7: v[6] = ptr[6]; [[fallthrough]];
     case 6: v[5] = ptr[5]; [[fallthrough]];
     case 5: v[4] = ptr[4]; [[fallthrough]];
@@ -3612,13 +3682,17 @@ SI V load(const T* ptr, size_t tail) {
     case 2: memcpy(&v, ptr, 2 * sizeof(T)); break;
     case 1: v[0] = ptr[0];
   }
+#  endif
   return v;
 }
 template <typename V, typename T>
 SI void store(T* ptr, size_t tail, V v) {
+#  if defined(JUMPER_IS_SKX)
+  memcpy(ptr, &v, (tail ? tail : N) * sizeof(T));
+#  else
   switch (tail & (N - 1)) {
     case 0: memcpy(ptr, &v, sizeof(v)); break;
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#    if defined(JUMPER_IS_HSW)
     case 15: ptr[14] = v[14]; [[fallthrough]];
     case 14: ptr[13] = v[13]; [[fallthrough]];
     case 13: ptr[12] = v[12]; [[fallthrough]];
@@ -3627,7 +3701,7 @@ SI void store(T* ptr, size_t tail, V v) {
     case 10: ptr[9] = v[9]; [[fallthrough]];
     case 9: ptr[8] = v[8]; [[fallthrough]];
     case 8: memcpy(ptr, &v, 8 * sizeof(T)); break;
-#  endif
+#    endif
     case 7: ptr[6] = v[6]; [[fallthrough]];
     case 6: ptr[5] = v[5]; [[fallthrough]];
     case 5: ptr[4] = v[4]; [[fallthrough]];
@@ -3636,9 +3710,35 @@ SI void store(T* ptr, size_t tail, V v) {
     case 2: memcpy(ptr, &v, 2 * sizeof(T)); break;
     case 1: ptr[0] = v[0];
   }
+#  endif
 }
 
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if defined(JUMPER_IS_SKX)
+template <typename V, typename T>
+SI V gather(const T* ptr, U32 ix) {
+  V v;
+  for (size_t i = 0; i < N; i++) {
+    v[i] = ptr[ix[i]];
+  }
+  return v;
+}
+
+template <>
+F gather(const float* ptr, U32 ix) {
+  __m512i lo, hi;
+  split(ix, &lo, &hi);
+
+  return join<F>(_mm512_i32gather_ps(lo, ptr, 4), _mm512_i32gather_ps(hi, ptr, 4));
+}
+
+template <>
+U32 gather(const uint32_t* ptr, U32 ix) {
+  __m512i lo, hi;
+  split(ix, &lo, &hi);
+
+  return join<U32>(_mm512_i32gather_epi32(lo, ptr, 4), _mm512_i32gather_epi32(hi, ptr, 4));
+}
+#  elif defined(JUMPER_IS_HSW)
 template <typename V, typename T>
 SI V gather(const T* ptr, U32 ix) {
   return V{
@@ -3676,7 +3776,7 @@ SI V gather(const T* ptr, U32 ix) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#  if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if 1 && defined(JUMPER_IS_HSW)
   // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
   __m256i _01, _23;
   split(rgba, &_01, &_23);
@@ -4075,6 +4175,22 @@ STAGE_GG(mirror_x_1, Ctx::None) {
   x = clamp_01(abs_((x - 1.0f) - two(floor_((x - 1.0f) * 0.5f)) - 1.0f));
 }
 
+SI F exclusive_repeat(F v, const SkRasterPipeline_TileCtx* ctx) {
+  return v - floor_(v * ctx->invScale) * ctx->scale;
+}
+SI F exclusive_mirror(F v, const SkRasterPipeline_TileCtx* ctx) {
+  auto limit = ctx->scale;
+  auto invLimit = ctx->invScale;
+  return abs_((v - limit) - (limit + limit) * floor_((v - limit) * (invLimit * 0.5f)) - limit);
+}
+// Tile x or y to [0,limit) == [0,limit - 1 ulp] (think, sampling from images).
+// The gather stages will hard clamp the output of these stages to [0,limit)...
+// we just need to do the basic repeat or mirroring.
+STAGE_GG(repeat_x, const SkRasterPipeline_TileCtx* ctx) { x = exclusive_repeat(x, ctx); }
+STAGE_GG(repeat_y, const SkRasterPipeline_TileCtx* ctx) { y = exclusive_repeat(y, ctx); }
+STAGE_GG(mirror_x, const SkRasterPipeline_TileCtx* ctx) { x = exclusive_mirror(x, ctx); }
+STAGE_GG(mirror_y, const SkRasterPipeline_TileCtx* ctx) { y = exclusive_mirror(y, ctx); }
+
 SI I16 cond_to_mask_16(I32 cond) { return cast<I16>(cond); }
 
 STAGE_GG(decal_x, SkRasterPipeline_DecalTileCtx* ctx) {
@@ -4097,6 +4213,14 @@ STAGE_PP(check_decal_mask, SkRasterPipeline_DecalTileCtx* ctx) {
   b = b & mask;
   a = a & mask;
 }
+STAGE_PP(apply_vector_mask, const uint32_t* ctx) {
+  // Like the decal stages, the lowp mask_2pt_conical stages store 16-bit masks.
+  auto mask = sk_unaligned_load<U16>(ctx);
+  r = r & mask;
+  g = g & mask;
+  b = b & mask;
+  a = a & mask;
+}
 
 SI void round_F_to_U16(
     F R, F G, F B, F A, bool interpolatedInPremul, U16* r, U16* g, U16* b, U16* a) {
@@ -4112,7 +4236,26 @@ SI void round_F_to_U16(
 SI void gradient_lookup(
     const SkRasterPipeline_GradientCtx* c, U32 idx, F t, U16* r, U16* g, U16* b, U16* a) {
   F fr, fg, fb, fa, br, bg, bb, ba;
-#  if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#  if defined(JUMPER_IS_SKX)
+  // The stop arrays are padded to at least 16 floats, so they each fit in one zmm register.
+  if (c->stopCount <= 16) {
+    __m512i lo, hi;
+    split(idx, &lo, &hi);
+
+    auto lookup = [&](const float* table) {
+      __m512 stops = _mm512_loadu_ps(table);
+      return join<F>(_mm512_permutexvar_ps(lo, stops), _mm512_permutexvar_ps(hi, stops));
+    };
+    fr = lookup(c->fs[0]);
+    br = lookup(c->bs[0]);
+    fg = lookup(c->fs[1]);
+    bg = lookup(c->bs[1]);
+    fb = lookup(c->fs[2]);
+    bb = lookup(c->bs[2]);
+    fa = lookup(c->fs[3]);
+    ba = lookup(c->bs[3]);
+  } else
+#  elif defined(JUMPER_IS_HSW)
   if (c->stopCount <= 8) {
     __m256i lo, hi;
     split(idx, &lo, &hi);
@@ -4276,6 +4419,66 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
 }
 #  endif  // SK_SUPPORT_LEGACY_BILERP_HIGHP
 
+SI F tile(F v, SkTileMode mode, float limit, float invLimit) {
+  // The ix_and_ptr() calls in sample() will clamp tile()'s output, so no need to clamp here.
+  switch (mode) {
+    case SkTileMode::kDecal:
+    case SkTileMode::kClamp: return v;
+    case SkTileMode::kRepeat: return v - floor_(v * invLimit) * limit;
+    case SkTileMode::kMirror:
+      return abs_((v - limit) - (limit + limit) * floor_((v - limit) * (invLimit * 0.5f)) - limit);
+  }
+  SkUNREACHABLE;
+}
+
+SI void sample(
+    const SkRasterPipeline_SamplerCtx2* ctx, F x, F y, U16* r, U16* g, U16* b, U16* a) {
+  x = tile(x, ctx->tileX, ctx->width, ctx->invWidth);
+  y = tile(y, ctx->tileY, ctx->height, ctx->invHeight);
+
+  switch (ctx->ct) {
+    default: *r = *g = *b = *a = 0; break;
+
+    case kRGBA_8888_SkColorType:
+    case kBGRA_8888_SkColorType: {
+      const uint32_t* ptr;
+      U32 ix = ix_and_ptr(&ptr, ctx, x, y);
+      from_8888(gather<U32>(ptr, ix), r, g, b, a);
+      if (ctx->ct == kBGRA_8888_SkColorType) {
+        std::swap(*r, *b);
+      }
+    } break;
+  }
+}
+
+// The tiled (repeat/mirror) counterpart of bilerp_clamp_8888. Weights stay in float, and
+// since they sum to 1 the accumulated channels stay on [0,255].
+STAGE_GP(bilinear, const SkRasterPipeline_SamplerCtx2* ctx) {
+  F fx = fract(x + 0.5f), fy = fract(y + 0.5f);
+  const F wx[] = {1.0f - fx, fx};
+  const F wy[] = {1.0f - fy, fy};
+
+  F R = 0, G = 0, B = 0, A = 0;
+  F sy = y - 0.5f;
+  for (int j = 0; j < 2; j++, sy += 1.0f) {
+    F sx = x - 0.5f;
+    for (int i = 0; i < 2; i++, sx += 1.0f) {
+      U16 sr, sg, sb, sa;
+      sample(ctx, sx, sy, &sr, &sg, &sb, &sa);
+
+      F w = wx[i] * wy[j];
+      R = mad(w, cast<F>(sr), R);
+      G = mad(w, cast<F>(sg), G);
+      B = mad(w, cast<F>(sb), B);
+      A = mad(w, cast<F>(sa), A);
+    }
+  }
+  r = cast<U16>(R + 0.5f);
+  g = cast<U16>(G + 0.5f);
+  b = cast<U16>(B + 0.5f);
+  a = cast<U16>(A + 0.5f);
+}
+
 STAGE_GG(xy_to_unit_angle, Ctx::None) {
   F xabs = abs_(x), yabs = abs_(y);
 
@@ -4299,6 +4502,48 @@ STAGE_GG(xy_to_unit_angle, Ctx::None) {
 }
 STAGE_GG(xy_to_radius, Ctx::None) { x = sqrt_(x * x + y * y); }
 
+// Please see https://skia.org/dev/design/conical for how our 2pt conical shader works.
+
+STAGE_GG(negate_x, Ctx::None) { x = -x; }
+
+STAGE_GG(xy_to_2pt_conical_strip, const SkRasterPipeline_2PtConicalCtx* ctx) {
+  x = x + sqrt_(ctx->fP0 - y * y);  // ctx->fP0 = r0 * r0
+}
+
+STAGE_GG(xy_to_2pt_conical_focal_on_circle, Ctx::None) {
+  x = x + y * y / x;  // (x^2 + y^2) / x
+}
+
+STAGE_GG(xy_to_2pt_conical_well_behaved, const SkRasterPipeline_2PtConicalCtx* ctx) {
+  x = sqrt_(x * x + y * y) - x * ctx->fP0;  // ctx->fP0 = 1/r1
+}
+
+STAGE_GG(xy_to_2pt_conical_greater, const SkRasterPipeline_2PtConicalCtx* ctx) {
+  x = sqrt_(x * x - y * y) - x * ctx->fP0;  // ctx->fP0 = 1/r1
+}
+
+STAGE_GG(xy_to_2pt_conical_smaller, const SkRasterPipeline_2PtConicalCtx* ctx) {
+  x = -sqrt_(x * x - y * y) - x * ctx->fP0;  // ctx->fP0 = 1/r1
+}
+
+STAGE_GG(alter_2pt_conical_compensate_focal, const SkRasterPipeline_2PtConicalCtx* ctx) {
+  x = x + ctx->fP1;  // ctx->fP1 = f
+}
+
+STAGE_GG(alter_2pt_conical_unswap, Ctx::None) { x = 1 - x; }
+
+STAGE_GG(mask_2pt_conical_nan, SkRasterPipeline_2PtConicalCtx* c) {
+  auto is_degenerate = (x != x);  // NaN
+  x = if_then_else(is_degenerate, F(0), x);
+  sk_unaligned_store(c->fMask, cond_to_mask_16(~is_degenerate));
+}
+
+STAGE_GG(mask_2pt_conical_degenerates, SkRasterPipeline_2PtConicalCtx* c) {
+  auto is_degenerate = (x <= 0) | (x != x);
+  x = if_then_else(is_degenerate, F(0), x);
+  sk_unaligned_store(c->fMask, cond_to_mask_16(~is_degenerate));
+}
+
 // ~~~~~~ Compound stages ~~~~~~ //
 
 STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
@@ -4345,6 +4590,7 @@ NOT_IMPLEMENTED(load_16161616)
 NOT_IMPLEMENTED(load_16161616_dst)
 NOT_IMPLEMENTED(store_16161616)
 NOT_IMPLEMENTED(gather_16161616)
+NOT_IMPLEMENTED(gather_yuv_8)
 NOT_IMPLEMENTED(load_a16)
 NOT_IMPLEMENTED(load_a16_dst)
 NOT_IMPLEMENTED(store_a16)
@@ -4396,12 +4642,6 @@ NOT_IMPLEMENTED(HLGinvish)
 NOT_IMPLEMENTED(rgb_to_hsl)
 NOT_IMPLEMENTED(hsl_to_rgb)
 NOT_IMPLEMENTED(gauss_a_to_rgba)
-NOT_IMPLEMENTED(mirror_x)
-NOT_IMPLEMENTED(repeat_x)
-NOT_IMPLEMENTED(mirror_y)
-NOT_IMPLEMENTED(repeat_y)
-NOT_IMPLEMENTED(negate_x)
-NOT_IMPLEMENTED(bilinear)
 #  if defined(SK_SUPPORT_LEGACY_BILERP_HIGHP)
 NOT_IMPLEMENTED(bilerp_clamp_8888)
 #  endif
@@ -4421,16 +4661,6 @@ NOT_IMPLEMENTED(bicubic_p1y)
 NOT_IMPLEMENTED(bicubic_p3y)
 NOT_IMPLEMENTED(save_xy)
 NOT_IMPLEMENTED(accumulate)
-NOT_IMPLEMENTED(xy_to_2pt_conical_well_behaved)
-NOT_IMPLEMENTED(xy_to_2pt_conical_strip)
-NOT_IMPLEMENTED(xy_to_2pt_conical_focal_on_circle)
-NOT_IMPLEMENTED(xy_to_2pt_conical_smaller)
-NOT_IMPLEMENTED(xy_to_2pt_conical_greater)
-NOT_IMPLEMENTED(alter_2pt_conical_compensate_focal)
-NOT_IMPLEMENTED(alter_2pt_conical_unswap)
-NOT_IMPLEMENTED(mask_2pt_conical_nan)
-NOT_IMPLEMENTED(mask_2pt_conical_degenerates)
-NOT_IMPLEMENTED(apply_vector_mask)
 #  undef NOT_IMPLEMENTED
 
 #endif  // defined(JUMPER_IS_SCALAR) controlling whether we build lowp stages
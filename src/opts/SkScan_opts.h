@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkScan_opts_DEFINED
+#define SkScan_opts_DEFINED
+
+#include "include/core/SkColor.h"
+#include "include/private/SkFixed.h"
+#include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
+
+// Coverage accumulation for the analytic AA scan converter (SkScan_AAAPath.cpp).
+// Every alpha row there is built by adding or subtracting whole rows of partial coverage,
+// so we do that a register at a time rather than a pixel at a time.
+
+namespace SK_OPTS_NS {
+
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+static constexpr int kAlphaStride = 64;
+#elif defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+static constexpr int kAlphaStride = 32;
+#else
+static constexpr int kAlphaStride = 16;
+#endif
+
+using AlphaVec = skvx::Vec<kAlphaStride, uint8_t>;
+
+// dst[i] = min(dst[i] + src[i], 0xFF)
+/*not static*/ inline void add_alphas(SkAlpha dst[], const SkAlpha src[], int n) {
+  for (; n >= kAlphaStride; n -= kAlphaStride) {
+    skvx::saturated_add(AlphaVec::Load(dst), AlphaVec::Load(src)).store(dst);
+    dst += kAlphaStride;
+    src += kAlphaStride;
+  }
+  for (; n > 0; n--) {
+    *dst = std::min(0xFF, *dst + *src++);
+    dst++;
+  }
+}
+
+// dst[i] = min(dst[i] + alpha, 0xFF)
+/*not static*/ inline void add_alpha_span(SkAlpha dst[], SkAlpha alpha, int n) {
+  const AlphaVec a(alpha);
+  for (; n >= kAlphaStride; n -= kAlphaStride) {
+    skvx::saturated_add(AlphaVec::Load(dst), a).store(dst);
+    dst += kAlphaStride;
+  }
+  for (; n > 0; n--) {
+    *dst = std::min(0xFF, *dst + alpha);
+    dst++;
+  }
+}
+
+// dst[i] = max(dst[i] - src[i], 0)
+/*not static*/ inline void sub_alphas(SkAlpha dst[], const SkAlpha src[], int n) {
+  for (; n >= kAlphaStride; n -= kAlphaStride) {
+    // There's no saturated_sub(), but x - min(x,y) is the same thing for unsigned values.
+    AlphaVec d = AlphaVec::Load(dst);
+    (d - skvx::min(d, AlphaVec::Load(src))).store(dst);
+    dst += kAlphaStride;
+    src += kAlphaStride;
+  }
+  for (; n > 0; n--) {
+    *dst = *dst > *src ? *dst - *src : 0;
+    dst++;
+    src++;
+  }
+}
+
+// dst[i] = (alpha16 + i*dY) >> 8, truncated to 8 bits.
+/*not static*/ inline void alpha_ramp(SkAlpha dst[], SkFixed alpha16, SkFixed dY, int n) {
+  using I32 = skvx::Vec<16, int32_t>;
+  const I32 step = I32{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15} * dY;
+  for (; n >= 16; n -= 16) {
+    skvx::cast<uint8_t>((alpha16 + step) >> 8).store(dst);
+    alpha16 += 16 * dY;
+    dst += 16;
+  }
+  for (; n > 0; n--) {
+    *dst++ = SkTo<uint8_t>((alpha16 >> 8) & 0xFF);
+    alpha16 += dY;
+  }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkScan_opts_DEFINED
@@ -10,6 +10,8 @@
 
 #include "include/private/SkColorData.h"
 #include "include/private/SkVx.h"
+#include "src/core/SkOpts.h"
+#include <string.h>
 #include <utility>
 
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
@@ -1301,6 +1303,99 @@ static void insert_alpha_should_swaprb(
 }
 #endif
 
+// The rest of these are written once with skvx, so each SkOpts_*.cpp gets them at its own width.
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+static constexpr int kExpandStride = 16;
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+static constexpr int kExpandStride = 8;
+#else
+static constexpr int kExpandStride = 4;
+#endif
+
+// 16-bit PNG components are big-endian, so truncating a (little-endian) 16-bit load to 8 bits
+// keeps exactly the high byte we want.
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const uint8_t* src, int count) {
+  using U16 = skvx::Vec<4 * kExpandStride, uint16_t>;
+  for (; count >= kExpandStride; count -= kExpandStride) {
+    skvx::cast<uint8_t>(U16::Load(src)).store(dst);
+    src += 8 * kExpandStride;
+    dst += kExpandStride;
+  }
+  for (; count > 0; count--) {
+    *dst++ = (uint32_t)src[6] << 24 | (uint32_t)src[4] << 16 | (uint32_t)src[2] << 8 | src[0];
+    src += 8;
+  }
+}
+
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+  using U16 = skvx::Vec<16, uint16_t>;
+  using U8 = skvx::Vec<16, uint8_t>;
+  const U8 opaque = {0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF};
+  // Each load covers 4 pixels and part of the next, so keep 2 pixels in reserve.
+  for (; count >= 6; count -= 4) {
+    U8 rgb = skvx::cast<uint8_t>(U16::Load(src));
+    (skvx::shuffle<0, 1, 2, 2, 3, 4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11>(rgb) | opaque).store(dst);
+    src += 24;
+    dst += 4;
+  }
+  for (; count > 0; count--) {
+    *dst++ = (uint32_t)0xFF << 24 | (uint32_t)src[4] << 16 | (uint32_t)src[2] << 8 | src[0];
+    src += 6;
+  }
+}
+
+/*not static*/ inline void index_to_8888(
+    uint32_t dst[], const uint8_t* src, const uint32_t table[], int count) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+  for (; count >= 16; count -= 16) {
+    __m512i indices = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)src));
+    _mm512_storeu_si512(dst, _mm512_i32gather_epi32(indices, table, 4));
+    src += 16;
+    dst += 16;
+  }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+  for (; count >= 8; count -= 8) {
+    __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)src));
+    _mm256_storeu_si256((__m256i*)dst, _mm256_i32gather_epi32((const int*)table, indices, 4));
+    src += 8;
+    dst += 8;
+  }
+#endif
+  // Without a gather instruction, a scalar loop is as good as anything.
+  for (; count > 0; count--) {
+    *dst++ = table[*src++];
+  }
+}
+
+/*not static*/ inline void masks_to_8888(
+    uint32_t dst[], const uint32_t src[], const SkOpts::SwizzleMasks& masks, int count) {
+  using U32 = skvx::Vec<kExpandStride, uint32_t>;
+  using I32 = skvx::Vec<kExpandStride, int32_t>;
+  using F32 = skvx::Vec<kExpandStride, float>;
+  auto expand = [&](const U32& px) {
+    U32 rgba = 0;
+    for (int i = 0; i < 4; i++) {
+      // Each channel is at most 8 bits once shifted down, so int conversions are exact and fast.
+      F32 c = skvx::cast<float>(skvx::cast<int32_t>((px & masks.mask[i]) >> masks.shift[i]));
+      I32 bits = skvx::cast<int32_t>(c * masks.scale[i] + masks.bias[i]);
+      rgba |= skvx::cast<uint32_t>(bits) << (8 * i);
+    }
+    return rgba;
+  };
+
+  for (; count >= kExpandStride; count -= kExpandStride) {
+    expand(U32::Load(src)).store(dst);
+    src += kExpandStride;
+    dst += kExpandStride;
+  }
+  if (count > 0) {
+    uint32_t tmp[kExpandStride] = {};
+    memcpy(tmp, src, count * sizeof(uint32_t));
+    expand(U32::Load(tmp)).store(tmp);
+    memcpy(dst, tmp, count * sizeof(uint32_t));
+  }
+}
+
 }  // namespace SK_OPTS_NS
 
 #endif  // SkSwizzler_opts_DEFINED
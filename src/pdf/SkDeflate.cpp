@@ -8,13 +8,19 @@
 #include "src/pdf/SkDeflate.h"
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/private/SkMalloc.h"
+#include "include/private/SkSemaphore.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkTraceEvent.h"
 
 #include "zlib.h"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
 
 namespace {
 
@@ -27,6 +33,193 @@ void* skia_alloc_func(void*, T items, T size) {
 
 void skia_free_func(void*, void* address) { sk_free(address); }
 
+void init_zstream(z_stream* zStream) {
+  zStream->next_in = nullptr;
+  zStream->zalloc = &skia_alloc_func;
+  zStream->zfree = &skia_free_func;
+  zStream->opaque = nullptr;
+}
+
+// Block-parallel compression, as in pigz.  Input is cut into kBlockSize blocks, and each block
+// is compressed on its own into raw deflate data, using the kWindowSize bytes before it as a
+// preset dictionary.  Every block but the last ends with a sync flush, which leaves it
+// byte-aligned and not final, so the blocks concatenate into one deflate stream.  We write the
+// zlib or gzip header and trailer ourselves around it, and keep the checksum as input arrives.
+constexpr size_t kBlockSize = 128 * 1024;
+constexpr size_t kWindowSize = 32 * 1024;  // The most deflate can refer back.
+constexpr size_t kMaxBlocksInFlight = 16;
+
+struct Block {
+  explicit Block(int level) : fLevel(level) {}
+
+  const int fLevel;
+  std::vector<uint8_t> fInput;  // The window, then the block itself.
+  size_t fWindow = 0;
+  bool fLast = false;
+  std::vector<uint8_t> fOutput;
+
+  // Whoever claims the block compresses it: either an executor thread, or the writer if it
+  // gets to the block first.  The writer never waits on a block that hasn't started, so
+  // this can't deadlock even when the executor's threads are all busy with our caller.
+  std::atomic<bool> fClaimed{false};
+  SkSemaphore fDone;
+
+  void compress() {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    z_stream zStream;
+    init_zstream(&zStream);
+    SkDEBUGCODE(int r =)
+    deflateInit2(&zStream, fLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+    SkASSERT(Z_OK == r);
+    if (fWindow) {
+      deflateSetDictionary(&zStream, fInput.data(), SkToUInt(fWindow));
+    }
+    const size_t size = fInput.size() - fWindow;
+    // deflateBound() is for Z_FINISH; a sync flush can add a few more bytes.
+    fOutput.resize(deflateBound(&zStream, (uLong)size) + 16);
+    zStream.next_in = fInput.data() + fWindow;
+    zStream.avail_in = SkToUInt(size);
+    size_t used = 0;
+    const int flush = fLast ? Z_FINISH : Z_SYNC_FLUSH;
+    while (true) {
+      zStream.next_out = fOutput.data() + used;
+      zStream.avail_out = SkToUInt(fOutput.size() - used);
+      int result = deflate(&zStream, flush);
+      used = fOutput.size() - zStream.avail_out;
+      if (result == Z_STREAM_END || (!fLast && zStream.avail_out > 0)) {
+        break;
+      }
+      fOutput.resize(2 * fOutput.size());
+    }
+    fOutput.resize(used);
+    (void)deflateEnd(&zStream);
+    std::vector<uint8_t>().swap(fInput);
+  }
+};
+
+class ParallelDeflate {
+ public:
+  ParallelDeflate(SkWStream* out, int level, bool gzip, SkExecutor* executor)
+      : fOut(out), fLevel(level), fGzip(gzip), fExecutor(executor) {
+    fCheck = gzip ? crc32(0, Z_NULL, 0) : adler32(0, Z_NULL, 0);
+    fCurrent = std::make_shared<Block>(fLevel);
+    fCurrent->fInput.reserve(kBlockSize);
+  }
+
+  void write(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len;) {
+      const size_t chunk = std::min<size_t>(len - i, 1 << 30);
+      fCheck = fGzip ? crc32(fCheck, data + i, SkToUInt(chunk))
+                     : adler32(fCheck, data + i, SkToUInt(chunk));
+      i += chunk;
+    }
+    fTotalIn += len;
+
+    while (len > 0) {
+      std::vector<uint8_t>& input = fCurrent->fInput;
+      const size_t tocopy = std::min(len, fCurrent->fWindow + kBlockSize - input.size());
+      input.insert(input.end(), data, data + tocopy);
+      data += tocopy;
+      len -= tocopy;
+      if (input.size() == fCurrent->fWindow + kBlockSize) {
+        this->dispatch(false);
+      }
+    }
+  }
+
+  void finalize() {
+    this->dispatch(true);
+    while (!fInFlight.empty()) {
+      this->writeOldest();
+    }
+    uint8_t trailer[8];
+    if (fGzip) {
+      for (int i = 0; i < 4; ++i) {
+        trailer[i] = (uint8_t)(fCheck >> (8 * i));
+        trailer[4 + i] = (uint8_t)(fTotalIn >> (8 * i));
+      }
+      fOut->write(trailer, 8);
+    } else {
+      for (int i = 0; i < 4; ++i) {
+        trailer[i] = (uint8_t)(fCheck >> (24 - 8 * i));
+      }
+      fOut->write(trailer, 4);
+    }
+  }
+
+  size_t bytesWritten() const { return fTotalIn; }
+
+ private:
+  void dispatch(bool last) {
+    std::shared_ptr<Block> block = std::move(fCurrent);
+    block->fLast = last;
+    fInFlight.push_back(block);
+    if (last) {
+      // The writer compresses the last block itself, so a stream that fits in one block
+      // is compressed in a single call without involving the executor at all.
+      return;
+    }
+
+    fCurrent = std::make_shared<Block>(fLevel);
+    const size_t window = std::min(kWindowSize, block->fInput.size());
+    fCurrent->fInput.reserve(window + kBlockSize);
+    fCurrent->fInput.assign(block->fInput.end() - window, block->fInput.end());
+    fCurrent->fWindow = window;
+
+    fExecutor->add([block]() {
+      if (!block->fClaimed.exchange(true)) {
+        block->compress();
+      }
+      block->fDone.signal();
+    });
+    while (fInFlight.size() > kMaxBlocksInFlight) {
+      this->writeOldest();
+    }
+  }
+
+  void writeOldest() {
+    std::shared_ptr<Block> block = std::move(fInFlight.front());
+    fInFlight.pop_front();
+    if (block->fClaimed.exchange(true)) {
+      block->fDone.wait();
+    } else {
+      block->compress();
+    }
+    if (!fWroteHeader) {
+      this->writeHeader();
+      fWroteHeader = true;
+    }
+    fOut->write(block->fOutput.data(), block->fOutput.size());
+  }
+
+  void writeHeader() {
+    // The same header zlib itself would write for this level.
+    const int level = fLevel < 0 ? 6 : fLevel;
+    if (fGzip) {
+      const uint8_t xfl = level == 9 ? 2 : level < 2 ? 4 : 0;
+      const uint8_t header[10] = {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, xfl, 3};
+      fOut->write(header, sizeof(header));
+    } else {
+      const int flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+      const int cmf = 0x78;
+      int flg = flevel << 6;
+      flg += 31 - (cmf * 256 + flg) % 31;
+      const uint8_t header[2] = {(uint8_t)cmf, (uint8_t)flg};
+      fOut->write(header, sizeof(header));
+    }
+  }
+
+  SkWStream* fOut;
+  const int fLevel;
+  const bool fGzip;
+  SkExecutor* fExecutor;
+  std::shared_ptr<Block> fCurrent;
+  std::deque<std::shared_ptr<Block>> fInFlight;
+  uLong fCheck;
+  size_t fTotalIn = 0;
+  bool fWroteHeader = false;
+};
+
 }  // namespace
 
 #define SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE 4096
@@ -60,20 +253,23 @@ struct SkDeflateWStream::Impl {
   unsigned char fInBuffer[SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE];
   size_t fInBufferIndex;
   z_stream fZStream;
+  std::unique_ptr<ParallelDeflate> fParallel;  // Used instead of fZStream if we have an executor.
 };
 
-SkDeflateWStream::SkDeflateWStream(SkWStream* out, int compressionLevel, bool gzip)
+SkDeflateWStream::SkDeflateWStream(
+    SkWStream* out, int compressionLevel, bool gzip, SkExecutor* executor)
     : fImpl(std::make_unique<SkDeflateWStream::Impl>()) {
   fImpl->fOut = out;
   fImpl->fInBufferIndex = 0;
   if (!fImpl->fOut) {
     return;
   }
-  fImpl->fZStream.next_in = nullptr;
-  fImpl->fZStream.zalloc = &skia_alloc_func;
-  fImpl->fZStream.zfree = &skia_free_func;
-  fImpl->fZStream.opaque = nullptr;
   SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+  if (executor) {
+    fImpl->fParallel = std::make_unique<ParallelDeflate>(out, compressionLevel, gzip, executor);
+    return;
+  }
+  init_zstream(&fImpl->fZStream);
   SkDEBUGCODE(int r =)
   deflateInit2(
       &fImpl->fZStream, compressionLevel, Z_DEFLATED, gzip ? 0x1F : 0x0F, 8, Z_DEFAULT_STRATEGY);
@@ -87,6 +283,11 @@ void SkDeflateWStream::finalize() {
   if (!fImpl->fOut) {
     return;
   }
+  if (fImpl->fParallel) {
+    fImpl->fParallel->finalize();
+    fImpl->fOut = nullptr;
+    return;
+  }
   do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer, fImpl->fInBufferIndex);
   (void)deflateEnd(&fImpl->fZStream);
   fImpl->fOut = nullptr;
@@ -97,6 +298,10 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
   if (!fImpl->fOut) {
     return false;
   }
+  if (fImpl->fParallel) {
+    fImpl->fParallel->write((const uint8_t*)void_buffer, len);
+    return true;
+  }
   const char* buffer = (const char*)void_buffer;
   while (len > 0) {
     size_t tocopy = std::min(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
@@ -117,5 +322,8 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 }
 
 size_t SkDeflateWStream::bytesWritten() const {
+  if (fImpl->fParallel) {
+    return fImpl->fParallel->bytesWritten();
+  }
   return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
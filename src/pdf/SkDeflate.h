@@ -10,6 +10,8 @@
 
 #include "include/core/SkStream.h"
 
+class SkExecutor;
+
 /**
  * Wrap a stream in this class to compress the information written to
  * this stream using the Deflate algorithm.
@@ -28,8 +30,15 @@ class SkDeflateWStream final : public SkWStream {
       a wrapper, documented in RFC 1952, around a deflate stream."
       gzip adds a header with a magic number to the beginning of the
       stream, allowing a client to identify a gzip file.
+
+      @param executor iff not null, input longer than one block (128KB)
+      is compressed a block at a time in parallel, pigz-style.  Each
+      block is primed with the 32KB before it, so the output is only
+      slightly larger than serial compression's.  Input that fits in
+      one block is compressed in a single call when finalized.
    */
-  SkDeflateWStream(SkWStream*, int compressionLevel = -1, bool gzip = false);
+  SkDeflateWStream(
+      SkWStream*, int compressionLevel = -1, bool gzip = false, SkExecutor* executor = nullptr);
 
   /** The destructor calls finalize(). */
   ~SkDeflateWStream() override;
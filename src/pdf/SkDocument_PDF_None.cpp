@@ -20,3 +20,13 @@ void SkPDF::SetNodeId(SkCanvas* c, int n) {
 SkPDF::AttributeList::AttributeList() = default;
 
 SkPDF::AttributeList::~AttributeList() = default;
+
+class SkPDFCache {};
+
+SkPDF::ResourceCache::ResourceCache(size_t) {}
+
+SkPDF::ResourceCache::~ResourceCache() = default;
+
+size_t SkPDF::ResourceCache::bytesUsed() const { return 0; }
+
+void SkPDF::ResourceCache::purgeAll() {}
@@ -16,8 +16,10 @@
 #include "include/private/SkColorData.h"
 #include "include/private/SkImageInfoPriv.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkMD5.h"
 #include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkJpegInfo.h"
+#include "src/pdf/SkPDFCache.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFTypes.h"
 #include "src/pdf/SkPDFUtils.h"
@@ -66,90 +68,117 @@ static SkColor get_neighbor_avg_color(const SkPixmap& bm, int xOrig, int yOrig)
   return n > 0 ? SkColorSetRGB(SkToU8(r / n), SkToU8(g / n), SkToU8(b / n)) : SK_ColorTRANSPARENT;
 }
 
-template <typename T>
-static void emit_image_stream(
-    SkPDFDocument* doc, SkPDFIndirectReference ref, T writeStream, SkISize size,
-    const char* colorSpace, SkPDFIndirectReference sMask, int length, bool isJpeg) {
-  SkPDFDict pdfDict("XObject");
-  pdfDict.insertName("Subtype", "Image");
-  pdfDict.insertInt("Width", size.width());
-  pdfDict.insertInt("Height", size.height());
-  pdfDict.insertName("ColorSpace", colorSpace);
+static void populate_image_dict(
+    SkPDFDict* pdfDict, SkISize size, const char* colorSpace, SkPDFIndirectReference sMask,
+    bool isJpeg) {
+  pdfDict->insertName("Subtype", "Image");
+  pdfDict->insertInt("Width", size.width());
+  pdfDict->insertInt("Height", size.height());
+  pdfDict->insertName("ColorSpace", colorSpace);
   if (sMask) {
-    pdfDict.insertRef("SMask", sMask);
+    pdfDict->insertRef("SMask", sMask);
   }
-  pdfDict.insertInt("BitsPerComponent", 8);
+  pdfDict->insertInt("BitsPerComponent", 8);
 #ifdef SK_PDF_BASE85_BINARY
   auto filters = SkPDFMakeArray();
   filters->appendName("ASCII85Decode");
   filters->appendName(isJpeg ? "DCTDecode" : "FlateDecode");
-  pdfDict.insertObject("Filter", std::move(filters));
+  pdfDict->insertObject("Filter", std::move(filters));
 #else
-  pdfDict.insertName("Filter", isJpeg ? "DCTDecode" : "FlateDecode");
+  pdfDict->insertName("Filter", isJpeg ? "DCTDecode" : "FlateDecode");
 #endif
   if (isJpeg) {
-    pdfDict.insertInt("ColorTransform", 0);
+    pdfDict->insertInt("ColorTransform", 0);
   }
+}
+
+template <typename T>
+static void emit_image_stream(
+    SkPDFDocument* doc, SkPDFIndirectReference ref, T writeStream, SkISize size,
+    const char* colorSpace, SkPDFIndirectReference sMask, int length, bool isJpeg) {
+  SkPDFDict pdfDict("XObject");
+  populate_image_dict(&pdfDict, size, colorSpace, sMask, isJpeg);
   pdfDict.insertInt("Length", length);
   doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
-static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+// Deflates whatever writePixels writes into memory, base85-encoding it if so configured.
+template <typename T>
+static sk_sp<SkData> deflate_image_data(SkPDFDocument* doc, T writePixels) {
   SkDynamicMemoryWStream buffer;
-  SkDeflateWStream deflateWStream(&buffer);
-  if (kAlpha_8_SkColorType == pm.colorType()) {
-    SkASSERT(pm.rowBytes() == (size_t)pm.width());
-    buffer.write(pm.addr8(), pm.width() * pm.height());
-  } else {
-    SkASSERT(pm.alphaType() == kUnpremul_SkAlphaType);
-    SkASSERT(pm.colorType() == kBGRA_8888_SkColorType);
-    SkASSERT(pm.rowBytes() == (size_t)pm.width() * 4);
-    const uint32_t* ptr = pm.addr32();
-    const uint32_t* stop = ptr + pm.height() * pm.width();
-
-    uint8_t byteBuffer[4092];
-    uint8_t* bufferStop = byteBuffer + SK_ARRAY_COUNT(byteBuffer);
-    uint8_t* dst = byteBuffer;
-    while (ptr != stop) {
-      *dst++ = 0xFF & ((*ptr++) >> SK_BGRA_A32_SHIFT);
-      if (dst == bufferStop) {
-        deflateWStream.write(byteBuffer, sizeof(byteBuffer));
-        dst = byteBuffer;
-      }
-    }
-    deflateWStream.write(byteBuffer, dst - byteBuffer);
+  {
+    SkDeflateWStream deflateWStream(&buffer, -1, false, doc->executor());
+    writePixels(&deflateWStream);
+    deflateWStream.finalize();
   }
-  deflateWStream.finalize();
-
 #ifdef SK_PDF_BASE85_BINARY
   SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
 #endif
-  int length = SkToInt(buffer.bytesWritten());
+  return buffer.detachAsData();
+}
+
+// Deflates whatever writePixels writes into an image stream.  When the document compresses in
+// place, that goes straight into the document; otherwise it's buffered so we know its length.
+template <typename T>
+static void emit_deflated_image_stream(
+    SkPDFDocument* doc, SkPDFIndirectReference ref, T writePixels, SkISize size,
+    const char* colorSpace, SkPDFIndirectReference sMask) {
+#ifndef SK_PDF_BASE85_BINARY
+  if (doc->compressesInPlace()) {
+    SkPDFDict pdfDict("XObject");
+    populate_image_dict(&pdfDict, size, colorSpace, sMask, false);
+    doc->emitStreamWithDeferredLength(
+        &pdfDict,
+        [&writePixels](SkWStream* dst) {
+          SkDeflateWStream deflateWStream(dst);
+          writePixels(&deflateWStream);
+          deflateWStream.finalize();
+        },
+        ref);
+    return;
+  }
+#endif
+  sk_sp<SkData> data = deflate_image_data(doc, std::move(writePixels));
   emit_image_stream(
-      doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-      pm.info().dimensions(), "DeviceGray", SkPDFIndirectReference(), length, false);
+      doc, ref, [&data](SkWStream* stream) { stream->write(data->data(), data->size()); }, size,
+      colorSpace, sMask, SkToInt(data->size()), false);
 }
 
-static void do_deflated_image(
-    const SkPixmap& pm, SkPDFDocument* doc, bool isOpaque, SkPDFIndirectReference ref) {
-  SkPDFIndirectReference sMask;
-  if (!isOpaque) {
-    sMask = doc->reserveRef();
+static void write_alpha(const SkPixmap& pm, SkWStream* deflateWStream) {
+  if (kAlpha_8_SkColorType == pm.colorType()) {
+    SkASSERT(pm.rowBytes() == (size_t)pm.width());
+    deflateWStream->write(pm.addr8(), pm.width() * pm.height());
+    return;
   }
-  SkDynamicMemoryWStream buffer;
-  SkDeflateWStream deflateWStream(&buffer);
-  const char* colorSpace = "DeviceGray";
+  SkASSERT(pm.alphaType() == kUnpremul_SkAlphaType);
+  SkASSERT(pm.colorType() == kBGRA_8888_SkColorType);
+  SkASSERT(pm.rowBytes() == (size_t)pm.width() * 4);
+  const uint32_t* ptr = pm.addr32();
+  const uint32_t* stop = ptr + pm.height() * pm.width();
+
+  uint8_t byteBuffer[4092];
+  uint8_t* bufferStop = byteBuffer + SK_ARRAY_COUNT(byteBuffer);
+  uint8_t* dst = byteBuffer;
+  while (ptr != stop) {
+    *dst++ = 0xFF & ((*ptr++) >> SK_BGRA_A32_SHIFT);
+    if (dst == bufferStop) {
+      deflateWStream->write(byteBuffer, sizeof(byteBuffer));
+      dst = byteBuffer;
+    }
+  }
+  deflateWStream->write(byteBuffer, dst - byteBuffer);
+}
+
+static void write_pixels(const SkPixmap& pm, SkWStream* deflateWStream) {
   switch (pm.colorType()) {
     case kAlpha_8_SkColorType:
-      fill_stream(&deflateWStream, '\x00', pm.width() * pm.height());
+      fill_stream(deflateWStream, '\x00', pm.width() * pm.height());
       break;
     case kGray_8_SkColorType:
-      SkASSERT(sMask.fValue = -1);
       SkASSERT(pm.rowBytes() == (size_t)pm.width());
-      deflateWStream.write(pm.addr8(), pm.width() * pm.height());
+      deflateWStream->write(pm.addr8(), pm.width() * pm.height());
       break;
     default:
-      colorSpace = "DeviceRGB";
       SkASSERT(pm.alphaType() == kUnpremul_SkAlphaType);
       SkASSERT(pm.colorType() == kBGRA_8888_SkColorType);
       SkASSERT(pm.rowBytes() == (size_t)pm.width() * 4);
@@ -168,49 +197,77 @@ static void do_deflated_image(
           *dst++ = SkColorGetG(color);
           *dst++ = SkColorGetB(color);
           if (dst == bufferStop) {
-            deflateWStream.write(byteBuffer, sizeof(byteBuffer));
+            deflateWStream->write(byteBuffer, sizeof(byteBuffer));
             dst = byteBuffer;
           }
         }
       }
-      deflateWStream.write(byteBuffer, dst - byteBuffer);
+      deflateWStream->write(byteBuffer, dst - byteBuffer);
   }
-  deflateWStream.finalize();
-#ifdef SK_PDF_BASE85_BINARY
-  SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-#endif
-  int length = SkToInt(buffer.bytesWritten());
-  emit_image_stream(
-      doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-      pm.info().dimensions(), colorSpace, sMask, length, false);
+}
+
+static const char* pixels_color_space(const SkPixmap& pm) {
+  const bool isGray =
+      pm.colorType() == kAlpha_8_SkColorType || pm.colorType() == kGray_8_SkColorType;
+  return isGray ? "DeviceGray" : "DeviceRGB";
+}
+
+static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+  emit_deflated_image_stream(
+      doc, ref, [&pm](SkWStream* dst) { write_alpha(pm, dst); }, pm.info().dimensions(),
+      "DeviceGray", SkPDFIndirectReference());
+}
+
+static void do_deflated_image(
+    const SkPixmap& pm, SkPDFDocument* doc, bool isOpaque, SkPDFIndirectReference ref) {
+  SkPDFIndirectReference sMask;
+  if (!isOpaque) {
+    sMask = doc->reserveRef();
+  }
+  emit_deflated_image_stream(
+      doc, ref, [&pm](SkWStream* dst) { write_pixels(pm, dst); }, pm.info().dimensions(),
+      pixels_color_space(pm), sMask);
   if (!isOpaque) {
     do_deflated_alpha(pm, doc, sMask);
   }
 }
 
-static bool do_jpeg(
-    sk_sp<SkData> data, SkPDFDocument* doc, SkISize size, SkPDFIndirectReference ref) {
+// Returns the color space to embed this JPEG as, or nullptr if it can't be passed through.
+static const char* jpeg_color_space(const SkData& data, SkISize size) {
   SkISize jpegSize;
   SkEncodedInfo::Color jpegColorType;
   SkEncodedOrigin exifOrientation;
-  if (!SkGetJpegInfo(data->data(), data->size(), &jpegSize, &jpegColorType, &exifOrientation)) {
-    return false;
+  if (!SkGetJpegInfo(data.data(), data.size(), &jpegSize, &jpegColorType, &exifOrientation)) {
+    return nullptr;
   }
   bool yuv = jpegColorType == SkEncodedInfo::kYUV_Color;
   bool goodColorType = yuv || jpegColorType == SkEncodedInfo::kGray_Color;
   if (jpegSize != size  // Safety check.
       || !goodColorType || kTopLeft_SkEncodedOrigin != exifOrientation) {
-    return false;
+    return nullptr;
   }
+  return yuv ? "DeviceRGB" : "DeviceGray";
+}
+
+static sk_sp<SkData> jpeg_stream_data(sk_sp<SkData> data) {
 #ifdef SK_PDF_BASE85_BINARY
   SkDynamicMemoryWStream buffer;
   SkPDFUtils::Base85Encode(SkMemoryStream::MakeDirect(data->data(), data->size()), &buffer);
   data = buffer.detachAsData();
 #endif
+  return data;
+}
 
+static bool do_jpeg(
+    sk_sp<SkData> data, SkPDFDocument* doc, SkISize size, SkPDFIndirectReference ref) {
+  const char* colorSpace = jpeg_color_space(*data, size);
+  if (!colorSpace) {
+    return false;
+  }
+  data = jpeg_stream_data(std::move(data));
   emit_image_stream(
-      doc, ref, [&data](SkWStream* dst) { dst->write(data->data(), data->size()); }, jpegSize,
-      yuv ? "DeviceRGB" : "DeviceGray", SkPDFIndirectReference(), SkToInt(data->size()), true);
+      doc, ref, [&data](SkWStream* dst) { dst->write(data->data(), data->size()); }, size,
+      colorSpace, SkPDFIndirectReference(), SkToInt(data->size()), true);
   return true;
 }
 
@@ -235,11 +292,100 @@ static SkBitmap to_pixels(const SkImage* image) {
   return bm;
 }
 
+// Encodes an image into memory the same way serialize_image() writes it to a document.  bm
+// holds the image's pixels if the caller already has them.
+static sk_sp<SkPDFCache::Image> encode_image(
+    const SkImage* img, sk_sp<SkData> encoded, int encodingQuality, SkBitmap bm,
+    SkPDFDocument* doc) {
+  auto image = sk_make_sp<SkPDFCache::Image>();
+  image->fSize = img->dimensions();
+  image->fIsJpeg = true;
+  if (encoded && (image->fColorSpace = jpeg_color_space(*encoded, image->fSize))) {
+    image->fData = jpeg_stream_data(std::move(encoded));
+    return image;
+  }
+  if (bm.isNull()) {
+    bm = to_pixels(img);
+  }
+  const SkPixmap& pm = bm.pixmap();
+  bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
+  if (encodingQuality <= 100 && isOpaque) {
+    if (sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality)) {
+      if ((image->fColorSpace = jpeg_color_space(*data, image->fSize))) {
+        image->fData = jpeg_stream_data(std::move(data));
+        return image;
+      }
+    }
+  }
+  image->fIsJpeg = false;
+  image->fColorSpace = pixels_color_space(pm);
+  image->fData = deflate_image_data(doc, [&pm](SkWStream* dst) { write_pixels(pm, dst); });
+  if (!isOpaque) {
+    image->fSMask = deflate_image_data(doc, [&pm](SkWStream* dst) { write_alpha(pm, dst); });
+  }
+  return image;
+}
+
+static void emit_encoded_image(
+    const SkPDFCache::Image& image, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+  SkPDFIndirectReference sMask;
+  if (image.fSMask) {
+    sMask = doc->reserveRef();
+  }
+  const SkData& data = *image.fData;
+  emit_image_stream(
+      doc, ref, [&data](SkWStream* dst) { dst->write(data.data(), data.size()); }, image.fSize,
+      image.fColorSpace, sMask, SkToInt(data.size()), image.fIsJpeg);
+  if (image.fSMask) {
+    const SkData& alpha = *image.fSMask;
+    emit_image_stream(
+        doc, sMask, [&alpha](SkWStream* dst) { dst->write(alpha.data(), alpha.size()); },
+        image.fSize, "DeviceGray", SkPDFIndirectReference(), SkToInt(alpha.size()), false);
+  }
+}
+
+// Looks the image up in the document's resource cache by a digest of its encoded data, or of
+// its pixels if it has none, and only encodes it if it isn't there.
+static void serialize_cached_image(
+    const SkImage* img, int encodingQuality, SkPDFDocument* doc, SkPDFIndirectReference ref,
+    SkPDFCache* cache) {
+  SkISize dimensions = img->dimensions();
+  sk_sp<SkData> encoded = img->refEncodedData();
+  SkBitmap bm;
+  SkMD5 md5;
+  md5.writeText("image");
+  md5.write(&encodingQuality, sizeof(encodingQuality));
+  md5.write(&dimensions, sizeof(dimensions));
+  if (encoded) {
+    md5.write(encoded->data(), encoded->size());
+  } else {
+    bm = to_pixels(img);
+    const SkPixmap& pm = bm.pixmap();
+    const int colorType = pm.colorType();
+    md5.write(&colorType, sizeof(colorType));
+    for (int y = 0; y < pm.height(); ++y) {
+      md5.write(pm.addr(0, y), pm.info().minRowBytes());
+    }
+  }
+  const SkPDFCache::Key key = md5.finish();
+
+  sk_sp<const SkPDFCache::Image> image = cache->findImage(key);
+  if (!image) {
+    image = encode_image(img, std::move(encoded), encodingQuality, std::move(bm), doc);
+    cache->addImage(key, image);
+  }
+  emit_encoded_image(*image, doc, ref);
+}
+
 void serialize_image(
     const SkImage* img, int encodingQuality, SkPDFDocument* doc, SkPDFIndirectReference ref) {
   SkASSERT(img);
   SkASSERT(doc);
   SkASSERT(encodingQuality >= 0);
+  if (SkPDFCache* cache = doc->resourceCache()) {
+    serialize_cached_image(img, encodingQuality, doc, ref, cache);
+    return;
+  }
   SkISize dimensions = img->dimensions();
   if (sk_sp<SkData> data = img->refEncodedData()) {
     if (do_jpeg(std::move(data), doc, dimensions, ref)) {
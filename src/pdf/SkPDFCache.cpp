@@ -0,0 +1,118 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/pdf/SkPDFCache.h"
+
+#include "include/docs/SkPDFDocument.h"
+
+SkPDF::ResourceCache::ResourceCache(size_t byteLimit)
+    : fCache(std::make_unique<SkPDFCache>(byteLimit)) {}
+
+SkPDF::ResourceCache::~ResourceCache() = default;
+
+size_t SkPDF::ResourceCache::bytesUsed() const { return fCache->bytesUsed(); }
+
+void SkPDF::ResourceCache::purgeAll() { fCache->purgeAll(); }
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkPDFCache::~SkPDFCache() { this->purgeAll(); }
+
+SkPDFCache::Entry* SkPDFCache::find(const Key& key) {
+  Entry** entry = fEntries.find(key);
+  if (!entry) {
+    return nullptr;
+  }
+  fLRU.remove(*entry);
+  fLRU.addToHead(*entry);
+  return *entry;
+}
+
+void SkPDFCache::add(Entry* entry) {
+  if (fEntries.find(entry->fKey)) {
+    // Another document encoded the same thing at the same time.  Keep the first one.
+    delete entry;
+    return;
+  }
+  fEntries.set(entry->fKey, entry);
+  fLRU.addToHead(entry);
+  fBytesUsed += entry->fBytes;
+  while (fBytesUsed > fByteLimit) {
+    this->remove(fLRU.tail());
+  }
+}
+
+void SkPDFCache::remove(Entry* entry) {
+  fLRU.remove(entry);
+  fEntries.remove(entry->fKey);
+  fBytesUsed -= entry->fBytes;
+  delete entry;
+}
+
+sk_sp<const SkPDFCache::Image> SkPDFCache::findImage(const Key& key) {
+  SkAutoMutexExclusive lock(fMutex);
+  Entry* entry = this->find(key);
+  return entry ? entry->fImage : nullptr;
+}
+
+void SkPDFCache::addImage(const Key& key, sk_sp<const Image> image) {
+  SkASSERT(image && image->fData);
+  size_t bytes = image->fData->size() + (image->fSMask ? image->fSMask->size() : 0);
+  SkAutoMutexExclusive lock(fMutex);
+  this->add(new Entry{key, std::move(image), nullptr, {}, bytes});
+}
+
+sk_sp<SkData> SkPDFCache::findFont(const Key& key) {
+  SkAutoMutexExclusive lock(fMutex);
+  Entry* entry = this->find(key);
+  return entry ? entry->fFont : nullptr;
+}
+
+void SkPDFCache::addFont(const Key& key, sk_sp<SkData> font) {
+  SkASSERT(font);
+  size_t bytes = font->size();
+  SkAutoMutexExclusive lock(fMutex);
+  this->add(new Entry{key, nullptr, std::move(font), {}, bytes});
+}
+
+// Typeface IDs are unique for the life of the process, so they can share the key space.
+static SkPDFCache::Key typeface_key(SkTypefaceID typefaceID) {
+  SkMD5 md5;
+  md5.writeText("typeface");
+  md5.write(&typefaceID, sizeof(typefaceID));
+  return md5.finish();
+}
+
+bool SkPDFCache::findTypefaceDigest(SkTypefaceID typefaceID, TypefaceDigest* digest) {
+  const Key key = typeface_key(typefaceID);
+  SkAutoMutexExclusive lock(fMutex);
+  Entry* entry = this->find(key);
+  if (!entry) {
+    return false;
+  }
+  *digest = entry->fTypeface;
+  return true;
+}
+
+void SkPDFCache::addTypefaceDigest(SkTypefaceID typefaceID, const TypefaceDigest& digest) {
+  const Key key = typeface_key(typefaceID);
+  SkAutoMutexExclusive lock(fMutex);
+  this->add(new Entry{key, nullptr, nullptr, digest, sizeof(Entry)});
+}
+
+size_t SkPDFCache::bytesUsed() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fBytesUsed;
+}
+
+void SkPDFCache::purgeAll() {
+  SkAutoMutexExclusive lock(fMutex);
+  while (Entry* entry = fLRU.head()) {
+    this->remove(entry);
+  }
+  SkASSERT(fBytesUsed == 0);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPDFCache_DEFINED
+#define SkPDFCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkThreadAnnotations.h"
+#include "src/core/SkMD5.h"
+#include "src/core/SkTInternalLList.h"
+
+// The implementation of SkPDF::ResourceCache: encoded resources shared between documents, keyed
+// by an MD5 digest of everything that went into encoding them.  Callers compute the keys, so each
+// kind of resource should start its digest with its own tag.
+class SkPDFCache {
+ public:
+  using Key = SkMD5::Digest;
+
+  // An image exactly as SkPDFSerializeImage() writes it: the bytes of its stream, after any
+  // filters, and those of its soft mask if it has one.
+  struct Image : public SkNVRefCnt<Image> {
+    sk_sp<SkData> fData;
+    sk_sp<SkData> fSMask;
+    SkISize fSize;
+    const char* fColorSpace;  // Static.
+    bool fIsJpeg;
+  };
+
+  explicit SkPDFCache(size_t byteLimit) : fByteLimit(byteLimit) {}
+  ~SkPDFCache();
+
+  sk_sp<const Image> findImage(const Key&);
+  void addImage(const Key&, sk_sp<const Image>);
+
+  // Subsetted font programs.
+  sk_sp<SkData> findFont(const Key&);
+  void addFont(const Key&, sk_sp<SkData>);
+
+  // What a typeface's subsets are keyed on, so its font data needn't be read and hashed for
+  // every document.  These are entries like any other: they count against the byte limit and are
+  // evicted least recently used first.
+  struct TypefaceDigest {
+    Key fDigest;  // Of the font data.
+    int fTTCIndex;
+  };
+  bool findTypefaceDigest(SkTypefaceID, TypefaceDigest*);
+  void addTypefaceDigest(SkTypefaceID, const TypefaceDigest&);
+
+  size_t bytesUsed() const;
+  void purgeAll();
+
+ private:
+  struct KeyHash {
+    uint32_t operator()(const Key& key) const {
+      uint32_t hash;
+      memcpy(&hash, key.data, sizeof(hash));  // It's already a good hash.
+      return hash;
+    }
+  };
+  struct Entry {
+    Key fKey;
+    sk_sp<const Image> fImage;
+    sk_sp<SkData> fFont;
+    TypefaceDigest fTypeface;
+    size_t fBytes;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+  };
+
+  Entry* find(const Key&) SK_REQUIRES(fMutex);
+  void add(Entry*) SK_REQUIRES(fMutex);
+  void remove(Entry*) SK_REQUIRES(fMutex);
+
+  mutable SkMutex fMutex;
+  SkTHashMap<Key, Entry*, KeyHash> fEntries SK_GUARDED_BY(fMutex);
+  SkTInternalLList<Entry> fLRU SK_GUARDED_BY(fMutex);  // Most recently used at the head.
+  size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+  const size_t fByteLimit;
+};
+
+#endif  // SkPDFCache_DEFINED
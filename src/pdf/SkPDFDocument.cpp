@@ -132,67 +132,97 @@ static void serialize_footer(
   wStream->writeText("\n%%EOF");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kPageTreeNodeSize) as the number of allowed children.  The internal
+// nodes have type "Pages" with an array of children, a parent pointer, and
+// the number of leaves below the node as "Count."  The leaves have type "Page"
+// and need a parent pointer.
+static constexpr size_t kPageTreeNodeSize = 8;
+
+namespace {
+struct PageTreeNode {
+  std::unique_ptr<SkPDFDict> fNode;
+  SkPDFIndirectReference fReservedRef;
+  int fPageObjectDescendantCount;
+
+  static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
+    std::vector<PageTreeNode> result;
+    const size_t n = vec.size();
+    SkASSERT(n >= 1);
+    const size_t result_len = (n - 1) / kPageTreeNodeSize + 1;
+    SkASSERT(result_len >= 1);
+    SkASSERT(n == 1 || result_len < n);
+    result.reserve(result_len);
+    size_t index = 0;
+    for (size_t i = 0; i < result_len; ++i) {
+      if (n != 1 && index + 1 == n) {  // No need to create a new node.
+        result.push_back(std::move(vec[index++]));
+        continue;
+      }
+      SkPDFIndirectReference parent = doc->reserveRef();
+      auto kids_list = SkPDFMakeArray();
+      int descendantCount = 0;
+      for (size_t j = 0; j < kPageTreeNodeSize && index < n; ++j) {
+        PageTreeNode& node = vec[index++];
+        node.fNode->insertRef("Parent", parent);
+        kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
+        descendantCount += node.fPageObjectDescendantCount;
+      }
+      auto next = SkPDFMakeDict("Pages");
+      next->insertInt("Count", descendantCount);
+      next->insertObject("Kids", std::move(kids_list));
+      result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
+    }
+    return result;
+  }
+};
+}  // namespace
+
+static SkPDFIndirectReference emit_page_tree_root(
+    SkPDFDocument* doc, std::vector<PageTreeNode> currentLayer) {
+  while (currentLayer.size() > 1) {
+    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+  }
+  SkASSERT(currentLayer.size() == 1);
+  const PageTreeNode& root = currentLayer[0];
+  return doc->emit(*root.fNode, root.fReservedRef);
+}
+
+// Builds the tree bottom up, skipping internal nodes that would have only one child.
 static SkPDFIndirectReference generate_page_tree(
     SkPDFDocument* doc, std::vector<std::unique_ptr<SkPDFDict>> pages,
     const std::vector<SkPDFIndirectReference>& pageRefs) {
-  // PDF wants a tree describing all the pages in the document.  We arbitrary
-  // choose 8 (kNodeSize) as the number of allowed children.  The internal
-  // nodes have type "Pages" with an array of children, a parent pointer, and
-  // the number of leaves below the node as "Count."  The leaves are passed
-  // into the method, have type "Page" and need a parent pointer. This method
-  // builds the tree bottom up, skipping internal nodes that would have only
-  // one child.
   SkASSERT(pages.size() > 0);
-  struct PageTreeNode {
-    std::unique_ptr<SkPDFDict> fNode;
-    SkPDFIndirectReference fReservedRef;
-    int fPageObjectDescendantCount;
-
-    static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
-      std::vector<PageTreeNode> result;
-      static constexpr size_t kMaxNodeSize = 8;
-      const size_t n = vec.size();
-      SkASSERT(n >= 1);
-      const size_t result_len = (n - 1) / kMaxNodeSize + 1;
-      SkASSERT(result_len >= 1);
-      SkASSERT(n == 1 || result_len < n);
-      result.reserve(result_len);
-      size_t index = 0;
-      for (size_t i = 0; i < result_len; ++i) {
-        if (n != 1 && index + 1 == n) {  // No need to create a new node.
-          result.push_back(std::move(vec[index++]));
-          continue;
-        }
-        SkPDFIndirectReference parent = doc->reserveRef();
-        auto kids_list = SkPDFMakeArray();
-        int descendantCount = 0;
-        for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
-          PageTreeNode& node = vec[index++];
-          node.fNode->insertRef("Parent", parent);
-          kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
-          descendantCount += node.fPageObjectDescendantCount;
-        }
-        auto next = SkPDFMakeDict("Pages");
-        next->insertInt("Count", descendantCount);
-        next->insertObject("Kids", std::move(kids_list));
-        result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
-      }
-      return result;
-    }
-  };
   std::vector<PageTreeNode> currentLayer;
   currentLayer.reserve(pages.size());
   SkASSERT(pages.size() == pageRefs.size());
   for (size_t i = 0; i < pages.size(); ++i) {
     currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
   }
-  currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
-  while (currentLayer.size() > 1) {
-    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+  return emit_page_tree_root(doc, PageTreeNode::Layer(std::move(currentLayer), doc));
+}
+
+// In streaming mode the pages have already been emitted, each pointing at the leaf node
+// reserved for its run of kPageTreeNodeSize pages, so we build the tree from those leaves up.
+static SkPDFIndirectReference generate_streamed_page_tree(
+    SkPDFDocument* doc, const std::vector<SkPDFIndirectReference>& leaves,
+    const std::vector<SkPDFIndirectReference>& pageRefs) {
+  SkASSERT(leaves.size() == (pageRefs.size() - 1) / kPageTreeNodeSize + 1);
+  std::vector<PageTreeNode> currentLayer;
+  currentLayer.reserve(leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i) {
+    auto kids_list = SkPDFMakeArray();
+    const size_t end = std::min(pageRefs.size(), (i + 1) * kPageTreeNodeSize);
+    for (size_t j = i * kPageTreeNodeSize; j < end; ++j) {
+      kids_list->appendRef(pageRefs[j]);
+    }
+    const int count = SkToInt(end - i * kPageTreeNodeSize);
+    auto leaf = SkPDFMakeDict("Pages");
+    leaf->insertInt("Count", count);
+    leaf->insertObject("Kids", std::move(kids_list));
+    currentLayer.push_back(PageTreeNode{std::move(leaf), leaves[i], count});
   }
-  SkASSERT(currentLayer.size() == 1);
-  const PageTreeNode& root = currentLayer[0];
-  return doc->emit(*root.fNode, root.fReservedRef);
+  return emit_page_tree_root(doc, std::move(currentLayer));
 }
 
 template <typename T, typename... Args>
@@ -240,7 +270,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
   SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-  if (fPages.empty()) {
+  if (fPageRefs.empty()) {
     // if this is the first page if the document.
     {
       SkAutoMutexExclusive autoMutexAcquire(fMutex);
@@ -271,6 +301,9 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
   fPageDevice = sk_make_sp<SkPDFDevice>(pageSize, this, initialTransform);
   reset_object(&fCanvas, fPageDevice);
   fCanvas.scale(fRasterScale, fRasterScale);
+  if (this->streaming() && fPageRefs.size() % kPageTreeNodeSize == 0) {
+    fPageTreeLeaves.push_back(this->reserveRef());
+  }
   fPageRefs.push_back(this->reserveRef());
   return &fCanvas;
 }
@@ -365,7 +398,13 @@ void SkPDFDocument::onEndPage() {
   // The StructParents unique identifier for each page is just its
   // 0-based page index.
   page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-  fPages.emplace_back(std::move(page));
+  if (this->streaming()) {
+    page->insertRef("Parent", fPageTreeLeaves.back());
+    this->emit(*page, fPageRefs.back());
+  } else {
+    fPages.emplace_back(std::move(page));
+  }
+  fPageCount++;
 }
 
 void SkPDFDocument::onAbort() { this->waitForJobs(); }
@@ -553,7 +592,7 @@ SkString SkPDFDocument::nextFontSubsetTag() {
 
 void SkPDFDocument::onClose(SkWStream* stream) {
   SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-  if (fPages.empty()) {
+  if (fPageRefs.empty()) {
     this->waitForJobs();
     return;
   }
@@ -566,7 +605,10 @@ void SkPDFDocument::onClose(SkWStream* stream) {
     docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
   }
 
-  docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+  docCatalog->insertRef(
+      "Pages", this->streaming()
+                   ? generate_streamed_page_tree(this, fPageTreeLeaves, fPageRefs)
+                   : generate_page_tree(this, std::move(fPages), fPageRefs));
 
   if (!fNamedDestinations.empty()) {
     docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -584,9 +626,7 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
   auto docCatalogRef = this->emit(*docCatalog);
 
-  for (const SkPDFFont* f : get_fonts(*this)) {
-    f->emitSubset(this);
-  }
+  SkPDFFont::EmitSubsets(get_fonts(*this), this);
 
     this->waitForJobs();
     {
@@ -595,7 +635,18 @@ void SkPDFDocument::onClose(SkWStream* stream) {
     }
 }
 
-void SkPDFDocument::incrementJobCount() { fJobCount++; }
+void SkPDFDocument::incrementJobCount() {
+  if (this->streaming()) {
+    // Each queued job holds its image or content stream in memory until it runs, so rather
+    // than let them pile up, wait for earlier jobs to finish.
+    static constexpr int kMaxStreamingJobs = 16;
+    while (fJobCount >= kMaxStreamingJobs) {
+      fSemaphore.wait();
+      --fJobCount;
+    }
+  }
+  fJobCount++;
+}
 
 void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
 
@@ -105,7 +105,35 @@ class SkPDFDocument : public SkDocument {
     this->endObject();
   }
 
+  /**
+     Like emitStream(), but for streams whose length isn't known until
+     they're written.  The dict's /Length refers to an object emitted right
+     after the stream, so writeStream can compress straight into the
+     document.  Used in streaming mode.
+   */
+  template <typename T>
+  void emitStreamWithDeferredLength(SkPDFDict* dict, T writeStream, SkPDFIndirectReference ref) {
+    SkPDFIndirectReference lengthRef = this->reserveRef();
+    dict->insertRef("Length", lengthRef);
+    SkAutoMutexExclusive lock(fMutex);
+    SkWStream* stream = this->beginObject(ref);
+    dict->emitObject(stream);
+    stream->writeText(" stream\n");
+    const size_t start = stream->bytesWritten();
+    writeStream(stream);
+    const size_t length = stream->bytesWritten() - start;
+    stream->writeText("\nendstream");
+    this->endObject();
+    this->beginObject(lengthRef)->writeBigDecAsText((int64_t)length);
+    this->endObject();
+  }
+
   const SkPDF::Metadata& metadata() const { return fMetadata; }
+  bool streaming() const { return fMetadata.fStreaming; }
+  // In streaming mode without an executor, compressed streams are written straight into the
+  // document with emitStreamWithDeferredLength().  With an executor they're still compressed
+  // into buffers, so jobs don't hold the document's lock while they compress.
+  bool compressesInPlace() const { return fMetadata.fStreaming && !fExecutor; }
 
   SkPDFIndirectReference getPage(size_t pageIndex) const;
   SkPDFIndirectReference currentPage() const {
@@ -128,9 +156,13 @@ class SkPDFDocument : public SkDocument {
   SkString nextFontSubsetTag();
 
   SkExecutor* executor() const { return fExecutor; }
+  // Shared with other documents; may be nullptr.
+  SkPDFCache* resourceCache() const {
+    return fMetadata.fResourceCache ? fMetadata.fResourceCache->fCache.get() : nullptr;
+  }
   void incrementJobCount();
   void signalJobComplete();
-  size_t currentPageIndex() { return fPages.size(); }
+  size_t currentPageIndex() { return fPageCount; }
   size_t pageCount() { return fPageRefs.size(); }
 
   const SkMatrix& currentPageTransform() const;
@@ -158,6 +190,10 @@ class SkPDFDocument : public SkDocument {
   SkCanvas fCanvas;
   std::vector<std::unique_ptr<SkPDFDict>> fPages;
   std::vector<SkPDFIndirectReference> fPageRefs;
+  // In streaming mode pages are emitted as they end, so their parents in the page tree are
+  // reserved up front, one per kPageTreeNodeSize pages, and fPages stays empty.
+  std::vector<SkPDFIndirectReference> fPageTreeLeaves;
+  size_t fPageCount = 0;  // Pages ended so far.
 
   sk_sp<SkPDFDevice> fPageDevice;
   std::atomic<int> fNextObjectNumber = {1};
@@ -7,6 +7,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkFontTypes.h"
@@ -29,11 +30,14 @@
 #include "include/private/SkTo.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkMD5.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkScalerCache.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkPDFBitmap.h"
+#include "src/pdf/SkPDFCache.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFFont.h"
 #include "src/pdf/SkPDFMakeCIDGlyphWidthsArray.h"
@@ -276,7 +280,101 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
   return SkData::MakeFromStream(stream.get(), size);
 }
 
-static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
+// Subsets the font, or finds the subset in the document's resource cache.  The cache key is a
+// digest of the font data, which the cache remembers for each typeface, and of the glyphs used.
+// Returns nullptr if the typeface has no font data.
+static sk_sp<SkData> read_font_data(SkTypeface* face, int* ttcIndex) {
+  std::unique_ptr<SkStreamAsset> fontAsset = face->openStream(ttcIndex);
+  if (!fontAsset || fontAsset->getLength() == 0) {
+    return nullptr;
+  }
+  return stream_to_data(std::move(fontAsset));
+}
+
+// The font data is only read if the subset isn't already cached.
+static sk_sp<SkData> subset_font(
+    SkTypeface* face, const SkPDFGlyphUse& glyphUsage, const char* fontName,
+    SkPDFDocument* doc) {
+  SkPDF::Metadata::Subsetter subsetter = doc->metadata().fSubsetter;
+  int ttcIndex = 0;
+  SkPDFCache* cache = doc->resourceCache();
+  if (!cache) {
+    sk_sp<SkData> fontData = read_font_data(face, &ttcIndex);
+    return fontData ? SkPDFSubsetFont(std::move(fontData), glyphUsage, subsetter, fontName,
+                                      ttcIndex)
+                    : nullptr;
+  }
+
+  sk_sp<SkData> fontData;
+  SkPDFCache::TypefaceDigest typeface;
+  if (!cache->findTypefaceDigest(face->uniqueID(), &typeface)) {
+    fontData = read_font_data(face, &ttcIndex);
+    if (!fontData) {
+      return nullptr;
+    }
+    SkMD5 md5;
+    md5.write(fontData->data(), fontData->size());
+    typeface = {md5.finish(), ttcIndex};
+    cache->addTypefaceDigest(face->uniqueID(), typeface);
+  }
+  SkMD5 md5;
+  md5.writeText("font");
+  md5.write(&typeface.fDigest, sizeof(typeface.fDigest));
+  md5.write(&typeface.fTTCIndex, sizeof(typeface.fTTCIndex));
+  md5.write(&subsetter, sizeof(subsetter));
+  md5.write(fontName, strlen(fontName) + 1);
+  glyphUsage.getSetValues([&md5](unsigned gid) {
+    uint16_t glyph = SkToU16(gid);
+    md5.write(&glyph, sizeof(glyph));
+  });
+  const SkPDFCache::Key key = md5.finish();
+
+  if (sk_sp<SkData> subset = cache->findFont(key)) {
+    return subset;
+  }
+  if (!fontData && !(fontData = read_font_data(face, &ttcIndex))) {
+    return nullptr;
+  }
+  sk_sp<SkData> subset =
+      SkPDFSubsetFont(std::move(fontData), glyphUsage, subsetter, fontName, ttcIndex);
+  if (subset) {
+    cache->addFont(key, subset);
+  }
+  return subset;
+}
+
+namespace {
+// The parts of a Type0 font that take real work to make.  They depend only on the font and the
+// glyphs it uses, so fonts can make them in parallel before any font is emitted.
+struct Type0Parts {
+  sk_sp<SkData> fSubset;  // nullptr if the font isn't subset, or subsetting failed.
+  std::unique_ptr<SkPDFArray> fWidths;
+  SkScalar fDefaultWidth = 0;
+  std::unique_ptr<SkStreamAsset> fToUnicode;
+};
+}  // namespace
+
+static std::unique_ptr<Type0Parts> make_type0_parts(
+    const SkPDFFont& font, const SkAdvancedTypefaceMetrics& metrics,
+    const std::vector<SkUnichar>& glyphToUnicode, SkPDFDocument* doc) {
+  auto parts = std::make_unique<Type0Parts>();
+  SkTypeface* face = font.typeface();
+  if (font.getType() == SkAdvancedTypefaceMetrics::kTrueType_Font &&
+      !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+    SkASSERT(font.firstGlyphID() == 1);
+    parts->fSubset = subset_font(face, font.glyphUsage(), metrics.fFontName.c_str(), doc);
+  }
+  parts->fWidths = SkPDFMakeCIDGlyphWidthsArray(*face, font.glyphUsage(), &parts->fDefaultWidth);
+  SkASSERT(SkToSizeT(face->countGlyphs()) == glyphToUnicode.size());
+  parts->fToUnicode = SkPDFMakeToUnicodeCmap(
+      glyphToUnicode.data(), &font.glyphUsage(), font.multiByteGlyphs(), font.firstGlyphID(),
+      font.lastGlyphID());
+  return parts;
+}
+
+// parts may be nullptr, if they haven't been made in advance.
+static void emit_subset_type0(
+    const SkPDFFont& font, SkPDFDocument* doc, std::unique_ptr<Type0Parts> parts) {
   const SkAdvancedTypefaceMetrics* metricsPtr = SkPDFFont::GetMetrics(font.typeface(), doc);
   SkASSERT(metricsPtr);
   if (!metricsPtr) {
@@ -284,6 +382,9 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
   }
   const SkAdvancedTypefaceMetrics& metrics = *metricsPtr;
   SkASSERT(can_embed(metrics));
+  if (!parts) {
+    parts = make_type0_parts(font, metrics, SkPDFFont::GetUnicodeMap(font.typeface(), doc), doc);
+  }
   SkAdvancedTypefaceMetrics::FontType type = font.getType();
   SkTypeface* face = font.typeface();
   SkASSERT(face);
@@ -292,54 +393,43 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
   uint16_t emSize = SkToU16(font.typeface()->getUnitsPerEm());
   SkPDFFont::PopulateCommonFontDescriptor(descriptor.get(), metrics, emSize, 0);
 
-  int ttcIndex;
-  std::unique_ptr<SkStreamAsset> fontAsset = face->openStream(&ttcIndex);
-  size_t fontSize = fontAsset ? fontAsset->getLength() : 0;
-  if (0 == fontSize) {
-    SkDebugf(
-        "Error: (SkTypeface)(%p)::openStream() returned "
-        "empty stream (%p) when identified as kType1CID_Font "
-        "or kTrueType_Font.\n",
-        face, fontAsset.get());
+  // Only TrueType fonts are subset.  When they are, the font data needn't be read again.
+  if (sk_sp<SkData> subsetFontData = std::move(parts->fSubset)) {
+    SkASSERT(type == SkAdvancedTypefaceMetrics::kTrueType_Font);
+    std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+    tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
+    descriptor->insertRef(
+        "FontFile2",
+        SkPDFStreamOut(std::move(tmp), SkMemoryStream::Make(std::move(subsetFontData)), doc, true));
   } else {
-    switch (type) {
-      case SkAdvancedTypefaceMetrics::kTrueType_Font: {
-        if (!SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
-          SkASSERT(font.firstGlyphID() == 1);
-          sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-              stream_to_data(std::move(fontAsset)), font.glyphUsage(), doc->metadata().fSubsetter,
-              metrics.fFontName.c_str(), ttcIndex);
-          if (subsetFontData) {
-            std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-            tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
-            descriptor->insertRef(
-                "FontFile2",
-                SkPDFStreamOut(
-                    std::move(tmp), SkMemoryStream::Make(std::move(subsetFontData)), doc, true));
-            break;
-          }
-          // If subsetting fails, fall back to original font data.
-          fontAsset = face->openStream(&ttcIndex);
-          SkASSERT(fontAsset);
-          SkASSERT(fontAsset->getLength() == fontSize);
-          if (!fontAsset || fontAsset->getLength() == 0) {
-            break;
-          }
+    // If subsetting fails, fall back to original font data.
+    int ttcIndex;
+    std::unique_ptr<SkStreamAsset> fontAsset = face->openStream(&ttcIndex);
+    size_t fontSize = fontAsset ? fontAsset->getLength() : 0;
+    if (0 == fontSize) {
+      SkDebugf(
+          "Error: (SkTypeface)(%p)::openStream() returned "
+          "empty stream (%p) when identified as kType1CID_Font "
+          "or kTrueType_Font.\n",
+          face, fontAsset.get());
+    } else {
+      switch (type) {
+        case SkAdvancedTypefaceMetrics::kTrueType_Font: {
+          std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+          tmp->insertInt("Length1", fontSize);
+          descriptor->insertRef(
+              "FontFile2", SkPDFStreamOut(std::move(tmp), std::move(fontAsset), doc, true));
+          break;
         }
-        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-        tmp->insertInt("Length1", fontSize);
-        descriptor->insertRef(
-            "FontFile2", SkPDFStreamOut(std::move(tmp), std::move(fontAsset), doc, true));
-        break;
-      }
-      case SkAdvancedTypefaceMetrics::kType1CID_Font: {
-        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-        tmp->insertName("Subtype", "CIDFontType0C");
-        descriptor->insertRef(
-            "FontFile3", SkPDFStreamOut(std::move(tmp), std::move(fontAsset), doc, true));
-        break;
+        case SkAdvancedTypefaceMetrics::kType1CID_Font: {
+          std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+          tmp->insertName("Subtype", "CIDFontType0C");
+          descriptor->insertRef(
+              "FontFile3", SkPDFStreamOut(std::move(tmp), std::move(fontAsset), doc, true));
+          break;
+        }
+        default: SkASSERT(false);
       }
-      default: SkASSERT(false);
     }
   }
 
@@ -364,15 +454,10 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     sysInfo->insertInt("Supplement", 0);
     newCIDFont->insertObject("CIDSystemInfo", std::move(sysInfo));
 
-    SkScalar defaultWidth = 0;
-    {
-      std::unique_ptr<SkPDFArray> widths =
-          SkPDFMakeCIDGlyphWidthsArray(*face, font.glyphUsage(), &defaultWidth);
-      if (widths && widths->size() > 0) {
-        newCIDFont->insertObject("W", std::move(widths));
-      }
-      newCIDFont->insertScalar("DW", defaultWidth);
+    if (parts->fWidths && parts->fWidths->size() > 0) {
+      newCIDFont->insertObject("W", std::move(parts->fWidths));
     }
+    newCIDFont->insertScalar("DW", parts->fDefaultWidth);
 
     ////////////////////////////////////////////////////////////////////////////
 
@@ -384,12 +469,7 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     descendantFonts->appendRef(doc->emit(*newCIDFont));
     fontDict.insertObject("DescendantFonts", std::move(descendantFonts));
 
-    const std::vector<SkUnichar>& glyphToUnicode = SkPDFFont::GetUnicodeMap(font.typeface(), doc);
-    SkASSERT(SkToSizeT(font.typeface()->countGlyphs()) == glyphToUnicode.size());
-    std::unique_ptr<SkStreamAsset> toUnicode = SkPDFMakeToUnicodeCmap(
-        glyphToUnicode.data(), &font.glyphUsage(), font.multiByteGlyphs(), font.firstGlyphID(),
-        font.lastGlyphID());
-    fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(toUnicode), doc));
+    fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(parts->fToUnicode), doc));
 
     doc->emit(fontDict, font.indirectReference());
 }
@@ -646,7 +726,8 @@ static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
 void SkPDFFont::emitSubset(SkPDFDocument* doc) const {
   switch (fFontType) {
     case SkAdvancedTypefaceMetrics::kType1CID_Font:
-    case SkAdvancedTypefaceMetrics::kTrueType_Font: return emit_subset_type0(*this, doc);
+    case SkAdvancedTypefaceMetrics::kTrueType_Font:
+      return emit_subset_type0(*this, doc, nullptr);
 #ifndef SK_PDF_DO_NOT_SUPPORT_TYPE_1_FONTS
     case SkAdvancedTypefaceMetrics::kType1_Font: return SkPDFEmitType1Font(*this, doc);
 #endif
@@ -654,6 +735,39 @@ void SkPDFFont::emitSubset(SkPDFDocument* doc) const {
   }
 }
 
+void SkPDFFont::EmitSubsets(const std::vector<const SkPDFFont*>& fonts, SkPDFDocument* doc) {
+  std::vector<std::unique_ptr<Type0Parts>> parts(fonts.size());
+  if (SkExecutor* executor = doc->executor()) {
+    // Fill the document's metrics and unicode map caches first, so the tasks only read them.
+    std::vector<const SkAdvancedTypefaceMetrics*> metrics(fonts.size());
+    for (size_t i = 0; i < fonts.size(); ++i) {
+      if (SkPDFFont::IsMultiByte(fonts[i]->getType())) {
+        metrics[i] = SkPDFFont::GetMetrics(fonts[i]->typeface(), doc);
+        (void)SkPDFFont::GetUnicodeMap(fonts[i]->typeface(), doc);
+      }
+    }
+    SkTaskGroup tasks(*executor);
+    for (size_t i = 0; i < fonts.size(); ++i) {
+      if (metrics[i]) {
+        const std::vector<SkUnichar>* glyphToUnicode =
+            &SkPDFFont::GetUnicodeMap(fonts[i]->typeface(), doc);
+        tasks.add([&parts, &fonts, &metrics, glyphToUnicode, doc, i]() {
+          parts[i] = make_type0_parts(*fonts[i], *metrics[i], *glyphToUnicode, doc);
+        });
+      }
+    }
+    tasks.wait();
+  }
+  // Everything is emitted here, in order, so the output doesn't depend on the tasks' timing.
+  for (size_t i = 0; i < fonts.size(); ++i) {
+    if (parts[i]) {
+      emit_subset_type0(*fonts[i], doc, std::move(parts[i]));
+    } else {
+      fonts[i]->emitSubset(doc);
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 bool SkPDFFont::CanEmbedTypeface(SkTypeface* typeface, SkPDFDocument* doc) {
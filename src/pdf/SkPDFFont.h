@@ -106,6 +106,12 @@ class SkPDFFont {
 
   void emitSubset(SkPDFDocument*) const;
 
+  /** Emits each font in turn.  With the document's executor, the slow parts of Type0 fonts
+   *  (subsetting, glyph widths and ToUnicode CMaps) are made in parallel first, and the output
+   *  is the same as emitting the fonts one at a time.
+   */
+  static void EmitSubsets(const std::vector<const SkPDFFont*>&, SkPDFDocument*);
+
   /**
    *  Return false iff the typeface has its NotEmbeddable flag set.
    *  typeface is not nullptr
@@ -473,9 +473,24 @@ static void serialize_stream(
   SkPDFDict tmpDict;
   SkPDFDict& dict = origDict ? *origDict : tmpDict;
   static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
+#ifndef SK_PDF_BASE85_BINARY
+  if (deflate && doc->compressesInPlace() && stream->getLength() > kMinimumSavings) {
+    // Compress straight into the document instead of into a buffer we measure first.
+    dict.insertName("Filter", "FlateDecode");
+    doc->emitStreamWithDeferredLength(
+        &dict,
+        [stream](SkWStream* dst) {
+          SkDeflateWStream deflateWStream(dst);
+          SkStreamCopy(&deflateWStream, stream);
+          deflateWStream.finalize();
+        },
+        ref);
+    return;
+  }
+#endif
   if (deflate && stream->getLength() > kMinimumSavings) {
     SkDynamicMemoryWStream compressedData;
-    SkDeflateWStream deflateWStream(&compressedData);
+    SkDeflateWStream deflateWStream(&compressedData, -1, false, doc->executor());
     SkStreamCopy(&deflateWStream, stream);
     deflateWStream.finalize();
 #ifdef SK_PDF_BASE85_BINARY
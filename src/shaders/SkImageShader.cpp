@@ -7,8 +7,10 @@
 
 #include "src/shaders/SkImageShader.h"
 
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkImageInfoPriv.h"
 #include "src/core/SkArenaAlloc.h"
+#include "src/core/SkCachedData.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkMatrixPriv.h"
@@ -19,6 +21,7 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkVM.h"
 #include "src/core/SkWriteBuffer.h"
+#include "src/core/SkYUVMath.h"
 #include "src/image/SkImage_Base.h"
 #include "src/shaders/SkBitmapProcShader.h"
 #include "src/shaders/SkEmptyShader.h"
@@ -239,6 +242,11 @@ SkShaderBase::Context* SkImageShader::onMakeContext(
     return nullptr;
   }
 
+  // Images drawn from YUV planes go through the raster pipeline instead; see doStages().
+  if (sampling.mipmap == SkMipmapMode::kNone && as_IB(fImage)->hasROYUVAPlanes()) {
+    return nullptr;
+  }
+
   // SkBitmapProcShader stores bitmap coordinates in a 16bit buffer,
   // so it can't handle bitmaps larger than 65535.
   //
@@ -474,12 +482,47 @@ bool SkImageShader::doStages(const SkStageRec& rec, TransformShader* updater) co
   matrix.normalizePerspective();
 
   SkASSERT(!sampling.useCubic || sampling.mipmap == SkMipmapMode::kNone);
-  auto* access = SkMipmapAccessor::Make(alloc, fImage.get(), matrix, sampling.mipmap);
-  if (!access) {
-    return false;
-  }
   SkPixmap pm;
-  std::tie(pm, matrix) = access->level();
+  SkRasterPipeline_GatherYUVCtx* yuv = nullptr;
+  SkYUVAPixmaps yuvaPixmaps;
+  sk_sp<SkCachedData> yuvaData;
+  if (sampling.mipmap == SkMipmapMode::kNone && !fRaw) {
+    yuvaData = as_IB(fImage)->getROYUVAPlanes(&yuvaPixmaps);
+  }
+  if (yuvaData) {
+    // Sample the Y, U, and V planes and convert to RGB in a single gather_yuv_8 stage, so there's
+    // never an RGBA copy of the image.  pm just describes the image, with kUnknown standing in
+    // for the YUV planes.
+    yuv = alloc->make<SkRasterPipeline_GatherYUVCtx>();
+    for (int i = 0; i < 3; i++) {
+      const SkPixmap& plane = yuvaPixmaps.plane(i);
+      yuv->planes[i] = static_cast<const uint8_t*>(plane.addr());
+      yuv->stride[i] = plane.rowBytesAsPixels();
+      yuv->width[i] = plane.width();
+      yuv->height[i] = plane.height();
+      // Not the ratio of plane to image size: odd-sized images round their chroma planes up.
+      auto [ssx, ssy] = yuvaPixmaps.yuvaInfo().planeSubsamplingFactors(i);
+      yuv->scaleX[i] = 1.0f / ssx;
+      yuv->scaleY[i] = 1.0f / ssy;
+    }
+    float m[20];
+    SkColorMatrix_YUV2RGB(yuvaPixmaps.yuvaInfo().yuvColorSpace(), m);
+    for (int row = 0; row < 3; row++) {
+      yuv->rgbFromYUV[4 * row + 0] = m[5 * row + 0];
+      yuv->rgbFromYUV[4 * row + 1] = m[5 * row + 1];
+      yuv->rgbFromYUV[4 * row + 2] = m[5 * row + 2];
+      yuv->rgbFromYUV[4 * row + 3] = m[5 * row + 4];
+    }
+    // The planes must outlive the pipeline.
+    alloc->make<sk_sp<SkCachedData>>(std::move(yuvaData));
+    pm = SkPixmap(fImage->imageInfo().makeColorType(kUnknown_SkColorType), nullptr, 0);
+  } else {
+    auto* access = SkMipmapAccessor::Make(alloc, fImage.get(), matrix, sampling.mipmap);
+    if (!access) {
+      return false;
+    }
+    std::tie(pm, matrix) = access->level();
+  }
 
   p->append(SkRasterPipeline::seed_shader);
 
@@ -598,7 +641,10 @@ bool SkImageShader::doStages(const SkStageRec& rec, TransformShader* updater) co
         p->append_transfer_function(*skcms_sRGB_TransferFunction());
         break;
 
-      case kUnknown_SkColorType: SkASSERT(false);
+      case kUnknown_SkColorType:
+        SkASSERT(yuv);
+        p->append(SkRasterPipeline::gather_yuv_8, yuv);
+        break;
     }
     if (decal_ctx) {
       p->append(SkRasterPipeline::check_decal_mask, decal_ctx);
@@ -21,17 +21,41 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
+#include "include/private/SkTArray.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/utils/SkAnimFrameCache.h"
 
 #include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
 
-SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
+namespace {
+
+// Every kKeyframeInterval-th frame along a chain of dependent frames is kept in the frame cache
+// longer than the rest, so seeking never has to decode more than this many frames.
+constexpr int kKeyframeInterval = 8;
+
+}  // namespace
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec)
+    : SkAnimCodecPlayer(std::move(codec), SkAnimFrameCache::NewSourceID(), nullptr) {}
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(
+    std::unique_ptr<SkCodec> codec, uint64_t sourceID, sk_sp<SkData> encoded)
+    : fCodec(std::move(codec)), fSourceID(sourceID), fEncoded(std::move(encoded)) {
   fImageInfo = fCodec->getInfo();
   fFrameInfos = fCodec->getFrameInfo();
-  fImages.resize(fFrameInfos.size());
+
+  // A frame's depth is how many frames must be decoded before it, back to an independent one.
+  std::vector<int> depth(fFrameInfos.size());
+  fKeyframes.resize(fFrameInfos.size());
+  for (size_t i = 0; i < fFrameInfos.size(); ++i) {
+    const int requiredFrame = fFrameInfos[i].fRequiredFrame;
+    SkASSERT(requiredFrame < (int)i);
+    depth[i] = requiredFrame == SkCodec::kNoFrame ? 0 : depth[requiredFrame] + 1;
+    fKeyframes[i] = depth[i] % kKeyframeInterval == 0;
+  }
 
   // change the interpretation of fDuration to a end-time for that frame
   size_t dur = 0;
@@ -44,18 +68,47 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
   if (!fTotalDuration) {
     // Static image -- may or may not have returned a single frame info.
     fFrameInfos.clear();
-    fImages.clear();
-    fImages.push_back(
-        SkImage::MakeFromGenerator(SkCodecImageGenerator::MakeFromCodec(std::move(fCodec))));
+    fKeyframes.clear();
+    fCurrImage =
+        SkImage::MakeFromGenerator(SkCodecImageGenerator::MakeFromCodec(std::move(fCodec)));
   }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+  if (fCodec && !SkAnimFrameCache::IsShareable(fSourceID)) {
+    // Nobody else can ever find these frames.
+    SkAnimFrameCache::Global()->purgeSource(fSourceID);
+  }
+}
+
+std::unique_ptr<SkAnimCodecPlayer> SkAnimCodecPlayer::Make(sk_sp<SkData> data) {
+  if (!data) {
+    return nullptr;
+  }
+  const uint64_t sourceID = SkAnimFrameCache::SourceID(*data);
+  auto codec = SkCodec::MakeFromData(data);
+  if (!codec) {
+    return nullptr;
+  }
+  return std::unique_ptr<SkAnimCodecPlayer>(
+      new SkAnimCodecPlayer(std::move(codec), sourceID, std::move(data)));
+}
+
+size_t SkAnimCodecPlayer::SetFrameCacheByteLimit(size_t newLimit) {
+  return SkAnimFrameCache::Global()->setByteLimit(newLimit);
+}
+
+size_t SkAnimCodecPlayer::GetFrameCacheByteLimit() {
+  return SkAnimFrameCache::Global()->byteLimit();
+}
+
+size_t SkAnimCodecPlayer::GetFrameCacheBytesUsed() {
+  return SkAnimFrameCache::Global()->bytesUsed();
+}
 
 SkISize SkAnimCodecPlayer::dimensions() const {
   if (!fCodec) {
-    auto image = fImages.front();
-    return image ? image->dimensions() : SkISize::MakeEmpty();
+    return fCurrImage ? fCurrImage->dimensions() : SkISize::MakeEmpty();
   }
   if (SkEncodedOriginSwapsWidthHeight(fCodec->getOrigin())) {
     return {fImageInfo.height(), fImageInfo.width()};
@@ -65,11 +118,31 @@ SkISize SkAnimCodecPlayer::dimensions() const {
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
   SkASSERT((unsigned)index < fFrameInfos.size());
-
-  if (fImages[index]) {
-    return fImages[index];
+  auto* cache = SkAnimFrameCache::Global();
+
+  // Walk back through the frames this one depends on until we find one that's already decoded,
+  // then decode forward from there.
+  SkSTArray<kKeyframeInterval, int> chain;
+  sk_sp<SkImage> image;
+  for (int i = index; i != SkCodec::kNoFrame; i = fFrameInfos[i].fRequiredFrame) {
+    if ((image = cache->find(fSourceID, fEncoded.get(), i))) {
+      break;
+    }
+    chain.push_back(i);
   }
+  while (!chain.empty()) {
+    const int i = chain.back();
+    chain.pop_back();
+    image = this->decodeFrame(i, std::move(image));
+    if (!image) {
+      return nullptr;
+    }
+    cache->add(fSourceID, fEncoded, i, image, fKeyframes[i]);
+  }
+  return image;
+}
 
+sk_sp<SkImage> SkAnimCodecPlayer::decodeFrame(int index, sk_sp<SkImage> requiredImage) {
   size_t rb = fImageInfo.minRowBytes();
   size_t size = fImageInfo.computeByteSize(rb);
   auto data = SkData::MakeUninitialized(size);
@@ -90,8 +163,7 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
   }
   const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-  if (requiredFrame != SkCodec::kNoFrame && fImages[requiredFrame]) {
-    auto requiredImage = fImages[requiredFrame];
+  if (requiredFrame != SkCodec::kNoFrame && requiredImage) {
     auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
     if (origin != kDefault_SkEncodedOrigin) {
       // The required frame is stored after applying the origin. Undo that,
@@ -124,13 +196,14 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
     image = SkImage::MakeRasterData(imageInfo, std::move(data), rb);
   }
-    return fImages[index] = image;
+  return image;
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
-  SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
-
-  return fTotalDuration > 0 ? this->getFrameAt(fCurrIndex) : fImages.front();
+  if (!fCurrImage && fTotalDuration > 0) {
+    fCurrImage = this->getFrameAt(fCurrIndex);
+  }
+  return fCurrImage;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -147,5 +220,9 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
       });
   int prevIndex = fCurrIndex;
   fCurrIndex = lower - fFrameInfos.begin();
-  return fCurrIndex != prevIndex;
+  if (fCurrIndex == prevIndex) {
+    return false;
+  }
+  fCurrImage.reset();
+  return true;
 }
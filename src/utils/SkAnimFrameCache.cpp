@@ -0,0 +1,160 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/utils/SkAnimFrameCache.h"
+
+#include "include/core/SkData.h"
+#include "src/core/SkOpts.h"
+
+#include <atomic>
+
+namespace {
+
+constexpr size_t kDefaultByteLimit = 32 * 1024 * 1024;
+
+}  // namespace
+
+SkAnimFrameCache::~SkAnimFrameCache() { this->purgeAll(); }
+
+SkAnimFrameCache* SkAnimFrameCache::Global() {
+  static auto* cache = new SkAnimFrameCache(kDefaultByteLimit);
+  return cache;
+}
+
+uint64_t SkAnimFrameCache::SourceID(const SkData& encoded) {
+  // Two differently seeded 32-bit hashes, with the length folded into the second.  Content IDs
+  // always have the top bit clear so they can't collide with NewSourceID().
+  const uint32_t lo = SkOpts::hash(encoded.data(), encoded.size(), 0);
+  const uint32_t hi = SkOpts::hash(encoded.data(), encoded.size(), (uint32_t)encoded.size());
+  return ((uint64_t)(hi & 0x7fffffff) << 32) | lo;
+}
+
+uint64_t SkAnimFrameCache::NewSourceID() {
+  static std::atomic<uint64_t> nextID{1};
+  return nextID.fetch_add(1, std::memory_order_relaxed) | (uint64_t{1} << 63);
+}
+
+bool SkAnimFrameCache::isSourceOf(uint64_t sourceID, const SkData* encoded) const {
+  if (!IsShareable(sourceID)) {
+    return true;
+  }
+  const Source* source = fSources.find(sourceID);
+  SkASSERT(encoded);
+  return !source || source->fEncoded.get() == encoded || source->fEncoded->equals(encoded);
+}
+
+sk_sp<SkImage> SkAnimFrameCache::find(uint64_t sourceID, const SkData* encoded, int frame) {
+  SkAutoMutexExclusive lock(fMutex);
+  Entry** entry = fEntries.find({sourceID, frame});
+  if (!entry || !this->isSourceOf(sourceID, encoded)) {
+    return nullptr;
+  }
+  auto& list = this->listFor(*entry);
+  list.remove(*entry);
+  list.addToHead(*entry);
+  return (*entry)->fImage;
+}
+
+void SkAnimFrameCache::add(
+    uint64_t sourceID, sk_sp<SkData> encoded, int frame, sk_sp<SkImage> image, bool keyframe) {
+  if (!image) {
+    return;
+  }
+  const size_t bytes = image->imageInfo().computeMinByteSize();
+
+  SkAutoMutexExclusive lock(fMutex);
+  if (fEntries.find({sourceID, frame})) {
+    // Another player decoded the same frame at the same time.  Keep the first one.
+    return;
+  }
+  if (IsShareable(sourceID)) {
+    if (!this->isSourceOf(sourceID, encoded.get())) {
+      return;
+    }
+    Source* source = fSources.find(sourceID);
+    if (!source) {
+      fBytesUsed += encoded->size();
+      source = fSources.set(sourceID, {std::move(encoded), 0});
+    }
+    ++source->fEntryCount;
+  }
+  auto* entry = new Entry{{sourceID, frame}, std::move(image), bytes, keyframe};
+  fEntries.set(entry->fKey, entry);
+  this->listFor(entry).addToHead(entry);
+  fBytesUsed += bytes;
+  this->purge();
+}
+
+void SkAnimFrameCache::remove(Entry* entry) {
+  this->listFor(entry).remove(entry);
+  fEntries.remove(entry->fKey);
+  fBytesUsed -= entry->fBytes;
+  if (IsShareable(entry->fKey.fSourceID)) {
+    Source* source = fSources.find(entry->fKey.fSourceID);
+    if (--source->fEntryCount == 0) {
+      fBytesUsed -= source->fEncoded->size();
+      fSources.remove(entry->fKey.fSourceID);
+    }
+  }
+  delete entry;
+}
+
+void SkAnimFrameCache::purge() {
+  while (fBytesUsed > fByteLimit) {
+    Entry* victim = fFrames.tail() ? fFrames.tail() : fKeyframes.tail();
+    SkASSERT(victim);
+    this->remove(victim);
+  }
+}
+
+size_t SkAnimFrameCache::setByteLimit(size_t byteLimit) {
+  SkAutoMutexExclusive lock(fMutex);
+  const size_t prev = fByteLimit;
+  fByteLimit = byteLimit;
+  this->purge();
+  return prev;
+}
+
+size_t SkAnimFrameCache::byteLimit() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fByteLimit;
+}
+
+size_t SkAnimFrameCache::bytesUsed() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fBytesUsed;
+}
+
+int SkAnimFrameCache::count() const {
+  SkAutoMutexExclusive lock(fMutex);
+  return fEntries.count();
+}
+
+void SkAnimFrameCache::purgeSource(uint64_t sourceID) {
+  SkAutoMutexExclusive lock(fMutex);
+  for (auto* list : {&fFrames, &fKeyframes}) {
+    Entry* entry = list->head();
+    while (entry) {
+      Entry* next = entry->fNext;
+      if (entry->fKey.fSourceID == sourceID) {
+        this->remove(entry);
+      }
+      entry = next;
+    }
+  }
+}
+
+void SkAnimFrameCache::purgeAll() {
+  SkAutoMutexExclusive lock(fMutex);
+  while (Entry* entry = fFrames.head()) {
+    this->remove(entry);
+  }
+  while (Entry* entry = fKeyframes.head()) {
+    this->remove(entry);
+  }
+  SkASSERT(fBytesUsed == 0);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAnimFrameCache_DEFINED
+#define SkAnimFrameCache_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkThreadAnnotations.h"
+#include "src/core/SkTInternalLList.h"
+
+#include <stdint.h>
+
+class SkData;
+
+// Decoded frames of animated images, shared by every SkAnimCodecPlayer playing the same encoded
+// data and bounded by a byte budget.
+//
+// Frames are keyed by a source ID and a frame index.  SourceID() hashes the encoded bytes, so
+// players built from identical data share their frames; NewSourceID() hands out IDs that are never
+// shared, for players that only have a codec.  The cache keeps the encoded data of each shareable
+// source it has frames of, and counts it against the budget, so that a frame is only found by
+// players of the very same bytes, even if two sources' hashes collide.
+//
+// Most frames of a GIF or WebP depend on an earlier frame, so seeking costs as many decodes as it
+// takes to reach a cached ancestor.  Players mark every few frames along each dependency chain as
+// keyframes; those are evicted only after every other frame is gone, which bounds the length of
+// that walk as long as the keyframes fit in the budget.  Otherwise eviction is least recently used.
+class SkAnimFrameCache {
+ public:
+  explicit SkAnimFrameCache(size_t byteLimit) : fByteLimit(byteLimit) {}
+  ~SkAnimFrameCache();
+
+  static SkAnimFrameCache* Global();
+
+  static uint64_t SourceID(const SkData& encoded);
+  static uint64_t NewSourceID();
+  static bool IsShareable(uint64_t sourceID) { return !(sourceID >> 63); }
+
+  // Returns the cached frame, or nullptr.  A hit makes the frame the most recently used.
+  // 'encoded' is the data a shareable source ID was made from, and is ignored for others.
+  sk_sp<SkImage> find(uint64_t sourceID, const SkData* encoded, int frame);
+  // Remember this frame, then purge down to the byte limit.  The new frame may be purged right
+  // away if it's bigger than the whole budget.  Frames of data whose ID collides with another
+  // source's aren't cached.
+  void add(
+      uint64_t sourceID, sk_sp<SkData> encoded, int frame, sk_sp<SkImage> image, bool keyframe);
+
+  // Returns the previous limit.
+  size_t setByteLimit(size_t byteLimit);
+  size_t byteLimit() const;
+  size_t bytesUsed() const;
+  int count() const;
+  void purgeSource(uint64_t sourceID);
+  void purgeAll();
+
+ private:
+  struct Key {
+    uint64_t fSourceID;
+    int fFrame;
+
+    bool operator==(const Key& that) const {
+      return fSourceID == that.fSourceID && fFrame == that.fFrame;
+    }
+  };
+  struct KeyHash {
+    uint32_t operator()(const Key& key) const {
+      return SkGoodHash()(key.fSourceID) ^ SkGoodHash()(key.fFrame);
+    }
+  };
+  struct Entry {
+    Key fKey;
+    sk_sp<SkImage> fImage;
+    size_t fBytes;
+    bool fKeyframe;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+  };
+  struct Source {
+    sk_sp<SkData> fEncoded;
+    int fEntryCount;
+  };
+
+  SkTInternalLList<Entry>& listFor(const Entry* entry) SK_REQUIRES(fMutex) {
+    return entry->fKeyframe ? fKeyframes : fFrames;
+  }
+  // Whether frames cached for this source ID were decoded from 'encoded'.
+  bool isSourceOf(uint64_t sourceID, const SkData* encoded) const SK_REQUIRES(fMutex);
+  void remove(Entry*) SK_REQUIRES(fMutex);
+  void purge() SK_REQUIRES(fMutex);
+
+  mutable SkMutex fMutex;
+  SkTHashMap<Key, Entry*, KeyHash> fEntries SK_GUARDED_BY(fMutex);
+  // The shareable sources with cached frames.
+  SkTHashMap<uint64_t, Source> fSources SK_GUARDED_BY(fMutex);
+  // Most recently used at the head.
+  SkTInternalLList<Entry> fFrames SK_GUARDED_BY(fMutex);
+  SkTInternalLList<Entry> fKeyframes SK_GUARDED_BY(fMutex);
+  size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+  size_t fByteLimit SK_GUARDED_BY(fMutex);
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "include/utils/SkAnimCodecPlayer.h"
+#include "src/utils/SkAnimFrameCache.h"
 #include "tests/CodecPriv.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
@@ -664,3 +665,97 @@ DEF_TEST(AnimCodecPlayer, r) {
         test.fFile);
   }
 }
+
+static bool same_pixels(const sk_sp<SkImage>& a, const sk_sp<SkImage>& b) {
+  SkBitmap bmA, bmB;
+  bmA.allocPixels(SkImageInfo::MakeN32Premul(a->dimensions()));
+  bmB.allocPixels(bmA.info());
+  return a->dimensions() == b->dimensions() && a->readPixels(bmA.pixmap(), 0, 0) &&
+         b->readPixels(bmB.pixmap(), 0, 0) &&
+         0 == memcmp(bmA.getPixels(), bmB.getPixels(), bmA.computeByteSize());
+}
+
+DEF_TEST(AnimCodecPlayer_FrameCache, r) {
+  for (const char* file : {"images/required.gif", "images/alphabetAnim.gif",
+                           "images/stoplight.webp", "images/required.webp"}) {
+    sk_sp<SkData> data = GetResourceAsData(file);
+    if (!data) {
+      continue;
+    }
+    const size_t oldLimit = SkAnimCodecPlayer::SetFrameCacheByteLimit(64 * 1024 * 1024);
+
+    // Play every frame in order, one codec call per frame.
+    auto player = SkAnimCodecPlayer::Make(data);
+    REPORTER_ASSERT(r, player);
+    const int frameCount = (int)SkCodec::MakeFromData(data)->getFrameCount();
+    std::vector<uint32_t> times;
+    std::vector<sk_sp<SkImage>> frames;
+    uint32_t t = 0;
+    for (const auto& info : SkCodec::MakeFromData(data)->getFrameInfo()) {
+      times.push_back(t);
+      t += info.fDuration;
+      player->seek(times.back());
+      frames.push_back(player->getFrame());
+      REPORTER_ASSERT(r, frames.back(), "%s: no frame %zu", file, frames.size() - 1);
+    }
+    REPORTER_ASSERT(r, (int)frames.size() == frameCount);
+
+    // Another player of the same data shares those frames.
+    auto sharing = SkAnimCodecPlayer::Make(data);
+    for (int i = frameCount - 1; i >= 0; --i) {
+      sharing->seek(times[i]);
+      REPORTER_ASSERT(r, sharing->getFrame() == frames[i], "%s: frame %d not shared", file, i);
+    }
+
+    // Seeking randomly with a budget too small for every frame decodes the same pixels, and the
+    // cache stays within budget.
+    const size_t frameBytes = frames[0]->imageInfo().computeMinByteSize();
+    SkAnimCodecPlayer::SetFrameCacheByteLimit(3 * frameBytes);
+    auto codec = SkCodec::MakeFromData(data);
+    auto seeker = std::make_unique<SkAnimCodecPlayer>(std::move(codec));
+    for (int i : {frameCount - 1, 0, frameCount / 2, frameCount - 2, 1, frameCount / 3}) {
+      if (i < 0 || i >= frameCount) {
+        continue;
+      }
+      seeker->seek(times[i]);
+      auto frame = seeker->getFrame();
+      REPORTER_ASSERT(
+          r, frame && same_pixels(frame, frames[i]), "%s: mismatched frame %d", file, i);
+      REPORTER_ASSERT(r, SkAnimCodecPlayer::GetFrameCacheBytesUsed() <= 3 * frameBytes);
+    }
+
+    SkAnimCodecPlayer::SetFrameCacheByteLimit(oldLimit);
+  }
+}
+
+DEF_TEST(AnimCodecPlayer_FrameCacheCollision, r) {
+  SkAnimFrameCache cache(1024 * 1024);
+  SkBitmap bm;
+  bm.allocN32Pixels(4, 4);
+  bm.eraseColor(SK_ColorRED);
+  sk_sp<SkImage> image = bm.asImage();
+  const size_t imageBytes = image->imageInfo().computeMinByteSize();
+
+  // Pretend two different sources hashed to the same ID.
+  const char kA[] = "first source", kB[] = "other source";
+  sk_sp<SkData> a = SkData::MakeWithCopy(kA, sizeof(kA));
+  sk_sp<SkData> b = SkData::MakeWithCopy(kB, sizeof(kB));
+  const uint64_t sourceID = SkAnimFrameCache::SourceID(*a);
+  REPORTER_ASSERT(r, SkAnimFrameCache::IsShareable(sourceID));
+
+  cache.add(sourceID, a, 0, image, true);
+  REPORTER_ASSERT(r, cache.bytesUsed() == imageBytes + a->size());
+  REPORTER_ASSERT(r, cache.find(sourceID, a.get(), 0) == image);
+  sk_sp<SkData> copyOfA = SkData::MakeWithCopy(kA, sizeof(kA));
+  REPORTER_ASSERT(r, cache.find(sourceID, copyOfA.get(), 0) == image);
+  REPORTER_ASSERT(r, !cache.find(sourceID, b.get(), 0));
+
+  // The colliding source's frames aren't cached at all.
+  cache.add(sourceID, b, 1, image, true);
+  REPORTER_ASSERT(r, !cache.find(sourceID, b.get(), 1));
+  REPORTER_ASSERT(r, cache.count() == 1);
+
+  // The encoded data goes with the source's last frame.
+  cache.purgeSource(sourceID);
+  REPORTER_ASSERT(r, cache.count() == 0 && cache.bytesUsed() == 0);
+}
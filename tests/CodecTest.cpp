@@ -19,6 +19,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
@@ -554,6 +555,115 @@ DEF_TEST(Codec_png, r) {
   check(r, "images/yellow_rose.png", SkISize::Make(400, 301), false, false, true, true);
 }
 
+DEF_TEST(Codec_subsetDecode, r) {
+  // JPEG and PNG can't subset in getPixels() natively, so they decode subsets with their
+  // scanline or incremental decoders.  That should match the same rect of a full decode.
+  const struct {
+    const char* path;
+    float scale;
+  } recs[] = {
+      {"images/mandrill_512_q075.jpg", 1.0f}, {"images/mandrill_512_q075.jpg", 0.5f},
+      {"images/mandrill_512_q075.jpg", 0.375f}, {"images/mandrill_h2v1.jpg", 0.25f},
+      {"images/CMYK.jpg", 1.0f}, {"images/mandrill_512.png", 1.0f},
+      {"images/plane_interlaced.png", 1.0f},
+  };
+  for (const auto& rec : recs) {
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(GetResourceAsData(rec.path)));
+    if (!codec) {
+      ERRORF(r, "Unable to decode '%s'", rec.path);
+      continue;
+    }
+    const SkISize size = codec->dimensions();
+    const SkISize scaledSize = codec->getScaledDimensions(rec.scale);
+    const SkImageInfo info =
+        codec->getInfo().makeDimensions(scaledSize).makeColorType(kN32_SkColorType);
+    SkBitmap full;
+    full.allocPixels(info);
+    if (SkCodec::kSuccess != codec->getPixels(full.pixmap())) {
+      ERRORF(r, "Failed to decode '%s'", rec.path);
+      continue;
+    }
+
+    SkRandom rand;
+    for (int i = 0; i < 5; i++) {
+      SkIRect subset = generate_random_subset(&rand, size.width(), size.height());
+      if (scaledSize != size && (subset.width() < 16 || subset.height() < 16)) {
+        continue;  // Too small to tell which scale we're asking for.
+      }
+      // Round the origin down and the size up, as getPixels() does.
+      const SkIRect scaledSubset = SkIRect::MakeXYWH(
+          subset.x() * scaledSize.width() / size.width(),
+          subset.y() * scaledSize.height() / size.height(),
+          (subset.width() * scaledSize.width() + size.width() - 1) / size.width(),
+          (subset.height() * scaledSize.height() + size.height() - 1) / size.height());
+      if (!SkIRect::MakeSize(scaledSize).contains(scaledSubset)) {
+        continue;
+      }
+
+      SkBitmap bm;
+      bm.allocPixels(info.makeDimensions(scaledSubset.size()));
+      SkCodec::Options opts;
+      opts.fSubset = &subset;
+      const SkCodec::Result result = codec->getPixels(bm.pixmap(), &opts);
+      if (SkCodec::kSuccess != result) {
+        ERRORF(
+            r, "Failed to decode a subset of '%s': %s", rec.path, SkCodec::ResultToString(result));
+        continue;
+      }
+
+      SkBitmap expected;
+      SkAssertResult(full.extractSubset(&expected, scaledSubset));
+      REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected.pixmap(), bm.pixmap()), "%s", rec.path);
+    }
+  }
+}
+
+DEF_TEST(Codec_subsetDecodeInvalid, r) {
+  // The dst must be the subset at a native scale exactly; near misses would decode a
+  // different rect than the one asked for.
+  SkIRect subset = SkIRect::MakeXYWH(10, 10, 100, 100);
+  SkCodec::Options opts;
+  opts.fSubset = &subset;
+  const struct {
+    const char* path;
+    SkISize dstSize;
+    SkCodec::Result expected;
+  } recs[] = {
+      {"images/mandrill_512.png", {100, 100}, SkCodec::kSuccess},
+      {"images/mandrill_512.png", {101, 101}, SkCodec::kInvalidScale},
+      {"images/mandrill_512.png", {50, 50}, SkCodec::kInvalidScale},
+      {"images/mandrill_512_q075.jpg", {50, 50}, SkCodec::kSuccess},
+      {"images/mandrill_512_q075.jpg", {51, 51}, SkCodec::kInvalidScale},
+      {"images/mandrill_512_q075.jpg", {60, 60}, SkCodec::kInvalidScale},
+  };
+  for (const auto& rec : recs) {
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(GetResourceAsData(rec.path)));
+    if (!codec) {
+      ERRORF(r, "Unable to decode '%s'", rec.path);
+      continue;
+    }
+    SkBitmap bm;
+    bm.allocPixels(codec->getInfo().makeDimensions(rec.dstSize).makeColorType(kN32_SkColorType));
+    const SkCodec::Result result = codec->getPixels(bm.pixmap(), &opts);
+    REPORTER_ASSERT(
+        r, result == rec.expected, "%s %dx%d: %s", rec.path, rec.dstSize.width(),
+        rec.dstSize.height(), SkCodec::ResultToString(result));
+  }
+
+  // Later frames may depend on earlier ones, so they can't be decoded a subset at a time.
+  std::unique_ptr<SkCodec> codec(
+      SkCodec::MakeFromData(GetResourceAsData("images/randPixelsAnim.gif")));
+  if (!codec) {
+    ERRORF(r, "Unable to decode randPixelsAnim.gif");
+    return;
+  }
+  subset = SkIRect::MakeXYWH(1, 1, 2, 2);
+  opts.fFrameIndex = 1;
+  SkBitmap bm;
+  bm.allocPixels(codec->getInfo().makeDimensions(subset.size()).makeColorType(kN32_SkColorType));
+  REPORTER_ASSERT(r, codec->getPixels(bm.pixmap(), &opts) == SkCodec::kUnimplemented);
+}
+
 // Disable RAW tests for Win32.
 #if defined(SK_CODEC_DECODES_RAW) && (!defined(_WIN32))
 DEF_TEST(Codec_raw, r) {
@@ -1865,3 +1975,36 @@ DEF_TEST(Codec_noConversion, r) {
     REPORTER_ASSERT(r, bm.getColor(0, 0) == rec.color);
   }
 }
+
+// Decoding on an executor must match decoding serially exactly.
+DEF_TEST(Codec_executor, r) {
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+  sk_sp<SkColorSpace> p3 =
+      SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3);
+  for (const char* name : {"images/mandrill_512_restart.jpg", "images/mandrill_1600.png",
+                           "images/plane_interlaced.png", "images/index8.png"}) {
+    sk_sp<SkData> data = GetResourceAsData(name);
+    if (!data) {
+      continue;
+    }
+    for (const sk_sp<SkColorSpace>& cs : {sk_sp<SkColorSpace>(nullptr), p3}) {
+      std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+      REPORTER_ASSERT(r, codec);
+      const SkImageInfo info =
+          codec->getInfo().makeColorType(kRGBA_8888_SkColorType).makeColorSpace(cs);
+      SkBitmap serial, parallel;
+      serial.allocPixels(info);
+      parallel.allocPixels(info);
+      REPORTER_ASSERT(r, codec->getPixels(serial.pixmap()) == SkCodec::kSuccess);
+
+      SkCodec::Options options;
+      options.fExecutor = executor.get();
+      REPORTER_ASSERT(
+          r,
+          codec->getPixels(info, parallel.getPixels(), parallel.rowBytes(), &options) ==
+                  SkCodec::kSuccess);
+
+      REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial.pixmap(), parallel.pixmap()), "%s", name);
+    }
+  }
+}
@@ -12,6 +12,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkStream.h"
@@ -323,6 +324,52 @@ DEF_TEST(Encode_PngOptions, r) {
   REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngExecutor, r) {
+  SkBitmap bitmap;
+  if (!GetResourceAsBitmap("images/mandrill_512.png", &bitmap)) {
+    return;
+  }
+  SkPixmap src;
+  REPORTER_ASSERT(r, bitmap.peekPixels(&src));
+
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+  for (auto filters : {SkPngEncoder::FilterFlag::kAll, SkPngEncoder::FilterFlag::kNone,
+                       SkPngEncoder::FilterFlag::kPaeth}) {
+    for (int zlibLevel : {0, 1, 6, 9}) {
+      SkPngEncoder::Options options;
+      options.fFilterFlags = filters;
+      options.fZLibLevel = zlibLevel;
+      SkDynamicMemoryWStream serial;
+      REPORTER_ASSERT(r, SkPngEncoder::Encode(&serial, src, options));
+
+      options.fExecutor = executor.get();
+      SkDynamicMemoryWStream parallel;
+      REPORTER_ASSERT(r, SkPngEncoder::Encode(&parallel, src, options));
+
+      // Encoding a few rows at a time must stitch together just the same.
+      SkDynamicMemoryWStream incremental;
+      auto encoder = SkPngEncoder::Make(&incremental, src, options);
+      REPORTER_ASSERT(r, encoder);
+      for (int rows = 0; rows < src.height(); rows += 100) {
+        REPORTER_ASSERT(r, encoder->encodeRows(100));
+      }
+
+      sk_sp<SkData> serialData = serial.detachAsData();
+      sk_sp<SkData> parallelData = parallel.detachAsData();
+      // Chunking costs a little compression, but not much.
+      REPORTER_ASSERT(r, parallelData->size() <= serialData->size() * 1.05,
+                      "%zu vs %zu", parallelData->size(), serialData->size());
+
+      SkBitmap bm0, bm1, bm2;
+      SkImage::MakeFromEncoded(serialData)->asLegacyBitmap(&bm0);
+      SkImage::MakeFromEncoded(parallelData)->asLegacyBitmap(&bm1);
+      SkImage::MakeFromEncoded(incremental.detachAsData())->asLegacyBitmap(&bm2);
+      REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0));
+      REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
+    }
+  }
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
   SkBitmap bm;
@@ -5,9 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRegion.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkScan.h"
 #include "tests/Test.h"
 
@@ -42,3 +47,165 @@ DEF_TEST(FillPathInverse, reporter) {
 
   REPORTER_ASSERT(reporter, blitter.m_blitCount == expected_lines);
 }
+
+// The analytic AA coverage kernels in SkOpts must match their one-pixel-at-a-time definitions
+// at every length, including those that aren't a multiple of the SIMD width.
+DEF_TEST(FillPath_AAACoverageOpts, r) {
+  SkRandom rand;
+  for (int n = 0; n < 150; n++) {
+    SkAlpha dst[150], src[150], want[150];
+    for (int i = 0; i < n; i++) {
+      dst[i] = rand.nextU() & 0xFF;
+      src[i] = rand.nextU() & 0xFF;
+    }
+
+    for (int i = 0; i < n; i++) {
+      want[i] = std::min(0xFF, dst[i] + src[i]);
+    }
+    SkAlpha got[150];
+    memcpy(got, dst, n);
+    SkOpts::add_alphas(got, src, n);
+    REPORTER_ASSERT(r, !memcmp(got, want, n));
+
+    for (int i = 0; i < n; i++) {
+      want[i] = std::min(0xFF, dst[i] + src[0]);
+    }
+    memcpy(got, dst, n);
+    SkOpts::add_alpha_span(got, n ? src[0] : 0, n);
+    REPORTER_ASSERT(r, !memcmp(got, want, n));
+
+    for (int i = 0; i < n; i++) {
+      want[i] = dst[i] > src[i] ? dst[i] - src[i] : 0;
+    }
+    memcpy(got, dst, n);
+    SkOpts::sub_alphas(got, src, n);
+    REPORTER_ASSERT(r, !memcmp(got, want, n));
+
+    const SkFixed start = rand.nextRangeU(0, 0xFFFF), dY = rand.nextRangeU(0, 0x1FF);
+    for (SkFixed step : {dY, -dY}) {
+      for (int i = 0; i < n; i++) {
+        want[i] = ((start + i * step) >> 8) & 0xFF;
+      }
+      SkOpts::alpha_ramp(got, start, step, n);
+      REPORTER_ASSERT(r, !memcmp(got, want, n));
+    }
+  }
+}
+
+// Sparse strips compute exact area coverage where AAA approximates it, so the two don't agree
+// pixel for pixel along edges.  But they should agree everywhere away from the edges, and on
+// the total coverage.
+DEF_TEST(FillPath_SparseStrips, r) {
+  SkPath circle = SkPath::Circle(200, 200, 190);
+  SkPath star;
+  star.moveTo(200, 5);
+  for (int i = 1; i < 5; i++) {
+    const float a = i * 4 * SK_ScalarPI / 5 - SK_ScalarPI / 2;
+    star.lineTo(200 + 195 * std::cos(a), 200 + 195 * std::sin(a));
+  }
+  SkPath cubic;
+  cubic.moveTo(0, 400).cubicTo(130, -250, 270, 650, 400, 0).lineTo(400, 400).close();
+
+  const bool useSparseStrips = gSkUseSparseStrips;
+  for (const SkPath& path : {circle, star, cubic}) {
+    for (bool clipped : {false, true}) {
+      SkBitmap bm[2];
+      for (bool sparse : {false, true}) {
+        gSkUseSparseStrips = sparse;
+        bm[sparse].allocPixels(SkImageInfo::MakeA8(400, 400));
+        bm[sparse].eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bm[sparse]);
+        if (clipped) {
+          canvas.clipRect(SkRect::MakeLTRB(37, 23, 362, 381));
+        }
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        canvas.drawPath(path, paint);
+      }
+
+      double sum[2] = {0, 0};
+      int mismatches = 0;
+      for (int y = 1; y < 399; y++) {
+        for (int x = 1; x < 399; x++) {
+          sum[0] += *bm[0].getAddr8(x, y);
+          sum[1] += *bm[1].getAddr8(x, y);
+          // Away from edges, where all 9 neighboring pixels agree, coverage must be exact.
+          const SkAlpha a = *bm[0].getAddr8(x, y);
+          bool interior = true;
+          for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+              interior = interior && *bm[0].getAddr8(x + dx, y + dy) == a;
+            }
+          }
+          if (interior && (a == 0 || a == 0xFF) && *bm[1].getAddr8(x, y) != a) {
+            mismatches++;
+          }
+        }
+      }
+      REPORTER_ASSERT(r, mismatches == 0, "%d", mismatches);
+      REPORTER_ASSERT(r, std::abs(sum[1] - sum[0]) <= 0.002 * sum[0], "%g vs %g", sum[1], sum[0]);
+    }
+  }
+  gSkUseSparseStrips = useSparseStrips;
+}
+
+// Where a path crosses or overlaps itself, the winding inside a pixel can take more than two
+// values, and summing signed areas there gives the wrong coverage.  Sparse strips sample those
+// pixels instead.  AAA approximates them too, so compare with AAA drawn at 4x and averaged down.
+DEF_TEST(FillPath_SparseStrips_SelfIntersecting, r) {
+  SkPath pentagram;
+  pentagram.moveTo(200, 5);
+  for (int i = 1; i < 5; i++) {
+    const float a = i * 4 * SK_ScalarPI / 5 - SK_ScalarPI / 2;
+    pentagram.lineTo(200 + 195 * std::cos(a), 200 + 195 * std::sin(a));
+  }
+  SkPath bowtie;
+  bowtie.moveTo(10.3f, 20.6f).lineTo(390.1f, 380.4f).lineTo(389.7f, 30.2f).lineTo(20.5f, 370.8f);
+  SkPath doubled;
+  doubled.addCircle(200.3f, 199.6f, 150.2f).addCircle(200.3f, 199.6f, 150.2f);
+  SkPath circles;
+  circles.addCircle(150.5f, 170.2f, 120.3f).addCircle(250.1f, 230.7f, 120.6f);
+  SkPath rects;
+  rects.addRect({20.3f, 30.6f, 300.2f, 250.9f}).addRect({100.7f, 120.1f, 380.4f, 370.5f});
+  SkPath loop;
+  loop.moveTo(20, 380).cubicTo(600, -100, -200, -100, 380, 380).close();
+
+  const bool useSparseStrips = gSkUseSparseStrips;
+  for (const SkPath& shape : {pentagram, bowtie, doubled, circles, rects, loop}) {
+    for (SkPathFillType fillType : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd}) {
+      SkPath path = shape;
+      path.setFillType(fillType);
+      SkPaint paint;
+      paint.setAntiAlias(true);
+
+      SkBitmap aaa, sparse;
+      aaa.allocPixels(SkImageInfo::MakeA8(1600, 1600));
+      aaa.eraseColor(SK_ColorTRANSPARENT);
+      gSkUseSparseStrips = false;
+      SkCanvas canvas(aaa);
+      canvas.scale(4, 4);
+      canvas.drawPath(path, paint);
+
+      sparse.allocPixels(SkImageInfo::MakeA8(400, 400));
+      sparse.eraseColor(SK_ColorTRANSPARENT);
+      gSkUseSparseStrips = true;
+      SkCanvas(sparse).drawPath(path, paint);
+
+      int maxDiff = 0;
+      for (int y = 0; y < 400; y++) {
+        for (int x = 0; x < 400; x++) {
+          int sum = 0;
+          for (int dy = 0; dy < 4; dy++) {
+            for (int dx = 0; dx < 4; dx++) {
+              sum += *aaa.getAddr8(4 * x + dx, 4 * y + dy);
+            }
+          }
+          maxDiff = std::max(maxDiff, std::abs(*sparse.getAddr8(x, y) - (sum + 8) / 16));
+        }
+      }
+      // Flattening curves and AAA's own approximations leave some difference along the edges.
+      REPORTER_ASSERT(r, maxDiff <= 40, "%d", maxDiff);
+    }
+  }
+  gSkUseSparseStrips = useSparseStrips;
+}
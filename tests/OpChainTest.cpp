@@ -6,12 +6,15 @@
  */
 
 #include "include/gpu/GrDirectContext.h"
+#include "include/utils/SkRandom.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
+#include "src/gpu/ganesh/geometry/GrRect.h"
 #include "src/gpu/ganesh/ops/GrOp.h"
+#include "src/gpu/ganesh/ops/OpChainIndex.h"
 #include "src/gpu/ganesh/ops/OpsTask.h"
 #include "tests/Test.h"
 #include <iterator>
@@ -261,3 +264,70 @@ DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
     }
   }
 }
+
+/**
+ * Checks OpChainIndex's answers against a search of every chain, with chains of all sizes, some
+ * reaching outside the target, growing as they are added.
+ */
+DEF_TEST(OpChainIndexTest, reporter) {
+  static constexpr int kNumChains = 300;
+  static constexpr uint32_t kNumClasses = 4;
+  const SkRect target = SkRect::MakeWH(256, 128);
+
+  SkRandom random;
+  auto randomRect = [&]() {
+    float size = random.nextBool() ? random.nextRangeF(1, 16) : random.nextRangeF(1, 300);
+    float x = random.nextRangeF(-40, target.width() + 40);
+    float y = random.nextRangeF(-40, target.height() + 40);
+    return SkRect::MakeXYWH(x, y, size * random.nextRangeF(0.25f, 2), size);
+  };
+
+  skgpu::v1::OpChainIndex index;
+  index.reset(target);
+  std::vector<SkRect> bounds;
+  std::vector<uint32_t> classes;
+  for (int i = 0; i < kNumChains; ++i) {
+    bounds.push_back(randomRect());
+    classes.push_back(random.nextULessThan(kNumClasses));
+    index.addChain(classes.back(), bounds.back());
+    if (random.nextULessThan(4) == 0) {
+      int grow = random.nextULessThan(bounds.size());
+      bounds[grow].join(randomRect());
+      index.growChain(grow, bounds[grow]);
+    }
+    REPORTER_ASSERT(reporter, index.count() == (int)bounds.size());
+
+    SkRect query = randomRect();
+    int pivot = random.nextULessThan(bounds.size() + 1);
+    int last = -1;
+    for (int j = 0; j < pivot; ++j) {
+      if (GrRectsOverlap(bounds[j], query)) {
+        last = j;
+      }
+    }
+    int first = bounds.size();
+    for (int j = bounds.size() - 1; j > pivot; --j) {
+      if (GrRectsOverlap(bounds[j], query)) {
+        first = j;
+      }
+    }
+    REPORTER_ASSERT(reporter, index.lastOverlap(query, pivot) == last);
+    REPORTER_ASSERT(reporter, index.firstOverlap(query, pivot) == first);
+  }
+
+  for (uint32_t c = 0; c < kNumClasses; ++c) {
+    std::vector<int> expected;
+    for (int j = 0; j < kNumChains; ++j) {
+      if (classes[j] == c) {
+        expected.push_back(j);
+      }
+    }
+    SkSpan<const int> found = index.chainsOfClass(c);
+    REPORTER_ASSERT(reporter, std::equal(found.begin(), found.end(), expected.begin(),
+                                         expected.end()));
+  }
+  REPORTER_ASSERT(reporter, index.chainsOfClass(kNumClasses).empty());
+
+  index.clear();
+  REPORTER_ASSERT(reporter, index.count() == 0);
+}
@@ -9,6 +9,8 @@
 
 #ifdef SK_SUPPORT_PDF
 
+#  include "include/core/SkData.h"
+#  include "include/core/SkExecutor.h"
 #  include "include/private/SkTo.h"
 #  include "include/utils/SkRandom.h"
 #  include "src/pdf/SkDeflate.h"
@@ -28,9 +30,11 @@ void skia_free_func(void*, void* address) { sk_free(address); }
 
 /**
  *  Use the un-deflate compression algorithm to decompress the data in src,
- *  returning the result.  Returns nullptr if an error occurs.
+ *  returning the result.  Returns nullptr if an error occurs.  The default
+ *  windowBits expects a zlib stream; add 16 for gzip.
  */
-std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkStream* src) {
+std::unique_ptr<SkStreamAsset> stream_inflate(
+    skiatest::Reporter* reporter, SkStream* src, int windowBits = MAX_WBITS) {
   SkDynamicMemoryWStream decompressedDynamicMemoryWStream;
   SkWStream* dst = &decompressedDynamicMemoryWStream;
 
@@ -46,7 +50,7 @@ std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkSt
   flateData.next_out = outputBuffer;
   flateData.avail_out = kBufferSize;
   int rc;
-  rc = inflateInit(&flateData);
+  rc = inflateInit2(&flateData, windowBits);
   if (rc != Z_OK) {
     ERRORF(reporter, "Zlib: inflateInit failed");
     return nullptr;
@@ -164,4 +168,45 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
   REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateWStream_Parallel, r) {
+  // Compressible input, so matches cross the 128KB block boundaries.
+  SkRandom random(654321);
+  const size_t kMaxSize = 1000 * 1000;
+  SkAutoTMalloc<uint8_t> buffer(kMaxSize);
+  for (size_t j = 0; j < kMaxSize; ++j) {
+    buffer[j] = j >= 1000 && random.nextBool() ? buffer[j - random.nextRangeU(1, 1000)]
+                                               : (uint8_t)random.nextULessThan(16);
+  }
+
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+  for (size_t size : {(size_t)0, (size_t)1, (size_t)128 * 1024, (size_t)3 * 128 * 1024 + 17,
+                      kMaxSize}) {
+    for (bool gzip : {false, true}) {
+      for (int level : {-1, 1, 9}) {
+        SkDynamicMemoryWStream dynamicMemoryWStream;
+        {
+          SkDeflateWStream deflateWStream(&dynamicMemoryWStream, level, gzip, executor.get());
+          size_t j = 0;
+          while (j < size) {
+            size_t writeSize = std::min<size_t>(size - j, random.nextRangeU(1, 100000));
+            REPORTER_ASSERT(r, deflateWStream.write(&buffer[j], writeSize));
+            j += writeSize;
+          }
+          REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+        }
+        std::unique_ptr<SkStreamAsset> compressed(dynamicMemoryWStream.detachAsStream());
+        std::unique_ptr<SkStreamAsset> decompressed(
+            stream_inflate(r, compressed.get(), gzip ? MAX_WBITS + 16 : MAX_WBITS));
+        if (!decompressed || decompressed->getLength() != size) {
+          ERRORF(r, "Parallel decompression failed: size %zu, gzip %d, level %d", size, gzip,
+                 level);
+          continue;
+        }
+        sk_sp<SkData> data = SkData::MakeFromStream(decompressed.get(), size);
+        REPORTER_ASSERT(r, size == 0 || 0 == memcmp(data->data(), buffer.get(), size));
+      }
+    }
+  }
+}
+
 #endif
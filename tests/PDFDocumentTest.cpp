@@ -9,6 +9,8 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
 #include "src/core/SkOSFile.h"
@@ -17,6 +19,10 @@
 
 #include "tools/ToolUtils.h"
 
+#include <cstring>
+#include <string>
+#include <vector>
+
 static void test_empty(skiatest::Reporter* reporter) {
   SkDynamicMemoryWStream stream;
 
@@ -254,3 +260,161 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
   doc->beginPage(612, 792)->drawImage(b.asImage(), 0, 0);
   doc->abort();
 }
+
+// Checks that every entry in the cross-reference table points at the object it names.
+static bool xref_is_valid(const SkData& pdf) {
+  const char* bytes = (const char*)pdf.data();
+  const std::string text(bytes, pdf.size());
+  size_t startxref = text.rfind("startxref\n");
+  if (startxref == std::string::npos) {
+    return false;
+  }
+  size_t xref = strtoul(bytes + startxref + strlen("startxref\n"), nullptr, 10);
+  if (text.compare(xref, strlen("xref\n0 "), "xref\n0 ") != 0) {
+    return false;
+  }
+  char* end;
+  int count = (int)strtol(bytes + xref + strlen("xref\n0 "), &end, 10);
+  const char* entry = end + 1 + 20;  // Skip the newline and the free zeroth entry.
+  for (int i = 1; i < count; ++i, entry += 20) {
+    size_t offset = strtoul(entry, nullptr, 10);
+    SkString expected = SkStringPrintf("%d 0 obj\n", i);
+    if (offset >= pdf.size() || text.compare(offset, expected.size(), expected.c_str()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static sk_sp<SkData> make_report(SkPDF::Metadata metadata, int pages) {
+  SkBitmap opaque, translucent;
+  opaque.allocN32Pixels(64, 64);
+  opaque.eraseColor(SK_ColorBLUE);
+  translucent.allocN32Pixels(64, 64);
+  translucent.eraseColor(0x80FF0000);
+  SkDynamicMemoryWStream stream;
+  auto doc = SkPDF::MakeDocument(&stream, metadata);
+  for (int i = 0; i < pages; ++i) {
+    SkCanvas* canvas = doc->beginPage(612, 792);
+    canvas->drawColor(SkColorSetARGB(0xFF, 0x00, (uint8_t)(255.0f * i / pages), 0x00));
+    // A new image on each page, so every page emits its own image streams.
+    opaque.notifyPixelsChanged();
+    translucent.notifyPixelsChanged();
+    canvas->drawImage(opaque.asImage(), 10, 10);
+    canvas->drawImage(translucent.asImage(), 100, 10);
+    doc->endPage();
+  }
+  doc->close();
+  return stream.detachAsData();
+}
+
+DEF_TEST(SkPDF_streaming, r) {
+  REQUIRE_PDF_DOCUMENT(SkPDF_streaming, r);
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+  for (SkExecutor* exec : {(SkExecutor*)nullptr, executor.get()}) {
+    for (int pages : {1, 8, 9, 70}) {
+      SkPDF::Metadata metadata;
+      metadata.fExecutor = exec;
+      metadata.fStreaming = true;
+      sk_sp<SkData> pdf = make_report(metadata, pages);
+      REPORTER_ASSERT(r, pdf->size() > 0 && 0 == memcmp(pdf->data(), "%PDF", 4));
+      REPORTER_ASSERT(r, xref_is_valid(*pdf), "%d pages", pages);
+
+      const std::string text((const char*)pdf->data(), pdf->size());
+      REPORTER_ASSERT(
+          r, text.find(SkStringPrintf("/Count %d", pages).c_str()) != std::string::npos);
+      if (!exec) {
+        // Compressed streams have their lengths written after them.
+        REPORTER_ASSERT(r, text.find(" 0 R>> stream") != std::string::npos);
+      }
+    }
+  }
+}
+
+static sk_sp<SkData> make_logo_letter(SkPDF::Metadata metadata, sk_sp<SkTypeface> typeface) {
+  SkBitmap logo;
+  logo.allocN32Pixels(64, 64);
+  logo.eraseColor(0x80FF0000);
+  logo.erase(SK_ColorBLUE, SkIRect::MakeXYWH(16, 16, 32, 32));
+  SkDynamicMemoryWStream stream;
+  auto doc = SkPDF::MakeDocument(&stream, metadata);
+  SkCanvas* canvas = doc->beginPage(612, 792);
+  canvas->drawImage(logo.asImage(), 10, 10);
+  if (typeface) {
+    SkFont font(std::move(typeface), 24);
+    canvas->drawString("Dear customer,", 10, 120, font, SkPaint());
+  }
+  doc->close();
+  return stream.detachAsData();
+}
+
+DEF_TEST(SkPDF_resource_cache, r) {
+  REQUIRE_PDF_DOCUMENT(SkPDF_resource_cache, r);
+  sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+  sk_sp<SkData> uncached = make_logo_letter(SkPDF::Metadata(), typeface);
+
+  SkPDF::ResourceCache cache;
+  SkPDF::Metadata metadata;
+  metadata.fResourceCache = &cache;
+  sk_sp<SkData> first = make_logo_letter(metadata, typeface);
+  const size_t bytesUsed = cache.bytesUsed();
+  REPORTER_ASSERT(r, bytesUsed > 0);
+
+  // Each new image is found in the cache, and written exactly as it would be without it.
+  sk_sp<SkData> second = make_logo_letter(metadata, typeface);
+  REPORTER_ASSERT(r, cache.bytesUsed() == bytesUsed);
+  REPORTER_ASSERT(r, uncached->equals(first.get()));
+  REPORTER_ASSERT(r, uncached->equals(second.get()));
+
+  cache.purgeAll();
+  REPORTER_ASSERT(r, cache.bytesUsed() == 0);
+
+  SkPDF::ResourceCache tinyCache(1);
+  metadata.fResourceCache = &tinyCache;
+  sk_sp<SkData> third = make_logo_letter(metadata, typeface);
+  REPORTER_ASSERT(r, tinyCache.bytesUsed() == 0);
+  REPORTER_ASSERT(r, uncached->equals(third.get()));
+}
+
+// With an executor, fonts' subsets, widths and ToUnicode CMaps are made in parallel, and then
+// emitted in the same order as without one.
+DEF_TEST(SkPDF_parallel_fonts, r) {
+  REQUIRE_PDF_DOCUMENT(SkPDF_parallel_fonts, r);
+  std::vector<sk_sp<SkTypeface>> typefaces;
+  for (const char* resource : {"fonts/Roboto-Regular.ttf", "fonts/Em.ttf", "fonts/ahem.ttf",
+                               "fonts/hintgasp.ttf", "fonts/ReallyBigA.ttf"}) {
+    if (sk_sp<SkTypeface> typeface = MakeResourceAsTypeface(resource)) {
+      typefaces.push_back(std::move(typeface));
+    }
+  }
+  auto makePDF = [&typefaces](SkExecutor* executor) {
+    SkPDF::Metadata metadata;
+    metadata.fExecutor = executor;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkCanvas* canvas = doc->beginPage(612, 792);
+    float y = 20;
+    for (const sk_sp<SkTypeface>& typeface : typefaces) {
+      canvas->drawString("Sphinx of black quartz, judge my vow.", 10, y, SkFont(typeface), {});
+      y += 20;
+    }
+    doc->close();
+    return stream.detachAsData();
+  };
+  sk_sp<SkData> serial = makePDF(nullptr);
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(3);
+  sk_sp<SkData> parallel = makePDF(executor.get());
+  REPORTER_ASSERT(r, xref_is_valid(*serial));
+  REPORTER_ASSERT(r, xref_is_valid(*parallel));
+  auto count = [](const SkData& pdf, const char* needle) {
+    const std::string text((const char*)pdf.data(), pdf.size());
+    int n = 0;
+    for (size_t i = text.find(needle); i != std::string::npos; i = text.find(needle, i + 1)) {
+      n++;
+    }
+    return n;
+  };
+  for (const char* needle : {"/FontDescriptor", "/ToUnicode", "/DescendantFonts"}) {
+    REPORTER_ASSERT(r, count(*serial, needle) == count(*parallel, needle), "%s", needle);
+  }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkMatrix.h"
+#include "include/utils/SkRandom.h"
+#include "src/gpu/tessellate/PatchWriter.h"
+#include "tests/Test.h"
+
+#include <array>
+#include <vector>
+
+namespace skgpu::tess {
+
+namespace {
+
+// The patches a PatchWriter wrote, in CPU memory.
+struct PatchData {
+  std::vector<char> fBytes;
+  LinearTolerances fWorstCaseTolerances;
+  int fAppendCount = 0;
+};
+
+class CpuPatchAllocator {
+ public:
+  CpuPatchAllocator(size_t stride, PatchData* data) : fStride(stride), fData(data) {}
+
+  VertexWriter append(const LinearTolerances& tolerances, int count) {
+    fData->fWorstCaseTolerances.accumulate(tolerances);
+    ++fData->fAppendCount;
+    size_t offset = fData->fBytes.size();
+    fData->fBytes.resize(offset + count * fStride);
+    return {fData->fBytes.data() + offset, count * fStride};
+  }
+
+ private:
+  const size_t fStride;
+  PatchData* fData;
+};
+
+// The same traits as the curve and wedge writers in PathTessellator.
+using CurveWriter = PatchWriter<
+    CpuPatchAllocator, Optional<PatchAttribs::kColor>, Optional<PatchAttribs::kWideColorIfEnabled>,
+    Optional<PatchAttribs::kExplicitCurveType>, AddTrianglesWhenChopping, DiscardFlatCurves>;
+
+using WedgeWriter = PatchWriter<
+    CpuPatchAllocator, Required<PatchAttribs::kFanPoint>, Optional<PatchAttribs::kColor>,
+    Optional<PatchAttribs::kWideColorIfEnabled>, Optional<PatchAttribs::kExplicitCurveType>>;
+
+constexpr static int kBatchSize = 8;
+using Curves = std::array<std::array<SkPoint, 4>, kBatchSize>;
+
+enum class Batched : bool { kNo = false, kYes = true };
+
+// Writes the cubics, or the quadratics made of their first three points, either all together with
+// writeCubics() or writeQuadratics(), or one at a time.
+template <typename Writer>
+PatchData write_curves(
+    PatchAttribs attribs, const SkMatrix& shaderMatrix, const Curves& curves, SkPathVerb verb,
+    Batched batched) {
+  PatchData data;
+  Writer writer(attribs, &data);
+  writer.setShaderTransform(wangs_formula::VectorXform(shaderMatrix));
+  if constexpr (std::is_same_v<Writer, WedgeWriter>) {
+    writer.updateFanPointAttrib({-7, 11});
+  }
+  if (attribs & PatchAttribs::kColor) {
+    writer.updateColorAttrib({.25f, .5f, .75f, 1});
+  }
+  skvx::float4 p0p1[kBatchSize], p2p3[kBatchSize];
+  skvx::float2 p2[kBatchSize];
+  for (int i = 0; i < kBatchSize; ++i) {
+    p0p1[i] = skvx::float4::Load(curves[i].data());
+    p2p3[i] = skvx::float4::Load(curves[i].data() + 2);
+    p2[i] = p2p3[i].lo;
+  }
+  if (batched == Batched::kYes) {
+    if (verb == SkPathVerb::kQuad) {
+      writer.writeQuadratics(p0p1, p2);
+    } else {
+      writer.writeCubics(p0p1, p2p3);
+    }
+  } else {
+    for (int i = 0; i < kBatchSize; ++i) {
+      if (verb == SkPathVerb::kQuad) {
+        writer.writeQuadratic(p0p1[i].lo, p0p1[i].hi, p2[i]);
+      } else {
+        writer.writeCubic(p0p1[i].lo, p0p1[i].hi, p2p3[i].lo, p2p3[i].hi);
+      }
+    }
+  }
+  return data;
+}
+
+template <typename Writer>
+void check_batch(
+    skiatest::Reporter* r, PatchAttribs attribs, const Curves& curves, bool expectOneAppend) {
+  const SkMatrix matrices[] = {
+      SkMatrix::I(), SkMatrix::Scale(3, .5f),
+      SkMatrix::MakeAll(.9f, -1.3f, 0, .7f, 1.1f, 0, 0, 0, 1)};
+  for (const SkMatrix& m : matrices) {
+    for (SkPathVerb verb : {SkPathVerb::kQuad, SkPathVerb::kCubic}) {
+      PatchData batched = write_curves<Writer>(attribs, m, curves, verb, Batched::kYes);
+      PatchData scalar = write_curves<Writer>(attribs, m, curves, verb, Batched::kNo);
+      REPORTER_ASSERT(r, batched.fBytes == scalar.fBytes);
+      REPORTER_ASSERT(
+          r, batched.fWorstCaseTolerances.numParametricSegments_p4() ==
+                 scalar.fWorstCaseTolerances.numParametricSegments_p4());
+      // A batch of curves that all fit in one patch is written with a single append.
+      REPORTER_ASSERT(r, (batched.fAppendCount == 1) == expectOneAppend);
+    }
+  }
+}
+
+template <typename Writer>
+void check_batches(skiatest::Reporter* r, PatchAttribs attribs) {
+  SkRandom rand;
+  Curves curves;
+  for (auto& curve : curves) {
+    for (SkPoint& pt : curve) {
+      pt = {rand.nextRangeF(0, 100), rand.nextRangeF(0, 100)};
+    }
+  }
+  // None of these need chopping.
+  check_batch<Writer>(r, attribs, curves, true);
+
+  // One is flat, which only the curve writer discards.
+  curves[4] = {{{10, 10}, {20, 20}, {30, 30}, {40, 40}}};
+  check_batch<Writer>(r, attribs, curves, std::is_same_v<Writer, WedgeWriter>);
+
+  // Some are too long to fit in one patch.
+  curves[1] = {{{0, 0}, {1e5f, 3e4f}, {-2e4f, 9e4f}, {5e4f, 5e4f}}};
+  curves[6] = {{{0, 0}, {-3e4f, 0}, {-3e4f, 8e4f}, {1e3f, 1e3f}}};
+  check_batch<Writer>(r, attribs, curves, false);
+}
+
+}  // namespace
+
+// Ensure writing a batch of curves writes exactly the same patches as writing them one at a time.
+DEF_TEST(PatchWriter_batches, r) {
+  for (PatchAttribs attribs :
+       {PatchAttribs::kNone, PatchAttribs::kColor | PatchAttribs::kExplicitCurveType,
+        PatchAttribs::kColor | PatchAttribs::kWideColorIfEnabled}) {
+    check_batches<CurveWriter>(r, attribs);
+    check_batches<WedgeWriter>(r, attribs | PatchAttribs::kFanPoint);
+  }
+}
+
+}  // namespace skgpu::tess
@@ -11,7 +11,10 @@
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -21,10 +24,13 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkImageFilters.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkMiniRecorder.h"
@@ -966,3 +972,159 @@ DEF_TEST(Picture_nested_op_count, r) {
   check(make_pic(10, leaf1), 10, 10);
   check(make_pic(10, leaf10), 10, 100);
 }
+
+DEF_TEST(Picture_parallelPlayback, r) {
+  // Overlapping draws across tile boundaries, with state changes in between, so tiles only
+  // come out right if each one replays its ops in order.  Axis-aligned rects rasterize the
+  // same no matter how the canvas is tiled, so we can expect an exact match.
+  auto record = [](SkBBHFactory* factory) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(700, 500), factory);
+    SkRandom rand;
+    SkPaint paint;
+    for (int i = 0; i < 200; i++) {
+      paint.setColor(rand.nextU() | 0x80000000);
+      paint.setAntiAlias(rand.nextBool());
+      canvas->save();
+      canvas->translate(rand.nextRangeScalar(-20, 20), rand.nextRangeScalar(-20, 20));
+      canvas->clipRect(SkRect::MakeXYWH(
+          rand.nextRangeScalar(0, 350), rand.nextRangeScalar(0, 250), 400, 300));
+      canvas->drawRect(
+          SkRect::MakeXYWH(
+              rand.nextRangeScalar(0, 600), rand.nextRangeScalar(0, 400),
+              rand.nextRangeScalar(5, 300), rand.nextRangeScalar(5, 300)),
+          paint);
+      canvas->restore();
+    }
+    return recorder.finishRecordingAsPicture();
+  };
+
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+  SkRTreeFactory factory;
+  for (SkBBHFactory* f : {(SkBBHFactory*)nullptr, (SkBBHFactory*)&factory}) {
+    sk_sp<SkPicture> picture = record(f);
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(700, 500);
+    sk_sp<SkSurface> serial = SkSurface::MakeRaster(info),
+                     parallel = SkSurface::MakeRaster(info);
+    serial->getCanvas()->scale(0.9f, 0.9f);
+    parallel->getCanvas()->scale(0.9f, 0.9f);
+
+    picture->playback(serial->getCanvas());
+    sk_sp<SkImage> before = parallel->makeImageSnapshot();
+    picture->parallelPlayback(parallel->getCanvas(), executor.get());
+
+    SkBitmap want, got, untouched;
+    REPORTER_ASSERT(r, want.tryAllocPixels(info) && serial->readPixels(want, 0, 0));
+    REPORTER_ASSERT(r, got.tryAllocPixels(info) && parallel->readPixels(got, 0, 0));
+    REPORTER_ASSERT(r, untouched.tryAllocPixels(info));
+    REPORTER_ASSERT(r, before->readPixels(untouched.pixmap(), 0, 0));
+    REPORTER_ASSERT(r, !memcmp(want.getPixels(), got.getPixels(), want.computeByteSize()));
+
+    // The snapshot taken before playback must not see any of the parallel drawing.
+    REPORTER_ASSERT(r, memcmp(untouched.getPixels(), got.getPixels(), got.computeByteSize()));
+    bool untouchedIsClear = true;
+    for (int y = 0; y < info.height(); y++) {
+      for (int x = 0; x < info.width(); x++) {
+        untouchedIsClear &= *untouched.getAddr32(x, y) == 0;
+      }
+    }
+    REPORTER_ASSERT(r, untouchedIsClear);
+  }
+}
+
+DEF_TEST(Picture_parallelPlayback_blurAcrossSeam, r) {
+  // Blurs, backdrop ones especially, read pixels across the 256-pixel tile edges, so pictures
+  // using them (even inside a nested picture) must play back exactly as they do serially.
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(600, 400));
+  SkPaint blur;
+  blur.setImageFilter(SkImageFilters::Blur(6, 6, nullptr));
+  canvas->drawRect(SkRect::MakeLTRB(200, 40, 320, 120), blur);
+  canvas->drawRect(SkRect::MakeLTRB(230, 180, 290, 330), SkPaint(SkColor4f{1, 0, 0, 1}));
+  const SkRect backdropBounds = SkRect::MakeLTRB(200, 200, 320, 300);
+  sk_sp<SkImageFilter> backdrop = SkImageFilters::Blur(8, 8, nullptr);
+  canvas->saveLayer(SkCanvas::SaveLayerRec(&backdropBounds, nullptr, backdrop.get(), 0));
+  canvas->restore();
+  sk_sp<SkPicture> blurred = recorder.finishRecordingAsPicture();
+
+  canvas = recorder.beginRecording(SkRect::MakeWH(600, 400));
+  canvas->drawPicture(blurred);
+  sk_sp<SkPicture> nested = recorder.finishRecordingAsPicture();
+
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+  for (const sk_sp<SkPicture>& picture : {blurred, nested}) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(600, 400);
+    sk_sp<SkSurface> serial = SkSurface::MakeRaster(info),
+                     parallel = SkSurface::MakeRaster(info);
+    picture->playback(serial->getCanvas());
+    picture->parallelPlayback(parallel->getCanvas(), executor.get());
+
+    SkBitmap want, got;
+    REPORTER_ASSERT(r, want.tryAllocPixels(info) && serial->readPixels(want, 0, 0));
+    REPORTER_ASSERT(r, got.tryAllocPixels(info) && parallel->readPixels(got, 0, 0));
+    REPORTER_ASSERT(r, !memcmp(want.getPixels(), got.getPixels(), want.computeByteSize()));
+  }
+}
+
+DEF_TEST(Picture_deferredFromData, r) {
+  SkBitmap bm;
+  make_bm(&bm, 10, 10, SK_ColorBLUE, true);
+  sk_sp<SkImage> image =
+      SkImage::MakeFromEncoded(bm.asImage()->encodeToData(SkEncodedImageFormat::kPNG, 100));
+  REPORTER_ASSERT(r, image);
+
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  for (int i = 0; i < 20; i++) {
+    canvas->drawCircle(i * 5, 50, 10, SkPaint(SkColor4f{0, 1, 0, 0.5f}));
+  }
+  sk_sp<SkPicture> nested = recorder.finishRecordingAsPicture();
+
+  canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  canvas->drawRect(SkRect::MakeXYWH(10, 10, 50, 30), SkPaint(SkColor4f{1, 0, 0, 1}));
+  canvas->drawImage(image, 40, 40);
+  canvas->drawPicture(nested);
+  canvas->drawPath(SkPath::Circle(70, 30, 20), SkPaint(SkColor4f{0, 0, 1, 0.5f}));
+  sk_sp<SkData> skp = recorder.finishRecordingAsPicture()->serialize();
+
+  auto draw = [&](const SkPicture* picture) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas(bitmap).drawPicture(picture);
+    return bitmap;
+  };
+  SkBitmap want = draw(SkPicture::MakeFromData(skp.get()).get());
+
+  // Sections of an .skp are padded to 4-byte alignment within it, so the deferred picture shares
+  // its bytes when the .skp itself starts aligned, as a mapped file does, and copies otherwise.
+  for (size_t pad : {0, 1, 2, 3}) {
+    sk_sp<SkData> storage = SkData::MakeUninitialized(pad + skp->size());
+    memcpy(static_cast<char*>(storage->writable_data()) + pad, skp->data(), skp->size());
+    sk_sp<SkData> data = SkData::MakeSubset(storage.get(), pad, skp->size());
+
+    struct Ctx {
+      const void* encoded = nullptr;
+    } ctx;
+    SkDeserialProcs procs;
+    procs.fImageProc = [](const void* encoded, size_t, void* ctx) -> sk_sp<SkImage> {
+      static_cast<Ctx*>(ctx)->encoded = encoded;
+      return nullptr;  // Use the default decoding.
+    };
+    procs.fImageCtx = &ctx;
+
+    sk_sp<SkPicture> picture = SkPicture::MakeDeferredFromData(data, &procs);
+    REPORTER_ASSERT(r, picture);
+    REPORTER_ASSERT(r, picture->cullRect() == SkRect::MakeWH(100, 100));
+    REPORTER_ASSERT(r, picture->approximateOpCount() > 0);
+
+    const bool shared = ctx.encoded >= data->bytes() && ctx.encoded < data->bytes() + data->size();
+    REPORTER_ASSERT(r, shared == (pad == 0));
+
+    SkBitmap got = draw(picture.get());
+    REPORTER_ASSERT(r, !memcmp(want.getPixels(), got.getPixels(), want.computeByteSize()));
+  }
+
+  REPORTER_ASSERT(r, !SkPicture::MakeDeferredFromData(SkData::MakeSubset(skp.get(), 0, 100)));
+}
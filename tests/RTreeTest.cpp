@@ -5,6 +5,9 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkRTree.h"
 #include "tests/Test.h"
@@ -53,7 +56,7 @@ static void run_queries(
   }
 }
 
-DEF_TEST(RTree, reporter) {
+static void test_rtree(skiatest::Reporter* reporter, SkRTree::Packing packing) {
   int expectedDepthMin = -1;
   int tmp = NUM_RECTS;
   while (tmp > 0) {
@@ -73,7 +76,7 @@ DEF_TEST(RTree, reporter) {
   SkRandom rand;
   SkAutoTMalloc<SkRect> rects(NUM_RECTS);
   for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
-    SkRTree rtree;
+    SkRTree rtree(packing);
     REPORTER_ASSERT(reporter, 0 == rtree.getCount());
 
     for (int j = 0; j < NUM_RECTS; j++) {
@@ -89,3 +92,41 @@ DEF_TEST(RTree, reporter) {
         reporter, expectedDepthMin <= rtree.getDepth() && expectedDepthMax >= rtree.getDepth());
   }
 }
+
+DEF_TEST(RTree, reporter) { test_rtree(reporter, SkRTree::Packing::kInsertionOrder); }
+
+DEF_TEST(RTree_Hilbert, reporter) { test_rtree(reporter, SkRTree::Packing::kHilbert); }
+
+// Pictures recorded with a Hilbert-packed R-tree must play back the same as insertion-order ones.
+DEF_TEST(RTreeFactory_Hilbert, reporter) {
+  auto record = [](SkBBHFactory* factory) {
+    SkRandom rand;
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(1000, 1000), factory);
+    SkPaint paint;
+    for (int i = 0; i < NUM_RECTS; ++i) {
+      paint.setColor(rand.nextU() | 0xFF000000);
+      canvas->drawRect(random_rect(rand), paint);
+    }
+    return recorder.finishRecordingAsPicture();
+  };
+  SkRTreeFactory hilbertFactory(SkRTreeFactory::Packing::kHilbert), orderedFactory;
+  sk_sp<SkPicture> hilbert = record(&hilbertFactory);
+  sk_sp<SkPicture> ordered = record(&orderedFactory);
+
+  SkRandom rand;
+  for (size_t i = 0; i < NUM_QUERIES; ++i) {
+    SkBitmap a, b;
+    a.allocN32Pixels(100, 100);
+    b.allocN32Pixels(100, 100);
+    const SkRect clip = random_rect(rand);
+    for (auto [bitmap, picture] : {std::make_pair(&a, hilbert), std::make_pair(&b, ordered)}) {
+      SkCanvas canvas(*bitmap);
+      canvas.clear(SK_ColorWHITE);
+      canvas.scale(0.1f, 0.1f);
+      canvas.clipRect(clip);
+      picture->playback(&canvas);
+    }
+    REPORTER_ASSERT(reporter, 0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize()));
+  }
+}
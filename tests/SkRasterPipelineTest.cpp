@@ -532,3 +532,37 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
   p.append(SkRasterPipeline::store_8888, &ptr);
   p.run(0, 0, 1, 1);
 }
+
+DEF_TEST(SkRasterPipeline_lowp_repeat, r) {
+  // Tile an 8 pixel row out across an odd width, so we exercise both full strides and tails.
+  uint32_t src[8];
+  for (int i = 0; i < 8; i++) {
+    src[i] = (4 * i + 0) << 0 | (4 * i + 1) << 8 | (4 * i + 2) << 16 | (4 * i + 3) << 24;
+  }
+  uint32_t dst[37] = {};
+
+  SkRasterPipeline_GatherCtx gather;
+  gather.pixels = src;
+  gather.stride = 8;
+  gather.width = 8;
+  gather.height = 1;
+
+  SkRasterPipeline_TileCtx tile;
+  tile.scale = 8;
+  tile.invScale = 1.0f / 8;
+
+  SkRasterPipeline_MemoryCtx ptr = {dst, 0};
+
+  SkRasterPipeline_<256> p;
+  p.append(SkRasterPipeline::seed_shader);
+  p.append(SkRasterPipeline::repeat_x, &tile);
+  p.append(SkRasterPipeline::gather_8888, &gather);
+  p.append(SkRasterPipeline::store_8888, &ptr);
+  p.run(0, 0, 37, 1);
+
+  for (int i = 0; i < 37; i++) {
+    if (dst[i] != src[i % 8]) {
+      ERRORF(r, "got %08x, want %08x at %d\n", dst[i], src[i % 8], i);
+    }
+  }
+}
@@ -14,6 +14,7 @@
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImage_Base.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
@@ -288,3 +289,41 @@ DEF_TEST(ResourceCache_purge, reporter) {
     }
   }
 }
+
+DEF_TEST(ResourceCache_sharded, reporter) {
+  constexpr int kShards = 4;
+  constexpr int kRecs = 64;
+  // Room for half of the recs across all shards.
+  SkShardedResourceCache cache(kRecs / 2 * 1024, kShards);
+  REPORTER_ASSERT(reporter, cache.shardCount() == kShards);
+  REPORTER_ASSERT(reporter, cache.getTotalByteLimit() == kRecs / 2 * 1024);
+  REPORTER_ASSERT(
+      reporter, cache.getEffectiveSingleAllocationByteLimit() == kRecs / 2 * 1024 / kShards);
+
+  int flags = 0;
+  SkTaskGroup().batch(kRecs, [&](int i) {
+    auto rec = std::make_unique<TestRec>(1, i, &flags);
+    rec->fCanBePurged = true;
+    cache.add(rec.release());
+  });
+  REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() <= cache.getTotalByteLimit());
+  REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() > 0);
+
+  // Whatever survived must be findable through its shard.
+  int visited = 0;
+  cache.visitAll([](const SkResourceCache::Rec&, void* ctx) { *(int*)ctx += 1; }, &visited);
+  int found = 0;
+  for (int i = 0; i < kRecs; ++i) {
+    auto visitor = [](const SkResourceCache::Rec&, void*) { return true; };
+    found += cache.find(TestKey(1, i), visitor, nullptr) ? 1 : 0;
+  }
+  REPORTER_ASSERT(reporter, found == visited);
+  REPORTER_ASSERT(reporter, (size_t)visited * 1024 == cache.getTotalBytesUsed());
+
+  // Shrinking the budget purges every shard down to its new slice.
+  cache.setTotalByteLimit(kShards * 1024);
+  REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() <= kShards * 1024);
+
+  cache.purgeAll();
+  REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == 0);
+}
@@ -7,9 +7,12 @@
 
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <thread>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
   SkStrikeCache cache;
 
@@ -46,3 +49,65 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
   }
     REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
 }
+
+DEF_TEST(SkStrikeCache_ThreadMemo, Reporter) {
+  SkStrikeCache cache;
+
+  SkFont font;
+  font.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal()));
+
+  SkPaint defaultPaint;
+  SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+      font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry), SkScalerContextFlags::kNone,
+      SkMatrix::I());
+
+  // Repeated lookups, memoized or not, all see the one strike in the cache.
+  sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+  std::atomic<int> mismatches{0};
+  SkTaskGroup().batch(64, [&](int) {
+    for (int i = 0; i < 10; i++) {
+      if (strikeSpec.findOrCreateStrike(&cache) != strike ||
+          cache.findStrike(strikeSpec.descriptor()) != strike) {
+        mismatches++;
+      }
+    }
+  });
+  REPORTER_ASSERT(Reporter, mismatches == 0);
+  REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 1);
+
+  // Once purged, the strike must not be found again through the memo.
+  cache.purgeAll();
+  REPORTER_ASSERT(Reporter, cache.findStrike(strikeSpec.descriptor()) == nullptr);
+  REPORTER_ASSERT(Reporter, strikeSpec.findOrCreateStrike(&cache) != strike);
+  REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 1);
+}
+
+DEF_TEST(SkStrikeCache_ThreadMemoRecency, Reporter) {
+  SkStrikeCache cache;
+  cache.setCacheCountLimit(4);
+
+  SkFont font;
+  font.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal()));
+  SkPaint defaultPaint;
+  auto strikeSpecOfSize = [&](float size) {
+    font.setSize(size);
+    return SkStrikeSpec::MakeMask(
+        font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+        SkScalerContextFlags::kNone, SkMatrix::I());
+  };
+
+  // A strike this thread keeps finding through its memo must not age out of the LRU list while
+  // other threads fill the cache.
+  SkStrikeSpec hotSpec = strikeSpecOfSize(10);
+  SkStrike* hot = hotSpec.findOrCreateStrike(&cache).get();
+  for (int i = 0; i < 16; i++) {
+    std::thread([&] { strikeSpecOfSize(20 + i).findOrCreateStrike(&cache); }).join();
+    REPORTER_ASSERT(Reporter, cache.findStrike(hotSpec.descriptor()).get() == hot);
+  }
+  REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= 4);
+
+  // Purging on another thread must also drop this thread's memo ref.
+  sk_sp<SkStrike> strike = hotSpec.findOrCreateStrike(&cache);
+  std::thread([&] { cache.purgeAll(); }).join();
+  REPORTER_ASSERT(Reporter, strike->unique());
+}
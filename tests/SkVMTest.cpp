@@ -10,11 +10,14 @@
 #include "include/private/SkColorData.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkVM.h"
+#include "src/core/SkVMJITCache.h"
 #include "src/gpu/ganesh/GrShaderCaps.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/codegen/SkSLVMCodeGenerator.h"
 #include "src/sksl/tracing/SkVMDebugTrace.h"
+#include "src/utils/SkOSPath.h"
 #include "src/utils/SkVMVisualizer.h"
 #include "tests/Test.h"
 
@@ -3034,3 +3037,59 @@ DEF_TEST(SkVM_Visualizer, r) {
              "<tr class='source'><td class='mask'>&#8617;v9</td>"
              "<td colspan=2>int main(int x, int y)</td></tr>"));
 }
+
+DEF_TEST(SkVM_JITCache, r) {
+  SkString tmpDir = skiatest::GetTmpDir();
+  if (tmpDir.isEmpty()) {
+    return;
+  }
+  SkString path = SkOSPath::Join(tmpDir.c_str(), "skvm_jit_cache");
+  {
+    SkFILEWStream empty(path.c_str());  // Start from an empty (so invalid) file.
+  }
+
+  const uint8_t codeA[] = {0xc3}, codeB[] = {0x90, 0x90, 0xc3};
+  {
+    SkVMJITCache cache;
+    REPORTER_ASSERT(r, !cache.enabled());
+    REPORTER_ASSERT(r, !cache.find(1));
+    REPORTER_ASSERT(r, cache.missCount() == 0);  // Disabled caches don't count.
+
+    REPORTER_ASSERT(r, cache.setPath(path.c_str()));
+    REPORTER_ASSERT(r, cache.enabled());
+    REPORTER_ASSERT(r, cache.count() == 0);
+    REPORTER_ASSERT(r, !cache.find(1));
+    cache.add(1, codeA, sizeof(codeA));
+    cache.add(2, codeB, sizeof(codeB));
+    REPORTER_ASSERT(r, cache.count() == 2);
+    REPORTER_ASSERT(r, cache.missCount() == 1);
+  }
+  {
+    SkVMJITCache cache;
+    REPORTER_ASSERT(r, cache.setPath(path.c_str()));
+    REPORTER_ASSERT(r, cache.count() == 2);
+    sk_sp<SkData> code = cache.find(2);
+    REPORTER_ASSERT(r, code && code->equals(SkData::MakeWithoutCopy(codeB, sizeof(codeB)).get()));
+    REPORTER_ASSERT(r, cache.hitCount() == 1);
+  }
+  {
+    // A torn record at the end of the file is dropped, and everything before it kept.
+    FILE* file = sk_fopen(path.c_str(), kAppend_SkFILE_Flag);
+    REPORTER_ASSERT(r, file);
+    sk_fwrite(codeB, sizeof(codeB), file);
+    sk_fclose(file);
+
+    SkVMJITCache cache;
+    REPORTER_ASSERT(r, cache.setPath(path.c_str()));
+    REPORTER_ASSERT(r, cache.count() == 2);
+    cache.add(3, codeA, sizeof(codeA));
+  }
+  {
+    SkVMJITCache cache;
+    REPORTER_ASSERT(r, cache.setPath(path.c_str()));
+    REPORTER_ASSERT(r, cache.count() == 3);
+    REPORTER_ASSERT(r, cache.find(1) && cache.find(3));
+    REPORTER_ASSERT(r, cache.setPath(nullptr));
+    REPORTER_ASSERT(r, !cache.enabled() && cache.count() == 0);
+  }
+}
@@ -8,11 +8,13 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkOverdrawCanvas.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkSurface.h"
+#include "include/effects/SkImageFilters.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrDirectContext.h"
 #include "src/core/SkAutoPixmapStorage.h"
@@ -673,6 +675,110 @@ DEF_TEST(surface_raster_zeroinitialized, reporter) {
   }
 }
 
+// Sticks to rects: curved AA edges that cross a band seam are chopped there, and can differ
+// slightly from an unbanded draw.
+static void draw_threaded_surface_content(SkCanvas* canvas) {
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  canvas->clear(SK_ColorWHITE);
+  canvas->save();
+  canvas->translate(7, 13);
+  canvas->clipRect(SkRect::MakeLTRB(0, 0, 250, 400));
+  paint.setColor(SK_ColorBLUE);
+  canvas->drawRect(SkRect::MakeLTRB(10.5f, 30.25f, 200.75f, 290.5f), paint);
+  canvas->saveLayerAlpha(nullptr, 0x80);
+  paint.setColor(SK_ColorRED);
+  canvas->drawRect(SkRect::MakeLTRB(20, 40, 230, 380), paint);
+  canvas->restore();
+  canvas->restore();
+  paint.setColor(SK_ColorGREEN);
+  canvas->drawRect(SkRect::MakeLTRB(100.5f, 200.5f, 290.5f, 470.5f), paint);
+}
+
+static bool surfaces_match(SkSurface* a, SkSurface* b) {
+  SkBitmap bmA, bmB;
+  bmA.allocPixels(a->imageInfo());
+  bmB.allocPixels(b->imageInfo());
+  if (!a->readPixels(bmA, 0, 0) || !b->readPixels(bmB, 0, 0)) {
+    return false;
+  }
+  return 0 == memcmp(bmA.getPixels(), bmB.getPixels(), bmA.computeByteSize());
+}
+
+DEF_TEST(SurfaceRasterThreaded, reporter) {
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(300, 500);
+  auto ref = SkSurface::MakeRaster(info);
+  auto threaded = SkSurface::MakeRasterThreaded(info, executor.get());
+  REPORTER_ASSERT(reporter, threaded && threaded->imageInfo() == info);
+
+  draw_threaded_surface_content(ref->getCanvas());
+  draw_threaded_surface_content(threaded->getCanvas());
+  REPORTER_ASSERT(reporter, surfaces_match(ref.get(), threaded.get()));
+
+  // Snapshots must not see draws recorded after them, nor content from still-open layers.
+  sk_sp<SkImage> before = threaded->makeImageSnapshot();
+  SkCanvas* canvas = threaded->getCanvas();
+  canvas->saveLayer(nullptr, nullptr);
+  canvas->drawColor(SK_ColorBLACK);
+  sk_sp<SkImage> during = threaded->makeImageSnapshot();
+  canvas->restore();
+  SkPixmap pmBefore, pmDuring;
+  REPORTER_ASSERT(reporter, before->peekPixels(&pmBefore) && during->peekPixels(&pmDuring));
+  REPORTER_ASSERT(reporter, *pmBefore.addr32(0, 0) == SK_ColorWHITE);
+  REPORTER_ASSERT(reporter, *pmDuring.addr32(0, 0) == SK_ColorWHITE);
+  ref->getCanvas()->drawColor(SK_ColorBLACK);
+  REPORTER_ASSERT(reporter, surfaces_match(ref.get(), threaded.get()));
+
+  // Matrix and clip state must survive across flushes.
+  for (SkSurface* surface : {ref.get(), threaded.get()}) {
+    SkCanvas* c = surface->getCanvas();
+    c->save();
+    c->clipRect(SkRect::MakeLTRB(10, 10, 200, 300));
+    c->scale(2, 2);
+    surface->makeImageSnapshot();
+    c->drawColor(SK_ColorYELLOW);
+    c->restore();
+    c->drawColor(0x40FF00FF);
+  }
+  REPORTER_ASSERT(reporter, surfaces_match(ref.get(), threaded.get()));
+}
+
+// Blurs read pixels from beyond a band's edges, so they must not be replayed band by band.
+DEF_TEST(SurfaceRasterThreaded_BlurAcrossSeam, reporter) {
+  std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(300, 500);
+  auto ref = SkSurface::MakeRaster(info);
+  auto threaded = SkSurface::MakeRasterThreaded(info, executor.get());
+
+  // The surface is cut into bands 72 rows tall; every blurred shape below straddles a seam.
+  auto drawBlurs = [](SkCanvas* canvas) {
+    canvas->clear(SK_ColorWHITE);
+    SkPaint blur;
+    blur.setImageFilter(SkImageFilters::Blur(6, 6, nullptr));
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+
+    canvas->saveLayer(nullptr, &blur);
+    canvas->drawRect(SkRect::MakeLTRB(20, 50, 120, 90), paint);
+    canvas->restore();
+
+    paint.setImageFilter(SkImageFilters::Blur(4, 8, nullptr));
+    canvas->drawRect(SkRect::MakeLTRB(150, 120, 250, 160), paint);
+
+    paint.setImageFilter(nullptr);
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeLTRB(30, 200, 270, 230), paint);
+    sk_sp<SkImageFilter> backdrop = SkImageFilters::Blur(5, 5, nullptr);
+    const SkRect backdropBounds = SkRect::MakeLTRB(0, 180, 300, 260);
+    canvas->saveLayer(SkCanvas::SaveLayerRec(&backdropBounds, nullptr, backdrop.get(), 0));
+    canvas->restore();
+  };
+  drawBlurs(ref->getCanvas());
+  drawBlurs(threaded->getCanvas());
+  REPORTER_ASSERT(reporter, surfaces_match(ref.get(), threaded.get()));
+}
+
 static sk_sp<SkSurface> create_gpu_surface_backend_texture(
     GrDirectContext* dContext, int sampleCnt, const SkColor4f& color) {
   // On Pixel and Pixel2XL's with Adreno 530 and 540s, setting width and height to 10s reliably
@@ -6,7 +6,9 @@
  */
 
 #include "include/core/SkSwizzle.h"
+#include "include/private/SkColorData.h"
 #include "include/private/SkImageInfoPriv.h"
+#include "include/utils/SkRandom.h"
 #include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
 #include "tests/Test.h"
@@ -127,6 +129,61 @@ DEF_TEST(SwizzleOpts, r) {
   REPORTER_ASSERT(r, dst == 0xFA04ADCA);
 }
 
+DEF_TEST(SwizzleOpts_Expand, r) {
+  // Odd widths exercise both the vector loops and their tails.
+  constexpr int kWidth = 67;
+  SkRandom rand;
+  uint8_t src[8 * kWidth];
+  for (uint8_t& byte : src) {
+    byte = rand.nextU() & 0xFF;
+  }
+  uint32_t src32[kWidth], table[256];
+  for (uint32_t& px : src32) {
+    px = rand.nextU();
+  }
+  for (uint32_t& color : table) {
+    color = rand.nextU();
+  }
+
+  for (int width = 0; width <= kWidth; width++) {
+    uint32_t dst[kWidth];
+
+    // 16-bit components are big-endian, so we keep every other byte.
+    SkOpts::RGBA16_to_RGBA(dst, src, width);
+    for (int x = 0; x < width; x++) {
+      const uint8_t* p = src + 8 * x;
+      REPORTER_ASSERT(r, dst[x] == SkPackARGB_as_RGBA(p[6], p[0], p[2], p[4]));
+    }
+    SkOpts::RGB16_to_RGB1(dst, src, width);
+    for (int x = 0; x < width; x++) {
+      const uint8_t* p = src + 6 * x;
+      REPORTER_ASSERT(r, dst[x] == SkPackARGB_as_RGBA(0xFF, p[0], p[2], p[4]));
+    }
+
+    SkOpts::index_to_8888(dst, src, table, width);
+    for (int x = 0; x < width; x++) {
+      REPORTER_ASSERT(r, dst[x] == table[src[x]]);
+    }
+
+    // 5-6-5 with a 1-bit alpha on top, like a 32-bit BMP might have.
+    const SkOpts::SwizzleMasks masks = {
+        {0xF800, 0x07E0, 0x001F, 0x80000000},
+        {11, 5, 0, 31},
+        {255.0f / 31, 255.0f / 63, 255.0f / 31, 255.0f},
+        {0.5f, 0.5f, 0.5f, 0.5f},
+    };
+    auto to_8 = [](uint32_t c, uint32_t max) { return (2 * 255 * c + max) / (2 * max); };
+    SkOpts::masks_to_8888(dst, src32, masks, width);
+    for (int x = 0; x < width; x++) {
+      const uint32_t p = src32[x];
+      REPORTER_ASSERT(
+          r, dst[x] == SkPackARGB_as_RGBA(
+                           (p >> 31) * 255, to_8((p >> 11) & 31, 31), to_8((p >> 5) & 63, 63),
+                           to_8(p & 31, 31)));
+    }
+  }
+}
+
 DEF_TEST(PublicSwizzleOpts, r) {
   uint32_t dst, src;
 
@@ -19,7 +19,10 @@
 #include "src/gpu/ganesh/effects/GrPorterDuffXferProcessor.h"
 #include "src/gpu/ganesh/geometry/GrAATriangulator.h"
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrPathUtils.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
+#include "src/gpu/ganesh/geometry/GrSweepTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/shaders/SkShaderBase.h"
 #include "tools/ToolUtils.h"
 #include <map>
@@ -488,8 +491,14 @@ CreatePathFn kNonEdgeAAPaths[] = {
 };
 
 #if SK_GPU_V1
+#  include "include/core/SkBitmap.h"
+#  include "include/core/SkCanvas.h"
+#  include "include/core/SkExecutor.h"
+#  include "include/core/SkSurface.h"
+#  include "include/utils/SkRandom.h"
 #  include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 #  include "src/gpu/ganesh/v1/SurfaceDrawContext_v1.h"
+#  include "tools/gpu/GrContextFactory.h"
 
 // A simple concave path. Test this with a non-invertible matrix.
 static SkPath create_path_17() {
@@ -862,6 +871,64 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(TriangulatingPathRendererTests, reporter, ctxInfo)
   test_path(ctx, sdc.get(), create_path_47(), SkMatrix(), GrAAType::kCoverage);
 }
 
+// Draws concave stars, with and without AA, on a context that triangulates them at flush time, in
+// parallel or not.
+static bool draw_stars(
+    const GrContextOptions& baseOptions, sk_gpu_test::GrContextFactory::ContextType type,
+    SkExecutor* executor, SkBitmap* bitmap) {
+  GrContextOptions options = baseOptions;
+  options.fGpuPathRenderers = GpuPathRenderers::kTriangulating;
+  options.fExecutor = executor;
+  options.fPrepareOpsInParallel = SkToBool(executor);
+  sk_gpu_test::GrContextFactory factory(options);
+  auto dContext = factory.get(type);
+  if (!dContext) {
+    return false;
+  }
+  SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+  sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(dContext, SkBudgeted::kNo, info);
+  if (!surface) {
+    return false;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorWHITE);
+  SkRandom rand;
+  for (int i = 0; i < 32; ++i) {
+    SkPoint center = {rand.nextRangeF(0, 256), rand.nextRangeF(0, 256)};
+    float radius = rand.nextRangeF(8, 64);
+    SkPath star;
+    for (int p = 0; p < 7; ++p) {
+      float angle = p * 3 * SK_ScalarPI * 2 / 7;
+      star.lineTo(center + SkVector{SkScalarCos(angle), SkScalarSin(angle)} * radius);
+    }
+    SkPaint paint;
+    paint.setAntiAlias(i % 2);
+    paint.setColor(0xff000000 | rand.nextU());
+    canvas->drawPath(star, paint);
+  }
+  bitmap->allocPixels(info);
+  return surface->readPixels(*bitmap, 0, 0);
+}
+
+DEF_GPUTEST(TriangulatingPathRenderer_ParallelPrepare, reporter, options) {
+  std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(2);
+  for (int i = 0; i < sk_gpu_test::GrContextFactory::kContextTypeCnt; ++i) {
+    auto type = static_cast<sk_gpu_test::GrContextFactory::ContextType>(i);
+    if (!sk_gpu_test::GrContextFactory::IsRenderingContext(type)) {
+      continue;
+    }
+    SkBitmap serial, parallel;
+    if (!draw_stars(options, type, nullptr, &serial) ||
+        !draw_stars(options, type, threadPool.get(), &parallel)) {
+      continue;
+    }
+    REPORTER_ASSERT(
+        reporter,
+        !memcmp(serial.getPixels(), parallel.getPixels(), serial.computeByteSize()),
+        "%s", sk_gpu_test::GrContextFactory::ContextTypeName(type));
+  }
+}
+
 #endif  // SK_GPU_V1
 
 namespace {
@@ -1157,6 +1224,233 @@ DEF_TEST(GrInnerFanTriangulator, r) {
   }
 }
 
+// Triangulates 'path' like PathInnerTriangulateOp does, adds it to 'cache', and checks that the
+// cache gives back the same triangles and breadcrumbs.
+static void add_to_cache(skiatest::Reporter* r, GrTriangulatorCache* cache, const SkPath& path) {
+  SkArenaAlloc arena(GrTriangulator::kArenaDefaultChunkSize);
+  GrInnerFanTriangulator::BreadcrumbTriangleList breadcrumbs;
+  SimpleVertexAllocator vertexAlloc;
+  bool isLinear;
+  GrInnerFanTriangulator triangulator(path, &arena);
+  auto* polys = triangulator.pathToPolys(&breadcrumbs, &isLinear);
+  int splitBreadcrumbCount = breadcrumbs.count();
+  int vertexCount = triangulator.polysToTriangles(polys, &vertexAlloc, &breadcrumbs);
+  cache->addInnerFan(
+      path, isLinear, vertexAlloc.fPoints.get(), vertexCount, breadcrumbs, splitBreadcrumbCount);
+
+  sk_sp<const GrTriangulatorCache::InnerFan> fan = cache->findInnerFan(path);
+  if (!fan) {
+    ERRORF(r, "triangulation not found in cache");
+    return;
+  }
+  REPORTER_ASSERT(r, fan->fIsLinear == isLinear);
+  REPORTER_ASSERT(r, fan->vertexCount() == vertexCount);
+  REPORTER_ASSERT(
+      r, !memcmp(fan->fVertices.data(), vertexAlloc.fPoints.get(), vertexCount * sizeof(SkPoint)));
+  GrInnerFanTriangulator::BreadcrumbTriangleList cachedBreadcrumbs;
+  fan->appendBreadcrumbs(&arena, &cachedBreadcrumbs);
+  REPORTER_ASSERT(r, cachedBreadcrumbs.count() == breadcrumbs.count());
+  for (auto *a = breadcrumbs.head(), *b = cachedBreadcrumbs.head(); a && b;
+       a = a->fNext, b = b->fNext) {
+    REPORTER_ASSERT(r, !memcmp(a->fPts, b->fPts, sizeof(a->fPts)));
+  }
+}
+
+DEF_TEST(GrTriangulatorCache, r) {
+  SkPath star = ToolUtils::make_star(SkRect::MakeWH(100, 200), 7, 3);
+  SkPath bowtie = SkPath().lineTo(1, 0).lineTo(0, 1).lineTo(1, 1);
+
+  GrTriangulatorCache cache(1 << 20);
+  REPORTER_ASSERT(r, !cache.findInnerFan(star));
+  add_to_cache(r, &cache, star);
+  add_to_cache(r, &cache, bowtie);
+
+  // Copies and rebuilt paths are found, but other fill types need their own triangulations.
+  SkPath copy = star;
+  REPORTER_ASSERT(r, cache.findInnerFan(copy));
+  REPORTER_ASSERT(r, cache.findInnerFan(ToolUtils::make_star(SkRect::MakeWH(100, 200), 7, 3)));
+  copy.setFillType(SkPathFillType::kEvenOdd);
+  REPORTER_ASSERT(r, !cache.findInnerFan(copy));
+  size_t bytesUsed = cache.bytesUsed();
+  add_to_cache(r, &cache, copy);
+  REPORTER_ASSERT(r, cache.bytesUsed() > bytesUsed);
+  REPORTER_ASSERT(r, cache.findInnerFan(star)->fSplitBreadcrumbs ==
+                         cache.findInnerFan(copy)->fSplitBreadcrumbs);
+
+  // A new cache can start with all of the triangulations.
+  sk_sp<SkData> data = cache.serialize();
+  GrTriangulatorCache warmCache(1 << 20);
+  REPORTER_ASSERT(r, warmCache.deserialize(data->data(), data->size()));
+  for (const SkPath& path : {star, copy, bowtie}) {
+    sk_sp<const GrTriangulatorCache::InnerFan> a = cache.findInnerFan(path);
+    sk_sp<const GrTriangulatorCache::InnerFan> b = warmCache.findInnerFan(path);
+    REPORTER_ASSERT(r, b && a->fIsLinear == b->fIsLinear);
+    REPORTER_ASSERT(r, b && a->fVertices == b->fVertices);
+    REPORTER_ASSERT(r, b && a->fSplitBreadcrumbs->fPts == b->fSplitBreadcrumbs->fPts);
+    REPORTER_ASSERT(r, b && a->fWindingBreadcrumbs == b->fWindingBreadcrumbs);
+  }
+  REPORTER_ASSERT(r, !warmCache.deserialize(data->data(), data->size() - 4));
+  REPORTER_ASSERT(r, !warmCache.deserialize(data->bytes() + 4, data->size() - 4));
+
+  // Over budget, the least recently used paths go first.
+  GrTriangulatorCache smallCache(warmCache.bytesUsed() - 1);
+  REPORTER_ASSERT(r, smallCache.deserialize(data->data(), data->size()));
+  REPORTER_ASSERT(r, smallCache.bytesUsed() < warmCache.bytesUsed());
+  REPORTER_ASSERT(r, !smallCache.findInnerFan(bowtie));
+  REPORTER_ASSERT(r, smallCache.findInnerFan(star));
+
+  REPORTER_ASSERT(r, cache.hits() > 0 && cache.misses() == 2);
+  cache.purgeAll();
+  REPORTER_ASSERT(r, cache.bytesUsed() == 0);
+  REPORTER_ASSERT(r, !cache.findInnerFan(star));
+}
+
+// Meshes for TriangulatingPathRenderer serve any tolerance they're accurate enough for, so a path
+// that's only been translated finds its mesh.
+DEF_TEST(GrTriangulatorCache_Meshes, r) {
+  SkPath star = ToolUtils::make_star(SkRect::MakeWH(100, 200), 7, 3);
+  SkPath circle = SkPath::Circle(50, 50, 40);
+  auto add_mesh = [&](GrTriangulatorCache* cache, const SkPath& path, SkScalar tol) {
+    SimpleVertexAllocator vertexAlloc;
+    bool isLinear;
+    int vertexCount = GrTriangulator::PathToTriangles(
+        path, tol, path.getBounds(), &vertexAlloc, &isLinear);
+    cache->addMesh(path, tol, isLinear, vertexAlloc.fPoints.get(), vertexCount);
+    return vertexCount;
+  };
+
+  GrTriangulatorCache cache(1 << 20);
+  REPORTER_ASSERT(r, !cache.findMesh(star, 1));
+  int starCount = add_mesh(&cache, star, 1);
+  sk_sp<const GrTriangulatorCache::Mesh> mesh = cache.findMesh(star, 100);
+  REPORTER_ASSERT(r, mesh && mesh->fIsLinear && mesh->vertexCount() == starCount);
+  REPORTER_ASSERT(r, cache.findMesh(star, 0.01f) == mesh);
+  SkPath evenOddStar = star;
+  evenOddStar.setFillType(SkPathFillType::kEvenOdd);
+  REPORTER_ASSERT(r, !cache.findMesh(evenOddStar, 1));
+  // Meshes and inner fans of a path share its entry.
+  add_to_cache(r, &cache, star);
+  REPORTER_ASSERT(r, cache.findMesh(star, 1) == mesh);
+
+  // Curved meshes serve tolerances down to a third of their own, and finer ones replace them.
+  add_mesh(&cache, circle, 0.5f);
+  REPORTER_ASSERT(r, cache.findMesh(circle, 0.25f));
+  REPORTER_ASSERT(r, !cache.findMesh(circle, 0.1f));
+  add_mesh(&cache, circle, 0.05f);
+  REPORTER_ASSERT(r, cache.findMesh(circle, 0.1f));
+  REPORTER_ASSERT(r, cache.findMesh(circle, 1)->fTolerance == 0.05f);
+  add_mesh(&cache, circle, 1);
+  REPORTER_ASSERT(r, cache.findMesh(circle, 1)->fTolerance == 0.05f);
+
+  sk_sp<SkData> data = cache.serialize();
+  GrTriangulatorCache warmCache(1 << 20);
+  REPORTER_ASSERT(r, warmCache.deserialize(data->data(), data->size()));
+  for (const SkPath& path : {star, circle}) {
+    sk_sp<const GrTriangulatorCache::Mesh> a = cache.findMesh(path, 1);
+    sk_sp<const GrTriangulatorCache::Mesh> b = warmCache.findMesh(path, 1);
+    REPORTER_ASSERT(r, b && a->fIsLinear == b->fIsLinear && a->fTolerance == b->fTolerance);
+    REPORTER_ASSERT(r, b && a->fVertices == b->fVertices);
+  }
+  REPORTER_ASSERT(r, warmCache.findInnerFan(star));
+}
+
+static double triangles_area(const SkPoint* pts, int vertexCount) {
+  double area = 0;
+  for (int i = 0; i + 2 < vertexCount; i += 3) {
+    SkVector a = pts[i + 1] - pts[i], b = pts[i + 2] - pts[i];
+    area += std::abs((double)a.fX * b.fY - (double)a.fY * b.fX) / 2;
+  }
+  return area;
+}
+
+// Returns how many of the triangles contain 'p', or -1 if it's too close to one's edge to tell.
+static int triangles_coverage(const SkPoint* pts, int vertexCount, SkPoint p) {
+  int coverage = 0;
+  for (int i = 0; i + 2 < vertexCount; i += 3) {
+    int sides = 0;
+    for (int j = 0; j < 3; ++j) {
+      SkPoint a = pts[i + j], b = pts[i + (j + 1) % 3];
+      double side = (double)(b.fX - a.fX) * (p.fY - a.fY) - (double)(b.fY - a.fY) * (p.fX - a.fX);
+      if (std::abs(side) <= 1e-4 * SkPoint::Distance(a, b) * std::max(1.f, p.length())) {
+        return -1;
+      }
+      sides += side > 0 ? 1 : -1;
+    }
+    coverage += std::abs(sides) == 3;
+  }
+  return coverage;
+}
+
+// The sweep engine should cover the same points as the mesh engine, each once, and for paths
+// without curves, the same points as SkPath::contains(). It gives up only on paths with enormous
+// coordinates, where the rounding of its predicates disagrees; those only have to not crash.
+static void check_sweep_triangulator(skiatest::Reporter* r, SkPath path) {
+  SkRect clipBounds = path.getBounds().makeOutset(1, 1);
+  bool comparable = SkRect::MakeLTRB(-1e6f, -1e6f, 1e6f, 1e6f).contains(clipBounds);
+  for (SkPathFillType fillType :
+       {SkPathFillType::kWinding, SkPathFillType::kEvenOdd, SkPathFillType::kInverseWinding,
+        SkPathFillType::kInverseEvenOdd}) {
+    path.setFillType(fillType);
+    SimpleVertexAllocator meshAlloc, sweepAlloc;
+    bool isLinear;
+    int meshCount = GrTriangulator::PathToTriangles(
+        path, GrPathUtils::kDefaultTolerance, clipBounds, &meshAlloc, &isLinear);
+    int sweepCount;
+    bool swept = GrSweepTriangulator::PathToTriangles(
+        path, GrPathUtils::kDefaultTolerance, clipBounds, &sweepAlloc, &isLinear, &sweepCount);
+    REPORTER_ASSERT(r, swept || !comparable, "sweep engine gave up on a path it should handle");
+    if (!swept || !comparable) {
+      continue;
+    }
+    double meshArea = triangles_area(meshAlloc.fPoints.get(), meshCount);
+    double sweepArea = triangles_area(sweepAlloc.fPoints.get(), sweepCount);
+    REPORTER_ASSERT(
+        r, std::abs(meshArea - sweepArea) <= 1e-2 * meshArea, "mesh area %g, sweep area %g",
+        meshArea, sweepArea);
+
+    constexpr int kSamples = 32;
+    int mismatches = 0;
+    for (int y = 0; y < kSamples; ++y) {
+      for (int x = 0; x < kSamples; ++x) {
+        SkPoint p = {clipBounds.fLeft + (x + 0.37f) * clipBounds.width() / kSamples,
+                     clipBounds.fTop + (y + 0.61f) * clipBounds.height() / kSamples};
+        int sweepCoverage = triangles_coverage(sweepAlloc.fPoints.get(), sweepCount, p);
+        int meshCoverage = triangles_coverage(meshAlloc.fPoints.get(), meshCount, p);
+        if (sweepCoverage < 0 || meshCoverage < 0) {
+          continue;
+        }
+        int expected = isLinear ? path.contains(p.fX, p.fY) : meshCoverage;
+        mismatches += sweepCoverage != expected;
+      }
+    }
+    REPORTER_ASSERT(r, mismatches == 0, "%d of %d samples covered wrongly", mismatches,
+                    kSamples * kSamples);
+  }
+}
+
+DEF_TEST(GrSweepTriangulator, r) {
+  for (CreatePathFn createPath : kNonEdgeAAPaths) {
+    check_sweep_triangulator(r, createPath());
+  }
+  // A wavy spiral crosses itself dozens of times, and random polygons hundreds of times.
+  SkPath spiral;
+  for (int i = 0; i < 300; ++i) {
+    float theta = 3 * 2 * SK_ScalarPI * i / 300, radius = 300 + 20 * sinf(7.1f * theta);
+    SkPoint p = {radius * cosf(theta) + i * 0.01f, radius * sinf(theta)};
+    i == 0 ? spiral.moveTo(p) : spiral.lineTo(p);
+  }
+  check_sweep_triangulator(r, spiral);
+  SkRandom rand;
+  for (int i = 0; i < 8; ++i) {
+    SkPath polygon;
+    polygon.moveTo(rand.nextRangeF(0, 100), rand.nextRangeF(0, 100));
+    for (int j = 0; j < 40; ++j) {
+      polygon.lineTo(rand.nextRangeF(0, 100), rand.nextRangeF(0, 100));
+    }
+    check_sweep_triangulator(r, polygon);
+  }
+}
+
 static void test_crbug_1262444(skiatest::Reporter* r) {
   SkPath path;
 
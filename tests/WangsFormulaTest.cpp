@@ -10,6 +10,8 @@
 #include "src/gpu/tessellate/WangsFormula.h"
 #include "tests/Test.h"
 
+#include <array>
+
 namespace skgpu::tess {
 
 const SkPoint kSerp[4] = {
@@ -288,6 +290,87 @@ DEF_TEST(wangs_formula_vectorXforms, r) {
   });
 }
 
+// Ensure the batch versions return exactly what the scalar ones do for each curve in the batch,
+// including for curves with infinite or NaN coordinates.
+DEF_TEST(wangs_formula_batch, r) {
+  constexpr static int N = 8;
+  constexpr static float inf = std::numeric_limits<float>::infinity();
+  constexpr static float nan = std::numeric_limits<float>::quiet_NaN();
+
+  auto same_p4 = [](float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+
+  // Quadratics use the first three points of each curve.
+  auto check_batch = [&](const std::array<SkPoint, 4>* curves,
+                         const wangs_formula::VectorXform& xform) {
+    skvx::Vec<N, float> x[4], y[4];
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        x[j][i] = curves[i][j].fX;
+        y[j][i] = curves[i][j].fY;
+      }
+    }
+    skvx::Vec<N, float> quadP4 = wangs_formula::quadratic_p4(kPrecision, x, y, xform);
+    skvx::Vec<N, int> quadLog2 = wangs_formula::quadratic_log2(kPrecision, x, y, xform);
+    skvx::Vec<N, float> cubicP4 = wangs_formula::cubic_p4(kPrecision, x, y, xform);
+    skvx::Vec<N, int> cubicLog2 = wangs_formula::cubic_log2(kPrecision, x, y, xform);
+    for (int i = 0; i < N; ++i) {
+      const SkPoint* pts = curves[i].data();
+      REPORTER_ASSERT(r, same_p4(quadP4[i], wangs_formula::quadratic_p4(kPrecision, pts, xform)));
+      REPORTER_ASSERT(r, quadLog2[i] == wangs_formula::quadratic_log2(kPrecision, pts, xform));
+      REPORTER_ASSERT(r, same_p4(cubicP4[i], wangs_formula::cubic_p4(kPrecision, pts, xform)));
+      REPORTER_ASSERT(r, cubicLog2[i] == wangs_formula::cubic_log2(kPrecision, pts, xform));
+    }
+  };
+
+  std::vector<std::array<SkPoint, 4>> curves;
+  curves.push_back({kSerp[0], kSerp[1], kSerp[2], kSerp[3]});
+  curves.push_back({kLoop[0], kLoop[1], kLoop[2], kLoop[3]});
+  curves.push_back({kQuad[0], kQuad[1], kQuad[2], kQuad[0]});
+  SkRandom rand;
+  for_random_beziers(4, &rand, [&](const SkPoint pts[]) {
+    curves.push_back({pts[0], pts[1], pts[2], pts[3]});
+  });
+  // Put each non-finite value in each coordinate of a curve, and make some curves whose squared
+  // lengths overflow to infinity.
+  for (float bad : {inf, -inf, nan}) {
+    for (int j = 0; j < 8; ++j) {
+      std::array<SkPoint, 4> pts = {kSerp[0], kSerp[1], kSerp[2], kSerp[3]};
+      (j & 1 ? pts[j / 2].fY : pts[j / 2].fX) = bad;
+      curves.push_back(pts);
+    }
+  }
+  curves.push_back({{{0, 0}, {inf, inf}, {inf, inf}, {0, 0}}});
+  curves.push_back({{{1e30f, 0}, {-1e30f, 0}, {1e30f, 1e30f}, {0, -1e30f}}});
+  curves.push_back({{{0, 0}, {0, 0}, {0, 0}, {0, 0}}});
+  while (curves.size() % N) {
+    curves.push_back(curves[curves.size() % N]);
+  }
+
+  for_random_matrices(&rand, [&](const SkMatrix& m) {
+    wangs_formula::VectorXform xform(m);
+    for (size_t i = 0; i < curves.size(); i += N) {
+      check_batch(&curves[i], xform);
+    }
+  });
+
+  // The vector nextlog16() matches the scalar one around every power of 2, and for all the values
+  // sk_float_nextlog2() treats specially.
+  std::vector<float> values = {0, -0.f, -1, inf, -inf, nan, -nan, FLT_MAX, FLT_MIN, FLT_TRUE_MIN};
+  for (int i = -150; i <= 128; ++i) {
+    float pow2 = std::ldexp(1.f, i);
+    values.insert(values.end(), {pow2, std::nextafter(pow2, 0.f), std::nextafter(pow2, inf)});
+  }
+  while (values.size() % N) {
+    values.push_back(values[values.size() % N]);
+  }
+  for (size_t i = 0; i < values.size(); i += N) {
+    skvx::Vec<N, int> log16 = wangs_formula::nextlog16(skvx::Vec<N, float>::Load(&values[i]));
+    for (int j = 0; j < N; ++j) {
+      REPORTER_ASSERT(r, log16[j] == wangs_formula::nextlog16(values[i + j]));
+    }
+  }
+}
+
 DEF_TEST(wangs_formula_worst_case_cubic, r) {
   {
     SkPoint worstP[] = {{0, 0}, {100, 100}, {0, 0}, {0, 0}};
@@ -6,10 +6,15 @@
  */
 
 #include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
 #include "include/private/SkTemplates.h"
 #include "src/core/SkAutoMalloc.h"
+#include "src/core/SkBitmapCache.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
@@ -121,6 +126,64 @@ DEF_TEST(Jpeg_YUV_Codec, r) {
   codec_yuv(r, "images/arrow.png", nullptr);
 }
 
+extern bool gSkForceRasterPipelineBlitter;
+
+// Draws a lazy JPEG with and without SkGraphics::SetRasterYUVPlanes(), and returns the largest
+// difference in any channel.  Both draws use SkRasterPipeline, so filtering is done the same way.
+static int max_yuv_draw_diff(
+    skiatest::Reporter* r, const char path[], float scale, const SkSamplingOptions& sampling) {
+  sk_sp<SkData> data = GetResourceAsData(path);
+  if (!data) {
+    return 0;
+  }
+  auto draw = [&](bool yuv, SkBitmap* bitmap) {
+    bool wasYUV = SkGraphics::SetRasterYUVPlanes(yuv);
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(data);
+    REPORTER_ASSERT(r, image && image->isLazyGenerated());
+    bitmap->allocN32Pixels(
+        SkScalarCeilToInt(image->width() * scale), SkScalarCeilToInt(image->height() * scale));
+    SkCanvas canvas(*bitmap);
+    canvas.scale(scale, scale);
+    canvas.drawImage(image, 0, 0, sampling);
+
+    // Drawing from YUV planes never makes an RGBA copy of the image.
+    SkBitmap cached;
+    REPORTER_ASSERT(r, !yuv == SkBitmapCache::Find(SkBitmapCacheDesc::Make(image.get()), &cached));
+    SkGraphics::SetRasterYUVPlanes(wasYUV);
+  };
+  SkBitmap rgba, yuv;
+  bool wasForced = gSkForceRasterPipelineBlitter;
+  gSkForceRasterPipelineBlitter = true;
+  draw(false, &rgba);
+  draw(true, &yuv);
+  gSkForceRasterPipelineBlitter = wasForced;
+
+  int maxDiff = 0;
+  for (int y = 0; y < rgba.height(); y++) {
+    for (int x = 0; x < rgba.width(); x++) {
+      SkColor a = rgba.getColor(x, y), b = yuv.getColor(x, y);
+      for (int shift : {0, 8, 16, 24}) {
+        int diff = (int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF);
+        maxDiff = std::max(maxDiff, std::abs(diff));
+      }
+    }
+  }
+  return maxDiff;
+}
+
+DEF_TEST(Jpeg_YUV_RasterDraw, r) {
+  const SkSamplingOptions kLinear(SkFilterMode::kLinear);
+  // Without chroma subsampling, only rounding in the color conversion differs.
+  REPORTER_ASSERT(r, max_yuv_draw_diff(r, "images/mandrill_h1v1.jpg", 1, {}) <= 1);
+  REPORTER_ASSERT(r, max_yuv_draw_diff(r, "images/mandrill_h1v1.jpg", 0.37f, kLinear) <= 1);
+  // Subsampled chroma is upsampled the way libjpeg does it, so only rounding differs there too.
+  REPORTER_ASSERT(r, max_yuv_draw_diff(r, "images/mandrill_h2v1.jpg", 1, {}) <= 2);
+  REPORTER_ASSERT(r, max_yuv_draw_diff(r, "images/mandrill_512_q075.jpg", 1, {}) <= 2);
+  REPORTER_ASSERT(r, max_yuv_draw_diff(r, "images/mandrill_512_q075.jpg", 0.37f, kLinear) <= 2);
+  // 439x154, so its 4:2:0 chroma planes are rounded up to 220x77.
+  REPORTER_ASSERT(r, max_yuv_draw_diff(r, "images/cropped_mandrill.jpg", 1.5f, kLinear) <= 2);
+}
+
 #include "include/effects/SkColorMatrix.h"
 #include "src/core/SkYUVMath.h"
 
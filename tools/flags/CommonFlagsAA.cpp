@@ -11,10 +11,12 @@ static DEFINE_bool(forceAnalyticAA, false,
             "Force analytic anti-aliasing even if the path is complicated: "
             "whether it's concave or convex, we consider a path complicated"
             "if its number of points is comparable to its resolution.");
+static DEFINE_bool(sparseStrips, false, "Fill large anti-aliased paths with sparse strips.");
 
 void SetAnalyticAA() {
   gSkUseAnalyticAA = FLAGS_analyticAA;
   gSkForceAnalyticAA = FLAGS_forceAnalyticAA;
+  gSkUseSparseStrips = FLAGS_sparseStrips;
 }
 
 }  // namespace CommonFlags